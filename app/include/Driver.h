@@ -5,70 +5,134 @@
 
 #include "CommaSeparatedIterator.h"
 #include "P2108.h"
+#include "ReportWriter.h"
 #include "ReturnCodes.h"
+#include "Service.h"
 #include "Structs.h"
 
-#include <fstream>   // for std::ofstream
-#include <iomanip>   // for std::left, std::setw
+#include <cstddef>   // for std::size_t
 #include <iostream>  // for std::cout
-#include <ostream>   // for std::endl, std::ostream
+#include <istream>   // for std::istream
+#include <ostream>   // for std::ostream
 #include <string>    // for std::string
 #include <vector>    // for std::vector
 
-/////////////////////////////
-// Macros
-
-/** Shortcut for concise print-to-file statements in driver */
-#define PRINT << std::endl << std::left << std::setw(25) <<
-/** Shortcut for setting fixed whitespace padding in driver file output */
-#define SETW13 << std::setw(13) <<
-
 //////////////////////////////
 // Library Namespace
 using namespace ITS::ITU::PSeries::P2108;
 
 /////////////////////////////
 // Functions
+int RunDriver(
+    const std::vector<std::string> &args,
+    std::istream &in,
+    std::ostream &out,
+    std::ostream &err
+);
+int RunModel(
+    const DrvrParams &params,
+    const std::vector<std::string> &args,
+    std::istream &in,
+    std::ostream &out,
+    std::ostream &err
+);
 void Help(std::ostream &os = std::cout);
-DrvrReturnCode ParseArguments(int argc, char **argv, DrvrParams &params);
-DrvrReturnCode ValidateInputs(const DrvrParams &params);
+DrvrReturnCode ParseArguments(
+    const std::vector<std::string> &args,
+    DrvrParams &params,
+    std::ostream &out,
+    std::ostream &err
+);
+DrvrReturnCode ValidateInputs(const DrvrParams &params, std::ostream &err);
 
 // Aeronautical Statistical Model
 ReturnCode CallAeronauticalStatisticalModel(
-    ASMParams &asm_params, std::vector<double> &L_ces__db
+    ASMParams &asm_params, double &L_ces__db
 );
-DrvrReturnCode
-    ParseASMInputFile(const std::string &in_file, ASMParams &asm_params);
-DrvrReturnCode ParseASMInputStream(std::istream &stream, ASMParams &asm_params);
-void WriteASMInputs(std::ofstream &fp, const ASMParams &params);
+DrvrReturnCode ParseASMInputFile(
+    const std::string &in_file, ASMParams &asm_params, std::ostream &err
+);
+DrvrReturnCode ParseASMInputStream(
+    std::istream &stream, ASMParams &asm_params, std::ostream &err
+);
+void WriteASMInputs(ReportWriter &fp, const ASMParams &params);
 
 // Height Gain Terminal Correction Model
 ReturnCode CallHeightGainTerminalCorrectionModel(
-    HGTCMParams &hgtcm_params, std::vector<double> &A_h__db
+    HGTCMParams &hgtcm_params, double &A_h__db
+);
+DrvrReturnCode ParseHGTCMInputFile(
+    const std::string &in_file, HGTCMParams &hgtcm_params, std::ostream &err
 );
-DrvrReturnCode
-    ParseHGTCMInputFile(const std::string &in_file, HGTCMParams &hgtcm_params);
-DrvrReturnCode
-    ParseHGTCMInputStream(std::istream &stream, HGTCMParams &hgtcm_params);
-void WriteHGTCMInputs(std::ofstream &fp, const HGTCMParams &params);
+DrvrReturnCode ParseHGTCMInputStream(
+    std::istream &stream, HGTCMParams &hgtcm_params, std::ostream &err
+);
+void WriteHGTCMInputs(ReportWriter &fp, const HGTCMParams &params);
 
 // Terrestrial Statistical Model
 ReturnCode CallTerrestrialStatisticalModel(
-    TSMParams &tsm_params, std::vector<double> &L_ctt__db
+    TSMParams &tsm_params, double &L_ctt__db
+);
+DrvrReturnCode ParseTSMInputFile(
+    const std::string &in_file, TSMParams &tsm_params, std::ostream &err
+);
+DrvrReturnCode ParseTSMInputStream(
+    std::istream &stream, TSMParams &tsm_params, std::ostream &err
+);
+void WriteTSMInputs(ReportWriter &fp, const TSMParams &params);
+
+// Mixed-model batch files
+int RunMixedBatch(
+    const DrvrParams &params,
+    std::istream &in,
+    std::ostream &out,
+    std::ostream &err
+);
+DrvrReturnCode ParseMixedBatchFile(
+    const std::string &in_file, MixedBatch &batch, std::ostream &err
+);
+DrvrReturnCode ParseMixedBatchStream(
+    std::istream &stream, MixedBatch &batch, std::ostream &err
+);
+void CallMixedBatch(MixedBatch &batch);
+void WriteMixedBatchResults(ReportWriter &fp, const MixedBatch &batch);
+
+// Aircraft track replay
+int RunTrackReplay(
+    const DrvrParams &params,
+    std::istream &in,
+    std::ostream &out,
+    std::ostream &err
+);
+DrvrReturnCode ReplayTrackStream(
+    std::istream &stream, ReportWriter &fp, std::ostream &err
+);
+
+// Parameter sweeps
+int RunSweep(const DrvrParams &params, std::ostream &out, std::ostream &err);
+DrvrReturnCode ParseSweepAxis(const std::string &arg, SweepAxis &axis);
+DrvrReturnCode WriteSweep(
+    const P2108Model model,
+    const std::vector<SweepAxis> &axes,
+    const std::size_t n_threads,
+    std::ostream &os,
+    std::ostream &err
+);
+
+// Precomputed surfaces
+int RunSurfaceWriter(
+    const DrvrParams &params, std::ostream &out, std::ostream &err
 );
-DrvrReturnCode
-    ParseTSMInputFile(const std::string &in_file, TSMParams &tsm_params);
-DrvrReturnCode ParseTSMInputStream(std::istream &stream, TSMParams &tsm_params);
-void WriteTSMInputs(std::ofstream &fp, const TSMParams &params);
 
 // Reporting
-void PrintClutterTypeLabel(std::ofstream &fp, const ClutterType clutter_type);
+void PrintClutterTypeLabel(ReportWriter &fp, const ClutterType clutter_type);
 
 // Driver Utils
 std::string GetDatetimeString();
 DrvrReturnCode ParseBoolean(const std::string &str, bool &value);
 DrvrReturnCode ParseDouble(const std::string &str, double &value);
 DrvrReturnCode ParseInteger(const std::string &str, int &value);
-void PrintLabel(std::ostream &os, const std::string &lbl);
+void PrintLabel(ReportWriter &fp, const std::string &lbl);
+void SplitFields(const std::string &line, std::vector<std::string> &fields);
 void StringToLower(std::string &str);
 void Version(std::ostream &os = std::cout);
\ No newline at end of file
@@ -0,0 +1,86 @@
+/** @file ReportWriter.h
+ * Buffered writer for formatting driver output text.
+ */
+#pragma once
+
+#include <cstddef>  // for std::size_t
+#include <ostream>  // for std::ostream
+#include <string>   // for std::string
+#include <vector>   // for std::vector
+
+/** Floating point notation used by the ReportWriter */
+enum class NumberFormat {
+    GENERAL,  /**< Default `std::ostream` notation (`%g`-style) */
+    FIXED,    /**< Fixed-point notation, as with `std::fixed` */
+    SHORTEST, /**< Shortest representation which round-trips exactly */
+};
+
+/*******************************************************************************
+ * @class ReportWriter
+ * Formats text and numbers into a preallocated buffer which is flushed to an
+ * output stream in large blocks.
+ *
+ * Output is byte-identical to the equivalent `std::ostream` insertions using
+ * `std::left` and `std::setw`. Numbers are written in the configured notation
+ * and precision; the defaults match a freshly constructed `std::ostream`.
+ * Fixed-point values are converted with integer arithmetic, falling back to
+ * the C library only when the correctly rounded result is ambiguous.
+ ******************************************************************************/
+class ReportWriter {
+    public:
+        /** Default size of the output buffer, in bytes */
+        static constexpr std::size_t DEFAULT_CAPACITY = 1 << 16;
+        /** Field width used for labels in the driver report */
+        static constexpr int LABEL_WIDTH = 25;
+        /** Field width used for values in the driver report */
+        static constexpr int VALUE_WIDTH = 13;
+
+        /***********************************************************************
+         * Constructor method
+         *
+         * @param[in] os        Output stream which receives the buffered text
+         * @param[in] capacity  Size of the output buffer, in bytes
+         **********************************************************************/
+        ReportWriter(std::ostream &os, std::size_t capacity = DEFAULT_CAPACITY);
+
+        /** Destructor, which flushes any buffered text to the stream */
+        ~ReportWriter();
+
+        ReportWriter(const ReportWriter &) = delete;
+        ReportWriter &operator=(const ReportWriter &) = delete;
+
+        void SetNumberFormat(const NumberFormat format, const int precision);
+        void Flush();
+
+        ReportWriter &Write(const char c);
+        ReportWriter &Write(const char *str);
+        ReportWriter &Write(const std::string &str);
+        ReportWriter &Write(const int value);
+        ReportWriter &Write(const double value);
+
+        ReportWriter &WriteField(const std::string &str, const int width);
+        ReportWriter &WriteField(const int value, const int width);
+        ReportWriter &WriteField(const double value, const int width);
+
+        ReportWriter &Label(const std::string &lbl);
+
+        static std::size_t
+            FormatFixed(const double value, const int precision, char *buf);
+        static std::size_t
+            FormatGeneral(const double value, const int precision, char *buf);
+        static std::size_t FormatShortest(const double value, char *buf);
+
+        /** Size of a buffer guaranteed to hold any single formatted number */
+        static constexpr std::size_t MAX_NUMBER_LENGTH = 400;
+    private:
+        void Reserve(const std::size_t n);
+        void WriteBytes(const char *data, const std::size_t n);
+        void Pad(const std::size_t length, const int width);
+        std::size_t FormatNumber(const double value, char *buf) const;
+
+        std::ostream &os_;         /**< Stream receiving flushed output */
+        std::vector<char> buffer_; /**< Preallocated output buffer */
+        std::size_t size_;         /**< Number of buffered bytes */
+        NumberFormat format_;      /**< Notation used for floating point */
+        int precision_;            /**< Precision used for floating point */
+};
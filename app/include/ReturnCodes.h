@@ -17,6 +17,8 @@ enum DrvrReturnCode {
     DRVRERR__INVALID_OPTION,            /**< Unknown option specified */
     DRVRERR__OPENING_INPUT_FILE,        /**< Failed to open the input file for reading */
     DRVRERR__OPENING_OUTPUT_FILE,       /**< Failed to open the output file for writing */
+    DRVRERR__OPENING_TRACE_FILE,        /**< Failed to open the trace file for writing */
+    DRVRERR__WRITING_SURFACE,           /**< Failed to write the precomputed surface file */
 
     // Input File Parsing Errors
     DRVRERR__PARSE = 160,               /**< Failed parsing inputs; unknown parameter */
@@ -28,11 +30,24 @@ enum DrvrReturnCode {
     DRVRERR__PARSE_REPR_HEIGHT,         /**< Failed to parse representative height value */
     DRVRERR__PARSE_CLUTTER_TYPE,        /**< Failed to parse clutter type value */
     DRVRERR__PARSE_PATH_DIST,           /**< Failed to parse path distance value */
+    DRVRERR__PARSE_MODEL,               /**< Failed to parse the model of a batch row */
+    DRVRERR__PARSE_TRACK,               /**< Failed to parse the track of a replay row */
+    DRVRERR__PARSE_POSITION,            /**< Failed to parse a position of a replay row */
+    DRVRERR__PARSE_SWEEP,               /**< Failed to parse a sweep range */
 
     // Validation Errors
     DRVRERR__VALIDATION_IN_FILE = 192,  /**< Input file not specified */
     DRVRERR__VALIDATION_OUT_FILE,       /**< Output file not specified */
     DRVRERR__VALIDATION_MODEL,          /**< Model not specified */
+    DRVRERR__VALIDATION_WORKERS,        /**< Invalid number of worker threads */
+    DRVRERR__VALIDATION_SWEEP,          /**< Sweep ranges do not match the model inputs */
+    DRVRERR__VALIDATION_NODES,          /**< Invalid number of surface grid nodes */
+
+    // Service Errors
+    DRVRERR__SERVICE_UNSUPPORTED = 224, /**< Service mode is not supported on this platform */
+    DRVRERR__SERVICE_SOCKET,            /**< Failed to create or listen on the service socket */
+    DRVRERR__SERVICE_FRAME,             /**< Received a malformed service request frame */
+    DRVRERR__SERVICE_SHM,               /**< Failed to create or map the shared-memory region */
 };
 // clang-format on
 
@@ -0,0 +1,124 @@
+/** @file Service.h
+ * Interface for running the driver as a persistent local service.
+ */
+#pragma once
+
+#include "ReturnCodes.h"
+#include "Structs.h"
+
+#include <condition_variable>  // for std::condition_variable
+#include <cstddef>             // for std::size_t
+#include <cstdint>             // for std::int32_t, std::uint32_t
+#include <deque>               // for std::deque
+#include <mutex>               // for std::mutex
+#include <ostream>             // for std::ostream
+#include <set>                 // for std::set
+#include <string>              // for std::string
+#include <thread>              // for std::thread
+#include <vector>              // for std::vector
+
+/////////////////////////////
+// Wire Protocol
+//
+// Each request frame is a ServiceRequestHeader followed by the model input
+// columns, each containing `count` values of type double, in the order:
+//   HGTCM: f__ghz, h__meter, w_s__meter, R__meter, clutter_type
+//   TSM:   f__ghz, d__km, p
+//   ASM:   f__ghz, theta__deg, p
+// Each response frame is a ServiceResponseHeader followed by `count` return
+// codes (int32) and then `count` clutter loss values (double), in dB. Loss
+// values are NaN where the return code is not `SUCCESS`. All values use the
+// host byte order. A response with a non-success status is sent before the
+// connection is closed when a malformed request is received.
+
+/** Identifies the start of each service frame (ASCII "P218") */
+constexpr std::uint32_t SERVICE_FRAME_MAGIC = 0x50323138;
+
+/** Maximum number of records accepted in a single request frame */
+constexpr std::uint32_t SERVICE_MAX_RECORDS = 1u << 20;
+
+/** Default time allowed to receive a request frame and send its response */
+constexpr int SERVICE_FRAME_TIMEOUT__MS = 10000;
+
+/** Header of a service request frame */
+struct ServiceRequestHeader {
+        std::uint32_t magic; /**< Must equal `SERVICE_FRAME_MAGIC` */
+        std::int32_t model;  /**< Model to run, a `P2108Model` value */
+        std::uint32_t count; /**< Number of records in the frame */
+};
+
+/** Header of a service response frame */
+struct ServiceResponseHeader {
+        std::uint32_t magic; /**< Always equal to `SERVICE_FRAME_MAGIC` */
+        std::int32_t status; /**< `DRVR__SUCCESS` or a driver error code */
+        std::uint32_t count; /**< Number of records in the frame */
+};
+
+/////////////////////////////
+// Functions
+std::size_t GetModelInputCount(const P2108Model model);
+void EvaluateModelColumns(
+    const P2108Model model,
+    const double *const *columns,
+    const std::size_t count,
+    std::int32_t *rtn,
+    double *loss
+);
+DrvrReturnCode RunService(const DrvrParams &params, std::ostream &err);
+
+/*******************************************************************************
+ * @class ServiceServer
+ * Answers model requests received on a Unix domain socket.
+ *
+ * A single thread accepts connections and polls the idle ones. When a request
+ * frame arrives on a connection, the connection is handed to a pool of worker
+ * threads. A worker answers that one frame and returns the connection to the
+ * poller, so idle persistent clients never occupy a worker. A frame must be
+ * received and answered within the frame timeout, or its connection is
+ * closed, so a client which stalls partway through a frame occupies a worker
+ * for at most that time. Only available on POSIX platforms.
+ ******************************************************************************/
+class ServiceServer {
+    public:
+        /***********************************************************************
+         * Constructor method
+         *
+         * @param[in] socket_path        Filesystem path of the socket to
+         *                               listen on
+         * @param[in] n_workers          Number of worker threads (0 selects
+         *                               the number of hardware threads)
+         * @param[in] frame_timeout__ms  Time allowed to receive each request
+         *                               frame and send its response, in ms
+         **********************************************************************/
+        ServiceServer(
+            const std::string &socket_path,
+            unsigned int n_workers,
+            int frame_timeout__ms = SERVICE_FRAME_TIMEOUT__MS
+        );
+
+        /** Destructor, which stops the service if it is running */
+        ~ServiceServer();
+
+        ServiceServer(const ServiceServer &) = delete;
+        ServiceServer &operator=(const ServiceServer &) = delete;
+
+        DrvrReturnCode Start(std::ostream &err);
+        void Stop();
+    private:
+        void PollLoop();
+        void WorkerLoop();
+        void Wake();
+
+        std::string socket_path_; /**< Path of the listening socket */
+        unsigned int n_workers_;  /**< Number of worker threads */
+        int frame_timeout__ms_;   /**< Time allowed for each frame, in ms */
+        int listen_fd_;           /**< Listening socket descriptor */
+        int wake_fds_[2];         /**< Pipe used to interrupt the poller */
+        bool stopping_;           /**< Set when the service is stopping */
+        std::mutex mutex_;        /**< Guards the members below */
+        std::condition_variable ready_; /**< Signals pending connections */
+        std::set<int> idle_;      /**< Connections awaiting a request frame */
+        std::deque<int> pending_; /**< Connections with a frame to answer */
+        std::set<int> active_;    /**< Connections being served */
+        std::vector<std::thread> threads_; /**< Poller and worker threads */
+};
@@ -0,0 +1,71 @@
+/** @file ShmService.h
+ * Interface for serving driver requests over shared memory.
+ */
+#pragma once
+
+#include "P2108Shm.h"
+#include "ReturnCodes.h"
+
+#include <cstddef>  // for std::size_t
+#include <cstdint>  // for std::uint32_t
+#include <ostream>  // for std::ostream
+#include <string>   // for std::string
+#include <thread>   // for std::thread
+#include <vector>   // for std::vector
+
+/** Default maximum number of records per shared-memory slot */
+constexpr std::uint32_t SHM_DEFAULT_CAPACITY = 16384;
+
+/*******************************************************************************
+ * @class ShmServer
+ * Answers model requests written into a POSIX shared-memory region.
+ *
+ * The region layout and the client interface are defined in `P2108Shm.h`.
+ * Worker threads evaluate submitted slots in place, writing results into the
+ * output columns of the same slot. Slots and columns are located from the
+ * layout given to the constructor, never from the writable region header.
+ * Slots claimed by a client which exits without releasing them are not
+ * reclaimed. Only available on Linux.
+ ******************************************************************************/
+class ShmServer {
+    public:
+        /***********************************************************************
+         * Constructor method
+         *
+         * @param[in] name       Name of the shared-memory region, e.g. "/p2108"
+         * @param[in] n_workers  Number of worker threads (0 selects the number
+         *                       of hardware threads)
+         * @param[in] n_slots    Number of slots (0 selects twice the number of
+         *                       worker threads)
+         * @param[in] capacity   Maximum number of records per slot
+         **********************************************************************/
+        ShmServer(
+            const std::string &name,
+            unsigned int n_workers,
+            std::uint32_t n_slots = 0,
+            std::uint32_t capacity = SHM_DEFAULT_CAPACITY
+        );
+
+        /** Destructor, which stops the service if it is running */
+        ~ShmServer();
+
+        ShmServer(const ShmServer &) = delete;
+        ShmServer &operator=(const ShmServer &) = delete;
+
+        DrvrReturnCode Start(std::ostream &err);
+        void Stop();
+    private:
+        void WorkerLoop();
+        void ServeSlot(const std::uint32_t slot);
+
+        std::string name_;                 /**< Name of the region */
+        unsigned int n_workers_;           /**< Number of worker threads */
+        std::uint32_t n_slots_;            /**< Number of slots */
+        std::uint32_t capacity_;           /**< Records per slot */
+        void *region_;                     /**< Start of the mapped region */
+        std::size_t size_;                 /**< Size of the region, in bytes */
+        int lock_fd_;                      /**< Locked region descriptor */
+        P2108ShmHeader *header_;           /**< Region header */
+        bool stopping_;                    /**< Set when the service stops */
+        std::vector<std::thread> threads_; /**< Worker threads */
+};
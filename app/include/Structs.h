@@ -3,9 +3,12 @@
 */
 #pragma once
 
-#include "P2108.h"  // For ClutterType enum
+#include "P2108.h"         // For ClutterType enum
+#include "P2108Surface.h"  // for P2108_SURFACE_DEFAULT_NODES
 
-#include <string>  // for std::string
+#include <cstddef>  // for std::size_t
+#include <string>   // for std::string
+#include <vector>   // for std::vector
 
 /////////////////////////////
 // Enums
@@ -15,16 +18,31 @@ enum class P2108Model {
     HGTCM = 1,    /**< Height Gain Terminal Correction Model */
     TSM = 2,      /**< Terrestrial Statistical Model */
     ASM = 3,      /**< Aeronautical Statistical Model */
+    MIXED = 4,    /**< Batch file with a model selected on each row */
+    TRACKS = 5,   /**< Replay of aircraft tracks through the ASM */
 };
 
 /////////////////////////////
 // Data Structures
 
+/** Values of one model input of a parameter sweep */
+struct SweepAxis {
+        std::string key;            /**< Input file key of the parameter */
+        std::vector<double> values; /**< Values, in sweep order */
+};
+
 /** Parameters provided to the command line driver */
 struct DrvrParams {
         std::string in_file = "";               /**< Input file */
         std::string out_file = "";              /**< Output file */
         P2108Model model = P2108Model::NOT_SET; /**< Model selection */
+        std::string socket_path = ""; /**< Service mode socket path */
+        std::string shm_name = ""; /**< Service mode shared-memory name */
+        int n_workers = 0; /**< Service worker threads (0 for automatic) */
+        std::string trace_file = ""; /**< Chrome trace output file */
+        std::vector<SweepAxis> sweep; /**< Parameter ranges of a sweep */
+        std::string surface_file = ""; /**< Precomputed surface output file */
+        int n_nodes = P2108_SURFACE_DEFAULT_NODES; /**< Surface grid nodes */
 };
 
 /** Input parameters for the Height Gain Terminal Correction Model */
@@ -73,4 +91,44 @@ struct ASMInputKeys {
         static const std::string f__ghz;     /**< Frequency, in GHz */
         static const std::string theta__deg; /**< Elevation angle, in degrees */
         static const std::string p;          /**< Percentage of locations */
-};  // Constants defined in app/src/AeronauticalStatisticalModel.cpp
\ No newline at end of file
+};  // Constants defined in app/src/AeronauticalStatisticalModel.cpp
+
+/** Records of one model in a mixed-model batch, in input order */
+struct MixedBatchBucket {
+        std::vector<std::size_t> rows;  /**< Input row of each record */
+        std::vector<double> f__ghz;     /**< Frequency, in GHz */
+        std::vector<double> h__meter;   /**< Antenna height, in meters */
+        std::vector<double> w_s__meter; /**< Street width, in meters */
+        std::vector<double> R__meter;   /**< Clutter height, in meters */
+        std::vector<int> clutter_type;  /**< Clutter type (enum value) */
+        std::vector<double> d__km;      /**< Path distance, in km */
+        std::vector<double> theta__deg; /**< Elevation angle, in degrees */
+        std::vector<double> p;          /**< Percentage of locations */
+};
+
+/** Inputs and results of a mixed-model batch file */
+struct MixedBatch {
+        std::vector<P2108Model> models; /**< Model of each row */
+        MixedBatchBucket hgtcm;         /**< Rows using the HGTCM */
+        MixedBatchBucket tsm;           /**< Rows using the TSM */
+        MixedBatchBucket aero;          /**< Rows using the ASM */
+        std::vector<int> rtn;           /**< Return code of each row */
+        std::vector<double> loss__db;   /**< Clutter loss of each row, in dB */
+};
+
+/** Column names of mixed-model batch files */
+struct MixedBatchKeys {
+        static const std::string model; /**< Model of the row */
+};  // Constant defined in app/src/MixedBatch.cpp
+
+/** Column names of aircraft track replay files */
+struct TrackReplayKeys {
+        static const std::string track;              /**< Track ID */
+        static const std::string time;               /**< Time of the sample */
+        static const std::string lat__deg;           /**< Aircraft latitude */
+        static const std::string lon__deg;           /**< Aircraft longitude */
+        static const std::string alt__meter;         /**< Aircraft altitude */
+        static const std::string station_lat__deg;   /**< Station latitude */
+        static const std::string station_lon__deg;   /**< Station longitude */
+        static const std::string station_alt__meter; /**< Station altitude */
+};  // Constants defined in app/src/TrackReplay.cpp
@@ -0,0 +1,125 @@
+/** @file Tracing.h
+ * Lightweight span tracing for the driver, exported as Chrome trace JSON.
+ */
+#pragma once
+
+#include <atomic>   // for std::atomic
+#include <chrono>   // for std::chrono::steady_clock
+#include <cstddef>  // for std::size_t
+#include <cstdint>  // for std::uint64_t
+#include <memory>   // for std::unique_ptr
+#include <mutex>    // for std::mutex
+#include <ostream>  // for std::ostream
+#include <vector>   // for std::vector
+
+/** Default number of events kept per thread */
+constexpr std::size_t TRACE_DEFAULT_CAPACITY = 1 << 16;
+
+/** A single begin or end event */
+struct TraceEvent {
+        const char *name;   /**< Span name (a string literal) */
+        std::uint64_t t__ns; /**< Time since the tracer was created, in ns */
+        char phase;         /**< 'B' for begin, 'E' for end */
+};
+
+/*******************************************************************************
+ * @class TraceBuffer
+ * Fixed-capacity ring buffer of the events recorded by one thread.
+ *
+ * Only the owning thread writes to the buffer, so recording an event needs no
+ * lock or atomic read-modify-write. When the buffer is full, the oldest
+ * events are overwritten.
+ ******************************************************************************/
+class TraceBuffer {
+    public:
+        TraceBuffer(const std::size_t capacity, const int thread_id);
+
+        void Record(const TraceEvent &event);
+        std::vector<TraceEvent> GetEvents() const;
+        int GetThreadId() const;
+    private:
+        std::vector<TraceEvent> events_;  /**< Ring storage */
+        std::size_t mask_;                /**< Capacity minus one */
+        std::atomic<std::uint64_t> head_; /**< Number of events recorded */
+        int thread_id_;                   /**< Thread index in the trace */
+};
+
+/*******************************************************************************
+ * @class Tracer
+ * Collects spans from all threads and writes them as Chrome trace JSON.
+ *
+ * Spans are recorded with `TraceSpan` while a tracer is installed with
+ * `TraceSession`. A session installs its tracer for the calling thread only,
+ * so concurrent driver runs trace independently; other threads which should
+ * record into the same tracer install their own session. When no tracer is
+ * installed, a span costs a single thread-local load. The trace can be opened
+ * in Perfetto or `chrome://tracing`.
+ ******************************************************************************/
+class Tracer {
+    public:
+        explicit Tracer(const std::size_t capacity = TRACE_DEFAULT_CAPACITY);
+
+        Tracer(const Tracer &) = delete;
+        Tracer &operator=(const Tracer &) = delete;
+
+        void Record(const char *name, const char phase);
+        void WriteChromeTrace(std::ostream &os) const;
+
+        static Tracer *GetActive();
+    private:
+        friend class TraceSession;
+
+        TraceBuffer *GetThreadBuffer();
+
+        std::size_t capacity_;         /**< Events kept per thread */
+        std::uint64_t id_;             /**< Unique identifier of this tracer */
+        std::chrono::steady_clock::time_point start_; /**< Time origin */
+        mutable std::mutex mutex_;     /**< Guards `buffers_` */
+        std::vector<std::unique_ptr<TraceBuffer>> buffers_; /**< Per thread */
+
+        /** Tracer installed on the calling thread, if any */
+        static thread_local Tracer *active_;
+};
+
+/*******************************************************************************
+ * @class TraceSession
+ * Installs a tracer on the calling thread for the lifetime of this object.
+ ******************************************************************************/
+class TraceSession {
+    public:
+        explicit TraceSession(Tracer *tracer);
+        ~TraceSession();
+
+        TraceSession(const TraceSession &) = delete;
+        TraceSession &operator=(const TraceSession &) = delete;
+    private:
+        Tracer *previous_; /**< Tracer installed before this session */
+};
+
+/*******************************************************************************
+ * @class TraceSpan
+ * Records a begin event on construction and an end event on destruction.
+ *
+ * @param[in] name  Span name, which must be a string literal
+ ******************************************************************************/
+class TraceSpan {
+    public:
+        explicit TraceSpan(const char *name):
+            tracer_(Tracer::GetActive()), name_(name) {
+            if (tracer_ != nullptr) {
+                tracer_->Record(name_, 'B');
+            }
+        }
+
+        ~TraceSpan() {
+            if (tracer_ != nullptr) {
+                tracer_->Record(name_, 'E');
+            }
+        }
+
+        TraceSpan(const TraceSpan &) = delete;
+        TraceSpan &operator=(const TraceSpan &) = delete;
+    private:
+        Tracer *tracer_;   /**< Tracer active when the span began */
+        const char *name_; /**< Span name */
+};
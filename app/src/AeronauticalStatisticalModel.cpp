@@ -2,14 +2,13 @@
  * Implements top-level functions for running the Aeronautical Statistical Model.
  */
 #include "Driver.h"
+#include "Tracing.h"
 
-#include <fstream>   // for std::ifstream, std::ofstream
-#include <iostream>  // for std::cerr
+#include <fstream>   // for std::ifstream
 #include <istream>   // for std::istream
-#include <ostream>   // for std::endl
+#include <ostream>   // for std::endl, std::ostream
 #include <string>    // for std::string
 #include <tuple>     // for std::tie
-#include <vector>    // for std::vector
 
 // Define the input keys
 const std::string ASMInputKeys::f__ghz = "f__ghz";
@@ -24,16 +23,12 @@ const std::string ASMInputKeys::p = "p";
  * @return                 Return code
  ******************************************************************************/
 ReturnCode CallAeronauticalStatisticalModel(
-    ASMParams &asm_params, std::vector<double> &L_ces__db
+    ASMParams &asm_params, double &L_ces__db
 ) {
-    ReturnCode rtn;
-    double L_ces;
-    rtn = AeronauticalStatisticalModel(
-        asm_params.f__ghz, asm_params.theta__deg, asm_params.p, L_ces
+    TraceSpan span("CallAeronauticalStatisticalModel");
+    return AeronauticalStatisticalModel(
+        asm_params.f__ghz, asm_params.theta__deg, asm_params.p, L_ces__db
     );
-    L_ces__db.push_back(L_ces);
-
-    return rtn;
 }
 
 /*******************************************************************************
@@ -41,10 +36,13 @@ ReturnCode CallAeronauticalStatisticalModel(
  * 
  * @param[in]  stream      Input stream containing ASM parameters
  * @param[out] asm_params  ASM input parameter struct
+ * @param[out] err         Output stream for error messages
  * @return                 Return code
  ******************************************************************************/
-DrvrReturnCode
-    ParseASMInputStream(std::istream &stream, ASMParams &asm_params) {
+DrvrReturnCode ParseASMInputStream(
+    std::istream &stream, ASMParams &asm_params, std::ostream &err
+) {
+    TraceSpan span("ParseASMInputStream");
     CommaSeparatedIterator it(stream);
     DrvrReturnCode rtn = DRVR__SUCCESS;
     std::string key, value, errMsg;
@@ -63,12 +61,12 @@ DrvrReturnCode
             if (rtn == DRVRERR__PARSE)
                 rtn = DRVRERR__PARSE_PERCENTAGE;
         } else {
-            std::cerr << "Unknown parameter: " << key << std::endl;
+            err << "Unknown parameter: " << key << std::endl;
             rtn = DRVRERR__PARSE;
         }
 
         if (rtn != DRVR__SUCCESS) {
-            std::cerr << GetDrvrReturnStatusMsg(rtn) << std::endl;
+            err << GetDrvrReturnStatusMsg(rtn) << std::endl;
             return rtn;
         }
         ++it;
@@ -81,26 +79,31 @@ DrvrReturnCode
  * 
  * @param[in]  in_file     Path to ASM input parameter file
  * @param[out] asm_params  ASM input parameter struct
+ * @param[out] err         Output stream for error messages
  * @return                 Return code
  ******************************************************************************/
-DrvrReturnCode
-    ParseASMInputFile(const std::string &in_file, ASMParams &asm_params) {
+DrvrReturnCode ParseASMInputFile(
+    const std::string &in_file, ASMParams &asm_params, std::ostream &err
+) {
     std::ifstream file(in_file);
     if (!file) {
-        std::cerr << "Failed to open file " << in_file << std::endl;
+        err << "Failed to open file " << in_file << std::endl;
         return DRVRERR__OPENING_INPUT_FILE;
     }
-    return ParseASMInputStream(file, asm_params);
+    return ParseASMInputStream(file, asm_params, err);
 }
 
 /*******************************************************************************
  * Write Aeronautical Statistical Model inputs to the report file
  * 
- * @param[in] fp      Output stream, a text file open for writing
+ * @param[in] fp      Report writer for the output file
  * @param[in] params  ASM input parameter struct
  ******************************************************************************/
-void WriteASMInputs(std::ofstream &fp, const ASMParams &params) {
-    fp PRINT ASMInputKeys::f__ghz SETW13 params.f__ghz << "(gigahertz)";
-    fp PRINT ASMInputKeys::theta__deg SETW13 params.theta__deg << "(degrees)";
-    fp PRINT ASMInputKeys::p SETW13 params.p << "(%)";
+void WriteASMInputs(ReportWriter &fp, const ASMParams &params) {
+    constexpr int w = ReportWriter::VALUE_WIDTH;
+    fp.Label(ASMInputKeys::f__ghz).WriteField(params.f__ghz, w);
+    fp.Write("(gigahertz)");
+    fp.Label(ASMInputKeys::theta__deg).WriteField(params.theta__deg, w);
+    fp.Write("(degrees)");
+    fp.Label(ASMInputKeys::p).WriteField(params.p, w).Write("(%)");
 }
\ No newline at end of file
@@ -4,6 +4,7 @@
 #include "CommaSeparatedIterator.h"
 
 #include "Driver.h"
+#include "Tracing.h"
 
 #include <cstddef>    // for std::size_t
 #include <istream>    // for std::istream
@@ -25,6 +26,7 @@ CommaSeparatedIterator::CommaSeparatedIterator(std::istream &stream):
  * @return A reference to the updated iterator.
  **********************************************************************/
 CommaSeparatedIterator &CommaSeparatedIterator::operator++() {
+    TraceSpan span("CommaSeparatedIterator::operator++");
     if (std::getline(stream_, line_)) {
         // Skip line if empty
         if (line_.empty()) {
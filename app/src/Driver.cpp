@@ -1,67 +1,152 @@
 /** @file Driver.cpp
- * Implements the main function of the executable, and other high-level functions
+ * Implements the entry point of the driver, and other high-level functions
  */
 #include "Driver.h"
 
+#include "Tracing.h"
+
 #include <algorithm>  // for std::find
-#include <fstream>    // for std::ifstream, std::ofstream
-#include <iomanip>    // for std::setw
-#include <ios>        // for std::left
-#include <iostream>   // for std::cerr
-#include <ostream>    // for std::endl
+#include <cstddef>    // for std::size_t
+#include <fstream>    // for std::ofstream
+#include <istream>    // for std::istream
+#include <ostream>    // for std::endl, std::ostream
 #include <string>     // for std::string
 #include <vector>     // for std::vector
 
 /*******************************************************************************
- * Main function of the driver executable
- * 
- * @param[in] argc  Number of arguments entered on the command line
- * @param[in] argv  Array containing the provided command-line arguments
- * @return          Return code
+ * Run the driver with the given command-line arguments.
+ *
+ * This is the entry point of the driver executable, which may also be called
+ * in-process. It does not use any global state: the input file name "-" reads
+ * the inputs from `in`, the output file name "-" writes the report to `out`,
+ * and help and version information is also written to `out`. All error
+ * messages are written to `err`.
+ *
+ * @param[in]  args  Command-line arguments, excluding the program name
+ * @param[in]  in    Input stream used when the input file is "-"
+ * @param[out] out   Output stream for the report, help, and version text
+ * @param[out] err   Output stream for error messages
+ * @return           Return code
  ******************************************************************************/
-int main(int argc, char **argv) {
+int RunDriver(
+    const std::vector<std::string> &args,
+    std::istream &in,
+    std::ostream &out,
+    std::ostream &err
+) {
     int rtn;
     DrvrParams params;
 
     // Parse command line arguments
-    rtn = ParseArguments(argc, argv, params);
+    rtn = ParseArguments(args, params, out, err);
     if (rtn == DRVR__RETURN_SUCCESS) {
         return SUCCESS;
     } else if (rtn != DRVR__SUCCESS) {
-        Help();
+        Help(out);
         return rtn;
     }
 
     // Ensure required options were provided
-    rtn = ValidateInputs(params);
+    rtn = ValidateInputs(params, err);
     if (rtn != DRVR__SUCCESS) {
-        Help();
+        Help(out);
         return rtn;
     }
 
+    if (params.trace_file.empty()) {
+        return RunModel(params, args, in, out, err);
+    }
+
+    // Record spans while the model runs, then write them to the trace file
+    std::ofstream trace_file(params.trace_file);
+    if (!trace_file) {
+        err << GetDrvrReturnStatusMsg(DRVRERR__OPENING_TRACE_FILE) << std::endl;
+        return DRVRERR__OPENING_TRACE_FILE;
+    }
+    Tracer tracer;
+    {
+        TraceSession session(&tracer);
+        rtn = RunModel(params, args, in, out, err);
+    }
+    tracer.WriteChromeTrace(trace_file);
+    return rtn;
+}
+
+/*******************************************************************************
+ * Run the selected model, or the service, once the arguments are validated.
+ *
+ * @param[in]  params  Structure with validated user input parameters
+ * @param[in]  args    Command-line arguments, echoed in the report
+ * @param[in]  in      Input stream used when the input file is "-"
+ * @param[out] out     Output stream used when the output file is "-"
+ * @param[out] err     Output stream for error messages
+ * @return             Return code
+ ******************************************************************************/
+int RunModel(
+    const DrvrParams &params,
+    const std::vector<std::string> &args,
+    std::istream &in,
+    std::ostream &out,
+    std::ostream &err
+) {
+    int rtn;
+
+    // Run as a persistent service if requested
+    if (!params.socket_path.empty() || !params.shm_name.empty()) {
+        rtn = RunService(params, err);
+        return (rtn == DRVR__SUCCESS) ? SUCCESS : rtn;
+    }
+
+    // Write a precomputed surface file, without evaluating any inputs
+    if (!params.surface_file.empty()) {
+        return RunSurfaceWriter(params, out, err);
+    }
+
+    // Evaluate the model over ranges of its inputs, without an input file
+    if (!params.sweep.empty()) {
+        return RunSweep(params, out, err);
+    }
+
+    // Run a batch file with a model selected on each row
+    if (params.model == P2108Model::MIXED) {
+        return RunMixedBatch(params, in, out, err);
+    }
+
+    // Replay aircraft tracks through the Aeronautical Statistical Model
+    if (params.model == P2108Model::TRACKS) {
+        return RunTrackReplay(params, in, out, err);
+    }
+
     // Initialize model inputs/outputs
     HGTCMParams hgtcm_params;
     TSMParams tsm_params;
     ASMParams asm_params;
-    std::vector<double> loss__db;  // Use for any model
+    double loss__db = 0;  // Use for any model
+    const bool use_stdin = params.in_file == "-";
 
     switch (params.model) {
         case P2108Model::HGTCM:
-            rtn = ParseHGTCMInputFile(params.in_file, hgtcm_params);
+            rtn = use_stdin
+                    ? ParseHGTCMInputStream(in, hgtcm_params, err)
+                    : ParseHGTCMInputFile(params.in_file, hgtcm_params, err);
             if (rtn != DRVR__SUCCESS) {
                 return rtn;
             }
             rtn = CallHeightGainTerminalCorrectionModel(hgtcm_params, loss__db);
             break;
         case P2108Model::TSM:
-            rtn = ParseTSMInputFile(params.in_file, tsm_params);
+            rtn = use_stdin
+                    ? ParseTSMInputStream(in, tsm_params, err)
+                    : ParseTSMInputFile(params.in_file, tsm_params, err);
             if (rtn != DRVR__SUCCESS) {
                 return rtn;
             }
             rtn = CallTerrestrialStatisticalModel(tsm_params, loss__db);
             break;
         case P2108Model::ASM:
-            rtn = ParseASMInputFile(params.in_file, asm_params);
+            rtn = use_stdin
+                    ? ParseASMInputStream(in, asm_params, err)
+                    : ParseASMInputFile(params.in_file, asm_params, err);
             if (rtn != DRVR__SUCCESS) {
                 return rtn;
             }
@@ -73,54 +158,60 @@ int main(int argc, char **argv) {
 
     // Return driver error code if one was returned
     if (rtn > DRVR__RETURN_SUCCESS) {
-        std::cerr << GetDrvrReturnStatusMsg(rtn) << std::endl;
+        err << GetDrvrReturnStatusMsg(rtn) << std::endl;
         return rtn;
     }
 
-    // Open output file for writing
-    std::ofstream fp(params.out_file);
-    if (!fp) {
-        std::cerr << "Error opening output file. Exiting." << std::endl;
-        return DRVRERR__OPENING_OUTPUT_FILE;
+    // Open output file for writing, unless writing to the output stream
+    std::ofstream file;
+    if (params.out_file != "-") {
+        file.open(params.out_file);
+        if (!file) {
+            err << "Error opening output file. Exiting." << std::endl;
+            return DRVRERR__OPENING_OUTPUT_FILE;
+        }
     }
+    std::ostream &fp = file.is_open() ? file : out;
 
     // Print generator information to file
-    fp << std::left << std::setw(25) << "Model" << LIBRARY_NAME;
-    fp PRINT "Model Variant";
+    TraceSpan span("WriteReport");
+    ReportWriter report(fp);
+    report.WriteField("Model", ReportWriter::LABEL_WIDTH).Write(LIBRARY_NAME);
+    report.Label("Model Variant");
     switch (params.model) {
         case P2108Model::HGTCM:
-            fp << "Height Gain Terminal Correction Model";
+            report.Write("Height Gain Terminal Correction Model");
             break;
         case P2108Model::TSM:
-            fp << "Terrestrial Statistical Model";
+            report.Write("Terrestrial Statistical Model");
             break;
         case P2108Model::ASM:
-            fp << "Aeronautical Statistical Model";
+            report.Write("Aeronautical Statistical Model");
             break;
         // Validation above ensures one of the above cases evaluates
         default:
             break;
     }
-    fp PRINT "Library Version" << "v" << LIBRARY_VERSION;
-    fp PRINT "Driver Version" << "v" << DRIVER_VERSION;
-    fp PRINT "Date Generated" << GetDatetimeString();
-    fp PRINT "Input Arguments";
-    for (int i = 1; i < argc; i++) {
-        fp << argv[i] << " ";
+    report.Label("Library Version").Write('v').Write(LIBRARY_VERSION);
+    report.Label("Driver Version").Write('v').Write(DRIVER_VERSION);
+    report.Label("Date Generated").Write(GetDatetimeString());
+    report.Label("Input Arguments");
+    for (const std::string &arg : args) {
+        report.Write(arg).Write(' ');
     }
-    fp << std::endl << std::endl;
+    report.Write("\n\n");
 
     // Print inputs to file
-    fp << "Inputs";
+    report.Write("Inputs");
     switch (params.model) {
         case P2108Model::HGTCM:
-            WriteHGTCMInputs(fp, hgtcm_params);
+            WriteHGTCMInputs(report, hgtcm_params);
             break;
         case P2108Model::TSM:
-            WriteTSMInputs(fp, tsm_params);
+            WriteTSMInputs(report, tsm_params);
             break;
         case P2108Model::ASM:
-            WriteASMInputs(fp, asm_params);
+            WriteASMInputs(report, asm_params);
             break;
         // Validation above ensures one of these cases evaluates
         default:
@@ -128,66 +219,80 @@ int main(int argc, char **argv) {
     }
 
     // Print results to file
-    fp << std::endl << std::endl << "Results";
-    fp PRINT "Return Code" SETW13 rtn;
-    PrintLabel(fp, GetReturnStatus(rtn));
+    report.Write("\n\nResults");
+    report.Label("Return Code").WriteField(rtn, ReportWriter::VALUE_WIDTH);
+    PrintLabel(report, GetReturnStatus(rtn));
     if (rtn == SUCCESS) {
-        fp PRINT "Clutter loss" SETW13 std::fixed << std::setprecision(1)
-                                                  << loss__db.front() << "(dB)";
+        report.SetNumberFormat(NumberFormat::FIXED, 1);
+        report.Label("Clutter loss")
+            .WriteField(loss__db, ReportWriter::VALUE_WIDTH)
+            .Write("(dB)");
     }
-    fp.close();
+    report.Flush();
+    fp.flush();
     return SUCCESS;
 }
 
 /*******************************************************************************
  * Parse the command line arguments
  * 
- * @param[in]  argc    Number of arguments
- * @param[in]  argv    Command line arguments
+ * @param[in]  args    Command line arguments, excluding the program name
  * @param[out] params  Structure with user input params
+ * @param[out] out     Output stream for help and version information
+ * @param[out] err     Output stream for error messages
  * @return             Return code
  ******************************************************************************/
-DrvrReturnCode ParseArguments(int argc, char **argv, DrvrParams &params) {
-    const std::vector<std::string> validArgs
-        = {"-i", "-o", "-model", "-h", "--help", "-v", "--version"};
+DrvrReturnCode ParseArguments(
+    const std::vector<std::string> &args,
+    DrvrParams &params,
+    std::ostream &out,
+    std::ostream &err
+) {
+    const std::vector<std::string> validArgs = {
+        "-i", "-o", "-model", "-sweep", "-serve", "-shm", "-workers", "-trace",
+        "-surface", "-nodes", "-h", "--help", "-v", "--version"
+    };
 
-    for (int i = 1; i < argc; i++) {
+    const std::size_t argc = args.size();
+    for (std::size_t i = 0; i < argc; i++) {
         // Parse arg to lowercase string
-        std::string arg(argv[i]);
+        std::string arg(args[i]);
         StringToLower(arg);
 
         // Check if provided flag is valid
         if (std::find(validArgs.begin(), validArgs.end(), arg)
             == validArgs.end()) {
             // Invalid argument provided
-            std::cerr << "Unknown option: " << argv[i] << std::endl;
+            err << "Unknown option: " << args[i] << std::endl;
             return DRVRERR__INVALID_OPTION;
         }
 
         // Handle simple flags which don't have associated values (e.g., "-v", "-DBG")
         if (arg == "-v" || arg == "--version") {
-            Version();
+            Version(out);
             return DRVR__RETURN_SUCCESS;
         } else if (arg == "-h" || arg == "--help") {
-            Help();
+            Help(out);
             return DRVR__RETURN_SUCCESS;
         }
 
-        // Check if end of arguments reached or next argument is another flag
-        if (i + 1 >= argc || argv[i + 1][0] == '-') {
-            std::cerr << "Error: no value given for " << arg << std::endl;
+        // Check if end of arguments reached or next argument is another flag.
+        // A lone "-" is a value, selecting the input or output stream.
+        if (i + 1 >= argc
+            || (args[i + 1][0] == '-' && args[i + 1].size() > 1)) {
+            err << "Error: no value given for " << arg << std::endl;
             return DRVRERR__MISSING_OPTION;
         }
 
         // Handle inputs which provide values (e.g. "-i in.txt").
         if (arg == "-i") {
-            params.in_file = argv[i + 1];
+            params.in_file = args[i + 1];
             i++;
         } else if (arg == "-o") {
-            params.out_file = argv[i + 1];
+            params.out_file = args[i + 1];
             i++;
         } else if (arg == "-model") {
-            std::string argval(argv[i + 1]);
+            std::string argval(args[i + 1]);
             StringToLower(argval);
             if (argval == "asm") {
                 params.model = P2108Model::ASM;
@@ -195,6 +300,47 @@ DrvrReturnCode ParseArguments(int argc, char **argv, DrvrParams &params) {
                 params.model = P2108Model::HGTCM;
             } else if (argval == "tsm") {
                 params.model = P2108Model::TSM;
+            } else if (argval == "mixed") {
+                params.model = P2108Model::MIXED;
+            } else if (argval == "tracks") {
+                params.model = P2108Model::TRACKS;
+            }
+            i++;
+        } else if (arg == "-sweep") {
+            SweepAxis axis;
+            if (ParseSweepAxis(args[i + 1], axis) != DRVR__SUCCESS) {
+                err << GetDrvrReturnStatusMsg(DRVRERR__PARSE_SWEEP) << ": "
+                    << args[i + 1] << std::endl;
+                return DRVRERR__PARSE_SWEEP;
+            }
+            params.sweep.push_back(axis);
+            i++;
+        } else if (arg == "-serve") {
+            params.socket_path = args[i + 1];
+            i++;
+        } else if (arg == "-shm") {
+            params.shm_name = args[i + 1];
+            i++;
+        } else if (arg == "-surface") {
+            params.surface_file = args[i + 1];
+            i++;
+        } else if (arg == "-nodes") {
+            if (ParseInteger(args[i + 1], params.n_nodes) != DRVR__SUCCESS
+                || params.n_nodes < 2) {
+                err << GetDrvrReturnStatusMsg(DRVRERR__VALIDATION_NODES)
+                    << std::endl;
+                return DRVRERR__VALIDATION_NODES;
+            }
+            i++;
+        } else if (arg == "-trace") {
+            params.trace_file = args[i + 1];
+            i++;
+        } else if (arg == "-workers") {
+            if (ParseInteger(args[i + 1], params.n_workers) != DRVR__SUCCESS
+                || params.n_workers < 1) {
+                err << GetDrvrReturnStatusMsg(DRVRERR__VALIDATION_WORKERS)
+                    << std::endl;
+                return DRVRERR__VALIDATION_WORKERS;
             }
             i++;
         }
@@ -211,9 +357,46 @@ DrvrReturnCode ParseArguments(int argc, char **argv, DrvrParams &params) {
 void Help(std::ostream &os) {
     os << std::endl << "Usage: .\\<Driver Executable> [Options]" << std::endl;
     os << "Options (not case sensitive)" << std::endl;
-    os << "\t-i      :: Input file name" << std::endl;
-    os << "\t-o      :: Output file name" << std::endl;
-    os << "\t-model  :: Model to run [HGTCM, TSM, ASM]" << std::endl;
+    os << "\t-i      :: Input file name (\"-\" for standard input)"
+       << std::endl;
+    os << "\t-o      :: Output file name (\"-\" for standard output)"
+       << std::endl;
+    os << "\t-model  :: Model to run [HGTCM, TSM, ASM, MIXED, TRACKS]"
+       << std::endl;
+    os << "\t          MIXED reads a CSV file with a model column and writes"
+       << std::endl;
+    os << "\t          a CSV file of results, in the order of the input rows"
+       << std::endl;
+    os << "\t          TRACKS replays a CSV file of aircraft track samples"
+       << std::endl;
+    os << "\t          through the ASM, writing the loss of each sample"
+       << std::endl;
+    os << "Sweep Options (replace -i)" << std::endl;
+    os << "\t-sweep  :: Range of one model input, as key=spec, repeated for"
+       << std::endl;
+    os << "\t          every input of the model (HGTCM, TSM, or ASM). spec"
+       << std::endl;
+    os << "\t          is start:stop:step, log:start:stop:count, or a comma"
+       << std::endl;
+    os << "\t          separated list. Writes a CSV file of every combination"
+       << std::endl;
+    os << "\t-workers :: Number of sweep threads [default: all]" << std::endl;
+    os << "Service Options (replace -i, -o, and -model; POSIX only)"
+       << std::endl;
+    os << "\t-serve   :: Answer requests on this Unix domain socket path"
+       << std::endl;
+    os << "\t-shm     :: Answer requests in this shared-memory region (Linux)"
+       << std::endl;
+    os << "\t-workers :: Number of service worker threads [default: all]"
+       << std::endl;
+    os << "Surface Options (replace -i, -o, and -model)" << std::endl;
+    os << "\t-surface :: Write precomputed loss surfaces to this file"
+       << std::endl;
+    os << "\t-nodes   :: Number of grid nodes along each axis [default: "
+       << P2108_SURFACE_DEFAULT_NODES << "]" << std::endl;
+    os << "Diagnostic Options" << std::endl;
+    os << "\t-trace  :: Write a Chrome trace (JSON) of the run to this file"
+       << std::endl;
     os << std::endl << "Examples:" << std::endl;
     os << "\t[WINDOWS] " << DRIVER_NAME
        << ".exe -i inputs.txt -model ASM -o results.txt" << std::endl;
@@ -229,15 +412,22 @@ void Help(std::ostream &os) {
  * Validate that required inputs are present for the mode specified by the user.
  * 
  * This function DOES NOT check the validity of the parameter values, only that
- * required parameters have been specified by the user
+ * required parameters have been specified by the user. No other options are
+ * required when running as a service or writing a surface file, and no input
+ * file is required for a sweep.
  * 
- * @param[in] params  Structure with user input parameters
- * @return            Return code
+ * @param[in]  params  Structure with user input parameters
+ * @param[out] err     Output stream for error messages
+ * @return             Return code
  ******************************************************************************/
-DrvrReturnCode ValidateInputs(const DrvrParams &params) {
+DrvrReturnCode ValidateInputs(const DrvrParams &params, std::ostream &err) {
     DrvrParams not_set;
     DrvrReturnCode rtn = DRVR__SUCCESS;
-    if (params.in_file == not_set.in_file)
+    if (params.socket_path != not_set.socket_path
+        || params.shm_name != not_set.shm_name
+        || params.surface_file != not_set.surface_file)
+        return rtn;
+    if (params.in_file == not_set.in_file && params.sweep.empty())
         rtn = DRVRERR__VALIDATION_IN_FILE;
     if (params.out_file == not_set.out_file)
         rtn = DRVRERR__VALIDATION_OUT_FILE;
@@ -245,7 +435,7 @@ DrvrReturnCode ValidateInputs(const DrvrParams &params) {
         rtn = DRVRERR__VALIDATION_MODEL;
 
     if (rtn != DRVR__SUCCESS)
-        std::cerr << GetDrvrReturnStatusMsg(rtn) << std::endl;
+        err << GetDrvrReturnStatusMsg(rtn) << std::endl;
 
     return rtn;
 }
@@ -21,6 +21,7 @@
 #include <iostream>   // for std::cerr, std::endl
 #include <ostream>    // for std::ostream
 #include <string>     // for std::stod, std::stoi, std::string
+#include <vector>     // for std::vector
 
 /******************************************************************************
  * Get a string containing the current date and time information.
@@ -117,14 +118,43 @@ DrvrReturnCode ParseInteger(const std::string &str, int &value) {
 /*******************************************************************************
  * Helper function to standardize printing of text labels to file
  * 
- * @param[in] os   Output stream for writing
+ * @param[in] fp   Report writer for the output file
  * @param[in] lbl  Text message
  ******************************************************************************/
-void PrintLabel(std::ostream &os, const std::string &lbl) {
-    os << "[" << lbl << "]";
+void PrintLabel(ReportWriter &fp, const std::string &lbl) {
+    fp.Write('[').Write(lbl).Write(']');
 }
 
 
+/*******************************************************************************
+ * Split a line into comma-delimited fields, trimming surrounding whitespace.
+ *
+ * @param[in]  line    Line of text
+ * @param[out] fields  Fields of the line, reusing its existing storage
+ ******************************************************************************/
+void SplitFields(const std::string &line, std::vector<std::string> &fields) {
+    static const char *const whitespace = " \t\r\n";
+    fields.clear();
+    std::size_t start = 0;
+    while (true) {
+        const std::size_t end = line.find(',', start);
+        const std::string field = line.substr(
+            start, (end == std::string::npos) ? std::string::npos : end - start
+        );
+        const std::size_t first = field.find_first_not_of(whitespace);
+        if (first == std::string::npos) {
+            fields.emplace_back();
+        } else {
+            const std::size_t last = field.find_last_not_of(whitespace);
+            fields.push_back(field.substr(first, last - first + 1));
+        }
+        if (end == std::string::npos) {
+            return;
+        }
+        start = end + 1;
+    }
+}
+
 /******************************************************************************
  * Convert a string to lowercase.
  * 
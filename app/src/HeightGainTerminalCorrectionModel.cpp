@@ -2,14 +2,13 @@
  * Implements functions for running the Height Gain Terminal Correction Model.
  */
 #include "Driver.h"
+#include "Tracing.h"
 
-#include <fstream>   // for std::ifstream, std::ofstream
-#include <iostream>  // for std::cerr
+#include <fstream>   // for std::ifstream
 #include <istream>   // for std::istream
-#include <ostream>   // for std::endl
+#include <ostream>   // for std::endl, std::ostream
 #include <string>    // for std::string
 #include <tuple>     // for std::tie
-#include <vector>    // for std::vector
 
 // Define the input keys
 const std::string HGTCMInputKeys::f__ghz = "f__ghz";
@@ -26,21 +25,17 @@ const std::string HGTCMInputKeys::clutter_type = "clutter_type";
  * @return                   Return code
  ******************************************************************************/
 ReturnCode CallHeightGainTerminalCorrectionModel(
-    HGTCMParams &hgtcm_params, std::vector<double> &A_h__db
+    HGTCMParams &hgtcm_params, double &A_h__db
 ) {
-    ReturnCode rtn;
-    double A_h;
-    rtn = HeightGainTerminalCorrectionModel(
+    TraceSpan span("CallHeightGainTerminalCorrectionModel");
+    return HeightGainTerminalCorrectionModel(
         hgtcm_params.f__ghz,
         hgtcm_params.h__meter,
         hgtcm_params.w_s__meter,
         hgtcm_params.R__meter,
         hgtcm_params.clutter_type,
-        A_h
+        A_h__db
     );
-    A_h__db.push_back(A_h);
-
-    return rtn;
 }
 
 /*******************************************************************************
@@ -48,10 +43,13 @@ ReturnCode CallHeightGainTerminalCorrectionModel(
  * 
  * @param[in]  stream        Input stream containing HGTCM parameters
  * @param[out] hgtcm_params  HGTCM input parameter struct
+ * @param[out] err           Output stream for error messages
  * @return                   Return code
  ******************************************************************************/
-DrvrReturnCode
-    ParseHGTCMInputStream(std::istream &stream, HGTCMParams &hgtcm_params) {
+DrvrReturnCode ParseHGTCMInputStream(
+    std::istream &stream, HGTCMParams &hgtcm_params, std::ostream &err
+) {
+    TraceSpan span("ParseHGTCMInputStream");
     CommaSeparatedIterator it(stream);
     DrvrReturnCode rtn = DRVR__SUCCESS;
     std::string key, value;
@@ -83,12 +81,12 @@ DrvrReturnCode
                     = static_cast<ClutterType>(clutter_type_int);
             }
         } else {
-            std::cerr << "Unknown parameter: " << key << std::endl;
+            err << "Unknown parameter: " << key << std::endl;
             rtn = DRVRERR__PARSE;
         }
 
         if (rtn != DRVR__SUCCESS) {
-            std::cerr << GetDrvrReturnStatusMsg(rtn) << std::endl;
+            err << GetDrvrReturnStatusMsg(rtn) << std::endl;
             return rtn;
         }
         ++it;
@@ -101,31 +99,37 @@ DrvrReturnCode
  * 
  * @param[in]  in_file       Path to HGTCM input parameter file
  * @param[out] hgtcm_params  HGTCM input parameter struct
+ * @param[out] err           Output stream for error messages
  * @return                   Return code
  ******************************************************************************/
-DrvrReturnCode
-    ParseHGTCMInputFile(const std::string &in_file, HGTCMParams &hgtcm_params) {
+DrvrReturnCode ParseHGTCMInputFile(
+    const std::string &in_file, HGTCMParams &hgtcm_params, std::ostream &err
+) {
     std::ifstream file(in_file);
     if (!file) {
-        std::cerr << "Failed to open file " << in_file << std::endl;
+        err << "Failed to open file " << in_file << std::endl;
         return DRVRERR__OPENING_INPUT_FILE;
     }
-    return ParseHGTCMInputStream(file, hgtcm_params);
+    return ParseHGTCMInputStream(file, hgtcm_params, err);
 }
 
 /*******************************************************************************
  * Write Height Gain Terminal Correction Model inputs to the report file
  * 
- * @param[in] fp      Output stream, a text file open for writing
+ * @param[in] fp      Report writer for the output file
  * @param[in] params  HGTCM input parameter struct
  ******************************************************************************/
-void WriteHGTCMInputs(std::ofstream &fp, const HGTCMParams &params) {
-    fp PRINT HGTCMInputKeys::f__ghz SETW13 params.f__ghz << "(gigahertz)";
-    fp PRINT HGTCMInputKeys::h__meter SETW13 params.h__meter << "(meters)";
-    fp PRINT HGTCMInputKeys::w_s__meter SETW13 params.w_s__meter << "(meters)";
-    fp PRINT HGTCMInputKeys::R__meter SETW13 params.R__meter << "(meters)";
-    fp PRINT HGTCMInputKeys::clutter_type SETW13 static_cast<int>(
-        params.clutter_type
-    );
+void WriteHGTCMInputs(ReportWriter &fp, const HGTCMParams &params) {
+    constexpr int w = ReportWriter::VALUE_WIDTH;
+    fp.Label(HGTCMInputKeys::f__ghz).WriteField(params.f__ghz, w);
+    fp.Write("(gigahertz)");
+    fp.Label(HGTCMInputKeys::h__meter).WriteField(params.h__meter, w);
+    fp.Write("(meters)");
+    fp.Label(HGTCMInputKeys::w_s__meter).WriteField(params.w_s__meter, w);
+    fp.Write("(meters)");
+    fp.Label(HGTCMInputKeys::R__meter).WriteField(params.R__meter, w);
+    fp.Write("(meters)");
+    fp.Label(HGTCMInputKeys::clutter_type)
+        .WriteField(static_cast<int>(params.clutter_type), w);
     PrintClutterTypeLabel(fp, params.clutter_type);
 }
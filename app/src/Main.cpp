@@ -0,0 +1,23 @@
+/** @file Main.cpp
+ * Implements the main function of the executable
+ */
+#include "Driver.h"
+
+#include <iostream>  // for std::cerr, std::cin, std::cout
+#include <string>    // for std::string
+#include <vector>    // for std::vector
+
+/*******************************************************************************
+ * Main function of the driver executable
+ * 
+ * @param[in] argc  Number of arguments entered on the command line
+ * @param[in] argv  Array containing the provided command-line arguments
+ * @return          Return code
+ ******************************************************************************/
+int main(int argc, char **argv) {
+    // Skip the program name
+    const std::vector<std::string> args(
+        argc > 0 ? argv + 1 : argv, argv + argc
+    );
+    return RunDriver(args, std::cin, std::cout, std::cerr);
+}
@@ -0,0 +1,467 @@
+/** @file MixedBatch.cpp
+ * Implements mixed-model batch files, with a model selected on each row.
+ *
+ * A mixed-model batch file is a comma-delimited table. Its first line names
+ * the columns: `model`, plus the input parameters of every model used in the
+ * file, with the same names as in the single-model input files. Each
+ * following row gives a model (`HGTCM`, `TSM` or `ASM`) and its inputs;
+ * columns which the model of a row does not use may be left empty.
+ *
+ * Rows are grouped by model, and each group is evaluated with that model's
+ * batch function. Results are written as a comma-delimited table in the
+ * order of the input rows.
+ */
+#include "Driver.h"
+#include "P2108Batch.h"
+#include "Tracing.h"
+
+#include <cstddef>   // for std::size_t
+#include <fstream>   // for std::ifstream, std::ofstream
+#include <istream>   // for std::istream, std::getline
+#include <limits>    // for std::numeric_limits
+#include <ostream>   // for std::endl, std::ostream
+#include <string>    // for std::string
+#include <vector>    // for std::vector
+
+// Define the column name of the model selection
+const std::string MixedBatchKeys::model = "model";
+
+namespace {
+/** Column of each parameter in a mixed-model batch file, or -1 if absent */
+struct MixedBatchColumns {
+        int model = -1;        /**< Model selection */
+        int f__ghz = -1;       /**< Frequency, in GHz */
+        int h__meter = -1;     /**< Antenna height, in meters */
+        int w_s__meter = -1;   /**< Street width, in meters */
+        int R__meter = -1;     /**< Clutter height, in meters */
+        int clutter_type = -1; /**< Clutter type (enum value) */
+        int d__km = -1;        /**< Path distance, in km */
+        int theta__deg = -1;   /**< Elevation angle, in degrees */
+        int p = -1;            /**< Percentage of locations */
+};
+
+/*******************************************************************************
+ * Map the column names of a mixed-model batch file to their positions.
+ *
+ * @param[in]  names    Column names, from the first line of the file
+ * @param[out] columns  Position of each known column
+ * @param[out] err      Output stream for error messages
+ * @return              Return code
+ ******************************************************************************/
+DrvrReturnCode ParseMixedBatchHeader(
+    const std::vector<std::string> &names,
+    MixedBatchColumns &columns,
+    std::ostream &err
+) {
+    for (std::size_t i = 0; i < names.size(); i++) {
+        std::string name = names[i];
+        StringToLower(name);
+        const int c = static_cast<int>(i);
+        if (name == MixedBatchKeys::model) {
+            columns.model = c;
+        } else if (name == HGTCMInputKeys::f__ghz) {
+            columns.f__ghz = c;
+        } else if (name == HGTCMInputKeys::h__meter) {
+            columns.h__meter = c;
+        } else if (name == HGTCMInputKeys::w_s__meter) {
+            columns.w_s__meter = c;
+        } else if (name == HGTCMInputKeys::R__meter) {
+            columns.R__meter = c;
+        } else if (name == HGTCMInputKeys::clutter_type) {
+            columns.clutter_type = c;
+        } else if (name == TSMInputKeys::d__km) {
+            columns.d__km = c;
+        } else if (name == ASMInputKeys::theta__deg) {
+            columns.theta__deg = c;
+        } else if (name == TSMInputKeys::p) {
+            columns.p = c;
+        } else {
+            err << "Unknown column: " << names[i] << std::endl;
+            return DRVRERR__PARSE;
+        }
+    }
+    if (columns.model < 0) {
+        err << "Missing column: " << MixedBatchKeys::model << std::endl;
+        return DRVRERR__PARSE_MODEL;
+    }
+    return DRVR__SUCCESS;
+}
+
+/** Parse a floating point field */
+DrvrReturnCode Parse(const std::string &field, double &value) {
+    return ParseDouble(field, value);
+}
+
+/** Parse an integer field */
+DrvrReturnCode Parse(const std::string &field, int &value) {
+    return ParseInteger(field, value);
+}
+
+/*******************************************************************************
+ * Parse one numeric field of a row and append it to an input column.
+ *
+ * A field in a column which is absent from the file is treated as empty.
+ *
+ * @param[in]  fields  Fields of the row
+ * @param[in]  column  Position of the field, or -1 if the column is absent
+ * @param[in]  error   Return code if the field is not a number
+ * @param[out] values  Input column to append the value to
+ * @return             Return code
+ ******************************************************************************/
+template<typename T>
+DrvrReturnCode AppendField(
+    const std::vector<std::string> &fields,
+    const int column,
+    const DrvrReturnCode error,
+    std::vector<T> &values
+) {
+    static const std::string empty;
+    const std::string &field
+        = (column >= 0 && static_cast<std::size_t>(column) < fields.size())
+            ? fields[column]
+            : empty;
+    T value;
+    if (Parse(field, value) != DRVR__SUCCESS) {
+        return error;
+    }
+    values.push_back(value);
+    return DRVR__SUCCESS;
+}
+
+/*******************************************************************************
+ * Parse the inputs of one row into the bucket of its model.
+ *
+ * @param[in]  fields   Fields of the row
+ * @param[in]  columns  Position of each known column
+ * @param[in]  row      Index of the row, from 0
+ * @param[out] batch    Mixed-model batch to add the row to
+ * @return              Return code
+ ******************************************************************************/
+DrvrReturnCode ParseMixedBatchRow(
+    const std::vector<std::string> &fields,
+    const MixedBatchColumns &columns,
+    const std::size_t row,
+    MixedBatch &batch
+) {
+    std::string name = (static_cast<std::size_t>(columns.model) < fields.size())
+                         ? fields[columns.model]
+                         : "";
+    StringToLower(name);
+
+    MixedBatchBucket *bucket;
+    P2108Model model;
+    if (name == "hgtcm") {
+        bucket = &batch.hgtcm;
+        model = P2108Model::HGTCM;
+    } else if (name == "tsm") {
+        bucket = &batch.tsm;
+        model = P2108Model::TSM;
+    } else if (name == "asm") {
+        bucket = &batch.aero;
+        model = P2108Model::ASM;
+    } else {
+        return DRVRERR__PARSE_MODEL;
+    }
+
+    DrvrReturnCode rtn = AppendField(
+        fields, columns.f__ghz, DRVRERR__PARSE_FREQ, bucket->f__ghz
+    );
+    switch (model) {
+        case P2108Model::HGTCM:
+            if (rtn == DRVR__SUCCESS)
+                rtn = AppendField(
+                    fields,
+                    columns.h__meter,
+                    DRVRERR__PARSE_HEIGHT,
+                    bucket->h__meter
+                );
+            if (rtn == DRVR__SUCCESS)
+                rtn = AppendField(
+                    fields,
+                    columns.w_s__meter,
+                    DRVRERR__PARSE_STREET_WIDTH,
+                    bucket->w_s__meter
+                );
+            if (rtn == DRVR__SUCCESS)
+                rtn = AppendField(
+                    fields,
+                    columns.R__meter,
+                    DRVRERR__PARSE_REPR_HEIGHT,
+                    bucket->R__meter
+                );
+            if (rtn == DRVR__SUCCESS)
+                rtn = AppendField(
+                    fields,
+                    columns.clutter_type,
+                    DRVRERR__PARSE_CLUTTER_TYPE,
+                    bucket->clutter_type
+                );
+            break;
+        case P2108Model::TSM:
+            if (rtn == DRVR__SUCCESS)
+                rtn = AppendField(
+                    fields,
+                    columns.d__km,
+                    DRVRERR__PARSE_PATH_DIST,
+                    bucket->d__km
+                );
+            break;
+        default:
+            if (rtn == DRVR__SUCCESS)
+                rtn = AppendField(
+                    fields,
+                    columns.theta__deg,
+                    DRVRERR__PARSE_THETA,
+                    bucket->theta__deg
+                );
+            break;
+    }
+    if (rtn == DRVR__SUCCESS && model != P2108Model::HGTCM)
+        rtn = AppendField(
+            fields, columns.p, DRVRERR__PARSE_PERCENTAGE, bucket->p
+        );
+    if (rtn != DRVR__SUCCESS)
+        return rtn;
+
+    batch.models.push_back(model);
+    bucket->rows.push_back(row);
+    return rtn;
+}
+
+/*******************************************************************************
+ * Copy the results of one bucket to their rows of the batch.
+ *
+ * @param[in]     bucket    Records of one model
+ * @param[in]     rtn       Return code of each record of the bucket
+ * @param[in]     loss__db  Clutter loss of each record of the bucket, in dB
+ * @param[in,out] batch     Mixed-model batch receiving the results
+ ******************************************************************************/
+void ScatterResults(
+    const MixedBatchBucket &bucket,
+    const std::vector<int> &rtn,
+    const std::vector<double> &loss__db,
+    MixedBatch &batch
+) {
+    for (std::size_t i = 0; i < bucket.rows.size(); i++) {
+        batch.rtn[bucket.rows[i]] = rtn[i];
+        batch.loss__db[bucket.rows[i]] = loss__db[i];
+    }
+}
+}  // namespace
+
+/*******************************************************************************
+ * Parse input stream (file or string stream) to a mixed-model batch.
+ *
+ * @param[in]  stream  Input stream containing the batch file
+ * @param[out] batch   Mixed-model batch, with the inputs of each row
+ * @param[out] err     Output stream for error messages
+ * @return             Return code
+ ******************************************************************************/
+DrvrReturnCode ParseMixedBatchStream(
+    std::istream &stream, MixedBatch &batch, std::ostream &err
+) {
+    TraceSpan span("ParseMixedBatchStream");
+    std::string line;
+    std::vector<std::string> fields;
+    MixedBatchColumns columns;
+    DrvrReturnCode rtn = DRVR__SUCCESS;
+    bool have_header = false;
+    std::size_t line_number = 0;
+    while (std::getline(stream, line)) {
+        line_number++;
+        if (line.find_first_not_of(" \t\r") == std::string::npos) {
+            continue;  // Skip blank lines
+        }
+        SplitFields(line, fields);
+        if (!have_header) {
+            rtn = ParseMixedBatchHeader(fields, columns, err);
+            have_header = true;
+        } else {
+            rtn = ParseMixedBatchRow(
+                fields, columns, batch.models.size(), batch
+            );
+        }
+        if (rtn != DRVR__SUCCESS) {
+            err << "Error on line " << line_number << ": "
+                << GetDrvrReturnStatusMsg(rtn) << std::endl;
+            return rtn;
+        }
+    }
+    return rtn;
+}
+
+/*******************************************************************************
+ * Parse a mixed-model batch file.
+ *
+ * @param[in]  in_file  Path to the batch file
+ * @param[out] batch    Mixed-model batch, with the inputs of each row
+ * @param[out] err      Output stream for error messages
+ * @return              Return code
+ ******************************************************************************/
+DrvrReturnCode ParseMixedBatchFile(
+    const std::string &in_file, MixedBatch &batch, std::ostream &err
+) {
+    std::ifstream file(in_file);
+    if (!file) {
+        err << "Failed to open file " << in_file << std::endl;
+        return DRVRERR__OPENING_INPUT_FILE;
+    }
+    return ParseMixedBatchStream(file, batch, err);
+}
+
+/*******************************************************************************
+ * Evaluate every row of a mixed-model batch.
+ *
+ * The rows of each model are evaluated together by the model's batch
+ * function, and their results stored in the order of the input rows.
+ *
+ * @param[in,out] batch  Mixed-model batch, receiving the results of each row
+ ******************************************************************************/
+void CallMixedBatch(MixedBatch &batch) {
+    TraceSpan span("CallMixedBatch");
+    const std::size_t n = batch.models.size();
+    batch.rtn.assign(n, SUCCESS);
+    batch.loss__db.assign(n, std::numeric_limits<double>::quiet_NaN());
+
+    constexpr std::ptrdiff_t D = sizeof(double);
+    constexpr std::ptrdiff_t I = sizeof(int);
+    std::vector<int> rtn;
+    std::vector<double> loss__db;
+
+    const MixedBatchBucket &hgtcm = batch.hgtcm;
+    rtn.resize(hgtcm.rows.size());
+    loss__db.resize(hgtcm.rows.size());
+    P2108HeightGainTerminalCorrectionModelBatch(
+        hgtcm.rows.size(),
+        hgtcm.f__ghz.data(),
+        D,
+        hgtcm.h__meter.data(),
+        D,
+        hgtcm.w_s__meter.data(),
+        D,
+        hgtcm.R__meter.data(),
+        D,
+        hgtcm.clutter_type.data(),
+        I,
+        loss__db.data(),
+        D,
+        rtn.data(),
+        I
+    );
+    ScatterResults(hgtcm, rtn, loss__db, batch);
+
+    const MixedBatchBucket &tsm = batch.tsm;
+    rtn.resize(tsm.rows.size());
+    loss__db.resize(tsm.rows.size());
+    P2108TerrestrialStatisticalModelBatch(
+        tsm.rows.size(),
+        tsm.f__ghz.data(),
+        D,
+        tsm.d__km.data(),
+        D,
+        tsm.p.data(),
+        D,
+        ABRAMOWITZ_STEGUN,
+        loss__db.data(),
+        D,
+        rtn.data(),
+        I
+    );
+    ScatterResults(tsm, rtn, loss__db, batch);
+
+    const MixedBatchBucket &aero = batch.aero;
+    rtn.resize(aero.rows.size());
+    loss__db.resize(aero.rows.size());
+    P2108AeronauticalStatisticalModelBatch(
+        aero.rows.size(),
+        aero.f__ghz.data(),
+        D,
+        aero.theta__deg.data(),
+        D,
+        aero.p.data(),
+        D,
+        ABRAMOWITZ_STEGUN,
+        loss__db.data(),
+        D,
+        rtn.data(),
+        I
+    );
+    ScatterResults(aero, rtn, loss__db, batch);
+}
+
+/*******************************************************************************
+ * Write the results of a mixed-model batch, in the order of the input rows.
+ *
+ * Each line gives the row number (from 1), model, return code and clutter
+ * loss in dB. The loss is empty where the return code is not `SUCCESS`.
+ *
+ * @param[in] fp     Report writer for the output file
+ * @param[in] batch  Evaluated mixed-model batch
+ ******************************************************************************/
+void WriteMixedBatchResults(ReportWriter &fp, const MixedBatch &batch) {
+    TraceSpan span("WriteMixedBatchResults");
+    fp.SetNumberFormat(NumberFormat::SHORTEST, 0);
+    fp.Write("row,model,rtn,loss__db\n");
+    for (std::size_t i = 0; i < batch.models.size(); i++) {
+        fp.Write(static_cast<int>(i + 1)).Write(',');
+        switch (batch.models[i]) {
+            case P2108Model::HGTCM:
+                fp.Write("HGTCM,");
+                break;
+            case P2108Model::TSM:
+                fp.Write("TSM,");
+                break;
+            default:
+                fp.Write("ASM,");
+                break;
+        }
+        fp.Write(batch.rtn[i]).Write(',');
+        if (batch.rtn[i] == SUCCESS) {
+            fp.Write(batch.loss__db[i]);
+        }
+        fp.Write('\n');
+    }
+}
+
+/*******************************************************************************
+ * Run a mixed-model batch file, after the command line has been validated.
+ *
+ * @param[in]  params  Validated driver parameters
+ * @param[in]  in      Input stream, read when the input file is "-"
+ * @param[out] out     Output stream, written when the output file is "-"
+ * @param[out] err     Output stream for error messages
+ * @return             Return code
+ ******************************************************************************/
+int RunMixedBatch(
+    const DrvrParams &params,
+    std::istream &in,
+    std::ostream &out,
+    std::ostream &err
+) {
+    MixedBatch batch;
+    const DrvrReturnCode rtn
+        = (params.in_file == "-")
+            ? ParseMixedBatchStream(in, batch, err)
+            : ParseMixedBatchFile(params.in_file, batch, err);
+    if (rtn != DRVR__SUCCESS) {
+        return rtn;
+    }
+    CallMixedBatch(batch);
+
+    // Open output file for writing, unless writing to the output stream
+    std::ofstream file;
+    if (params.out_file != "-") {
+        file.open(params.out_file);
+        if (!file) {
+            err << "Error opening output file. Exiting." << std::endl;
+            return DRVRERR__OPENING_OUTPUT_FILE;
+        }
+    }
+    std::ostream &fp = file.is_open() ? file : out;
+    {
+        ReportWriter report(fp);
+        WriteMixedBatchResults(report, batch);
+    }
+    fp.flush();
+    return SUCCESS;
+}
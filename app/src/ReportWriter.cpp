@@ -0,0 +1,353 @@
+/** @file ReportWriter.cpp
+ * Implements a buffered writer for formatting driver output text.
+ */
+#include "ReportWriter.h"
+
+#include "Tracing.h"
+
+#include <algorithm>  // for std::max, std::min
+#include <cmath>      // for std::fabs, std::floor, std::isfinite, std::signbit
+#include <cstdint>    // for std::uint64_t
+#include <cstdio>     // for std::snprintf
+#include <cstdlib>    // for std::strtod
+#include <cstring>    // for std::memcpy, std::memset, std::strlen
+#include <limits>     // for std::numeric_limits
+#include <ostream>    // for std::ostream
+#include <string>     // for std::string
+
+// Out-of-line definitions for ODR-used static members (required in C++11)
+constexpr std::size_t ReportWriter::DEFAULT_CAPACITY;
+constexpr int ReportWriter::LABEL_WIDTH;
+constexpr int ReportWriter::VALUE_WIDTH;
+constexpr std::size_t ReportWriter::MAX_NUMBER_LENGTH;
+
+namespace {
+/** Convert a `snprintf` return value to the number of characters written */
+std::size_t ClampLength(const int len) {
+    if (len < 0) {
+        return 0;
+    }
+    return std::min(
+        static_cast<std::size_t>(len), ReportWriter::MAX_NUMBER_LENGTH - 1
+    );
+}
+}  // namespace
+
+ReportWriter::ReportWriter(std::ostream &os, std::size_t capacity):
+    os_(os),
+    buffer_(std::max(capacity, 2 * MAX_NUMBER_LENGTH)),
+    size_(0),
+    format_(NumberFormat::GENERAL),
+    precision_(6) {}
+
+ReportWriter::~ReportWriter() {
+    Flush();
+}
+
+/*******************************************************************************
+ * Set the notation and precision used when writing floating point values.
+ *
+ * As with `std::ostream`, the precision is the number of digits after the
+ * decimal point for `FIXED` notation and the number of significant digits for
+ * `GENERAL` notation. It is ignored for `SHORTEST` notation. Values are
+ * limited to the range [0, 17].
+ *
+ * @param[in] format     Floating point notation
+ * @param[in] precision  Floating point precision
+ ******************************************************************************/
+void ReportWriter::SetNumberFormat(
+    const NumberFormat format, const int precision
+) {
+    format_ = format;
+    precision_ = std::min(std::max(precision, 0), 17);
+}
+
+/*******************************************************************************
+ * Write all buffered text to the output stream in a single block.
+ ******************************************************************************/
+void ReportWriter::Flush() {
+    TraceSpan span("ReportWriter::Flush");
+    if (size_ > 0) {
+        os_.write(buffer_.data(), static_cast<std::streamsize>(size_));
+        size_ = 0;
+    }
+}
+
+/*******************************************************************************
+ * Ensure the buffer has room for `n` more bytes, flushing if required.
+ *
+ * @param[in] n  Number of bytes which will be written
+ ******************************************************************************/
+void ReportWriter::Reserve(const std::size_t n) {
+    if (size_ + n > buffer_.size()) {
+        Flush();
+    }
+}
+
+/*******************************************************************************
+ * Append raw bytes, writing directly to the stream if they exceed the buffer.
+ *
+ * @param[in] data  Bytes to write
+ * @param[in] n     Number of bytes to write
+ ******************************************************************************/
+void ReportWriter::WriteBytes(const char *data, const std::size_t n) {
+    Reserve(n);
+    if (n > buffer_.size()) {
+        os_.write(data, static_cast<std::streamsize>(n));
+        return;
+    }
+    std::memcpy(buffer_.data() + size_, data, n);
+    size_ += n;
+}
+
+/*******************************************************************************
+ * Pad a field of `length` characters with spaces up to `width` characters.
+ *
+ * @param[in] length  Number of characters already written to the field
+ * @param[in] width   Minimum field width
+ ******************************************************************************/
+void ReportWriter::Pad(const std::size_t length, const int width) {
+    if (width <= 0 || length >= static_cast<std::size_t>(width)) {
+        return;
+    }
+    const std::size_t n = static_cast<std::size_t>(width) - length;
+    Reserve(n);
+    if (n > buffer_.size()) {
+        os_ << std::string(n, ' ');
+        return;
+    }
+    std::memset(buffer_.data() + size_, ' ', n);
+    size_ += n;
+}
+
+/** Write a single character */
+ReportWriter &ReportWriter::Write(const char c) {
+    Reserve(1);
+    buffer_[size_++] = c;
+    return *this;
+}
+
+/** Write a C-style string */
+ReportWriter &ReportWriter::Write(const char *str) {
+    WriteBytes(str, std::strlen(str));
+    return *this;
+}
+
+/** Write a string */
+ReportWriter &ReportWriter::Write(const std::string &str) {
+    WriteBytes(str.data(), str.size());
+    return *this;
+}
+
+/** Write an integer */
+ReportWriter &ReportWriter::Write(const int value) {
+    return WriteField(value, 0);
+}
+
+/** Write a floating point value using the current notation and precision */
+ReportWriter &ReportWriter::Write(const double value) {
+    return WriteField(value, 0);
+}
+
+/*******************************************************************************
+ * Write a left-justified string, padded with spaces to a minimum width.
+ *
+ * @param[in] str    String to write
+ * @param[in] width  Minimum field width
+ * @return           A reference to this writer
+ ******************************************************************************/
+ReportWriter &
+    ReportWriter::WriteField(const std::string &str, const int width) {
+    WriteBytes(str.data(), str.size());
+    Pad(str.size(), width);
+    return *this;
+}
+
+/*******************************************************************************
+ * Write a left-justified integer, padded with spaces to a minimum width.
+ *
+ * @param[in] value  Integer to write
+ * @param[in] width  Minimum field width
+ * @return           A reference to this writer
+ ******************************************************************************/
+ReportWriter &ReportWriter::WriteField(const int value, const int width) {
+    Reserve(MAX_NUMBER_LENGTH);
+    char *const out = buffer_.data() + size_;
+    char digits[16];
+    std::size_t n = 0;
+    // Negate into unsigned space so that INT_MIN is handled correctly
+    unsigned int u = static_cast<unsigned int>(value);
+    if (value < 0) {
+        u = 0u - u;
+    }
+    do {
+        digits[n++] = static_cast<char>('0' + u % 10);
+        u /= 10;
+    } while (u != 0);
+    std::size_t len = 0;
+    if (value < 0) {
+        out[len++] = '-';
+    }
+    while (n > 0) {
+        out[len++] = digits[--n];
+    }
+    size_ += len;
+    Pad(len, width);
+    return *this;
+}
+
+/*******************************************************************************
+ * Write a left-justified floating point value, using the current notation and
+ * precision, padded with spaces to a minimum width.
+ *
+ * @param[in] value  Floating point value to write
+ * @param[in] width  Minimum field width
+ * @return           A reference to this writer
+ ******************************************************************************/
+ReportWriter &ReportWriter::WriteField(const double value, const int width) {
+    Reserve(MAX_NUMBER_LENGTH);
+    const std::size_t len = FormatNumber(value, buffer_.data() + size_);
+    size_ += len;
+    Pad(len, width);
+    return *this;
+}
+
+/*******************************************************************************
+ * Start a new report line with a left-justified label.
+ *
+ * Equivalent to `os << std::endl << std::left << std::setw(25) << lbl`,
+ * without flushing the stream.
+ *
+ * @param[in] lbl  Label text
+ * @return         A reference to this writer
+ ******************************************************************************/
+ReportWriter &ReportWriter::Label(const std::string &lbl) {
+    Write('\n');
+    return WriteField(lbl, LABEL_WIDTH);
+}
+
+/*******************************************************************************
+ * Format a value using the current notation and precision.
+ *
+ * @param[in]  value  Floating point value to format
+ * @param[out] buf    Destination, at least `MAX_NUMBER_LENGTH` bytes
+ * @return            Number of characters written (not null-terminated)
+ ******************************************************************************/
+std::size_t ReportWriter::FormatNumber(const double value, char *buf) const {
+    switch (format_) {
+        case NumberFormat::FIXED:
+            return FormatFixed(value, precision_, buf);
+        case NumberFormat::SHORTEST:
+            return FormatShortest(value, buf);
+        case NumberFormat::GENERAL:
+        default:
+            return FormatGeneral(value, precision_, buf);
+    }
+}
+
+/*******************************************************************************
+ * Format a value in fixed-point notation, identical to `printf("%.*f")`.
+ *
+ * Values of moderate magnitude are scaled by a power of ten and rounded with
+ * integer arithmetic. The scaling may introduce up to half an ulp of error, so
+ * values whose scaled fractional part falls within that error of one half
+ * (where the rounding direction is ambiguous) are formatted by the C library,
+ * which rounds the exact binary value.
+ *
+ * @param[in]  value      Floating point value to format
+ * @param[in]  precision  Digits after the decimal point, [0, 17]
+ * @param[out] buf        Destination, at least `MAX_NUMBER_LENGTH` bytes
+ * @return                Number of characters written (not null-terminated)
+ ******************************************************************************/
+std::size_t ReportWriter::FormatFixed(
+    const double value, const int precision, char *buf
+) {
+    static const double POW10[]
+        = {1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9};
+    static const std::uint64_t IPOW10[] = {
+        1, 10, 100, 1000, 10000, 100000, 1000000, 10000000, 100000000,
+        1000000000
+    };
+
+    if (precision >= 0 && precision <= 9 && std::isfinite(value)) {
+        const double scaled = std::fabs(value) * POW10[precision];
+        if (scaled < 4.5e15) {
+            const double whole = std::floor(scaled);
+            const double frac = scaled - whole;  // exact
+            const double tol = scaled * std::numeric_limits<double>::epsilon();
+            if (std::fabs(frac - 0.5) > tol) {
+                const std::uint64_t n = static_cast<std::uint64_t>(whole)
+                                      + (frac > 0.5 ? 1 : 0);
+                std::uint64_t int_part = n / IPOW10[precision];
+                std::uint64_t frac_part = n % IPOW10[precision];
+
+                char digits[24];
+                std::size_t nd = 0;
+                do {
+                    digits[nd++] = static_cast<char>('0' + int_part % 10);
+                    int_part /= 10;
+                } while (int_part != 0);
+
+                std::size_t len = 0;
+                if (std::signbit(value)) {
+                    buf[len++] = '-';
+                }
+                while (nd > 0) {
+                    buf[len++] = digits[--nd];
+                }
+                if (precision > 0) {
+                    buf[len++] = '.';
+                    for (int i = precision - 1; i >= 0; i--) {
+                        buf[len + i] = static_cast<char>('0' + frac_part % 10);
+                        frac_part /= 10;
+                    }
+                    len += static_cast<std::size_t>(precision);
+                }
+                return len;
+            }
+        }
+    }
+
+    const int len
+        = std::snprintf(buf, MAX_NUMBER_LENGTH, "%.*f", precision, value);
+    return ClampLength(len);
+}
+
+/*******************************************************************************
+ * Format a value in general notation, identical to `printf("%.*g")` and to
+ * the default notation of `std::ostream`.
+ *
+ * @param[in]  value      Floating point value to format
+ * @param[in]  precision  Number of significant digits, [0, 17]
+ * @param[out] buf        Destination, at least `MAX_NUMBER_LENGTH` bytes
+ * @return                Number of characters written (not null-terminated)
+ ******************************************************************************/
+std::size_t ReportWriter::FormatGeneral(
+    const double value, const int precision, char *buf
+) {
+    const int len
+        = std::snprintf(buf, MAX_NUMBER_LENGTH, "%.*g", precision, value);
+    return ClampLength(len);
+}
+
+/*******************************************************************************
+ * Format a value using the fewest significant digits (of 15, 16 or 17) which
+ * parse back to exactly the same value.
+ *
+ * Any value with 15 or fewer significant decimal digits is printed with
+ * trailing zeros removed, so short inputs such as `0.1` produce short output.
+ *
+ * @param[in]  value  Floating point value to format
+ * @param[out] buf    Destination, at least `MAX_NUMBER_LENGTH` bytes
+ * @return            Number of characters written (not null-terminated)
+ ******************************************************************************/
+std::size_t ReportWriter::FormatShortest(const double value, char *buf) {
+    std::size_t len = 0;
+    for (int precision = 15; precision <= 17; precision++) {
+        len = FormatGeneral(value, precision, buf);
+        if (!std::isfinite(value) || std::strtod(buf, nullptr) == value) {
+            break;
+        }
+    }
+    return len;
+}
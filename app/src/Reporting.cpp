@@ -3,16 +3,15 @@
  */
 #include "Driver.h"
 
-#include <fstream>  // for std::ofstream
-#include <string>   // for std::string
+#include <string>  // for std::string
 
 /*******************************************************************************
  * Print text message corresponding to clutter type enum value
  * 
- * @param[in] fp            Output stream, a text file open for writing
+ * @param[in] fp            Report writer for the output file
  * @param[in] clutter_type  Height Gain Terminal Correction Model clutter type
  ******************************************************************************/
-void PrintClutterTypeLabel(std::ofstream &fp, const ClutterType clutter_type) {
+void PrintClutterTypeLabel(ReportWriter &fp, const ClutterType clutter_type) {
     std::string label;
     switch (clutter_type) {
         case ClutterType::WATER_SEA:
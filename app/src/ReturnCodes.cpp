@@ -23,6 +23,10 @@ std::string GetDrvrReturnStatusMsg(int code) {
             "Failed to open the input file for reading"},
            {DRVRERR__OPENING_OUTPUT_FILE,
             "Failed to open the output file for writing"},
+           {DRVRERR__OPENING_TRACE_FILE,
+            "Failed to open the trace file for writing"},
+           {DRVRERR__WRITING_SURFACE,
+            "Failed to write the precomputed surface file"},
            {DRVRERR__PARSE, "Failed parsing inputs; unknown parameter"},
            {DRVRERR__PARSE_FREQ, "Failed to parse frequency value"},
            {DRVRERR__PARSE_THETA, "Failed to parse theta value"},
@@ -33,12 +37,31 @@ std::string GetDrvrReturnStatusMsg(int code) {
             "Failed to parse representative height value"},
            {DRVRERR__PARSE_CLUTTER_TYPE, "Failed to parse clutter type value"},
            {DRVRERR__PARSE_PATH_DIST, "Failed to parse path distance value"},
+           {DRVRERR__PARSE_MODEL, "Failed to parse the model of a batch row"},
+           {DRVRERR__PARSE_TRACK, "Failed to parse the track of a replay row"},
+           {DRVRERR__PARSE_POSITION,
+            "Failed to parse a position of a replay row"},
+           {DRVRERR__PARSE_SWEEP, "Failed to parse a sweep range"},
            {DRVRERR__VALIDATION_IN_FILE,
             "Option -i is required but was not provided"},
            {DRVRERR__VALIDATION_OUT_FILE,
             "Option -o is required but was not provided"},
            {DRVRERR__VALIDATION_MODEL,
-            "Option -model is required but was not provided"}};
+            "Option -model is required but was not provided"},
+           {DRVRERR__VALIDATION_WORKERS,
+            "Option -workers must be a positive integer"},
+           {DRVRERR__VALIDATION_SWEEP,
+            "Option -sweep must give each input of the model exactly once"},
+           {DRVRERR__VALIDATION_NODES,
+            "Option -nodes must be an integer of at least 2"},
+           {DRVRERR__SERVICE_UNSUPPORTED,
+            "Service mode is not supported on this platform"},
+           {DRVRERR__SERVICE_SOCKET,
+            "Failed to create or listen on the service socket"},
+           {DRVRERR__SERVICE_FRAME,
+            "Received a malformed service request frame"},
+           {DRVRERR__SERVICE_SHM,
+            "Failed to create or map the shared-memory region"}};
 
     // Construct status message
     std::string msg = DRIVER_NAME;
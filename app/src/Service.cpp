@@ -0,0 +1,588 @@
+/** @file Service.cpp
+ * Implements the persistent local service mode of the driver.
+ */
+#include "Service.h"
+
+#include "P2108.h"
+#include "ShmService.h"
+
+#include <chrono>     // for std::chrono::steady_clock, ...
+#include <climits>    // for INT_MAX, INT_MIN
+#include <cstddef>    // for std::size_t
+#include <cstdint>    // for std::int32_t
+#include <cstring>    // for std::memcpy, std::strerror
+#include <limits>     // for std::numeric_limits
+#include <mutex>      // for std::lock_guard, std::unique_lock
+#include <ostream>    // for std::endl, std::ostream
+#include <string>     // for std::string
+#include <thread>     // for std::thread
+#include <vector>     // for std::vector
+
+#ifndef _WIN32
+    #include <cerrno>        // for ECONNREFUSED, EINTR, errno
+    #include <csignal>       // for SIGINT, SIGTERM, sigset_t
+    #include <fcntl.h>       // for fcntl, F_SETFL, O_NONBLOCK
+    #include <poll.h>        // for poll, pollfd
+    #include <pthread.h>     // for pthread_sigmask
+    #include <sys/socket.h>  // for accept, bind, connect, listen, recv, send
+    #include <sys/stat.h>    // for stat, S_ISSOCK
+    #include <sys/un.h>      // for sockaddr_un
+    #include <unistd.h>      // for close, pipe, read, unlink, write
+#endif
+
+using namespace ITS::ITU::PSeries::P2108;
+
+/*******************************************************************************
+ * Get the number of input columns required by a model.
+ *
+ * @param[in] model  Model selection
+ * @return           Number of inputs, or 0 if the model is invalid
+ ******************************************************************************/
+std::size_t GetModelInputCount(const P2108Model model) {
+    switch (model) {
+        case P2108Model::HGTCM:
+            return 5;
+        case P2108Model::TSM:
+        case P2108Model::ASM:
+            return 3;
+        default:
+            return 0;
+    }
+}
+
+/*******************************************************************************
+ * Evaluate a model over columns of inputs.
+ *
+ * The input columns are ordered as documented for the service wire protocol.
+ * Loss values are NaN where the return code is not `SUCCESS`.
+ *
+ * @param[in]  model    Model selection
+ * @param[in]  columns  Pointers to each input column, `count` values each
+ * @param[in]  count    Number of records
+ * @param[out] rtn      Return code of each record
+ * @param[out] loss     Clutter loss of each record, in dB
+ ******************************************************************************/
+void EvaluateModelColumns(
+    const P2108Model model,
+    const double *const *columns,
+    const std::size_t count,
+    std::int32_t *rtn,
+    double *loss
+) {
+    const double nan = std::numeric_limits<double>::quiet_NaN();
+    ReturnCode r;
+    double value;
+    for (std::size_t i = 0; i < count; i++) {
+        switch (model) {
+            case P2108Model::HGTCM:
+                {
+                    // Out-of-range clutter types map to an invalid value
+                    const double c = columns[4][i];
+                    const int clutter_type
+                        = (c >= INT_MIN && c <= INT_MAX) ? static_cast<int>(c)
+                                                         : 0;
+                    r = HeightGainTerminalCorrectionModel(
+                        columns[0][i],
+                        columns[1][i],
+                        columns[2][i],
+                        columns[3][i],
+                        static_cast<ClutterType>(clutter_type),
+                        value
+                    );
+                    break;
+                }
+            case P2108Model::TSM:
+                r = TerrestrialStatisticalModel(
+                    columns[0][i], columns[1][i], columns[2][i], value
+                );
+                break;
+            case P2108Model::ASM:
+                r = AeronauticalStatisticalModel(
+                    columns[0][i], columns[1][i], columns[2][i], value
+                );
+                break;
+            default:
+                rtn[i] = DRVRERR__VALIDATION_MODEL;
+                loss[i] = nan;
+                continue;
+        }
+        rtn[i] = r;
+        loss[i] = (r == SUCCESS) ? value : nan;
+    }
+}
+
+#ifndef _WIN32
+namespace {
+    #ifdef MSG_NOSIGNAL
+/** Flags which prevent SIGPIPE when a client disconnects early */
+constexpr int SEND_FLAGS = MSG_NOSIGNAL;
+    #else
+constexpr int SEND_FLAGS = 0;  // SO_NOSIGPIPE is set on each socket instead
+    #endif
+
+typedef std::chrono::steady_clock Clock;
+
+/*******************************************************************************
+ * Wait until a socket is ready for reading or writing.
+ *
+ * @param[in] fd        Socket
+ * @param[in] events    `POLLIN` or `POLLOUT`
+ * @param[in] deadline  Time by which the socket must be ready
+ * @return              False on timeout or error
+ ******************************************************************************/
+bool WaitUntil(
+    const int fd, const short events, const Clock::time_point deadline
+) {
+    while (true) {
+        const std::chrono::milliseconds remaining
+            = std::chrono::duration_cast<std::chrono::milliseconds>(
+                deadline - Clock::now()
+            );
+        if (remaining.count() <= 0) {
+            return false;
+        }
+        pollfd p;
+        p.fd = fd;
+        p.events = events;
+        p.revents = 0;
+        const int r = poll(&p, 1, static_cast<int>(remaining.count()));
+        if (r < 0 && errno == EINTR) {
+            continue;
+        }
+        return r > 0;
+    }
+}
+
+/** Read exactly `n` bytes from a socket before a deadline. Returns false on
+ *  EOF, error or timeout. */
+bool ReadFully(
+    const int fd, void *buf, std::size_t n, const Clock::time_point deadline
+) {
+    char *p = static_cast<char *>(buf);
+    while (n > 0) {
+        if (!WaitUntil(fd, POLLIN, deadline)) {
+            return false;
+        }
+        const ssize_t r = recv(fd, p, n, 0);
+        if (r < 0 && errno == EINTR) {
+            continue;
+        }
+        if (r <= 0) {
+            return false;
+        }
+        p += r;
+        n -= static_cast<std::size_t>(r);
+    }
+    return true;
+}
+
+/** Write exactly `n` bytes to a socket before a deadline. Returns false on
+ *  error or timeout. */
+bool WriteFully(
+    const int fd,
+    const void *buf,
+    std::size_t n,
+    const Clock::time_point deadline
+) {
+    const char *p = static_cast<const char *>(buf);
+    while (n > 0) {
+        if (!WaitUntil(fd, POLLOUT, deadline)) {
+            return false;
+        }
+        const ssize_t r = send(fd, p, n, SEND_FLAGS);
+        if (r < 0 && errno == EINTR) {
+            continue;
+        }
+        if (r <= 0) {
+            return false;
+        }
+        p += r;
+        n -= static_cast<std::size_t>(r);
+    }
+    return true;
+}
+
+/** Buffers which a worker thread reuses between request frames */
+struct FrameBuffers {
+        std::vector<double> inputs;       /**< Input columns */
+        std::vector<std::int32_t> rtn;    /**< Return codes */
+        std::vector<double> loss;         /**< Clutter loss values, in dB */
+        std::vector<char> response;       /**< Assembled response frame */
+};
+
+/*******************************************************************************
+ * Answer one request frame on a connection.
+ *
+ * Buffers are reused between frames, so steady-state requests of a similar
+ * size do not allocate.
+ *
+ * @param[in] fd        Connected client socket, with a frame ready to read
+ * @param[in] deadline  Time by which the frame must be read and answered
+ * @param[in] buffers   Buffers of the calling worker thread
+ * @return              False if the client disconnected, sent a malformed
+ *                      frame or missed the deadline, so that the connection
+ *                      should be closed
+ ******************************************************************************/
+bool ServeFrame(
+    const int fd, const Clock::time_point deadline, FrameBuffers &buffers
+) {
+    ServiceRequestHeader request;
+    ServiceResponseHeader header;
+    header.magic = SERVICE_FRAME_MAGIC;
+    if (!ReadFully(fd, &request, sizeof(request), deadline)) {
+        return false;
+    }
+    const P2108Model model = static_cast<P2108Model>(request.model);
+    const std::size_t n_inputs = GetModelInputCount(model);
+    if (request.magic != SERVICE_FRAME_MAGIC || n_inputs == 0
+        || request.count > SERVICE_MAX_RECORDS) {
+        header.status = DRVRERR__SERVICE_FRAME;
+        header.count = 0;
+        WriteFully(fd, &header, sizeof(header), deadline);
+        return false;
+    }
+
+    const std::size_t count = request.count;
+    std::vector<double> &inputs = buffers.inputs;
+    inputs.resize(n_inputs * count);
+    const std::size_t input_bytes = inputs.size() * sizeof(double);
+    if (!ReadFully(fd, inputs.data(), input_bytes, deadline)) {
+        return false;
+    }
+    const double *columns[5];
+    for (std::size_t i = 0; i < n_inputs; i++) {
+        columns[i] = inputs.data() + i * count;
+    }
+    buffers.rtn.resize(count);
+    buffers.loss.resize(count);
+    EvaluateModelColumns(
+        model, columns, count, buffers.rtn.data(), buffers.loss.data()
+    );
+
+    // Assemble the response so that it is sent with a single call
+    header.status = DRVR__SUCCESS;
+    header.count = request.count;
+    const std::size_t rtn_bytes = count * sizeof(std::int32_t);
+    const std::size_t loss_bytes = count * sizeof(double);
+    buffers.response.resize(sizeof(header) + rtn_bytes + loss_bytes);
+    char *out = buffers.response.data();
+    std::memcpy(out, &header, sizeof(header));
+    std::memcpy(out + sizeof(header), buffers.rtn.data(), rtn_bytes);
+    std::memcpy(
+        out + sizeof(header) + rtn_bytes, buffers.loss.data(), loss_bytes
+    );
+    return WriteFully(
+        fd, buffers.response.data(), buffers.response.size(), deadline
+    );
+}
+}  // namespace
+#endif
+
+ServiceServer::ServiceServer(
+    const std::string &socket_path,
+    unsigned int n_workers,
+    int frame_timeout__ms
+):
+    socket_path_(socket_path),
+    n_workers_(n_workers),
+    frame_timeout__ms_(frame_timeout__ms),
+    listen_fd_(-1),
+    stopping_(false) {
+    wake_fds_[0] = wake_fds_[1] = -1;
+    if (n_workers_ == 0) {
+        n_workers_ = std::thread::hardware_concurrency();
+    }
+    if (n_workers_ == 0) {
+        n_workers_ = 1;
+    }
+}
+
+ServiceServer::~ServiceServer() {
+    Stop();
+}
+
+/*******************************************************************************
+ * Bind the socket and start the acceptor and worker threads.
+ *
+ * An existing socket file at the requested path is replaced only if it
+ * refuses connections, as one left behind by a run which was killed does.
+ * Starting fails if another service is listening on the path, or if the path
+ * names a file which is not a socket.
+ *
+ * @param[in] err  Output stream for error messages
+ * @return         Return code
+ ******************************************************************************/
+DrvrReturnCode ServiceServer::Start(std::ostream &err) {
+#ifdef _WIN32
+    err << "Service mode is not supported on this platform" << std::endl;
+    return DRVRERR__SERVICE_UNSUPPORTED;
+#else
+    sockaddr_un addr;
+    std::memset(&addr, 0, sizeof(addr));
+    addr.sun_family = AF_UNIX;
+    if (socket_path_.empty() || socket_path_.size() >= sizeof(addr.sun_path)) {
+        err << "Invalid socket path: " << socket_path_ << std::endl;
+        return DRVRERR__SERVICE_SOCKET;
+    }
+    std::memcpy(addr.sun_path, socket_path_.c_str(), socket_path_.size());
+
+    // Only a socket which refuses connections is stale and may be replaced
+    struct stat st;
+    if (stat(socket_path_.c_str(), &st) == 0 && S_ISSOCK(st.st_mode)) {
+        bool stale = false;
+        const int probe = socket(AF_UNIX, SOCK_STREAM, 0);
+        if (probe >= 0) {
+            stale = connect(
+                        probe, reinterpret_cast<sockaddr *>(&addr), sizeof(addr)
+                    ) != 0
+                 && errno == ECONNREFUSED;
+            close(probe);
+        }
+        if (!stale) {
+            err << "Socket " << socket_path_
+                << " is in use by another service" << std::endl;
+            return DRVRERR__SERVICE_SOCKET;
+        }
+        unlink(socket_path_.c_str());
+    }
+
+    listen_fd_ = socket(AF_UNIX, SOCK_STREAM, 0);
+    const bool bound
+        = listen_fd_ >= 0
+       && bind(listen_fd_, reinterpret_cast<sockaddr *>(&addr), sizeof(addr))
+              == 0;
+    if (!bound || listen(listen_fd_, SOMAXCONN) != 0 || pipe(wake_fds_) != 0) {
+        err << "Failed to listen on " << socket_path_ << ": "
+            << std::strerror(errno) << std::endl;
+        if (listen_fd_ >= 0) {
+            close(listen_fd_);
+            listen_fd_ = -1;
+        }
+        if (bound) {
+            unlink(socket_path_.c_str());
+        }
+        return DRVRERR__SERVICE_SOCKET;
+    }
+
+    // Neither end of the wake pipe blocks: the poller drains it, and a full
+    // pipe already guarantees that the poller wakes
+    fcntl(wake_fds_[0], F_SETFL, O_NONBLOCK);
+    fcntl(wake_fds_[1], F_SETFL, O_NONBLOCK);
+
+    threads_.emplace_back(&ServiceServer::PollLoop, this);
+    for (unsigned int i = 0; i < n_workers_; i++) {
+        threads_.emplace_back(&ServiceServer::WorkerLoop, this);
+    }
+    return DRVR__SUCCESS;
+#endif
+}
+
+/*******************************************************************************
+ * Stop accepting connections, disconnect all clients, and join all threads.
+ *
+ * The socket file is removed. Calling this method more than once is safe.
+ ******************************************************************************/
+void ServiceServer::Stop() {
+#ifndef _WIN32
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (threads_.empty() || stopping_) {
+            return;
+        }
+        stopping_ = true;
+        // Unblock workers waiting on clients which stalled within a frame
+        for (const int fd : active_) {
+            shutdown(fd, SHUT_RDWR);
+        }
+    }
+    ready_.notify_all();
+    Wake();
+    for (std::thread &t : threads_) {
+        t.join();
+    }
+    threads_.clear();
+
+    for (const int fd : idle_) {
+        close(fd);
+    }
+    idle_.clear();
+    for (const int fd : pending_) {
+        close(fd);
+    }
+    pending_.clear();
+    close(listen_fd_);
+    close(wake_fds_[0]);
+    close(wake_fds_[1]);
+    listen_fd_ = wake_fds_[0] = wake_fds_[1] = -1;
+    unlink(socket_path_.c_str());
+#endif
+}
+
+/*******************************************************************************
+ * Interrupt the poller, so that it rebuilds its set of idle connections.
+ ******************************************************************************/
+void ServiceServer::Wake() {
+#ifndef _WIN32
+    const char wake = 1;
+    if (write(wake_fds_[1], &wake, 1) < 0) {
+        // The pipe is full, so the poller is already due to wake
+    }
+#endif
+}
+
+/*******************************************************************************
+ * Accept connections and wait for request frames on idle connections, queuing
+ * those with a frame for the worker threads, until stopped.
+ ******************************************************************************/
+void ServiceServer::PollLoop() {
+#ifndef _WIN32
+    std::vector<pollfd> fds;
+    char drain[64];
+    while (true) {
+        fds.resize(2);
+        fds[0].fd = listen_fd_;
+        fds[1].fd = wake_fds_[0];
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            if (stopping_) {
+                return;
+            }
+            for (const int fd : idle_) {
+                fds.push_back(pollfd());
+                fds.back().fd = fd;
+            }
+        }
+        for (pollfd &p : fds) {
+            p.events = POLLIN;
+            p.revents = 0;
+        }
+        if (poll(fds.data(), fds.size(), -1) < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            return;
+        }
+        if (fds[1].revents != 0) {
+            while (read(wake_fds_[0], drain, sizeof(drain)) > 0) {
+                // Woken by Stop() or by a worker returning a connection
+            }
+        }
+
+        int accepted = -1;
+        if ((fds[0].revents & POLLIN) != 0) {
+            accepted = accept(listen_fd_, nullptr, nullptr);
+    #ifdef SO_NOSIGPIPE
+            if (accepted >= 0) {
+                const int on = 1;
+                setsockopt(
+                    accepted, SOL_SOCKET, SO_NOSIGPIPE, &on, sizeof(on)
+                );
+            }
+    #endif
+        }
+
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (stopping_) {
+            if (accepted >= 0) {
+                close(accepted);
+            }
+            return;
+        }
+        if (accepted >= 0) {
+            idle_.insert(accepted);
+        }
+        // Readable, closed, and failed connections all go to a worker, which
+        // answers the frame or closes the connection
+        for (std::size_t i = 2; i < fds.size(); i++) {
+            if (fds[i].revents != 0) {
+                idle_.erase(fds[i].fd);
+                pending_.push_back(fds[i].fd);
+                ready_.notify_one();
+            }
+        }
+    }
+#endif
+}
+
+/*******************************************************************************
+ * Answer one frame on each queued connection, returning the connection to
+ * the poller afterwards, until stopped. Connections which miss the frame
+ * timeout are closed.
+ ******************************************************************************/
+void ServiceServer::WorkerLoop() {
+#ifndef _WIN32
+    FrameBuffers buffers;
+    while (true) {
+        int fd;
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            ready_.wait(lock, [this] {
+                return stopping_ || !pending_.empty();
+            });
+            if (stopping_) {
+                return;
+            }
+            fd = pending_.front();
+            pending_.pop_front();
+            active_.insert(fd);
+        }
+        const Clock::time_point deadline
+            = Clock::now() + std::chrono::milliseconds(frame_timeout__ms_);
+        const bool keep = ServeFrame(fd, deadline, buffers);
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            active_.erase(fd);
+            if (keep) {
+                idle_.insert(fd);
+            }
+        }
+        if (keep) {
+            Wake();
+        } else {
+            close(fd);
+        }
+    }
+#endif
+}
+
+/*******************************************************************************
+ * Run the service until the process receives SIGINT or SIGTERM.
+ *
+ * @param[in] params  Driver parameters, including the socket path
+ * @param[in] err     Output stream for error messages
+ * @return            Return code
+ ******************************************************************************/
+DrvrReturnCode RunService(const DrvrParams &params, std::ostream &err) {
+#ifdef _WIN32
+    err << "Service mode is not supported on this platform" << std::endl;
+    (void)params;
+    return DRVRERR__SERVICE_UNSUPPORTED;
+#else
+    // Block termination signals in all service threads, then wait for them
+    sigset_t signals, previous;
+    sigemptyset(&signals);
+    sigaddset(&signals, SIGINT);
+    sigaddset(&signals, SIGTERM);
+    pthread_sigmask(SIG_BLOCK, &signals, &previous);
+
+    // Start each configured transport, then serve until signalled
+    const unsigned int n_workers = static_cast<unsigned int>(params.n_workers);
+    ServiceServer server(params.socket_path, n_workers);
+    ShmServer shm_server(params.shm_name, n_workers);
+    DrvrReturnCode rtn = DRVR__SUCCESS;
+    if (!params.socket_path.empty()) {
+        rtn = server.Start(err);
+    }
+    if (rtn == DRVR__SUCCESS && !params.shm_name.empty()) {
+        rtn = shm_server.Start(err);
+    }
+    if (rtn == DRVR__SUCCESS) {
+        int sig;
+        sigwait(&signals, &sig);
+    }
+    shm_server.Stop();
+    server.Stop();
+    pthread_sigmask(SIG_SETMASK, &previous, nullptr);
+    return rtn;
+#endif
+}
@@ -0,0 +1,255 @@
+/** @file ShmService.cpp
+ * Implements the shared-memory transport of the driver service mode.
+ */
+#include "ShmService.h"
+
+#include "Service.h"
+#include "Structs.h"
+
+#include <cerrno>   // for EEXIST, errno
+#include <climits>  // for INT_MAX
+#include <cstddef>  // for std::size_t
+#include <cstdint>  // for std::uint32_t, std::uint64_t
+#include <cstring>  // for std::strerror
+#include <ostream>  // for std::endl, std::ostream
+#include <string>   // for std::string
+#include <thread>   // for std::thread
+
+#ifdef __linux__
+    #include <fcntl.h>     // for O_CREAT, O_EXCL, O_RDWR
+    #include <sys/file.h>  // for flock, LOCK_EX, LOCK_NB
+    #include <sys/mman.h>  // for mmap, munmap, shm_open, shm_unlink
+    #include <unistd.h>    // for close, ftruncate
+#endif
+
+ShmServer::ShmServer(
+    const std::string &name,
+    unsigned int n_workers,
+    std::uint32_t n_slots,
+    std::uint32_t capacity
+):
+    name_(name),
+    n_workers_(n_workers),
+    n_slots_(n_slots),
+    capacity_(capacity),
+    region_(nullptr),
+    size_(0),
+    lock_fd_(-1),
+    header_(nullptr),
+    stopping_(false) {
+    if (n_workers_ == 0) {
+        n_workers_ = std::thread::hardware_concurrency();
+    }
+    if (n_workers_ == 0) {
+        n_workers_ = 1;
+    }
+    if (n_slots_ == 0) {
+        n_slots_ = 2 * n_workers_;
+    }
+}
+
+ShmServer::~ShmServer() {
+    Stop();
+}
+
+/*******************************************************************************
+ * Create and initialize the shared-memory region and start the workers.
+ *
+ * An existing region with the same name is replaced only if no service holds
+ * its lock, as with a region left behind by a run which was killed. Starting
+ * fails if another service is using the region.
+ *
+ * @param[in] err  Output stream for error messages
+ * @return         Return code
+ ******************************************************************************/
+DrvrReturnCode ShmServer::Start(std::ostream &err) {
+#ifdef __linux__
+    const std::uint64_t stride = P2108ShmSlotStride(capacity_);
+    const std::uint64_t offset = P2108_SHM_ALIGNMENT;
+    size_ = static_cast<std::size_t>(offset + n_slots_ * stride);
+
+    // The service holds a lock on its region while it runs, so a region which
+    // can be locked was left behind by a service which exited without stopping
+    int fd = shm_open(name_.c_str(), O_CREAT | O_EXCL | O_RDWR, 0600);
+    if (fd < 0 && errno == EEXIST) {
+        const int existing = shm_open(name_.c_str(), O_RDWR, 0);
+        const bool stale
+            = existing >= 0 && flock(existing, LOCK_EX | LOCK_NB) == 0;
+        if (stale) {
+            shm_unlink(name_.c_str());
+            fd = shm_open(name_.c_str(), O_CREAT | O_EXCL | O_RDWR, 0600);
+        }
+        if (existing >= 0) {
+            close(existing);
+        }
+        if (!stale) {
+            err << "Shared memory " << name_
+                << " is in use by another service" << std::endl;
+            return DRVRERR__SERVICE_SHM;
+        }
+    }
+    if (fd < 0 || flock(fd, LOCK_EX | LOCK_NB) != 0
+        || ftruncate(fd, static_cast<off_t>(size_)) != 0) {
+        err << "Failed to create shared memory " << name_ << ": "
+            << std::strerror(errno) << std::endl;
+        if (fd >= 0) {
+            close(fd);
+            shm_unlink(name_.c_str());
+        }
+        return DRVRERR__SERVICE_SHM;
+    }
+    region_ = mmap(nullptr, size_, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    if (region_ == MAP_FAILED) {
+        err << "Failed to map shared memory " << name_ << ": "
+            << std::strerror(errno) << std::endl;
+        region_ = nullptr;
+        close(fd);
+        shm_unlink(name_.c_str());
+        return DRVRERR__SERVICE_SHM;
+    }
+    lock_fd_ = fd;
+
+    // The region is zero-filled, so all slots start in the FREE state
+    header_ = static_cast<P2108ShmHeader *>(region_);
+    header_->version = P2108_SHM_VERSION;
+    header_->n_slots = n_slots_;
+    header_->capacity = capacity_;
+    header_->slot_offset = offset;
+    header_->slot_stride = stride;
+    __atomic_store_n(&header_->magic, P2108_SHM_MAGIC, __ATOMIC_RELEASE);
+    __atomic_store_n(&stopping_, false, __ATOMIC_RELEASE);
+
+    for (unsigned int i = 0; i < n_workers_; i++) {
+        threads_.emplace_back(&ShmServer::WorkerLoop, this);
+    }
+    return DRVR__SUCCESS;
+#else
+    err << "Shared memory transport is not supported on this platform"
+        << std::endl;
+    return DRVRERR__SERVICE_UNSUPPORTED;
+#endif
+}
+
+/*******************************************************************************
+ * Stop the workers, fail any pending requests, and remove the region.
+ *
+ * Clients which are still connected keep their mapping until they disconnect.
+ * Calling this method more than once is safe.
+ ******************************************************************************/
+void ShmServer::Stop() {
+#ifdef __linux__
+    if (header_ == nullptr) {
+        return;
+    }
+    __atomic_store_n(&stopping_, true, __ATOMIC_RELEASE);
+    __atomic_store_n(&header_->shutdown, 1u, __ATOMIC_RELEASE);
+    __atomic_add_fetch(&header_->request_seq, 1, __ATOMIC_ACQ_REL);
+    P2108ShmWake(&header_->request_seq, INT_MAX);
+    for (std::thread &t : threads_) {
+        t.join();
+    }
+    threads_.clear();
+
+    // Answer requests which no worker picked up, so clients do not hang
+    for (std::uint32_t i = 0; i < n_slots_; i++) {
+        P2108ShmSlot *slot = P2108ShmGetSlot(region_, capacity_, i);
+        std::uint32_t expected = P2108_SHM_SLOT_REQUEST;
+        if (__atomic_compare_exchange_n(
+                &slot->state,
+                &expected,
+                static_cast<std::uint32_t>(P2108_SHM_SLOT_BUSY),
+                false,
+                __ATOMIC_ACQ_REL,
+                __ATOMIC_RELAXED
+            )) {
+            slot->status = P2108_SHM_ERROR_SHUTDOWN;
+            __atomic_store_n(
+                &slot->state,
+                static_cast<std::uint32_t>(P2108_SHM_SLOT_RESPONSE),
+                __ATOMIC_RELEASE
+            );
+        }
+        P2108ShmWake(&slot->state, INT_MAX);
+    }
+    P2108ShmWake(&header_->release_seq, INT_MAX);
+
+    munmap(region_, size_);
+    shm_unlink(name_.c_str());
+    close(lock_fd_);
+    lock_fd_ = -1;
+    region_ = nullptr;
+    header_ = nullptr;
+#endif
+}
+
+/*******************************************************************************
+ * Claim and evaluate submitted slots until the service stops.
+ ******************************************************************************/
+void ShmServer::WorkerLoop() {
+#ifdef __linux__
+    while (true) {
+        // Read the sequence number before scanning, so that a request
+        // submitted during the scan always wakes this worker
+        const std::uint32_t seq
+            = __atomic_load_n(&header_->request_seq, __ATOMIC_ACQUIRE);
+        // Clients can write the shutdown word in the header, so the workers
+        // only stop when this service stops
+        if (__atomic_load_n(&stopping_, __ATOMIC_ACQUIRE)) {
+            return;
+        }
+        bool found = false;
+        for (std::uint32_t i = 0; i < n_slots_; i++) {
+            P2108ShmSlot *slot = P2108ShmGetSlot(region_, capacity_, i);
+            std::uint32_t expected = P2108_SHM_SLOT_REQUEST;
+            if (__atomic_compare_exchange_n(
+                    &slot->state,
+                    &expected,
+                    static_cast<std::uint32_t>(P2108_SHM_SLOT_BUSY),
+                    false,
+                    __ATOMIC_ACQ_REL,
+                    __ATOMIC_RELAXED
+                )) {
+                ServeSlot(i);
+                found = true;
+            }
+        }
+        if (!found) {
+            P2108ShmWait(&header_->request_seq, seq, -1);
+        }
+    }
+#endif
+}
+
+/*******************************************************************************
+ * Evaluate the request in a slot, writing the results in place.
+ *
+ * The client may still write to the slot, so its model and record count are
+ * each read once, and only the values which were checked are used.
+ *
+ * @param[in] slot  Index of a slot in the BUSY state
+ ******************************************************************************/
+void ShmServer::ServeSlot(const std::uint32_t slot) {
+#ifdef __linux__
+    P2108ShmSlot *s = P2108ShmGetSlot(region_, capacity_, slot);
+    P2108ShmBatch batch;
+    P2108ShmGetBatch(region_, capacity_, slot, &batch);
+    const P2108Model model = static_cast<P2108Model>(
+        __atomic_load_n(&s->model, __ATOMIC_RELAXED)
+    );
+    const std::uint32_t count = __atomic_load_n(&s->count, __ATOMIC_RELAXED);
+    if (GetModelInputCount(model) == 0 || count > capacity_) {
+        s->status = P2108_SHM_ERROR_ARGUMENT;
+    } else {
+        EvaluateModelColumns(model, batch.inputs, count, batch.rtn, batch.loss);
+        s->status = P2108_SHM_SUCCESS;
+    }
+    __atomic_store_n(
+        &s->state,
+        static_cast<std::uint32_t>(P2108_SHM_SLOT_RESPONSE),
+        __ATOMIC_RELEASE
+    );
+    P2108ShmWake(&s->state, INT_MAX);
+#else
+    (void)slot;
+#endif
+}
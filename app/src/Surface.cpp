@@ -0,0 +1,56 @@
+/** @file Surface.cpp
+ * Implements the writing of precomputed loss surface files.
+ *
+ * `-surface <file>` tabulates the models on grids spanning their domains,
+ * with `-nodes` nodes along each axis, and writes them to a file which the
+ * library maps with `P2108SurfaceOpen`. The interpolation error bound of
+ * each surface, as recorded in the file header, is written to the output.
+ */
+#include "Driver.h"
+#include "P2108Surface.h"
+
+#include <cstdint>  // for std::uint32_t
+#include <ostream>  // for std::endl, std::ostream
+
+/*******************************************************************************
+ * Write a precomputed loss surface file, and report its error bounds.
+ *
+ * @param[in]  params  Structure with validated user input parameters
+ * @param[out] out     Output stream for the error bounds
+ * @param[out] err     Output stream for error messages
+ * @return             Return code
+ ******************************************************************************/
+int RunSurfaceWriter(
+    const DrvrParams &params, std::ostream &out, std::ostream &err
+) {
+    P2108SurfaceSpec spec;
+    P2108SurfaceDefaultSpec(static_cast<std::uint32_t>(params.n_nodes), &spec);
+    if (P2108SurfaceWrite(params.surface_file.c_str(), &spec)
+        != P2108_SURFACE_SUCCESS) {
+        err << GetDrvrReturnStatusMsg(DRVRERR__WRITING_SURFACE) << std::endl;
+        return DRVRERR__WRITING_SURFACE;
+    }
+
+    // Report the error bounds recorded in the header
+    P2108Surface *surface;
+    if (P2108SurfaceOpen(params.surface_file.c_str(), &surface)
+        != P2108_SURFACE_SUCCESS) {
+        err << GetDrvrReturnStatusMsg(DRVRERR__WRITING_SURFACE) << std::endl;
+        return DRVRERR__WRITING_SURFACE;
+    }
+    const P2108SurfaceHeader *header = P2108SurfaceGetHeader(surface);
+    ReportWriter report(out);
+    report.WriteField("Surface File", ReportWriter::LABEL_WIDTH)
+        .Write(params.surface_file);
+    report.Label("Nodes per Axis").Write(params.n_nodes);
+    report.Label("TSM Median Error").Write(header->tsm_median.max_error);
+    report.Write(" (dB)");
+    report.Label("TSM Sigma Error").Write(header->tsm_sigma.max_error);
+    report.Write(" (dB)");
+    report.Label("ASM Error").Write(header->asm_loss.max_error);
+    report.Write(" (dB)");
+    report.Label("HGTCM Error").Write(header->hgtcm_loss.max_error);
+    report.Write(" (dB)\n");
+    P2108SurfaceClose(surface);
+    return SUCCESS;
+}
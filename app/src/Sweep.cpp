@@ -0,0 +1,629 @@
+/** @file Sweep.cpp
+ * Implements parameter sweeps, which evaluate a model over the Cartesian
+ * product of ranges of its inputs.
+ *
+ * Each input of the model is given a range with `-sweep key=spec`, where
+ * `key` is the input file key of the parameter and `spec` is one of:
+ *
+ * - `start:stop:step`, the values from `start` to `stop` (inclusive) in
+ *   steps of `step`;
+ * - `log:start:stop:count`, `count` logarithmically spaced values from
+ *   `start` to `stop`;
+ * - a comma-separated list of values, or a single value.
+ *
+ * Records are written as a comma-delimited table, with a column for each
+ * input in the order of the model's input file keys, then the return code
+ * and the loss. The last input varies fastest. Terms of the model which
+ * depend on fewer than all of the inputs are computed once for each of their
+ * values, outside the loop over the last input. Records are evaluated and
+ * formatted in parallel, in chunks, and written in order while the next
+ * chunks are evaluated, so sweeps of any size are streamed.
+ */
+#include "Driver.h"
+#include "P2108Kernels.h"
+#include "Tracing.h"
+
+#include <algorithm>  // for std::fill, std::max, std::min, std::replace
+#include <atomic>     // for std::atomic
+#include <cmath>      // for std::floor, std::fmin, std::log, std::pow
+#include <cstddef>    // for std::size_t
+#include <fstream>    // for std::ofstream
+#include <future>     // for std::async, std::future
+#include <limits>     // for std::numeric_limits
+#include <memory>     // for std::unique_ptr
+#include <ostream>    // for std::endl, std::ostream
+#include <string>     // for std::string, std::to_string
+#include <thread>     // for std::thread
+#include <vector>     // for std::vector
+
+namespace {
+/** Approximate number of records in a chunk evaluated by one thread */
+constexpr std::size_t CHUNK_RECORDS = 4096;
+
+/** Number of chunks per thread evaluated before they are written */
+constexpr std::size_t CHUNKS_PER_THREAD = 4;
+
+/** Largest number of values in the range of one input */
+constexpr std::size_t MAX_AXIS_VALUES = 1 << 24;
+
+/** Largest number of records in a sweep, so that counts of lines and chunks
+ *  cannot overflow */
+constexpr std::size_t MAX_SWEEP_RECORDS
+    = std::numeric_limits<std::size_t>::max() / CHUNK_RECORDS;
+
+/*******************************************************************************
+ * @class SweepModel
+ * Evaluates a model over lines of a sweep: the records with the same value
+ * of every input but the last.
+ ******************************************************************************/
+class SweepModel {
+    public:
+        virtual ~SweepModel() = default;
+
+        /***********************************************************************
+         * Evaluate the records of one line.
+         *
+         * @param[in]  index     Index of the value of each input but the last
+         * @param[out] loss__db  Loss of each value of the last input, in dB
+         * @param[out] rtn       Return code of each value of the last input
+         **********************************************************************/
+        virtual void EvaluateLine(
+            const std::size_t *index, double *loss__db, int *rtn
+        ) const = 0;
+};
+
+/*******************************************************************************
+ * @class TSMSweep
+ * Terrestrial Statistical Model over frequency, distance and percentage.
+ ******************************************************************************/
+class TSMSweep: public SweepModel {
+    public:
+        /** Compute the terms of each value of each input */
+        explicit TSMSweep(const std::vector<SweepAxis> &axes):
+            d__km_(axes[1].values) {
+            for (const double f__ghz : axes[0].values) {
+                f_code_.push_back(
+                    Inline::Section3p2_InputValidation(f__ghz, 2, 50)
+                );
+                P_l_.push_back(
+                    std::pow(10, -0.2 * Inline::Equation_4(f__ghz))
+                );
+                P_s_2km_.push_back(
+                    std::pow(10, -0.2 * Inline::Equation_5(f__ghz, 2))
+                );
+                f__ghz_.push_back(f__ghz);
+            }
+            for (const double d__km : d__km_) {
+                d_code_.push_back(
+                    Inline::Section3p2_InputValidation(1, d__km, 50)
+                );
+            }
+            for (const double p : axes[2].values) {
+                p_code_.push_back(Inline::Section3p2_InputValidation(1, 2, p));
+                Q_p_.push_back(
+                    (p_code_.back() == SUCCESS)
+                        ? Inline::InverseComplementaryCumulativeDistribution(
+                              p / 100
+                          )
+                        : 0
+                );
+            }
+        }
+
+        void EvaluateLine(
+            const std::size_t *index, double *L_ctt__db, int *rtn
+        ) const override {
+            const std::size_t i_f = index[0], i_d = index[1];
+            const std::size_t n_p = Q_p_.size();
+            const ReturnCode code
+                = (f_code_[i_f] != SUCCESS) ? f_code_[i_f] : d_code_[i_d];
+            if (code != SUCCESS) {
+                std::fill(rtn, rtn + n_p, code);
+                return;
+            }
+
+            // Median and standard deviation at 2 km and at the distance
+            const double P_l = P_l_[i_f], P_s_2km = P_s_2km_[i_f];
+            const double P_s_d = std::pow(
+                10, -0.2 * Inline::Equation_5(f__ghz_[i_f], d__km_[i_d])
+            );
+            const double median_2km__db
+                = Inline::Equation_3a_Median(P_l, P_s_2km);
+            const double sigma_2km__db = Inline::Equation_3b(P_l, P_s_2km);
+            const double median_d__db = Inline::Equation_3a_Median(P_l, P_s_d);
+            const double sigma_d__db = Inline::Equation_3b(P_l, P_s_d);
+            for (std::size_t k = 0; k < n_p; k++) {
+                rtn[k] = p_code_[k];
+                L_ctt__db[k] = std::fmin(
+                    median_2km__db - sigma_2km__db * Q_p_[k],
+                    median_d__db - sigma_d__db * Q_p_[k]
+                );
+            }
+        }
+    private:
+        std::vector<double> f__ghz_;     /**< Frequency, in GHz */
+        std::vector<ReturnCode> f_code_; /**< Validation of each frequency */
+        std::vector<double> P_l_;        /**< Location loss power */
+        std::vector<double> P_s_2km_;    /**< Slope loss power at 2 km */
+        std::vector<double> d__km_;      /**< Path distance, in km */
+        std::vector<ReturnCode> d_code_; /**< Validation of each distance */
+        std::vector<ReturnCode> p_code_; /**< Validation of each percentage */
+        std::vector<double> Q_p_;        /**< Inverse CCDF of each p / 100 */
+};
+
+/*******************************************************************************
+ * @class ASMSweep
+ * Aeronautical Statistical Model over frequency, elevation angle and
+ * percentage.
+ ******************************************************************************/
+class ASMSweep: public SweepModel {
+    public:
+        /** Compute the terms of each value of each input */
+        explicit ASMSweep(const std::vector<SweepAxis> &axes) {
+            for (const double f__ghz : axes[0].values) {
+                f_code_.push_back(
+                    Inline::Section3p3_InputValidation(f__ghz, 0, 50)
+                );
+                K_1_.push_back(Inline::Equation_7_K_1(f__ghz));
+            }
+            for (const double theta__deg : axes[1].values) {
+                double cot_term, exponent;
+                Inline::Equation_7_AngleTerms(theta__deg, cot_term, exponent);
+                theta_code_.push_back(
+                    Inline::Section3p3_InputValidation(10, theta__deg, 50)
+                );
+                cot_term_.push_back(cot_term);
+                exponent_.push_back(exponent);
+            }
+            for (const double p : axes[2].values) {
+                const ReturnCode code
+                    = Inline::Section3p3_InputValidation(10, 0, p);
+                p_code_.push_back(code);
+                log_q_.push_back(
+                    (code == SUCCESS) ? std::log(1 - p / 100.0) : 0
+                );
+                Q_p_.push_back(
+                    (code == SUCCESS)
+                        ? Inline::InverseComplementaryCumulativeDistribution(
+                              p / 100
+                          )
+                        : 0
+                );
+            }
+        }
+
+        void EvaluateLine(
+            const std::size_t *index, double *L_ces__db, int *rtn
+        ) const override {
+            const std::size_t i_f = index[0], i_theta = index[1];
+            const std::size_t n_p = Q_p_.size();
+            const ReturnCode code = (f_code_[i_f] != SUCCESS)
+                                      ? f_code_[i_f]
+                                      : theta_code_[i_theta];
+            if (code != SUCCESS) {
+                std::fill(rtn, rtn + n_p, code);
+                return;
+            }
+            const double K_1 = K_1_[i_f];
+            const double cot_term = cot_term_[i_theta];
+            const double exponent = exponent_[i_theta];
+            for (std::size_t k = 0; k < n_p; k++) {
+                rtn[k] = p_code_[k];
+                L_ces__db[k] = Inline::Equation_7_Combine(
+                    -K_1 * log_q_[k], cot_term, exponent, Q_p_[k]
+                );
+            }
+        }
+    private:
+        std::vector<ReturnCode> f_code_;     /**< Validation of frequencies */
+        std::vector<double> K_1_;            /**< Equation (7) K_1 */
+        std::vector<ReturnCode> theta_code_; /**< Validation of angles */
+        std::vector<double> cot_term_;       /**< Cotangent term of angles */
+        std::vector<double> exponent_;       /**< Exponent of angles */
+        std::vector<ReturnCode> p_code_;     /**< Validation of percentages */
+        std::vector<double> log_q_;          /**< ln(1 - p / 100) */
+        std::vector<double> Q_p_;            /**< Inverse CCDF of p / 100 */
+};
+
+/*******************************************************************************
+ * @class HGTCMSweep
+ * Height Gain Terminal Correction Model over frequency, antenna height,
+ * street width, clutter height and clutter type.
+ ******************************************************************************/
+class HGTCMSweep: public SweepModel {
+    public:
+        /** Compute the terms of each value of each input */
+        explicit HGTCMSweep(const std::vector<SweepAxis> &axes):
+            h__meter_(axes[1].values),
+            w_s__meter_(axes[2].values),
+            R__meter_(axes[3].values) {
+            for (const double f__ghz : axes[0].values) {
+                f_code_.push_back(
+                    Inline::Section3p1_InputValidation(f__ghz, 1, 1, 1)
+                );
+                K_h2_.push_back(Inline::Equation_2f(f__ghz));
+                K_nu_.push_back(Inline::Equation_2g(f__ghz));
+            }
+            for (const double clutter_type : axes[4].values) {
+                clutter_type_.push_back(
+                    static_cast<ClutterType>(static_cast<int>(clutter_type))
+                );
+            }
+        }
+
+        void EvaluateLine(
+            const std::size_t *index, double *A_h__db, int *rtn
+        ) const override {
+            const std::size_t i_f = index[0];
+            const double h__meter = h__meter_[index[1]];
+            const double w_s__meter = w_s__meter_[index[2]];
+            const double R__meter = R__meter_[index[3]];
+            const std::size_t n_types = clutter_type_.size();
+            ReturnCode code = f_code_[i_f];
+            if (code == SUCCESS) {
+                code = Inline::Section3p1_InputValidation(
+                    1, h__meter, w_s__meter, R__meter
+                );
+            }
+            if (code != SUCCESS) {
+                std::fill(rtn, rtn + n_types, code);
+                return;
+            }
+            for (std::size_t k = 0; k < n_types; k++) {
+                rtn[k] = Inline::HeightGainTerminalCorrectionModelTerms(
+                    K_h2_[i_f],
+                    K_nu_[i_f],
+                    h__meter,
+                    w_s__meter,
+                    R__meter,
+                    clutter_type_[k],
+                    A_h__db[k]
+                );
+            }
+        }
+    private:
+        std::vector<ReturnCode> f_code_;        /**< Validation of f */
+        std::vector<double> K_h2_;              /**< Equation (2f) of f */
+        std::vector<double> K_nu_;              /**< Equation (2g) of f */
+        std::vector<double> h__meter_;          /**< Antenna height */
+        std::vector<double> w_s__meter_;        /**< Street width */
+        std::vector<double> R__meter_;          /**< Clutter height */
+        std::vector<ClutterType> clutter_type_; /**< Clutter type */
+};
+
+/** Get the input file keys of a model, in sweep order */
+std::vector<std::string> SweepKeys(const P2108Model model) {
+    switch (model) {
+        case P2108Model::HGTCM:
+            return {
+                HGTCMInputKeys::f__ghz,
+                HGTCMInputKeys::h__meter,
+                HGTCMInputKeys::w_s__meter,
+                HGTCMInputKeys::R__meter,
+                HGTCMInputKeys::clutter_type
+            };
+        case P2108Model::TSM:
+            return {TSMInputKeys::f__ghz, TSMInputKeys::d__km, TSMInputKeys::p};
+        case P2108Model::ASM:
+            return {
+                ASMInputKeys::f__ghz, ASMInputKeys::theta__deg, ASMInputKeys::p
+            };
+        default:
+            return {};
+    }
+}
+
+/*******************************************************************************
+ * Evaluate and format chunks of a sweep in parallel.
+ *
+ * Each chunk is `lines_per_chunk` consecutive lines. Threads claim chunks
+ * until all have been formatted. The calling thread is one of the
+ * `n_threads` threads.
+ *
+ * @param[in]  model            Model of the sweep
+ * @param[in]  text             Formatted value of each input, with a comma
+ * @param[in]  first_chunk      First chunk to evaluate
+ * @param[in]  lines_per_chunk  Number of lines in each chunk
+ * @param[in]  n_lines          Number of lines in the sweep
+ * @param[out] chunks           Text of each chunk
+ * @param[in]  n_threads        Number of threads
+ ******************************************************************************/
+void FormatChunks(
+    const SweepModel &model,
+    const std::vector<std::vector<std::string>> &text,
+    const std::size_t first_chunk,
+    const std::size_t lines_per_chunk,
+    const std::size_t n_lines,
+    std::vector<std::string> &chunks,
+    const std::size_t n_threads
+) {
+    const std::size_t n_axes = text.size();
+    const std::size_t n_inner = text.back().size();
+    std::atomic<std::size_t> next(0);
+    const auto work = [&]() {
+        std::vector<std::size_t> index(n_axes - 1);
+        std::vector<double> loss__db(n_inner);
+        std::vector<int> rtn(n_inner);
+        std::string prefix;
+        char buf[ReportWriter::MAX_NUMBER_LENGTH];
+        std::size_t c;
+        while ((c = next.fetch_add(1)) < chunks.size()) {
+            std::string &chunk = chunks[c];
+            chunk.clear();
+            const std::size_t start = (first_chunk + c) * lines_per_chunk;
+            const std::size_t end = std::min(start + lines_per_chunk, n_lines);
+            for (std::size_t line = start; line < end; line++) {
+                // Index of each input but the last, the first varying slowest
+                std::size_t rest = line;
+                for (std::size_t a = n_axes - 1; a-- > 0;) {
+                    index[a] = rest % text[a].size();
+                    rest /= text[a].size();
+                }
+                model.EvaluateLine(index.data(), loss__db.data(), rtn.data());
+
+                prefix.clear();
+                for (std::size_t a = 0; a + 1 < n_axes; a++) {
+                    prefix += text[a][index[a]];
+                }
+                for (std::size_t k = 0; k < n_inner; k++) {
+                    chunk += prefix;
+                    chunk += text.back()[k];
+                    chunk += std::to_string(rtn[k]);
+                    chunk += ',';
+                    if (rtn[k] == SUCCESS) {
+                        chunk.append(
+                            buf, ReportWriter::FormatShortest(loss__db[k], buf)
+                        );
+                    }
+                    chunk += '\n';
+                }
+            }
+        }
+    };
+    std::vector<std::thread> threads;
+    for (std::size_t t = 1; t < std::min(n_threads, chunks.size()); t++) {
+        threads.emplace_back(work);
+    }
+    work();
+    for (std::thread &thread : threads) {
+        thread.join();
+    }
+}
+}  // namespace
+
+/*******************************************************************************
+ * Parse the range of one input of a sweep, given as `key=spec`.
+ *
+ * @param[in]  arg   Value of the `-sweep` option
+ * @param[out] axis  Key and values of the input
+ * @return           Return code
+ ******************************************************************************/
+DrvrReturnCode ParseSweepAxis(const std::string &arg, SweepAxis &axis) {
+    const std::size_t eq = arg.find('=');
+    if (eq == std::string::npos || eq == 0) {
+        return DRVRERR__PARSE_SWEEP;
+    }
+    axis.key = arg.substr(0, eq);
+    axis.values.clear();
+
+    // A list of values
+    std::string spec = arg.substr(eq + 1);
+    std::vector<std::string> fields;
+    if (spec.find(':') == std::string::npos) {
+        SplitFields(spec, fields);
+        if (fields.size() > MAX_AXIS_VALUES) {
+            return DRVRERR__PARSE_SWEEP;
+        }
+        for (const std::string &field : fields) {
+            double value;
+            if (ParseDouble(field, value) != DRVR__SUCCESS) {
+                return DRVRERR__PARSE_SWEEP;
+            }
+            axis.values.push_back(value);
+        }
+        return DRVR__SUCCESS;
+    }
+
+    // A range, as start:stop:step or log:start:stop:count
+    std::replace(spec.begin(), spec.end(), ':', ',');
+    SplitFields(spec, fields);
+    std::string kind = fields[0];
+    StringToLower(kind);
+    const bool log_spaced = (kind == "log");
+    if (log_spaced) {
+        fields.erase(fields.begin());
+    }
+    double start, stop, step;
+    if (fields.size() != 3 || ParseDouble(fields[0], start) != DRVR__SUCCESS
+        || ParseDouble(fields[1], stop) != DRVR__SUCCESS) {
+        return DRVRERR__PARSE_SWEEP;
+    }
+    if (log_spaced) {
+        int count;
+        if (ParseInteger(fields[2], count) != DRVR__SUCCESS || count < 1
+            || static_cast<std::size_t>(count) > MAX_AXIS_VALUES
+            || !(start > 0) || !(stop > 0)) {
+            return DRVRERR__PARSE_SWEEP;
+        }
+        const double ratio = stop / start;
+        axis.values.push_back(start);
+        for (int i = 1; i < count - 1; i++) {
+            axis.values.push_back(start * std::pow(ratio, i / (count - 1.0)));
+        }
+        if (count > 1) {
+            axis.values.push_back(stop);
+        }
+        return DRVR__SUCCESS;
+    }
+    if (ParseDouble(fields[2], step) != DRVR__SUCCESS) {
+        return DRVRERR__PARSE_SWEEP;
+    }
+    // Allow for rounding in the number of steps to an inclusive stop
+    const double n_steps = (stop - start) / step;
+    if (!(n_steps >= 0) || !(n_steps < MAX_AXIS_VALUES)) {
+        return DRVRERR__PARSE_SWEEP;
+    }
+    const std::size_t count
+        = static_cast<std::size_t>(std::floor(n_steps + 1e-9)) + 1;
+    for (std::size_t i = 0; i < count; i++) {
+        axis.values.push_back(start + static_cast<double>(i) * step);
+    }
+    return DRVR__SUCCESS;
+}
+
+/*******************************************************************************
+ * Evaluate a model over the Cartesian product of ranges of its inputs, and
+ * write the results as a comma-delimited table.
+ *
+ * @param[in]  model      Model to evaluate: HGTCM, TSM, or ASM
+ * @param[in]  axes       Range of each input of the model, in any order
+ * @param[in]  n_threads  Number of threads, or 0 for all hardware threads
+ * @param[out] os         Output stream for the results
+ * @param[out] err        Output stream for error messages
+ * @return                Return code
+ ******************************************************************************/
+DrvrReturnCode WriteSweep(
+    const P2108Model model,
+    const std::vector<SweepAxis> &axes,
+    const std::size_t n_threads,
+    std::ostream &os,
+    std::ostream &err
+) {
+    // Order the ranges as the inputs of the model
+    const std::vector<std::string> keys = SweepKeys(model);
+    std::vector<SweepAxis> ordered;
+    for (const std::string &key : keys) {
+        for (const SweepAxis &axis : axes) {
+            if (axis.key == key) {
+                ordered.push_back(axis);
+            }
+        }
+    }
+    if (keys.empty() || ordered.size() != keys.size()
+        || axes.size() != keys.size()) {
+        err << GetDrvrReturnStatusMsg(DRVRERR__VALIDATION_SWEEP) << std::endl;
+        return DRVRERR__VALIDATION_SWEEP;
+    }
+
+    // Check each product against the limit before multiplying
+    std::size_t n_records = 1;
+    for (const SweepAxis &axis : ordered) {
+        if (n_records != 0
+            && axis.values.size() > MAX_SWEEP_RECORDS / n_records) {
+            err << GetDrvrReturnStatusMsg(DRVRERR__PARSE_SWEEP)
+                << ": too many records" << std::endl;
+            return DRVRERR__PARSE_SWEEP;
+        }
+        n_records *= axis.values.size();
+    }
+
+    std::unique_ptr<SweepModel> engine;
+    std::string loss_key;
+    switch (model) {
+        case P2108Model::HGTCM:
+            for (const double clutter_type : ordered.back().values) {
+                if (clutter_type != std::floor(clutter_type)) {
+                    err << GetDrvrReturnStatusMsg(DRVRERR__PARSE_CLUTTER_TYPE)
+                        << std::endl;
+                    return DRVRERR__PARSE_CLUTTER_TYPE;
+                }
+            }
+            engine.reset(new HGTCMSweep(ordered));
+            loss_key = "A_h__db";
+            break;
+        case P2108Model::TSM:
+            engine.reset(new TSMSweep(ordered));
+            loss_key = "L_ctt__db";
+            break;
+        default:
+            engine.reset(new ASMSweep(ordered));
+            loss_key = "L_ces__db";
+            break;
+    }
+
+    // Format each input value once
+    std::vector<std::vector<std::string>> text(ordered.size());
+    char buf[ReportWriter::MAX_NUMBER_LENGTH];
+    for (std::size_t a = 0; a < ordered.size(); a++) {
+        for (const double value : ordered[a].values) {
+            text[a].emplace_back(buf, ReportWriter::FormatShortest(value, buf));
+            text[a].back() += ',';
+        }
+        os << ordered[a].key << ',';
+    }
+    os << "rtn," << loss_key << '\n';
+
+    std::size_t n_lines = 1;
+    for (std::size_t a = 0; a + 1 < ordered.size(); a++) {
+        n_lines *= ordered[a].values.size();
+    }
+    const std::size_t lines_per_chunk
+        = std::max<std::size_t>(1, CHUNK_RECORDS / text.back().size());
+    const std::size_t n_chunks
+        = (n_lines + lines_per_chunk - 1) / lines_per_chunk;
+    const std::size_t threads = (n_threads > 0)
+                                  ? n_threads
+                                  : std::max<std::size_t>(
+                                        1, std::thread::hardware_concurrency()
+                                    );
+    const std::size_t round_chunks = threads * CHUNKS_PER_THREAD;
+
+    // Write each round of chunks while the next round is evaluated
+    TraceSpan span("WriteSweep");
+    std::vector<std::string> rounds[2];
+    std::future<void> pending;
+    int b = 0;
+    for (std::size_t first = 0; first < n_chunks; first += round_chunks) {
+        std::vector<std::string> &chunks = rounds[b];
+        chunks.resize(std::min(round_chunks, n_chunks - first));
+        FormatChunks(
+            *engine, text, first, lines_per_chunk, n_lines, chunks, threads
+        );
+        if (pending.valid()) {
+            pending.get();
+        }
+        pending = std::async(std::launch::async, [&os, &chunks]() {
+            for (const std::string &chunk : chunks) {
+                os.write(chunk.data(), chunk.size());
+            }
+        });
+        b ^= 1;
+    }
+    if (pending.valid()) {
+        pending.get();
+    }
+    return DRVR__SUCCESS;
+}
+
+/*******************************************************************************
+ * Run a parameter sweep of the selected model.
+ *
+ * @param[in]  params  Structure with validated user input parameters
+ * @param[out] out     Output stream used when the output file is "-"
+ * @param[out] err     Output stream for error messages
+ * @return             Return code
+ ******************************************************************************/
+int RunSweep(const DrvrParams &params, std::ostream &out, std::ostream &err) {
+    // Open output file for writing, unless writing to the output stream
+    std::ofstream file;
+    if (params.out_file != "-") {
+        file.open(params.out_file);
+        if (!file) {
+            err << "Error opening output file. Exiting." << std::endl;
+            return DRVRERR__OPENING_OUTPUT_FILE;
+        }
+    }
+    std::ostream &fp = file.is_open() ? file : out;
+    const DrvrReturnCode rtn = WriteSweep(
+        params.model,
+        params.sweep,
+        static_cast<std::size_t>(params.n_workers),
+        fp,
+        err
+    );
+    fp.flush();
+    if (rtn != DRVR__SUCCESS) {
+        return rtn;
+    }
+    return SUCCESS;
+}
@@ -2,14 +2,13 @@
  * Implements top-level functions for running the Terrestrial Statistical Model.
  */
 #include "Driver.h"
+#include "Tracing.h"
 
-#include <fstream>   // for std::ifstream, std::ofstream
-#include <iostream>  // for std::cerr
+#include <fstream>   // for std::ifstream
 #include <istream>   // for std::istream
-#include <ostream>   // for std::endl
+#include <ostream>   // for std::endl, std::ostream
 #include <string>    // for std::string
 #include <tuple>     // for std::tie
-#include <vector>    // for std::vector
 
 // Define the input keys
 const std::string TSMInputKeys::f__ghz = "f__ghz";
@@ -24,16 +23,12 @@ const std::string TSMInputKeys::p = "p";
  * @return                 Return code
  ******************************************************************************/
 ReturnCode CallTerrestrialStatisticalModel(
-    TSMParams &tsm_params, std::vector<double> &L_ctt__db
+    TSMParams &tsm_params, double &L_ctt__db
 ) {
-    ReturnCode rtn;
-    double L_ctt;
-    rtn = TerrestrialStatisticalModel(
-        tsm_params.f__ghz, tsm_params.d__km, tsm_params.p, L_ctt
+    TraceSpan span("CallTerrestrialStatisticalModel");
+    return TerrestrialStatisticalModel(
+        tsm_params.f__ghz, tsm_params.d__km, tsm_params.p, L_ctt__db
     );
-    L_ctt__db.push_back(L_ctt);
-
-    return rtn;
 }
 
 /*******************************************************************************
@@ -41,10 +36,13 @@ ReturnCode CallTerrestrialStatisticalModel(
  * 
  * @param[in]  stream      Input stream containing TSM parameters
  * @param[out] tsm_params  TSM input parameter struct
+ * @param[out] err         Output stream for error messages
  * @return                 Return code
  ******************************************************************************/
-DrvrReturnCode
-    ParseTSMInputStream(std::istream &stream, TSMParams &tsm_params) {
+DrvrReturnCode ParseTSMInputStream(
+    std::istream &stream, TSMParams &tsm_params, std::ostream &err
+) {
+    TraceSpan span("ParseTSMInputStream");
     CommaSeparatedIterator it(stream);
     DrvrReturnCode rtn = DRVR__SUCCESS;
     std::string key, value;
@@ -63,12 +61,12 @@ DrvrReturnCode
             if (rtn == DRVRERR__PARSE)
                 rtn = DRVRERR__PARSE_PERCENTAGE;
         } else {
-            std::cerr << "Unknown parameter: " << key << std::endl;
+            err << "Unknown parameter: " << key << std::endl;
             rtn = DRVRERR__PARSE;
         }
 
         if (rtn != DRVR__SUCCESS) {
-            std::cerr << GetDrvrReturnStatusMsg(rtn) << std::endl;
+            err << GetDrvrReturnStatusMsg(rtn) << std::endl;
             return rtn;
         }
         ++it;
@@ -81,26 +79,31 @@ DrvrReturnCode
  * 
  * @param[in]  in_file     Path to TSM input parameter file
  * @param[out] tsm_params  TSM input parameter struct
+ * @param[out] err         Output stream for error messages
  * @return                 Return code
  ******************************************************************************/
-DrvrReturnCode
-    ParseTSMInputFile(const std::string &in_file, TSMParams &tsm_params) {
+DrvrReturnCode ParseTSMInputFile(
+    const std::string &in_file, TSMParams &tsm_params, std::ostream &err
+) {
     std::ifstream file(in_file);
     if (!file) {
-        std::cerr << "Failed to open file " << in_file << std::endl;
+        err << "Failed to open file " << in_file << std::endl;
         return DRVRERR__OPENING_INPUT_FILE;
     }
-    return ParseTSMInputStream(file, tsm_params);
+    return ParseTSMInputStream(file, tsm_params, err);
 }
 
 /*******************************************************************************
  * Write Terrestrial Statistical Model inputs to the report file
  * 
- * @param[in] fp      Output stream, a text file open for writing
+ * @param[in] fp      Report writer for the output file
  * @param[in] params  TSM input parameter struct
  ******************************************************************************/
-void WriteTSMInputs(std::ofstream &fp, const TSMParams &params) {
-    fp PRINT TSMInputKeys::f__ghz SETW13 params.f__ghz << "(gigahertz)";
-    fp PRINT TSMInputKeys::d__km SETW13 params.d__km << "(kilometers)";
-    fp PRINT TSMInputKeys::p SETW13 params.p << "(%)";
+void WriteTSMInputs(ReportWriter &fp, const TSMParams &params) {
+    constexpr int w = ReportWriter::VALUE_WIDTH;
+    fp.Label(TSMInputKeys::f__ghz).WriteField(params.f__ghz, w);
+    fp.Write("(gigahertz)");
+    fp.Label(TSMInputKeys::d__km).WriteField(params.d__km, w);
+    fp.Write("(kilometers)");
+    fp.Label(TSMInputKeys::p).WriteField(params.p, w).Write("(%)");
 }
\ No newline at end of file
@@ -0,0 +1,222 @@
+/** @file Tracing.cpp
+ * Implements span tracing for the driver and its Chrome trace JSON export.
+ */
+#include "Tracing.h"
+
+#include <algorithm>  // for std::sort
+#include <iomanip>    // for std::fixed, std::setprecision
+#include <utility>    // for std::pair
+
+thread_local Tracer *Tracer::active_ = nullptr;
+
+namespace {
+/** Source of unique tracer identifiers */
+std::atomic<std::uint64_t> next_tracer_id(1);
+
+/** Round a capacity up to a power of two, with a minimum of 2 */
+std::size_t RoundCapacity(const std::size_t capacity) {
+    std::size_t rounded = 2;
+    while (rounded < capacity) {
+        rounded <<= 1;
+    }
+    return rounded;
+}
+
+/** Write a string as a JSON string literal */
+void WriteJsonString(std::ostream &os, const char *str) {
+    os << '"';
+    for (const char *c = str; *c != '\0'; c++) {
+        if (*c == '"' || *c == '\\') {
+            os << '\\' << *c;
+        } else if (static_cast<unsigned char>(*c) < 0x20) {
+            os << ' ';
+        } else {
+            os << *c;
+        }
+    }
+    os << '"';
+}
+}  // namespace
+
+/*******************************************************************************
+ * Constructor for a per-thread ring buffer.
+ *
+ * @param[in] capacity   Number of events kept, rounded up to a power of two
+ * @param[in] thread_id  Thread index to report in the trace
+ ******************************************************************************/
+TraceBuffer::TraceBuffer(const std::size_t capacity, const int thread_id):
+    events_(RoundCapacity(capacity)),
+    mask_(events_.size() - 1),
+    head_(0),
+    thread_id_(thread_id) {}
+
+/*******************************************************************************
+ * Append an event, overwriting the oldest event if the buffer is full.
+ *
+ * Must only be called by the thread which owns the buffer.
+ *
+ * @param[in] event  Event to record
+ ******************************************************************************/
+void TraceBuffer::Record(const TraceEvent &event) {
+    const std::uint64_t head = head_.load(std::memory_order_relaxed);
+    events_[head & mask_] = event;
+    head_.store(head + 1, std::memory_order_release);
+}
+
+/*******************************************************************************
+ * Copy the retained events, oldest first.
+ *
+ * Intended to be called once the owning thread has stopped recording. Events
+ * recorded concurrently with this call may or may not be included.
+ *
+ * @return  Retained events
+ ******************************************************************************/
+std::vector<TraceEvent> TraceBuffer::GetEvents() const {
+    const std::uint64_t head = head_.load(std::memory_order_acquire);
+    const std::uint64_t n = std::min<std::uint64_t>(head, events_.size());
+    std::vector<TraceEvent> events;
+    events.reserve(static_cast<std::size_t>(n));
+    for (std::uint64_t i = head - n; i < head; i++) {
+        events.push_back(events_[i & mask_]);
+    }
+    return events;
+}
+
+/*******************************************************************************
+ * Get the thread index reported in the trace.
+ *
+ * @return  Thread index, starting from 1 in order of first use
+ ******************************************************************************/
+int TraceBuffer::GetThreadId() const {
+    return thread_id_;
+}
+
+/*******************************************************************************
+ * Constructor for a tracer. The time origin of the trace is set to now.
+ *
+ * @param[in] capacity  Number of events kept per thread
+ ******************************************************************************/
+Tracer::Tracer(const std::size_t capacity):
+    capacity_(capacity),
+    id_(next_tracer_id.fetch_add(1)),
+    start_(std::chrono::steady_clock::now()) {}
+
+/*******************************************************************************
+ * Record an event in the buffer of the calling thread.
+ *
+ * @param[in] name   Span name, which must outlive the tracer
+ * @param[in] phase  'B' for the start of a span, or 'E' for its end
+ ******************************************************************************/
+void Tracer::Record(const char *name, const char phase) {
+    const auto elapsed = std::chrono::steady_clock::now() - start_;
+    TraceEvent event;
+    event.name = name;
+    event.t__ns = static_cast<std::uint64_t>(
+        std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count()
+    );
+    event.phase = phase;
+    GetThreadBuffer()->Record(event);
+}
+
+/*******************************************************************************
+ * Get the buffer of the calling thread, creating it on first use.
+ *
+ * The mutex is only taken the first time a thread records into this tracer;
+ * later calls hit a per-thread cache keyed on the tracer identifier.
+ *
+ * @return  Buffer owned by the calling thread
+ ******************************************************************************/
+TraceBuffer *Tracer::GetThreadBuffer() {
+    static thread_local std::uint64_t cached_id = 0;
+    static thread_local TraceBuffer *cached_buffer = nullptr;
+    if (cached_id != id_) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        buffers_.emplace_back(new TraceBuffer(
+            capacity_, static_cast<int>(buffers_.size()) + 1
+        ));
+        cached_buffer = buffers_.back().get();
+        cached_id = id_;
+    }
+    return cached_buffer;
+}
+
+/*******************************************************************************
+ * Write all retained events in the Chrome trace event format.
+ *
+ * Events are written as "B" and "E" duration events with timestamps in
+ * microseconds, preceded by a "thread_name" metadata event for each thread.
+ * Spans whose begin event was overwritten in the ring buffer are dropped.
+ *
+ * @param[in] os  Stream to write the JSON document to
+ ******************************************************************************/
+void Tracer::WriteChromeTrace(std::ostream &os) const {
+    std::vector<std::pair<int, std::vector<TraceEvent>>> threads;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        for (const std::unique_ptr<TraceBuffer> &buffer : buffers_) {
+            threads.emplace_back(buffer->GetThreadId(), buffer->GetEvents());
+        }
+    }
+
+    const std::ios_base::fmtflags flags = os.flags();
+    const std::streamsize precision = os.precision();
+    os << std::fixed << std::setprecision(3);
+    os << "{\"traceEvents\":[";
+    bool first = true;
+    for (const auto &thread : threads) {
+        os << (first ? "\n" : ",\n");
+        first = false;
+        os << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":"
+           << thread.first << ",\"args\":{\"name\":\""
+           << (thread.first == 1 ? "main" : "worker") << ' ' << thread.first
+           << "\"}}";
+
+        // Skip end events whose begin events were overwritten
+        int depth = 0;
+        for (const TraceEvent &event : thread.second) {
+            if (event.phase == 'E') {
+                if (depth == 0) {
+                    continue;
+                }
+                depth--;
+            } else {
+                depth++;
+            }
+            os << ",\n{\"name\":";
+            WriteJsonString(os, event.name);
+            os << ",\"ph\":\"" << event.phase << "\",\"ts\":"
+               << static_cast<double>(event.t__ns) / 1e3
+               << ",\"pid\":1,\"tid\":" << thread.first << '}';
+        }
+    }
+    os << "\n],\"displayTimeUnit\":\"ns\"}\n";
+    os.flags(flags);
+    os.precision(precision);
+}
+
+/*******************************************************************************
+ * Get the tracer which spans on the calling thread are recorded into.
+ *
+ * @return  Installed tracer, or `nullptr` if tracing is off on this thread
+ ******************************************************************************/
+Tracer *Tracer::GetActive() {
+    return active_;
+}
+
+/*******************************************************************************
+ * Install a tracer on the calling thread until this session is destroyed.
+ *
+ * Sessions on one thread nest, so each restores the tracer it replaced.
+ *
+ * @param[in] tracer  Tracer to install, which must outlive the session
+ ******************************************************************************/
+TraceSession::TraceSession(Tracer *tracer): previous_(Tracer::active_) {
+    Tracer::active_ = tracer;
+}
+
+/*******************************************************************************
+ * Restore the tracer which was installed before this session.
+ ******************************************************************************/
+TraceSession::~TraceSession() {
+    Tracer::active_ = previous_;
+}
@@ -0,0 +1,451 @@
+/** @file TrackReplay.cpp
+ * Implements the replay of aircraft tracks through the Aeronautical
+ * Statistical Model.
+ *
+ * A track replay file is a comma-delimited table of samples, in time order.
+ * Its first line names the columns. Each sample gives a `track` ID (any
+ * text, such as an ICAO address), an optional `time` which is copied to the
+ * output, and the elevation angle of the aircraft, either as `theta__deg` or
+ * as the positions of the aircraft (`lat__deg`, `lon__deg`, `alt__meter`)
+ * and of the ground station (`station_lat__deg`, `station_lon__deg`,
+ * `station_alt__meter`). The frequency `f__ghz` and percentage `p` of a
+ * track are required on its first sample, and may be left empty on later
+ * samples to keep the values of the track.
+ *
+ * Samples are read and evaluated in chunks, so files of any length are
+ * streamed, and results are written as a comma-delimited table in the order
+ * of the input samples.
+ */
+#include "Driver.h"
+#include "P2108Tracks.h"
+#include "Tracing.h"
+
+#include <cstddef>        // for std::size_t
+#include <cstdint>        // for std::uint64_t
+#include <fstream>        // for std::ifstream, std::ofstream
+#include <istream>        // for std::istream, std::getline
+#include <ostream>        // for std::endl, std::ostream
+#include <string>         // for std::string
+#include <unordered_map>  // for std::unordered_map
+#include <vector>         // for std::vector
+
+// Define the column names of track replay files
+const std::string TrackReplayKeys::track = "track";
+const std::string TrackReplayKeys::time = "time";
+const std::string TrackReplayKeys::lat__deg = "lat__deg";
+const std::string TrackReplayKeys::lon__deg = "lon__deg";
+const std::string TrackReplayKeys::alt__meter = "alt__meter";
+const std::string TrackReplayKeys::station_lat__deg = "station_lat__deg";
+const std::string TrackReplayKeys::station_lon__deg = "station_lon__deg";
+const std::string TrackReplayKeys::station_alt__meter = "station_alt__meter";
+
+namespace {
+/** Number of samples read before they are evaluated and written */
+constexpr std::size_t CHUNK_SIZE = 4096;
+
+/** Column of each parameter in a track replay file, or -1 if absent */
+struct TrackReplayColumns {
+        int track = -1;              /**< Track ID */
+        int time = -1;               /**< Time of the sample */
+        int f__ghz = -1;             /**< Frequency, in GHz */
+        int p = -1;                  /**< Percentage of locations */
+        int theta__deg = -1;         /**< Elevation angle, in degrees */
+        int lat__deg = -1;           /**< Aircraft latitude, in degrees */
+        int lon__deg = -1;           /**< Aircraft longitude, in degrees */
+        int alt__meter = -1;         /**< Aircraft altitude, in meters */
+        int station_lat__deg = -1;   /**< Station latitude, in degrees */
+        int station_lon__deg = -1;   /**< Station longitude, in degrees */
+        int station_alt__meter = -1; /**< Station altitude, in meters */
+};
+
+/** State of one track, as last set from the file */
+struct TrackState {
+        const std::string *name; /**< Name of the track in the file */
+        std::uint64_t id;        /**< ID of the track in the replay */
+        double f__ghz;           /**< Frequency, in GHz */
+        double p;                /**< Percentage of locations */
+        int rtn;                 /**< Result of setting the track */
+};
+
+/** Get a field of a row, or an empty field if the column is absent */
+const std::string &GetField(
+    const std::vector<std::string> &fields, const int column
+) {
+    static const std::string empty;
+    return (column >= 0 && static_cast<std::size_t>(column) < fields.size())
+             ? fields[column]
+             : empty;
+}
+
+/*******************************************************************************
+ * @class TrackReplayer
+ * Parses the samples of a track replay file, and evaluates and writes them
+ * in chunks.
+ ******************************************************************************/
+class TrackReplayer {
+    public:
+        /** Create an empty replay writing to a report */
+        explicit TrackReplayer(ReportWriter &fp):
+            fp_(fp), replay_(P2108TrackReplayCreate()) {}
+
+        TrackReplayer(const TrackReplayer &) = delete;
+        TrackReplayer &operator=(const TrackReplayer &) = delete;
+
+        /** Free the replay */
+        ~TrackReplayer() {
+            P2108TrackReplayFree(replay_);
+        }
+
+        /** Map the column names of the file to their positions */
+        DrvrReturnCode ParseHeader(
+            const std::vector<std::string> &names, std::ostream &err
+        );
+
+        /** Parse one sample, evaluating the pending samples as needed */
+        DrvrReturnCode ParseSample(const std::vector<std::string> &fields);
+
+        /** Evaluate and write the pending samples */
+        void Flush();
+    private:
+        /** Find or set the track of a sample */
+        DrvrReturnCode SetTrack(
+            const std::vector<std::string> &fields, TrackState *&state
+        );
+
+        /** Parse the elevation angle of a sample */
+        DrvrReturnCode ParseAngle(
+            const std::vector<std::string> &fields, double &theta__deg
+        ) const;
+
+        ReportWriter &fp_;           /**< Report writer for the results */
+        P2108TrackReplay *replay_;   /**< Terms of each track */
+        TrackReplayColumns columns_; /**< Position of each known column */
+        std::unordered_map<std::string, TrackState> tracks_; /**< By name */
+
+        // Pending samples, in input order
+        std::vector<const std::string *> names_; /**< Track of each */
+        std::vector<std::string> times_;         /**< Time of each */
+        std::vector<std::uint64_t> ids_;         /**< Track ID of each */
+        std::vector<int> track_rtn_;             /**< Track status of each */
+        std::vector<double> theta__deg_;         /**< Elevation of each */
+        std::vector<double> L_ces__db_;          /**< Clutter loss of each */
+        std::vector<int> rtn_;                   /**< Return code of each */
+};
+
+/*******************************************************************************
+ * Map the column names of a track replay file to their positions.
+ *
+ * @param[in]  names  Column names, from the first line of the file
+ * @param[out] err    Output stream for error messages
+ * @return            Return code
+ ******************************************************************************/
+DrvrReturnCode TrackReplayer::ParseHeader(
+    const std::vector<std::string> &names, std::ostream &err
+) {
+    TrackReplayColumns &c = columns_;
+    for (std::size_t i = 0; i < names.size(); i++) {
+        std::string name = names[i];
+        StringToLower(name);
+        int *column = nullptr;
+        if (name == TrackReplayKeys::track) {
+            column = &c.track;
+        } else if (name == TrackReplayKeys::time) {
+            column = &c.time;
+        } else if (name == ASMInputKeys::f__ghz) {
+            column = &c.f__ghz;
+        } else if (name == ASMInputKeys::p) {
+            column = &c.p;
+        } else if (name == ASMInputKeys::theta__deg) {
+            column = &c.theta__deg;
+        } else if (name == TrackReplayKeys::lat__deg) {
+            column = &c.lat__deg;
+        } else if (name == TrackReplayKeys::lon__deg) {
+            column = &c.lon__deg;
+        } else if (name == TrackReplayKeys::alt__meter) {
+            column = &c.alt__meter;
+        } else if (name == TrackReplayKeys::station_lat__deg) {
+            column = &c.station_lat__deg;
+        } else if (name == TrackReplayKeys::station_lon__deg) {
+            column = &c.station_lon__deg;
+        } else if (name == TrackReplayKeys::station_alt__meter) {
+            column = &c.station_alt__meter;
+        } else {
+            err << "Unknown column: " << names[i] << std::endl;
+            return DRVRERR__PARSE;
+        }
+        *column = static_cast<int>(i);
+    }
+    if (c.track < 0) {
+        err << "Missing column: " << TrackReplayKeys::track << std::endl;
+        return DRVRERR__PARSE_TRACK;
+    }
+    if (c.theta__deg < 0
+        && (c.lat__deg < 0 || c.lon__deg < 0 || c.alt__meter < 0
+            || c.station_lat__deg < 0 || c.station_lon__deg < 0
+            || c.station_alt__meter < 0)) {
+        err << "Missing column: " << ASMInputKeys::theta__deg
+            << ", or the aircraft and station positions" << std::endl;
+        return DRVRERR__PARSE_THETA;
+    }
+    fp_.Write("track,time,rtn,L_ces__db\n");
+    return DRVR__SUCCESS;
+}
+
+/*******************************************************************************
+ * Find the track of a sample, and set its terms if they are new or changed.
+ *
+ * Pending samples are evaluated before the terms of one of their tracks are
+ * changed, so that each sample uses the terms in effect when it was read.
+ *
+ * @param[in]  fields  Fields of the row
+ * @param[out] state   State of the track
+ * @return             Return code
+ ******************************************************************************/
+DrvrReturnCode TrackReplayer::SetTrack(
+    const std::vector<std::string> &fields, TrackState *&state
+) {
+    const std::string &name = GetField(fields, columns_.track);
+    if (name.empty()) {
+        return DRVRERR__PARSE_TRACK;
+    }
+    const auto found = tracks_.find(name);
+    const bool is_new = (found == tracks_.end());
+    double f__ghz = is_new ? 0 : found->second.f__ghz;
+    double p = is_new ? 0 : found->second.p;
+    const std::string &f_field = GetField(fields, columns_.f__ghz);
+    const std::string &p_field = GetField(fields, columns_.p);
+    if ((is_new || !f_field.empty())
+        && ParseDouble(f_field, f__ghz) != DRVR__SUCCESS) {
+        return DRVRERR__PARSE_FREQ;
+    }
+    if ((is_new || !p_field.empty())
+        && ParseDouble(p_field, p) != DRVR__SUCCESS) {
+        return DRVRERR__PARSE_PERCENTAGE;
+    }
+
+    if (!is_new) {
+        state = &found->second;
+        if (f__ghz == state->f__ghz && p == state->p) {
+            return DRVR__SUCCESS;
+        }
+        Flush();
+    } else {
+        const std::uint64_t id = tracks_.size();
+        const auto added = tracks_.emplace(name, TrackState()).first;
+        state = &added->second;
+        state->name = &added->first;
+        state->id = id;
+    }
+    state->f__ghz = f__ghz;
+    state->p = p;
+    state->rtn = P2108TrackReplaySetTrack(
+        replay_, state->id, f__ghz, p, ABRAMOWITZ_STEGUN
+    );
+    if (state->rtn != P2108_TRACK_SUCCESS) {
+        P2108TrackReplayRemoveTrack(replay_, state->id);
+    }
+    return DRVR__SUCCESS;
+}
+
+/*******************************************************************************
+ * Parse the elevation angle of a sample, or compute it from the positions.
+ *
+ * @param[in]  fields      Fields of the row
+ * @param[out] theta__deg  Elevation angle, in degrees
+ * @return                 Return code
+ ******************************************************************************/
+DrvrReturnCode TrackReplayer::ParseAngle(
+    const std::vector<std::string> &fields, double &theta__deg
+) const {
+    const TrackReplayColumns &c = columns_;
+    if (c.theta__deg >= 0) {
+        return (ParseDouble(GetField(fields, c.theta__deg), theta__deg)
+                == DRVR__SUCCESS)
+                 ? DRVR__SUCCESS
+                 : DRVRERR__PARSE_THETA;
+    }
+    const int position_columns[] = {
+        c.station_lat__deg,
+        c.station_lon__deg,
+        c.station_alt__meter,
+        c.lat__deg,
+        c.lon__deg,
+        c.alt__meter
+    };
+    double position[6];
+    for (int i = 0; i < 6; i++) {
+        if (ParseDouble(GetField(fields, position_columns[i]), position[i])
+            != DRVR__SUCCESS) {
+            return DRVRERR__PARSE_POSITION;
+        }
+    }
+    theta__deg = P2108ElevationAngle(
+        position[0],
+        position[1],
+        position[2],
+        position[3],
+        position[4],
+        position[5]
+    );
+    return DRVR__SUCCESS;
+}
+
+/*******************************************************************************
+ * Parse one sample of a track replay file.
+ *
+ * @param[in] fields  Fields of the row
+ * @return            Return code
+ ******************************************************************************/
+DrvrReturnCode TrackReplayer::ParseSample(
+    const std::vector<std::string> &fields
+) {
+    TrackState *state;
+    DrvrReturnCode rtn = SetTrack(fields, state);
+    double theta__deg = 0;
+    if (rtn == DRVR__SUCCESS) {
+        rtn = ParseAngle(fields, theta__deg);
+    }
+    if (rtn != DRVR__SUCCESS) {
+        return rtn;
+    }
+    names_.push_back(state->name);
+    times_.push_back(GetField(fields, columns_.time));
+    ids_.push_back(state->id);
+    track_rtn_.push_back(state->rtn);
+    theta__deg_.push_back(theta__deg);
+    if (ids_.size() == CHUNK_SIZE) {
+        Flush();
+    }
+    return DRVR__SUCCESS;
+}
+
+/*******************************************************************************
+ * Evaluate the pending samples, and write their results.
+ *
+ * Each line gives the track, time, return code and clutter loss in dB. The
+ * loss is empty where the return code is not `SUCCESS`. Samples of tracks
+ * with an invalid frequency or percentage get the error of their track.
+ ******************************************************************************/
+void TrackReplayer::Flush() {
+    const std::size_t n = ids_.size();
+    if (n == 0) {
+        return;
+    }
+    TraceSpan span("EvaluateTrackSamples");
+    L_ces__db_.resize(n);
+    rtn_.resize(n);
+    P2108TrackReplayEvaluate(
+        replay_,
+        n,
+        ids_.data(),
+        theta__deg_.data(),
+        L_ces__db_.data(),
+        rtn_.data()
+    );
+    for (std::size_t i = 0; i < n; i++) {
+        const int rtn
+            = (track_rtn_[i] != P2108_TRACK_SUCCESS) ? track_rtn_[i] : rtn_[i];
+        fp_.Write(*names_[i]).Write(',').Write(times_[i]).Write(',');
+        fp_.Write(rtn).Write(',');
+        if (rtn == SUCCESS) {
+            fp_.Write(L_ces__db_[i]);
+        }
+        fp_.Write('\n');
+    }
+    names_.clear();
+    times_.clear();
+    ids_.clear();
+    track_rtn_.clear();
+    theta__deg_.clear();
+}
+}  // namespace
+
+/*******************************************************************************
+ * Replay a stream of aircraft track samples, writing the result of each.
+ *
+ * The results of samples before a parse error are written.
+ *
+ * @param[in]  stream  Input stream containing the track replay file
+ * @param[out] fp      Report writer for the results
+ * @param[out] err     Output stream for error messages
+ * @return             Return code
+ ******************************************************************************/
+DrvrReturnCode ReplayTrackStream(
+    std::istream &stream, ReportWriter &fp, std::ostream &err
+) {
+    TraceSpan span("ReplayTrackStream");
+    fp.SetNumberFormat(NumberFormat::SHORTEST, 0);
+    TrackReplayer replayer(fp);
+    std::string line;
+    std::vector<std::string> fields;
+    DrvrReturnCode rtn = DRVR__SUCCESS;
+    bool have_header = false;
+    std::size_t line_number = 0;
+    while (std::getline(stream, line)) {
+        line_number++;
+        if (line.find_first_not_of(" \t\r") == std::string::npos) {
+            continue;  // Skip blank lines
+        }
+        SplitFields(line, fields);
+        if (!have_header) {
+            rtn = replayer.ParseHeader(fields, err);
+            have_header = true;
+        } else {
+            rtn = replayer.ParseSample(fields);
+        }
+        if (rtn != DRVR__SUCCESS) {
+            err << "Error on line " << line_number << ": "
+                << GetDrvrReturnStatusMsg(rtn) << std::endl;
+            break;
+        }
+    }
+    replayer.Flush();
+    return rtn;
+}
+
+/*******************************************************************************
+ * Run an aircraft track replay, after the command line has been validated.
+ *
+ * @param[in]  params  Validated driver parameters
+ * @param[in]  in      Input stream, read when the input file is "-"
+ * @param[out] out     Output stream, written when the output file is "-"
+ * @param[out] err     Output stream for error messages
+ * @return             Return code
+ ******************************************************************************/
+int RunTrackReplay(
+    const DrvrParams &params,
+    std::istream &in,
+    std::ostream &out,
+    std::ostream &err
+) {
+    std::ifstream in_file;
+    if (params.in_file != "-") {
+        in_file.open(params.in_file);
+        if (!in_file) {
+            err << "Failed to open file " << params.in_file << std::endl;
+            return DRVRERR__OPENING_INPUT_FILE;
+        }
+    }
+    std::istream &stream = in_file.is_open() ? in_file : in;
+
+    // Open output file for writing, unless writing to the output stream
+    std::ofstream file;
+    if (params.out_file != "-") {
+        file.open(params.out_file);
+        if (!file) {
+            err << "Error opening output file. Exiting." << std::endl;
+            return DRVRERR__OPENING_OUTPUT_FILE;
+        }
+    }
+    std::ostream &fp = file.is_open() ? file : out;
+    DrvrReturnCode rtn;
+    {
+        ReportWriter report(fp);
+        rtn = ReplayTrackStream(stream, report, err);
+    }
+    fp.flush();
+    if (rtn != DRVR__SUCCESS) {
+        return rtn;
+    }
+    return SUCCESS;
+}
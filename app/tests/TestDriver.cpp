@@ -7,25 +7,20 @@
 
 TEST_F(DriverTest, MissingOptionError1) {
     // Test case: missing option between two provided flags
-    std::string cmd = executable + " -i -o out.txt";
-    SuppressOutputs(cmd);
-    int rtn = RunCommand(cmd);
+    int rtn = RunDriverWithArgs({"-i", "-o", "out.txt"});
     EXPECT_EQ(DRVRERR__MISSING_OPTION, rtn);
 }
 
 TEST_F(DriverTest, MissingOptionError2) {
     // Test case: missing option at the end of command
-    std::string cmd = executable + " -i";
-    SuppressOutputs(cmd);
-    int rtn = RunCommand(cmd);
+    int rtn = RunDriverWithArgs({"-i"});
     EXPECT_EQ(DRVRERR__MISSING_OPTION, rtn);
 }
 
 TEST_F(DriverTest, InvalidOptionError) {
-    std::string cmd = executable + " -X";
-    SuppressOutputs(cmd);
-    int rtn = RunCommand(cmd);
+    int rtn = RunDriverWithArgs({"-X"});
     EXPECT_EQ(DRVRERR__INVALID_OPTION, rtn);
+    EXPECT_NE(err_text.find("Unknown option: -X"), std::string::npos);
 }
 
 TEST_F(DriverTest, OpeningInputFileError) {
@@ -45,24 +40,44 @@ TEST_F(DriverTest, OpeningOutputFileError) {
 }
 
 TEST_F(DriverTest, ValidationInFileError) {
-    std::string cmd = executable + " -o out.txt -model ASM";
-    SuppressOutputs(cmd);
-    int rtn = RunCommand(cmd);
+    int rtn = RunDriverWithArgs({"-o", "out.txt", "-model", "ASM"});
     EXPECT_EQ(DRVRERR__VALIDATION_IN_FILE, rtn);
 }
 
 TEST_F(DriverTest, ValidationOutFileError) {
     // Input file does not need to exist here, just has to be specified
-    std::string cmd = executable + " -i in.txt -model ASM";
-    SuppressOutputs(cmd);
-    int rtn = RunCommand(cmd);
+    int rtn = RunDriverWithArgs({"-i", "in.txt", "-model", "ASM"});
     EXPECT_EQ(DRVRERR__VALIDATION_OUT_FILE, rtn);
 }
 
 TEST_F(DriverTest, ValidationModelError) {
     // Input file does not need to exist here, just has to be specified
-    std::string cmd = executable + " -i in.txt -o out.txt";
-    SuppressOutputs(cmd);
-    int rtn = RunCommand(cmd);
+    int rtn = RunDriverWithArgs({"-i", "in.txt", "-o", "out.txt"});
     EXPECT_EQ(rtn, DRVRERR__VALIDATION_MODEL);
 }
+
+TEST_F(DriverTest, StreamInputOutput) {
+    // Read inputs from the input stream and write the report to the output
+    std::string inputs = "f__ghz,10\ntheta__deg,10.5\np,45";
+    int rtn
+        = RunDriverWithArgs({"-i", "-", "-model", "ASM", "-o", "-"}, inputs);
+    EXPECT_EQ(rtn, SUCCESS);
+    EXPECT_NE(
+        out_text.find("Aeronautical Statistical Model"), std::string::npos
+    );
+    EXPECT_NE(out_text.find("Clutter loss"), std::string::npos);
+    EXPECT_TRUE(err_text.empty());
+}
+
+TEST_F(DriverTest, VersionOutput) {
+    int rtn = RunDriverWithArgs({"-v"});
+    EXPECT_EQ(rtn, SUCCESS);
+    EXPECT_NE(out_text.find("Driver Version"), std::string::npos);
+}
+
+TEST_F(DriverTest, ExecutableShim) {
+    // The executable passes its arguments and exit code through unchanged
+    std::string cmd = executable + " -X";
+    SuppressOutputs(cmd);
+    EXPECT_EQ(RunCommand(cmd), DRVRERR__INVALID_OPTION);
+}
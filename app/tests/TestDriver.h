@@ -15,7 +15,9 @@
 #include <cstdlib>   // for std::system
 #include <iostream>  // for std::cout
 #include <ostream>   // for std::endl, std::flush
+#include <sstream>   // for std::istringstream, std::ostringstream
 #include <string>    // for std::string
+#include <vector>    // for std::vector
 
 #ifndef _WIN32
     #include <unistd.h>  // for WEXITSTATUS
@@ -26,7 +28,9 @@
  * Test fixture for running the driver executable tests.
  * 
  * This class extends the Google Test framework's Test class and provides
- * utilities to set up, execute, and manage the output of the driver executable.
+ * utilities to set up, execute, and manage the output of the driver. The
+ * driver is run in-process through `RunDriver`; the executable itself is only
+ * run by tests of the `main` shim.
  ******************************************************************************/
 class DriverTest: public ::testing::Test {
     protected:
@@ -59,44 +63,53 @@ class DriverTest: public ::testing::Test {
         }
 
         /***********************************************************************
-         * Builds the command string to run the driver.
+         * Builds the command line arguments to run the driver.
          * 
-         * Constructs a command string using the provided driver parameters
-         * struct. Optionally, the command can be written such that stdout and
-         * are suppressed.
+         * Constructs the argument list using the provided driver parameters
+         * struct.
          * 
-         * @param[in] dParams          The driver parameters
-         * @param[in] suppressOutputs  Whether to suppress outputs (default: true)
-         * @return                     The constructed command string
+         * @param[in] dParams  The driver parameters
+         * @return             The constructed arguments
          **********************************************************************/
-        std::string BuildCommand(
-            const DrvrParams &dParams, const bool suppressOutputs = true
-        ) {
-            // Construct command from parameters
-            std::string command = executable;
-            command += " -i " + dParams.in_file;
+        std::vector<std::string> BuildArguments(const DrvrParams &dParams) {
+            std::vector<std::string> args = {"-i", dParams.in_file};
             switch (dParams.model) {
                 case P2108Model::HGTCM:
-                    command += " -model HGTCM";
+                    args.insert(args.end(), {"-model", "HGTCM"});
                     break;
                 case P2108Model::TSM:
-                    command += " -model TSM";
+                    args.insert(args.end(), {"-model", "TSM"});
                     break;
                 case P2108Model::ASM:
-                    command += " -model ASM";
+                    args.insert(args.end(), {"-model", "ASM"});
                     break;
-                default:  // avoid compile-time warning. command will be invalid if this runs.
+                default:  // avoid compile-time warning. arguments will be invalid if this runs.
                     break;
             }
-            command += " -o " + dParams.out_file;
+            args.insert(args.end(), {"-o", dParams.out_file});
+            return args;
+        }
 
-            // Suppress text output of the driver, to avoid cluttering
-            // test outputs.
-            if (suppressOutputs) {
-                SuppressOutputs(command);
-            }
-            // Return the full command string
-            return command;
+        /***********************************************************************
+         * Runs the driver in-process with the given arguments.
+         * 
+         * Text written by the driver is captured in `out_text` and
+         * `err_text`, to avoid cluttering test outputs.
+         * 
+         * @param[in] args     Command line arguments
+         * @param[in] in_text  Contents of the driver's input stream
+         * @return             Return code from the driver execution
+         **********************************************************************/
+        int RunDriverWithArgs(
+            const std::vector<std::string> &args,
+            const std::string &in_text = ""
+        ) {
+            std::istringstream in(in_text);
+            std::ostringstream out, err;
+            const int rtn = ::RunDriver(args, in, out, err);
+            out_text = out.str();
+            err_text = err.str();
+            return rtn;
         }
 
         /***********************************************************************
@@ -119,14 +132,13 @@ class DriverTest: public ::testing::Test {
         }
 
         /***********************************************************************
-         * Runs the driver executable.
+         * Runs the driver.
          * 
          * @param[in] dParams  Parameters to parse as command line arguments
          * @return             Return code from the driver execution
          **********************************************************************/
         int RunDriver(const DrvrParams &dParams) {
-            std::string cmd = BuildCommand(dParams);
-            return RunCommand(cmd);
+            return RunDriverWithArgs(BuildArguments(dParams));
         }
 
         /***********************************************************************
@@ -182,4 +194,10 @@ class DriverTest: public ::testing::Test {
 
         /** Driver parameters struct which may be used by tests */
         DrvrParams params;
+
+        /** Text written to the output stream by the last driver run */
+        std::string out_text;
+
+        /** Text written to the error stream by the last driver run */
+        std::string err_text;
 };
@@ -0,0 +1,109 @@
+#include "TestDriver.h"
+
+#include <sstream>  // for std::istringstream
+#include <string>   // for std::getline, std::stod, std::string
+#include <vector>   // for std::vector
+
+/*******************************************************************************
+ * Driver test fixture for mixed-model batch files
+ ******************************************************************************/
+class MixedDriverTest: public DriverTest {
+    protected:
+        /** Run a mixed-model batch read from standard input */
+        int RunMixed(const std::string &inputs) {
+            return RunDriverWithArgs(
+                {"-i", "-", "-model", "MIXED", "-o", "-"}, inputs
+            );
+        }
+
+        /** Split the output of the last run into lines */
+        std::vector<std::string> OutputLines() {
+            std::istringstream stream(out_text);
+            std::vector<std::string> lines;
+            std::string line;
+            while (std::getline(stream, line)) {
+                lines.push_back(line);
+            }
+            return lines;
+        }
+
+        /** Check an output line of a successful row */
+        void ExpectLine(
+            const std::string &line,
+            const std::string &prefix,
+            const double loss__db
+        ) {
+            ASSERT_EQ(line.compare(0, prefix.size(), prefix), 0) << line;
+            EXPECT_EQ(std::stod(line.substr(prefix.size())), loss__db);
+        }
+};
+
+TEST_F(MixedDriverTest, TestRowOrder) {
+    const std::string inputs
+        = "model,f__ghz,d__km,theta__deg,p,h__meter,w_s__meter,r__meter,"
+          "clutter_type\n"
+          "TSM,26.6,15.8,,45,,,,\n"
+          "ASM,26.6,,15.8,45,,,,\n"
+          "hgtcm,1.5,,,,2,27,15,3\n"
+          "TSM,26.6,0.1,,45,,,,\n"
+          "asm,26.6,,31.2,45,,,,\n";
+    EXPECT_EQ(RunMixed(inputs), SUCCESS);
+
+    double tsm, aero, hgtcm, aero2;
+    ASSERT_EQ(TerrestrialStatisticalModel(26.6, 15.8, 45, tsm), SUCCESS);
+    ASSERT_EQ(AeronauticalStatisticalModel(26.6, 15.8, 45, aero), SUCCESS);
+    ASSERT_EQ(
+        HeightGainTerminalCorrectionModel(
+            1.5, 2, 27, 15, ClutterType::SUBURBAN, hgtcm
+        ),
+        SUCCESS
+    );
+    ASSERT_EQ(AeronauticalStatisticalModel(26.6, 31.2, 45, aero2), SUCCESS);
+
+    // Results are in the order of the input rows; invalid rows have no loss
+    const std::vector<std::string> lines = OutputLines();
+    ASSERT_EQ(lines.size(), 6u);
+    EXPECT_EQ(lines[0], "row,model,rtn,loss__db");
+    ExpectLine(lines[1], "1,TSM,0,", tsm);
+    ExpectLine(lines[2], "2,ASM,0,", aero);
+    ExpectLine(lines[3], "3,HGTCM,0,", hgtcm);
+    EXPECT_EQ(lines[4], "4,TSM," + std::to_string(ERROR32__DISTANCE) + ",");
+    ExpectLine(lines[5], "5,ASM,0,", aero2);
+}
+
+TEST_F(MixedDriverTest, TestColumnsInAnyOrder) {
+    const std::string inputs = "p, d__km, model, f__ghz\n"
+                               "\n"
+                               "45, 15.8, TSM, 26.6\r\n";
+    EXPECT_EQ(RunMixed(inputs), SUCCESS);
+    double tsm;
+    TerrestrialStatisticalModel(26.6, 15.8, 45, tsm);
+    const std::vector<std::string> lines = OutputLines();
+    ASSERT_EQ(lines.size(), 2u);
+    ExpectLine(lines[1], "1,TSM,0,", tsm);
+}
+
+TEST_F(MixedDriverTest, TestParseErrors) {
+    EXPECT_EQ(RunMixed("f__ghz,d__km,p\n"), DRVRERR__PARSE_MODEL);
+    EXPECT_EQ(RunMixed("model,unknown\n"), DRVRERR__PARSE);
+    EXPECT_EQ(RunMixed("model,f__ghz\nITM,1\n"), DRVRERR__PARSE_MODEL);
+    EXPECT_EQ(
+        RunMixed("model,f__ghz,d__km,p\nTSM,26.6,,45\n"),
+        DRVRERR__PARSE_PATH_DIST
+    );
+    EXPECT_NE(err_text.find("line 2"), std::string::npos);
+    EXPECT_EQ(
+        RunMixed("model,f__ghz,theta__deg\nASM,26.6,15.8\n"),
+        DRVRERR__PARSE_PERCENTAGE
+    );
+    EXPECT_EQ(
+        RunMixed("model,f__ghz,h__meter,w_s__meter,r__meter,clutter_type\n"
+                 "HGTCM,1.5,2,27,15,urban\n"),
+        DRVRERR__PARSE_CLUTTER_TYPE
+    );
+}
+
+TEST_F(MixedDriverTest, TestEmptyBatch) {
+    EXPECT_EQ(RunMixed("model,f__ghz,d__km,p\n"), SUCCESS);
+    EXPECT_EQ(out_text, "row,model,rtn,loss__db\n");
+}
@@ -0,0 +1,34 @@
+/** @file TestDriverSurface.cpp
+ * Tests for writing precomputed loss surface files with the driver
+ */
+#include "TempTextFile.h"
+#include "TestDriver.h"
+
+#include "P2108Surface.h"
+
+#include <string>  // for std::string
+
+TEST_F(DriverTest, TestSurfaceWriter) {
+    const TempTextFile temp("");
+    const std::string path = temp.getFileName();
+    ASSERT_EQ(RunDriverWithArgs({"-surface", path, "-nodes", "8"}), SUCCESS);
+    EXPECT_NE(out_text.find("ASM Error"), std::string::npos);
+
+    P2108Surface *surface;
+    ASSERT_EQ(P2108SurfaceOpen(path.c_str(), &surface), P2108_SURFACE_SUCCESS);
+    const P2108SurfaceHeader *header = P2108SurfaceGetHeader(surface);
+    EXPECT_EQ(header->spec.tsm_f__ghz.count, 8u);
+    EXPECT_EQ(header->spec.hgtcm_nu.count, 8u);
+    P2108SurfaceClose(surface);
+}
+
+TEST_F(DriverTest, TestSurfaceWriterErrors) {
+    EXPECT_EQ(
+        RunDriverWithArgs({"-surface", "tmp.p2108", "-nodes", "1"}),
+        DRVRERR__VALIDATION_NODES
+    );
+    EXPECT_EQ(
+        RunDriverWithArgs({"-surface", "no_such_directory/tmp.p2108"}),
+        DRVRERR__WRITING_SURFACE
+    );
+}
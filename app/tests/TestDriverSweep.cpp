@@ -0,0 +1,311 @@
+#include "TestDriver.h"
+
+#include <cstddef>  // for std::size_t
+#include <sstream>  // for std::istringstream
+#include <string>   // for std::getline, std::stod, std::stoi, std::string
+#include <vector>   // for std::vector
+
+/*******************************************************************************
+ * Driver test fixture for parameter sweeps
+ ******************************************************************************/
+class SweepDriverTest: public DriverTest {
+    protected:
+        /** Split the output of the last run into rows of fields */
+        std::vector<std::vector<std::string>> OutputRows() {
+            std::istringstream stream(out_text);
+            std::vector<std::vector<std::string>> rows;
+            std::string line;
+            while (std::getline(stream, line)) {
+                rows.emplace_back();
+                SplitFields(line, rows.back());
+            }
+            return rows;
+        }
+
+        /** Check a result row against the return code and loss of a model */
+        void ExpectResult(
+            const std::vector<std::string> &row,
+            const ReturnCode rtn,
+            const double loss__db
+        ) {
+            ASSERT_GE(row.size(), 2u);
+            const std::size_t n = row.size();
+            EXPECT_EQ(std::stoi(row[n - 2]), rtn);
+            if (rtn == SUCCESS) {
+                EXPECT_EQ(std::stod(row[n - 1]), loss__db);
+            } else {
+                EXPECT_EQ(row[n - 1], "");
+            }
+        }
+};
+
+TEST_F(SweepDriverTest, TestParseSweepAxis) {
+    SweepAxis axis;
+    EXPECT_EQ(ParseSweepAxis("f__ghz=0.5:2:0.5", axis), DRVR__SUCCESS);
+    EXPECT_EQ(axis.key, "f__ghz");
+    EXPECT_EQ(axis.values, std::vector<double>({0.5, 1, 1.5, 2}));
+
+    // The stop is included despite rounding in the steps
+    EXPECT_EQ(ParseSweepAxis("p=0.1:0.3:0.1", axis), DRVR__SUCCESS);
+    EXPECT_EQ(axis.values.size(), 3u);
+    EXPECT_EQ(ParseSweepAxis("p=5:1:-2", axis), DRVR__SUCCESS);
+    EXPECT_EQ(axis.values, std::vector<double>({5, 3, 1}));
+
+    EXPECT_EQ(ParseSweepAxis("d__km=LOG:1:100:3", axis), DRVR__SUCCESS);
+    ASSERT_EQ(axis.values.size(), 3u);
+    EXPECT_EQ(axis.values[0], 1);
+    EXPECT_NEAR(axis.values[1], 10, 1e-12);
+    EXPECT_EQ(axis.values[2], 100);
+    EXPECT_EQ(ParseSweepAxis("d__km=log:2:100:1", axis), DRVR__SUCCESS);
+    EXPECT_EQ(axis.values, std::vector<double>({2}));
+
+    EXPECT_EQ(ParseSweepAxis("clutter_type=1, 4,6", axis), DRVR__SUCCESS);
+    EXPECT_EQ(axis.values, std::vector<double>({1, 4, 6}));
+    EXPECT_EQ(ParseSweepAxis("p=50", axis), DRVR__SUCCESS);
+    EXPECT_EQ(axis.values, std::vector<double>({50}));
+
+    for (const char *bad :
+         {"p", "=1", "p=", "p=1,,2", "p=1:2", "p=1:2:0", "p=2:1:1",
+          "p=1:2:3:4", "p=log:0:1:3", "p=log:1:2:0", "p=log:1:2:x",
+          "p=0:1:1e-12"}) {
+        EXPECT_EQ(ParseSweepAxis(bad, axis), DRVRERR__PARSE_SWEEP) << bad;
+    }
+}
+
+TEST_F(SweepDriverTest, TestTerrestrialSweep) {
+    const int rtn = RunDriverWithArgs(
+        {"-model",
+         "TSM",
+         "-sweep",
+         "p=1:99:1",
+         "-sweep",
+         "f__ghz=0.25,0.5:67:0.5",
+         "-sweep",
+         "d__km=0.1,log:0.25:50:4",
+         "-o",
+         "-"}
+    );
+    // A list with a range is not a valid list
+    EXPECT_EQ(rtn, DRVRERR__PARSE_SWEEP);
+
+    ASSERT_EQ(
+        RunDriverWithArgs(
+            {"-model",
+             "TSM",
+             "-sweep",
+             "p=0:100:1",
+             "-sweep",
+             "f__ghz=0.5:67:0.5",
+             "-sweep",
+             "d__km=log:0.125:50:4",
+             "-workers",
+             "1",
+             "-o",
+             "-"}
+        ),
+        SUCCESS
+    );
+    const std::vector<std::vector<std::string>> rows = OutputRows();
+    const std::size_t n_f = 134, n_d = 4, n_p = 101;
+    ASSERT_EQ(rows.size(), 1 + n_f * n_d * n_p);
+    const std::vector<std::string> header
+        = {"f__ghz", "d__km", "p", "rtn", "L_ctt__db"};
+    EXPECT_EQ(rows[0], header);
+    std::size_t n_valid = 0;
+    for (std::size_t r = 1; r < rows.size(); r++) {
+        const std::vector<std::string> &row = rows[r];
+        ASSERT_EQ(row.size(), 5u);
+        // The first input varies slowest, and the last fastest
+        const std::size_t i = r - 1;
+        EXPECT_EQ(std::stod(row[0]), 0.5 + 0.5 * (i / (n_d * n_p)));
+        EXPECT_EQ(std::stod(row[2]), static_cast<double>(i % n_p));
+        double L_ctt__db = 0;
+        const ReturnCode expected = TerrestrialStatisticalModel(
+            std::stod(row[0]), std::stod(row[1]), std::stod(row[2]), L_ctt__db
+        );
+        ExpectResult(row, expected, L_ctt__db);
+        n_valid += (expected == SUCCESS) ? 1 : 0;
+    }
+    EXPECT_EQ(n_valid, n_f * (n_d - 1) * (n_p - 2));
+
+    // The output does not depend on the number of threads
+    const std::string single = out_text;
+    ASSERT_EQ(
+        RunDriverWithArgs(
+            {"-model",
+             "TSM",
+             "-sweep",
+             "f__ghz=0.5:67:0.5",
+             "-sweep",
+             "d__km=log:0.125:50:4",
+             "-sweep",
+             "p=0:100:1",
+             "-workers",
+             "5",
+             "-o",
+             "-"}
+        ),
+        SUCCESS
+    );
+    EXPECT_EQ(out_text, single);
+}
+
+TEST_F(SweepDriverTest, TestAeronauticalSweep) {
+    ASSERT_EQ(
+        RunDriverWithArgs(
+            {"-model",
+             "ASM",
+             "-sweep",
+             "f__ghz=5,10,26.6,100",
+             "-sweep",
+             "theta__deg=-1:91:0.5",
+             "-sweep",
+             "p=log:0.01:99.99:40",
+             "-o",
+             "-"}
+        ),
+        SUCCESS
+    );
+    const std::vector<std::vector<std::string>> rows = OutputRows();
+    ASSERT_EQ(rows.size(), 1u + 4 * 185 * 40);
+    EXPECT_EQ(rows[0].back(), "L_ces__db");
+    for (std::size_t r = 1; r < rows.size(); r++) {
+        const std::vector<std::string> &row = rows[r];
+        double L_ces__db = 0;
+        const ReturnCode expected = AeronauticalStatisticalModel(
+            std::stod(row[0]), std::stod(row[1]), std::stod(row[2]), L_ces__db
+        );
+        ExpectResult(row, expected, L_ces__db);
+    }
+}
+
+TEST_F(SweepDriverTest, TestHeightGainSweep) {
+    ASSERT_EQ(
+        RunDriverWithArgs(
+            {"-model",
+             "HGTCM",
+             "-sweep",
+             "f__ghz=0.01,1.5,3",
+             "-sweep",
+             "h__meter=0:30:2.5",
+             "-sweep",
+             "w_s__meter=0,27",
+             "-sweep",
+             "r__meter=10,20",
+             "-sweep",
+             "clutter_type=0:7:1",
+             "-o",
+             "-"}
+        ),
+        SUCCESS
+    );
+    const std::vector<std::vector<std::string>> rows = OutputRows();
+    ASSERT_EQ(rows.size(), 1u + 3 * 13 * 2 * 2 * 8);
+    EXPECT_EQ(rows[0].back(), "A_h__db");
+    for (std::size_t r = 1; r < rows.size(); r++) {
+        const std::vector<std::string> &row = rows[r];
+        double A_h__db = 0;
+        const ReturnCode expected = HeightGainTerminalCorrectionModel(
+            std::stod(row[0]),
+            std::stod(row[1]),
+            std::stod(row[2]),
+            std::stod(row[3]),
+            static_cast<ClutterType>(std::stoi(row[4])),
+            A_h__db
+        );
+        ExpectResult(row, expected, A_h__db);
+    }
+}
+
+TEST_F(SweepDriverTest, TestSweepValidation) {
+    // Every input of the model is required, once
+    EXPECT_EQ(
+        RunDriverWithArgs(
+            {"-model", "TSM", "-sweep", "f__ghz=1", "-sweep", "p=50", "-o", "-"}
+        ),
+        DRVRERR__VALIDATION_SWEEP
+    );
+    EXPECT_EQ(
+        RunDriverWithArgs(
+            {"-model",
+             "TSM",
+             "-sweep",
+             "f__ghz=1",
+             "-sweep",
+             "d__km=1",
+             "-sweep",
+             "p=50",
+             "-sweep",
+             "p=60",
+             "-o",
+             "-"}
+        ),
+        DRVRERR__VALIDATION_SWEEP
+    );
+    EXPECT_EQ(
+        RunDriverWithArgs(
+            {"-model",
+             "TSM",
+             "-sweep",
+             "f__ghz=1",
+             "-sweep",
+             "d__km=1",
+             "-sweep",
+             "theta__deg=50",
+             "-o",
+             "-"}
+        ),
+        DRVRERR__VALIDATION_SWEEP
+    );
+    EXPECT_EQ(
+        RunDriverWithArgs({"-model", "MIXED", "-sweep", "f__ghz=1", "-o", "-"}),
+        DRVRERR__VALIDATION_SWEEP
+    );
+    EXPECT_EQ(
+        RunDriverWithArgs(
+            {"-model",
+             "HGTCM",
+             "-sweep",
+             "f__ghz=1",
+             "-sweep",
+             "h__meter=1",
+             "-sweep",
+             "w_s__meter=1",
+             "-sweep",
+             "r__meter=1",
+             "-sweep",
+             "clutter_type=1.5",
+             "-o",
+             "-"}
+        ),
+        DRVRERR__PARSE_CLUTTER_TYPE
+    );
+    EXPECT_EQ(
+        RunDriverWithArgs({"-model", "TSM", "-sweep", "f__ghz=1:2", "-o", "-"}),
+        DRVRERR__PARSE_SWEEP
+    );
+
+    // The number of records (2^64 here) must not overflow, and nothing is
+    // written when it is too large
+    const std::string many = "=1:65536:1";
+    EXPECT_EQ(
+        RunDriverWithArgs(
+            {"-model",
+             "HGTCM",
+             "-sweep",
+             "f__ghz" + many,
+             "-sweep",
+             "h__meter" + many,
+             "-sweep",
+             "w_s__meter" + many,
+             "-sweep",
+             "r__meter" + many,
+             "-sweep",
+             "clutter_type=1",
+             "-o",
+             "-"}
+        ),
+        DRVRERR__PARSE_SWEEP
+    );
+    EXPECT_EQ(out_text, "");
+}
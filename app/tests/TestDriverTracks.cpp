@@ -0,0 +1,140 @@
+#include "TestDriver.h"
+
+#include "P2108Tracks.h"
+
+#include <sstream>  // for std::istringstream, std::ostringstream
+#include <string>   // for std::getline, std::stod, std::string
+#include <vector>   // for std::vector
+
+/*******************************************************************************
+ * Driver test fixture for aircraft track replays
+ ******************************************************************************/
+class TracksDriverTest: public DriverTest {
+    protected:
+        /** Run a track replay read from standard input */
+        int RunTracks(const std::string &inputs) {
+            return RunDriverWithArgs(
+                {"-i", "-", "-model", "TRACKS", "-o", "-"}, inputs
+            );
+        }
+
+        /** Split the output of the last run into lines */
+        std::vector<std::string> OutputLines() {
+            std::istringstream stream(out_text);
+            std::vector<std::string> lines;
+            std::string line;
+            while (std::getline(stream, line)) {
+                lines.push_back(line);
+            }
+            return lines;
+        }
+
+        /** Check an output line of a successful sample */
+        void ExpectLine(
+            const std::string &line,
+            const std::string &prefix,
+            const double L_ces__db
+        ) {
+            ASSERT_EQ(line.compare(0, prefix.size(), prefix), 0) << line;
+            EXPECT_EQ(std::stod(line.substr(prefix.size())), L_ces__db);
+        }
+};
+
+TEST_F(TracksDriverTest, TestInterleavedTracks) {
+    const std::string inputs = "track,time,f__ghz,p,theta__deg\n"
+                               "A1B2C3,0.0,26.6,45,15.8\n"
+                               "4CA123,0.5,55.5,10,31.2\n"
+                               "A1B2C3,1.0,,,16.1\n"
+                               "4CA123,1.5,55.5,,-2\n"
+                               "A1B2C3,2.0,30,50,16.4\n";
+    EXPECT_EQ(RunTracks(inputs), SUCCESS);
+
+    double L1, L2, L3, L5;
+    AeronauticalStatisticalModel(26.6, 15.8, 45, L1);
+    AeronauticalStatisticalModel(55.5, 31.2, 10, L2);
+    AeronauticalStatisticalModel(26.6, 16.1, 45, L3);
+    AeronauticalStatisticalModel(30, 16.4, 50, L5);
+
+    // Empty inputs keep the values of the track; changes apply from then on
+    const std::vector<std::string> lines = OutputLines();
+    ASSERT_EQ(lines.size(), 6u);
+    EXPECT_EQ(lines[0], "track,time,rtn,L_ces__db");
+    ExpectLine(lines[1], "A1B2C3,0.0,0,", L1);
+    ExpectLine(lines[2], "4CA123,0.5,0,", L2);
+    ExpectLine(lines[3], "A1B2C3,1.0,0,", L3);
+    EXPECT_EQ(lines[4], "4CA123,1.5," + std::to_string(ERROR33__THETA) + ",");
+    ExpectLine(lines[5], "A1B2C3,2.0,0,", L5);
+}
+
+TEST_F(TracksDriverTest, TestPositions) {
+    const std::string inputs
+        = "track,lat__deg,lon__deg,alt__meter,station_lat__deg,"
+          "station_lon__deg,station_alt__meter,f__ghz,p\n"
+          "N123,45.45,7,10000,45,7,0,26.6,45\n";
+    EXPECT_EQ(RunTracks(inputs), SUCCESS);
+    double L_ces__db;
+    AeronauticalStatisticalModel(
+        26.6, P2108ElevationAngle(45, 7, 0, 45.45, 7, 10000), 45, L_ces__db
+    );
+    const std::vector<std::string> lines = OutputLines();
+    ASSERT_EQ(lines.size(), 2u);
+    ExpectLine(lines[1], "N123,,0,", L_ces__db);
+}
+
+TEST_F(TracksDriverTest, TestInvalidTrackInputs) {
+    EXPECT_EQ(
+        RunTracks("track,f__ghz,p,theta__deg\nX,5,45,10\nX,,,20\n"), SUCCESS
+    );
+    const std::string code = std::to_string(ERROR33__FREQUENCY);
+    const std::vector<std::string> lines = OutputLines();
+    ASSERT_EQ(lines.size(), 3u);
+    EXPECT_EQ(lines[1], "X,," + code + ",");
+    EXPECT_EQ(lines[2], "X,," + code + ",");
+}
+
+TEST_F(TracksDriverTest, TestLongReplay) {
+    // Samples span several chunks
+    std::ostringstream inputs;
+    inputs << "track,f__ghz,p,theta__deg\n";
+    const int n = 10000;
+    for (int i = 0; i < n; i++) {
+        inputs << "T" << i % 37 << ",26.6,45," << (i % 90) << "\n";
+    }
+    EXPECT_EQ(RunTracks(inputs.str()), SUCCESS);
+    const std::vector<std::string> lines = OutputLines();
+    ASSERT_EQ(lines.size(), static_cast<std::size_t>(n + 1));
+    double L_ces__db;
+    AeronauticalStatisticalModel(26.6, 9999 % 90, 45, L_ces__db);
+    ExpectLine(lines[n], "T" + std::to_string(9999 % 37) + ",,0,", L_ces__db);
+}
+
+TEST_F(TracksDriverTest, TestParseErrors) {
+    EXPECT_EQ(RunTracks("f__ghz,p,theta__deg\n"), DRVRERR__PARSE_TRACK);
+    EXPECT_EQ(RunTracks("track,f__ghz,p\n"), DRVRERR__PARSE_THETA);
+    EXPECT_EQ(RunTracks("track,unknown\n"), DRVRERR__PARSE);
+    EXPECT_EQ(
+        RunTracks("track,f__ghz,p,theta__deg\n,26.6,45,10\n"),
+        DRVRERR__PARSE_TRACK
+    );
+    EXPECT_EQ(
+        RunTracks("track,f__ghz,p,theta__deg\nA,,45,10\n"),
+        DRVRERR__PARSE_FREQ
+    );
+    EXPECT_EQ(
+        RunTracks(
+            "track,f__ghz,p,theta__deg\nA,26.6,45,10\nB,26.6,45,x\n"
+        ),
+        DRVRERR__PARSE_THETA
+    );
+    EXPECT_NE(err_text.find("line 3"), std::string::npos);
+    // Samples before the error are written
+    EXPECT_EQ(OutputLines().size(), 2u);
+    EXPECT_EQ(
+        RunTracks(
+            "track,lat__deg,lon__deg,alt__meter,station_lat__deg,"
+            "station_lon__deg,station_alt__meter,f__ghz,p\n"
+            "A,45,7,,45,7,0,26.6,45\n"
+        ),
+        DRVRERR__PARSE_POSITION
+    );
+}
@@ -0,0 +1,107 @@
+/** @file TestReportWriter.cpp
+ * Tests for the buffered report writer used by the driver
+ */
+// clang-format off
+// GoogleTest must be included first
+#include <gtest/gtest.h>  // GoogleTest
+// clang-format on
+
+#include "ReportWriter.h"
+
+#include <cstddef>  // for std::size_t
+#include <iomanip>  // for std::left, std::setprecision, std::setw
+#include <ios>      // for std::fixed
+#include <random>   // for std::mt19937, std::uniform_real_distribution
+#include <sstream>  // for std::ostringstream
+#include <string>   // for std::string
+#include <vector>   // for std::vector
+
+/*******************************************************************************
+ * Format a value with `std::ostream`, for comparison with the report writer
+ ******************************************************************************/
+std::string StreamFixed(const double value, const int precision) {
+    std::ostringstream oss;
+    oss << std::fixed << std::setprecision(precision) << value;
+    return oss.str();
+}
+
+std::string WriterFixed(const double value, const int precision) {
+    std::ostringstream oss;
+    {
+        ReportWriter writer(oss);
+        writer.SetNumberFormat(NumberFormat::FIXED, precision);
+        writer.Write(value);
+    }
+    return oss.str();
+}
+
+TEST(ReportWriterTest, TestFixedMatchesStreamForTies) {
+    // Values near rounding ties, where a scaled product may round incorrectly
+    const std::vector<double> values
+        = {0.0,  -0.0,  0.05,   0.15,   0.25,     0.35,    2.5,   -2.5,
+           -0.04, 0.45, 1.005,  2.675,  1234.5,   -999.95, 1e-9,  0.95,
+           9.95,  99.95, 1e15,  -1e300, 123456789.125};
+    for (const double v : values) {
+        for (int precision = 0; precision <= 9; precision++) {
+            EXPECT_EQ(WriterFixed(v, precision), StreamFixed(v, precision))
+                << "value " << v << ", precision " << precision;
+        }
+    }
+}
+
+TEST(ReportWriterTest, TestFixedMatchesStreamForRandomValues) {
+    std::mt19937 gen(2108);
+    std::uniform_real_distribution<double> dist(-200.0, 200.0);
+    for (int i = 0; i < 20000; i++) {
+        const double v = dist(gen);
+        const int precision = i % 10;
+        ASSERT_EQ(WriterFixed(v, precision), StreamFixed(v, precision))
+            << "value " << v << ", precision " << precision;
+    }
+}
+
+TEST(ReportWriterTest, TestGeneralMatchesStream) {
+    const std::vector<double> values = {26.6, 0.123456789, 1e-7, 123456789, 15};
+    for (const double v : values) {
+        std::ostringstream expected, actual;
+        expected << v;
+        {
+            ReportWriter writer(actual);
+            writer.Write(v);
+        }
+        EXPECT_EQ(actual.str(), expected.str());
+    }
+}
+
+TEST(ReportWriterTest, TestShortestRoundTrips) {
+    char buf[ReportWriter::MAX_NUMBER_LENGTH];
+    std::size_t len = ReportWriter::FormatShortest(0.1, buf);
+    EXPECT_EQ(std::string(buf, len), "0.1");
+    len = ReportWriter::FormatShortest(1.0 / 3.0, buf);
+    EXPECT_EQ(std::stod(std::string(buf, len)), 1.0 / 3.0);
+}
+
+TEST(ReportWriterTest, TestFieldsMatchStream) {
+    std::ostringstream expected, actual;
+    expected << std::left << std::setw(25) << "Model" << "P2108";
+    expected << std::endl << std::left << std::setw(25) << "f__ghz"
+             << std::setw(13) << 26.6 << "(gigahertz)";
+    expected << std::endl << std::left << std::setw(25) << "Return Code"
+             << std::setw(13) << -48;
+    expected << std::endl << std::left << std::setw(25) << "Clutter loss"
+             << std::setw(13) << std::fixed << std::setprecision(1) << 31.25
+             << "(dB)";
+    {
+        // Use a small buffer to exercise flushing between fields
+        ReportWriter writer(actual, 1);
+        writer.WriteField("Model", ReportWriter::LABEL_WIDTH).Write("P2108");
+        writer.Label("f__ghz").WriteField(26.6, ReportWriter::VALUE_WIDTH);
+        writer.Write("(gigahertz)");
+        writer.Label("Return Code").WriteField(-48, ReportWriter::VALUE_WIDTH);
+        writer.SetNumberFormat(NumberFormat::FIXED, 1);
+        writer.Label("Clutter loss")
+            .WriteField(31.25, ReportWriter::VALUE_WIDTH)
+            .Write("(dB)");
+    }
+    EXPECT_EQ(actual.str(), expected.str());
+}
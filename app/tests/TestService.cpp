@@ -0,0 +1,293 @@
+/** @file TestService.cpp
+ * Tests for the persistent local service mode of the driver
+ */
+// clang-format off
+// GoogleTest must be included first
+#include <gtest/gtest.h>  // GoogleTest
+// clang-format on
+
+#include "P2108.h"
+#include "Service.h"
+
+#ifndef _WIN32
+
+    #include <cmath>         // for std::isnan
+    #include <cstdint>       // for std::int32_t, std::uint32_t
+    #include <cstring>       // for std::memcpy, std::memset
+    #include <memory>        // for std::unique_ptr
+    #include <sstream>       // for std::ostringstream
+    #include <string>        // for std::string, std::to_string
+    #include <sys/socket.h>  // for bind, connect, recv, send, setsockopt
+    #include <sys/time.h>    // for timeval
+    #include <sys/un.h>      // for sockaddr_un
+    #include <thread>        // for std::thread
+    #include <unistd.h>      // for close, getpid
+    #include <vector>        // for std::vector
+
+using namespace ITS::ITU::PSeries::P2108;
+
+    #ifdef MSG_NOSIGNAL
+/** The service may close the connection before reading the body of a
+ * malformed frame, so writes from the test must not raise SIGPIPE */
+constexpr int SEND_FLAGS = MSG_NOSIGNAL;
+    #else
+constexpr int SEND_FLAGS = 0;  // SO_NOSIGPIPE is set on each socket instead
+    #endif
+
+/*******************************************************************************
+ * Test fixture which runs a service on a temporary socket
+ ******************************************************************************/
+class ServiceTest: public ::testing::Test {
+    protected:
+        void SetUp() override {
+            socket_path = "/tmp/p2108-service-test-"
+                        + std::to_string(static_cast<long>(getpid()))
+                        + ".sock";
+            server.reset(new ServiceServer(socket_path, 2));
+            std::ostringstream err;
+            ASSERT_EQ(server->Start(err), DRVR__SUCCESS) << err.str();
+        }
+
+        void TearDown() override {
+            server->Stop();
+        }
+
+        /** Connect a new client to the service */
+        int Connect() {
+            const int fd = socket(AF_UNIX, SOCK_STREAM, 0);
+    #ifdef SO_NOSIGPIPE
+            const int on = 1;
+            setsockopt(fd, SOL_SOCKET, SO_NOSIGPIPE, &on, sizeof(on));
+    #endif
+            sockaddr_un addr;
+            std::memset(&addr, 0, sizeof(addr));
+            addr.sun_family = AF_UNIX;
+            std::memcpy(addr.sun_path, socket_path.c_str(), socket_path.size());
+            EXPECT_EQ(
+                connect(fd, reinterpret_cast<sockaddr *>(&addr), sizeof(addr)),
+                0
+            );
+            return fd;
+        }
+
+        /** Send a request frame and receive the response */
+        std::int32_t Request(
+            const int fd,
+            const ServiceRequestHeader &request,
+            const std::vector<double> &columns,
+            std::vector<std::int32_t> &rtn,
+            std::vector<double> &loss
+        ) {
+            send(fd, &request, sizeof(request), SEND_FLAGS);
+            send(
+                fd, columns.data(), columns.size() * sizeof(double), SEND_FLAGS
+            );
+            ServiceResponseHeader header;
+            RecvAll(fd, &header, sizeof(header));
+            EXPECT_EQ(header.magic, SERVICE_FRAME_MAGIC);
+            rtn.resize(header.count);
+            loss.resize(header.count);
+            RecvAll(fd, rtn.data(), rtn.size() * sizeof(std::int32_t));
+            RecvAll(fd, loss.data(), loss.size() * sizeof(double));
+            return header.status;
+        }
+
+        void RecvAll(const int fd, void *buf, std::size_t n) {
+            char *p = static_cast<char *>(buf);
+            while (n > 0) {
+                const ssize_t r = recv(fd, p, n, 0);
+                ASSERT_GT(r, 0);
+                p += r;
+                n -= static_cast<std::size_t>(r);
+            }
+        }
+
+        std::string socket_path;               /**< Temporary socket path */
+        std::unique_ptr<ServiceServer> server; /**< Service under test */
+};
+
+TEST_F(ServiceTest, TestSingleRequest) {
+    const int fd = Connect();
+    ServiceRequestHeader request = {
+        SERVICE_FRAME_MAGIC, static_cast<std::int32_t>(P2108Model::ASM), 1
+    };
+    std::vector<std::int32_t> rtn;
+    std::vector<double> loss;
+    EXPECT_EQ(Request(fd, request, {10, 10.5, 45}, rtn, loss), DRVR__SUCCESS);
+    double expected;
+    AeronauticalStatisticalModel(10, 10.5, 45, expected);
+    ASSERT_EQ(rtn.size(), 1u);
+    EXPECT_EQ(rtn[0], SUCCESS);
+    EXPECT_EQ(loss[0], expected);
+    close(fd);
+}
+
+TEST_F(ServiceTest, TestBatchRequests) {
+    const int fd = Connect();
+    // TSM columns: f__ghz, d__km, p (the second record is invalid)
+    const std::vector<double> tsm = {26.6, 3, 15.8, 0.1, 45, 50};
+    ServiceRequestHeader request = {
+        SERVICE_FRAME_MAGIC, static_cast<std::int32_t>(P2108Model::TSM), 2
+    };
+    std::vector<std::int32_t> rtn;
+    std::vector<double> loss;
+    EXPECT_EQ(Request(fd, request, tsm, rtn, loss), DRVR__SUCCESS);
+    double expected;
+    TerrestrialStatisticalModel(26.6, 15.8, 45, expected);
+    ASSERT_EQ(rtn.size(), 2u);
+    EXPECT_EQ(rtn[0], SUCCESS);
+    EXPECT_EQ(loss[0], expected);
+    EXPECT_EQ(rtn[1], ERROR32__DISTANCE);
+    EXPECT_TRUE(std::isnan(loss[1]));
+
+    // HGTCM on the same connection, including an invalid clutter type
+    const std::vector<double> hgtcm = {1.5, 1.5, 2, 2, 27, 27, 15, 15, 4, 9};
+    request.model = static_cast<std::int32_t>(P2108Model::HGTCM);
+    EXPECT_EQ(Request(fd, request, hgtcm, rtn, loss), DRVR__SUCCESS);
+    HeightGainTerminalCorrectionModel(
+        1.5, 2, 27, 15, ClutterType::URBAN, expected
+    );
+    EXPECT_EQ(rtn[0], SUCCESS);
+    EXPECT_EQ(loss[0], expected);
+    EXPECT_EQ(rtn[1], ERROR31__CLUTTER_TYPE);
+    close(fd);
+}
+
+TEST_F(ServiceTest, TestConcurrentClients) {
+    double expected;
+    TerrestrialStatisticalModel(26.6, 15.8, 45, expected);
+    std::vector<std::thread> clients;
+    std::vector<int> failures(4, 0);
+    for (int c = 0; c < 4; c++) {
+        clients.emplace_back([this, c, expected, &failures] {
+            const int fd = Connect();
+            ServiceRequestHeader request = {
+                SERVICE_FRAME_MAGIC,
+                static_cast<std::int32_t>(P2108Model::TSM),
+                1
+            };
+            std::vector<std::int32_t> rtn;
+            std::vector<double> loss;
+            for (int i = 0; i < 100; i++) {
+                Request(fd, request, {26.6, 15.8, 45}, rtn, loss);
+                if (rtn.size() != 1 || loss[0] != expected) {
+                    failures[c]++;
+                }
+            }
+            close(fd);
+        });
+    }
+    for (std::thread &t : clients) {
+        t.join();
+    }
+    for (const int f : failures) {
+        EXPECT_EQ(f, 0);
+    }
+}
+
+TEST_F(ServiceTest, TestIdleClientsDoNotBlockWorkers) {
+    // More idle persistent clients than the service has workers
+    std::vector<int> idle;
+    std::vector<std::int32_t> rtn;
+    std::vector<double> loss;
+    ServiceRequestHeader request = {
+        SERVICE_FRAME_MAGIC, static_cast<std::int32_t>(P2108Model::ASM), 1
+    };
+    for (int c = 0; c < 4; c++) {
+        idle.push_back(Connect());
+        Request(idle.back(), request, {10, 10.5, 45}, rtn, loss);
+    }
+
+    // A new client is still answered, within a timeout rather than a hang
+    const int fd = Connect();
+    timeval timeout = {5, 0};
+    setsockopt(fd, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
+    EXPECT_EQ(Request(fd, request, {10, 10.5, 45}, rtn, loss), DRVR__SUCCESS);
+    ASSERT_EQ(rtn.size(), 1u);
+    EXPECT_EQ(rtn[0], SUCCESS);
+    close(fd);
+    for (const int c : idle) {
+        close(c);
+    }
+}
+
+TEST_F(ServiceTest, TestStalledClientsDoNotBlockWorkers) {
+    server->Stop();
+    server.reset(new ServiceServer(socket_path, 2, 200));
+    std::ostringstream err;
+    ASSERT_EQ(server->Start(err), DRVR__SUCCESS) << err.str();
+
+    // More clients than workers, each stalled partway through a frame
+    ServiceRequestHeader request = {
+        SERVICE_FRAME_MAGIC, static_cast<std::int32_t>(P2108Model::ASM), 1
+    };
+    std::vector<int> stalled;
+    for (int c = 0; c < 4; c++) {
+        stalled.push_back(Connect());
+        send(stalled.back(), &request, sizeof(request) / 2, SEND_FLAGS);
+    }
+
+    // A new client is still answered, within a timeout rather than a hang
+    const int fd = Connect();
+    timeval timeout = {5, 0};
+    setsockopt(fd, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
+    std::vector<std::int32_t> rtn;
+    std::vector<double> loss;
+    EXPECT_EQ(Request(fd, request, {10, 10.5, 45}, rtn, loss), DRVR__SUCCESS);
+    ASSERT_EQ(rtn.size(), 1u);
+    EXPECT_EQ(rtn[0], SUCCESS);
+    close(fd);
+
+    // The stalled connections are closed
+    for (const int c : stalled) {
+        setsockopt(c, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
+        char byte;
+        EXPECT_EQ(recv(c, &byte, 1, 0), 0);
+        close(c);
+    }
+}
+
+TEST_F(ServiceTest, TestMalformedFrame) {
+    const int fd = Connect();
+    ServiceRequestHeader request = {0xDEADBEEF, 2, 1};
+    std::vector<std::int32_t> rtn;
+    std::vector<double> loss;
+    EXPECT_EQ(Request(fd, request, {}, rtn, loss), DRVRERR__SERVICE_FRAME);
+    EXPECT_TRUE(rtn.empty());
+    close(fd);
+}
+
+TEST_F(ServiceTest, TestLiveSocketNotReplaced) {
+    // A second service on the same path fails, leaving the first serving
+    ServiceServer second(socket_path, 1);
+    std::ostringstream err;
+    EXPECT_EQ(second.Start(err), DRVRERR__SERVICE_SOCKET);
+    const int fd = Connect();
+    ServiceRequestHeader request = {
+        SERVICE_FRAME_MAGIC, static_cast<std::int32_t>(P2108Model::ASM), 1
+    };
+    std::vector<std::int32_t> rtn;
+    std::vector<double> loss;
+    EXPECT_EQ(Request(fd, request, {10, 10.5, 45}, rtn, loss), DRVR__SUCCESS);
+    close(fd);
+}
+
+TEST_F(ServiceTest, TestStaleSocketReplaced) {
+    // A socket file with no listener, as left behind by a killed service
+    server->Stop();
+    const int fd = socket(AF_UNIX, SOCK_STREAM, 0);
+    sockaddr_un addr;
+    std::memset(&addr, 0, sizeof(addr));
+    addr.sun_family = AF_UNIX;
+    std::memcpy(addr.sun_path, socket_path.c_str(), socket_path.size());
+    ASSERT_EQ(
+        bind(fd, reinterpret_cast<sockaddr *>(&addr), sizeof(addr)), 0
+    );
+    close(fd);
+
+    server.reset(new ServiceServer(socket_path, 1));
+    std::ostringstream err;
+    EXPECT_EQ(server->Start(err), DRVR__SUCCESS) << err.str();
+}
+
+#endif
@@ -0,0 +1,252 @@
+/** @file TestShmService.cpp
+ * Tests for the shared-memory transport of the driver service mode
+ */
+// clang-format off
+// GoogleTest must be included first
+#include <gtest/gtest.h>  // GoogleTest
+// clang-format on
+
+#include "P2108.h"
+#include "P2108Shm.h"
+#include "Service.h"
+#include "ShmService.h"
+#include "Structs.h"
+
+#ifdef __linux__
+
+    #include <chrono>        // for std::chrono::milliseconds
+    #include <csignal>       // for SIGTERM
+    #include <climits>       // for INT_MAX
+    #include <cstddef>       // for std::size_t
+    #include <cstdint>       // for std::int32_t, std::uint32_t
+    #include <fcntl.h>       // for O_CREAT, O_RDWR
+    #include <sstream>       // for std::ostringstream
+    #include <string>        // for std::string, std::to_string
+    #include <sys/mman.h>    // for mmap, munmap, shm_open
+    #include <sys/stat.h>    // for fstat
+    #include <sys/types.h>   // for pid_t
+    #include <sys/wait.h>    // for waitpid, WEXITSTATUS, WIFEXITED
+    #include <thread>        // for std::this_thread::sleep_for
+    #include <unistd.h>      // for _exit, close, fork, getpid
+    #include <vector>        // for std::vector
+
+using namespace ITS::ITU::PSeries::P2108;
+
+/*******************************************************************************
+ * Test fixture which runs the driver service in a separate process
+ ******************************************************************************/
+class ShmServiceTest: public ::testing::Test {
+    protected:
+        void SetUp() override {
+            shm_name = "/p2108-shm-test-"
+                     + std::to_string(static_cast<long>(getpid()));
+            child = fork();
+            ASSERT_GE(child, 0);
+            if (child == 0) {
+                DrvrParams params;
+                params.shm_name = shm_name;
+                params.n_workers = 2;
+                std::ostringstream err;
+                _exit(static_cast<int>(RunService(params, err)));
+            }
+
+            // Wait for the service to create the region
+            client = nullptr;
+            for (int i = 0; i < 500; i++) {
+                if (P2108ShmConnect(shm_name.c_str(), &client)
+                    == P2108_SHM_SUCCESS) {
+                    break;
+                }
+                std::this_thread::sleep_for(std::chrono::milliseconds(10));
+            }
+            ASSERT_NE(client, nullptr);
+        }
+
+        void TearDown() override {
+            if (client != nullptr) {
+                P2108ShmDisconnect(client);
+            }
+            if (child > 0) {
+                kill(child, SIGTERM);
+                int status = -1;
+                waitpid(child, &status, 0);
+                EXPECT_TRUE(WIFEXITED(status));
+                EXPECT_EQ(WEXITSTATUS(status), DRVR__SUCCESS);
+            }
+        }
+
+        std::string shm_name;    /**< Name of the shared-memory region */
+        pid_t child;             /**< Process running the service */
+        P2108ShmClient *client;  /**< Connection to the service */
+};
+
+TEST_F(ShmServiceTest, TestBatchInPlace) {
+    P2108ShmBatch batch;
+    ASSERT_EQ(P2108ShmAcquire(client, &batch), P2108_SHM_SUCCESS);
+    ASSERT_GE(batch.capacity, 1000u);
+
+    // TSM columns: f__ghz, d__km, p (the last record is invalid)
+    const std::uint32_t n = 1000;
+    for (std::uint32_t i = 0; i < n; i++) {
+        batch.inputs[0][i] = 2 + 0.05 * i;
+        batch.inputs[1][i] = 0.25 + 0.01 * i;
+        batch.inputs[2][i] = 1 + 0.098 * i;
+    }
+    batch.inputs[1][n - 1] = 0.1;
+    ASSERT_EQ(
+        P2108ShmSubmit(
+            client, &batch, static_cast<std::int32_t>(P2108Model::TSM), n
+        ),
+        P2108_SHM_SUCCESS
+    );
+    for (std::uint32_t i = 0; i < n - 1; i++) {
+        double expected;
+        const ReturnCode rtn = TerrestrialStatisticalModel(
+            batch.inputs[0][i], batch.inputs[1][i], batch.inputs[2][i], expected
+        );
+        EXPECT_EQ(batch.rtn[i], rtn);
+        EXPECT_EQ(batch.loss[i], expected);
+    }
+    EXPECT_EQ(batch.rtn[n - 1], ERROR32__DISTANCE);
+
+    // Reuse the slot for an ASM request
+    batch.inputs[0][0] = 10;
+    batch.inputs[1][0] = 10.5;
+    batch.inputs[2][0] = 45;
+    ASSERT_EQ(
+        P2108ShmSubmit(
+            client, &batch, static_cast<std::int32_t>(P2108Model::ASM), 1
+        ),
+        P2108_SHM_SUCCESS
+    );
+    double expected;
+    AeronauticalStatisticalModel(10, 10.5, 45, expected);
+    EXPECT_EQ(batch.rtn[0], SUCCESS);
+    EXPECT_EQ(batch.loss[0], expected);
+    P2108ShmRelease(client, &batch);
+}
+
+TEST_F(ShmServiceTest, TestInvalidRequest) {
+    P2108ShmBatch batch;
+    ASSERT_EQ(P2108ShmAcquire(client, &batch), P2108_SHM_SUCCESS);
+    EXPECT_EQ(P2108ShmSubmit(client, &batch, 7, 1), P2108_SHM_ERROR_ARGUMENT);
+    EXPECT_EQ(
+        P2108ShmSubmit(client, &batch, 3, batch.capacity + 1),
+        P2108_SHM_ERROR_ARGUMENT
+    );
+    P2108ShmRelease(client, &batch);
+}
+
+TEST_F(ShmServiceTest, TestCorruptedRegion) {
+    // Map the region as a misbehaving client would
+    const int fd = shm_open(shm_name.c_str(), O_RDWR, 0);
+    ASSERT_GE(fd, 0);
+    struct stat st;
+    ASSERT_EQ(fstat(fd, &st), 0);
+    const std::size_t size = static_cast<std::size_t>(st.st_size);
+    void *region
+        = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    close(fd);
+    ASSERT_NE(region, MAP_FAILED);
+    P2108ShmHeader *header = static_cast<P2108ShmHeader *>(region);
+    const std::uint32_t capacity = header->capacity;
+
+    // Overwrite the layout in the header
+    header->capacity = 0xFFFFFFFFu;
+    header->slot_offset = 1ull << 40;
+    header->slot_stride = P2108ShmSlotStride(header->capacity);
+    P2108ShmClient *other = nullptr;
+    EXPECT_EQ(
+        P2108ShmConnect(shm_name.c_str(), &other), P2108_SHM_ERROR_VERSION
+    );
+
+    // Submit a request with too many records, bypassing the client checks
+    P2108ShmBatch batch;
+    ASSERT_EQ(P2108ShmAcquire(client, &batch), P2108_SHM_SUCCESS);
+    EXPECT_EQ(batch.capacity, capacity);
+    P2108ShmSlot *slot = P2108ShmGetSlot(region, capacity, batch.slot);
+    slot->model = static_cast<std::int32_t>(P2108Model::ASM);
+    slot->count = capacity + 1;
+    __atomic_store_n(
+        &slot->state,
+        static_cast<std::uint32_t>(P2108_SHM_SLOT_REQUEST),
+        __ATOMIC_RELEASE
+    );
+    __atomic_add_fetch(&header->request_seq, 1, __ATOMIC_ACQ_REL);
+    P2108ShmWake(&header->request_seq, INT_MAX);
+    std::uint32_t state;
+    while ((state = __atomic_load_n(&slot->state, __ATOMIC_ACQUIRE))
+           != P2108_SHM_SLOT_RESPONSE) {
+        P2108ShmWait(&slot->state, state, 100);
+    }
+    EXPECT_EQ(slot->status, P2108_SHM_ERROR_ARGUMENT);
+
+    // The service keeps using the layout it created
+    batch.inputs[0][0] = 10;
+    batch.inputs[1][0] = 10.5;
+    batch.inputs[2][0] = 45;
+    ASSERT_EQ(
+        P2108ShmSubmit(
+            client, &batch, static_cast<std::int32_t>(P2108Model::ASM), 1
+        ),
+        P2108_SHM_SUCCESS
+    );
+    double expected;
+    AeronauticalStatisticalModel(10, 10.5, 45, expected);
+    EXPECT_EQ(batch.rtn[0], SUCCESS);
+    EXPECT_EQ(batch.loss[0], expected);
+    P2108ShmRelease(client, &batch);
+    munmap(region, size);
+}
+
+TEST_F(ShmServiceTest, TestAllSlots) {
+    // Claiming every slot, then releasing them, must not deadlock
+    std::vector<P2108ShmBatch> batches(4);
+    for (P2108ShmBatch &b : batches) {
+        ASSERT_EQ(P2108ShmAcquire(client, &b), P2108_SHM_SUCCESS);
+    }
+    for (std::size_t i = 1; i < batches.size(); i++) {
+        EXPECT_NE(batches[i].slot, batches[0].slot);
+    }
+    for (P2108ShmBatch &b : batches) {
+        P2108ShmRelease(client, &b);
+    }
+}
+
+TEST_F(ShmServiceTest, TestLiveRegionNotReplaced) {
+    // A second service with the same name fails, leaving the first serving
+    ShmServer second(shm_name, 1);
+    std::ostringstream err;
+    EXPECT_EQ(second.Start(err), DRVRERR__SERVICE_SHM);
+    P2108ShmBatch batch;
+    ASSERT_EQ(P2108ShmAcquire(client, &batch), P2108_SHM_SUCCESS);
+    batch.inputs[0][0] = 10;
+    batch.inputs[1][0] = 10.5;
+    batch.inputs[2][0] = 45;
+    EXPECT_EQ(
+        P2108ShmSubmit(
+            client, &batch, static_cast<std::int32_t>(P2108Model::ASM), 1
+        ),
+        P2108_SHM_SUCCESS
+    );
+    EXPECT_EQ(batch.rtn[0], SUCCESS);
+    P2108ShmRelease(client, &batch);
+}
+
+TEST(ShmServiceStaleTest, TestStaleRegionReplaced) {
+    // A region with no service holding its lock, as left behind by a
+    // killed service
+    const std::string name = "/p2108-shm-stale-test-"
+                           + std::to_string(static_cast<long>(getpid()));
+    const int fd = shm_open(name.c_str(), O_CREAT | O_RDWR, 0600);
+    ASSERT_GE(fd, 0);
+    close(fd);
+
+    ShmServer server(name, 1);
+    std::ostringstream err;
+    EXPECT_EQ(server.Start(err), DRVR__SUCCESS) << err.str();
+    server.Stop();
+    EXPECT_LT(shm_open(name.c_str(), O_RDWR, 0), 0);
+}
+
+#endif
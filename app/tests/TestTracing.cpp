@@ -0,0 +1,174 @@
+/** @file TestTracing.cpp
+ * Tests for the span tracing of the driver and its Chrome trace export
+ */
+#include "TempTextFile.h"
+#include "TestDriver.h"
+#include "Tracing.h"
+
+#include <cstddef>  // for std::size_t
+#include <cstdint>  // for std::uint64_t
+#include <fstream>  // for std::ifstream
+#include <sstream>  // for std::ostringstream, std::stringstream
+#include <string>   // for std::string
+#include <thread>   // for std::thread
+#include <vector>   // for std::vector
+
+namespace {
+/** Count the occurrences of a substring */
+std::size_t CountOf(const std::string &text, const std::string &sub) {
+    std::size_t n = 0;
+    for (std::size_t pos = text.find(sub); pos != std::string::npos;
+         pos = text.find(sub, pos + sub.size())) {
+        n++;
+    }
+    return n;
+}
+}  // namespace
+
+TEST(TracingTest, TestNoTracerByDefault) {
+    EXPECT_EQ(Tracer::GetActive(), nullptr);
+    {
+        TraceSpan span("Untraced");  // Must be a no-op
+    }
+    Tracer tracer;
+    {
+        TraceSession session(&tracer);
+        EXPECT_EQ(Tracer::GetActive(), &tracer);
+    }
+    EXPECT_EQ(Tracer::GetActive(), nullptr);
+}
+
+TEST(TracingTest, TestNestedSpans) {
+    Tracer tracer;
+    {
+        TraceSession session(&tracer);
+        TraceSpan outer("Outer");
+        {
+            TraceSpan inner("Inner");
+        }
+    }
+    std::ostringstream oss;
+    tracer.WriteChromeTrace(oss);
+    const std::string json = oss.str();
+    EXPECT_EQ(json.find("{\"traceEvents\":["), 0u);
+    EXPECT_EQ(CountOf(json, "\"name\":\"Outer\""), 2u);
+    EXPECT_EQ(CountOf(json, "\"name\":\"Inner\""), 2u);
+    EXPECT_EQ(CountOf(json, "\"ph\":\"B\""), 2u);
+    EXPECT_EQ(CountOf(json, "\"ph\":\"E\""), 2u);
+    EXPECT_LT(json.find("\"Outer\""), json.find("\"Inner\""));
+}
+
+TEST(TracingTest, TestRingBufferWraps) {
+    TraceBuffer buffer(4, 1);
+    for (std::uint64_t i = 0; i < 10; i++) {
+        buffer.Record({"Event", i, 'B'});
+    }
+    const std::vector<TraceEvent> events = buffer.GetEvents();
+    ASSERT_EQ(events.size(), 4u);
+    for (std::size_t i = 0; i < events.size(); i++) {
+        EXPECT_EQ(events[i].t__ns, 6 + i);
+    }
+}
+
+TEST(TracingTest, TestUnmatchedEndsDropped) {
+    // Only the end events of the first spans remain after wrapping
+    Tracer tracer(4);
+    {
+        TraceSession session(&tracer);
+        TraceSpan outer("Outer");
+        for (int i = 0; i < 3; i++) {
+            TraceSpan inner("Inner");
+        }
+    }
+    std::ostringstream oss;
+    tracer.WriteChromeTrace(oss);
+    const std::string json = oss.str();
+    EXPECT_EQ(CountOf(json, "\"ph\":\"B\""), CountOf(json, "\"ph\":\"E\""));
+    EXPECT_EQ(CountOf(json, "\"name\":\"Outer\""), 0u);
+}
+
+TEST(TracingTest, TestThreadsHaveOwnBuffers) {
+    Tracer tracer;
+    {
+        std::vector<std::thread> threads;
+        for (int t = 0; t < 4; t++) {
+            threads.emplace_back([&tracer] {
+                TraceSession session(&tracer);
+                for (int i = 0; i < 100; i++) {
+                    TraceSpan span("Work");
+                }
+            });
+        }
+        for (std::thread &thread : threads) {
+            thread.join();
+        }
+    }
+    std::ostringstream oss;
+    tracer.WriteChromeTrace(oss);
+    const std::string json = oss.str();
+    EXPECT_EQ(CountOf(json, "\"name\":\"thread_name\""), 4u);
+    EXPECT_EQ(CountOf(json, "\"name\":\"Work\""), 800u);
+    for (int t = 1; t <= 4; t++) {
+        EXPECT_EQ(
+            CountOf(json, "\"tid\":" + std::to_string(t) + "}"), 200u
+        );
+    }
+}
+
+TEST(TracingTest, TestSessionsArePerThread) {
+    // A session on another thread neither sees nor replaces this one
+    Tracer tracer, other;
+    TraceSession session(&tracer);
+    std::thread thread([&other] {
+        EXPECT_EQ(Tracer::GetActive(), nullptr);
+        TraceSession other_session(&other);
+        EXPECT_EQ(Tracer::GetActive(), &other);
+        TraceSpan span("Other");
+    });
+    thread.join();
+    EXPECT_EQ(Tracer::GetActive(), &tracer);
+    {
+        TraceSpan span("Mine");
+    }
+    std::ostringstream oss;
+    tracer.WriteChromeTrace(oss);
+    EXPECT_EQ(CountOf(oss.str(), "\"name\":\"Mine\""), 2u);
+    EXPECT_EQ(CountOf(oss.str(), "\"name\":\"Other\""), 0u);
+}
+
+TEST_F(DriverTest, TestTraceFile) {
+    // A unique file, which the driver overwrites, so concurrent tests differ
+    const TempTextFile temp("");
+    const std::string trace_file = temp.getFileName();
+    const int rtn = RunDriverWithArgs(
+        {"-i", "-", "-o", "-", "-model", "TSM", "-trace", trace_file},
+        "f__ghz,26.6\nd__km,15.8\np,45\n"
+    );
+    EXPECT_EQ(rtn, SUCCESS);
+    EXPECT_NE(out_text.find("Clutter loss"), std::string::npos);
+
+    std::ifstream file(trace_file);
+    ASSERT_TRUE(file.is_open());
+    std::stringstream json;
+    json << file.rdbuf();
+    file.close();
+    for (const std::string name : {
+             "ParseTSMInputStream",
+             "CommaSeparatedIterator::operator++",
+             "CallTerrestrialStatisticalModel",
+             "WriteReport",
+             "ReportWriter::Flush",
+         }) {
+        EXPECT_NE(json.str().find("\"" + name + "\""), std::string::npos)
+            << name;
+    }
+    EXPECT_EQ(Tracer::GetActive(), nullptr);
+}
+
+TEST_F(DriverTest, TestTraceFileError) {
+    const int rtn = RunDriverWithArgs(
+        {"-i", "-", "-o", "-", "-model", "TSM", "-trace", "/invalid/t.json"},
+        "f__ghz,26.6\nd__km,15.8\np,45\n"
+    );
+    EXPECT_EQ(rtn, DRVRERR__OPENING_TRACE_FILE);
+}
@@ -0,0 +1,404 @@
+/** @file AccuracyHarness.cpp
+ * Compares the accuracy and throughput of all registered implementations.
+ *
+ * Each implementation is run over the reference test data (from the
+ * `extern/test-data` submodule, when available) and over dense random samples
+ * of the valid input domains. Test data results are compared to the values in
+ * the test data files, and random sample results are compared to the scalar
+ * reference implementation. The results are written as a Markdown table.
+ */
+#include "Implementations.h"
+#include "Samples.h"
+
+#include "P2108.h"
+
+#include <chrono>     // for std::chrono::steady_clock, std::chrono::duration
+#include <cmath>      // for std::abs, std::isfinite
+#include <cstddef>    // for std::size_t
+#include <cstdint>    // for std::int64_t, std::uint64_t
+#include <cstdio>     // for std::snprintf
+#include <cstdlib>    // for std::strtoul
+#include <cstring>    // for std::memcpy
+#include <fstream>    // for std::ifstream, std::ofstream
+#include <iostream>   // for std::cerr, std::cout
+#include <limits>     // for std::numeric_limits
+#include <ostream>    // for std::endl, std::ostream
+#include <sstream>    // for std::istringstream
+#include <string>     // for std::getline, std::string
+#include <vector>     // for std::vector
+
+using namespace ITS::ITU::PSeries::P2108;
+
+namespace {
+/** Default number of random samples per function */
+constexpr std::size_t DEFAULT_SAMPLES = 1000000;
+
+/** Minimum time spent measuring the throughput of each implementation, in s */
+constexpr double MIN_TIMING__SEC = 0.2;
+
+/** A set of records on which to compare implementations */
+struct Dataset {
+        std::string name;                        /**< Short description */
+        std::vector<std::vector<double>> inputs; /**< Input columns */
+        std::vector<int> rtn;         /**< Expected codes, if known */
+        std::vector<double> expected; /**< Expected results, if known */
+};
+
+/** Error statistics of one implementation on one dataset */
+struct ErrorStats {
+        std::size_t n_compared = 0;   /**< Results compared */
+        std::size_t n_mismatched = 0; /**< Return codes which differ */
+        double max_abs = 0;           /**< Maximum absolute error */
+        double sum_abs = 0;           /**< Sum of absolute errors */
+        std::uint64_t max_ulp = 0;    /**< Maximum error, in ULP */
+        double sum_ulp = 0;           /**< Sum of errors, in ULP */
+};
+
+/** Map a double to an integer which is ordered like the double values */
+std::int64_t OrderedBits(const double x) {
+    std::int64_t i;
+    std::memcpy(&i, &x, sizeof(i));
+    return (i < 0) ? std::numeric_limits<std::int64_t>::min() - i : i;
+}
+
+/*******************************************************************************
+ * Get the number of representable doubles between two values.
+ *
+ * @param[in] a  First value
+ * @param[in] b  Second value
+ * @return       Distance, in units in the last place
+ ******************************************************************************/
+std::uint64_t UlpDistance(const double a, const double b) {
+    const std::uint64_t ia = static_cast<std::uint64_t>(OrderedBits(a));
+    const std::uint64_t ib = static_cast<std::uint64_t>(OrderedBits(b));
+    return (OrderedBits(a) > OrderedBits(b)) ? ia - ib : ib - ia;
+}
+
+/** Get the name of the test data file of a function, if there is one */
+std::string GetTestDataFileName(const ModelFunction model) {
+    switch (model) {
+        case ModelFunction::ASM:
+            return "AeronauticalStatisticalModelTestData.csv";
+        case ModelFunction::TSM:
+            return "TerrestrialStatisticalModelTestData.csv";
+        case ModelFunction::HGTCM:
+            return "HeightGainTerminalCorrectionModelTestData.csv";
+        default:
+            return "";
+    }
+}
+
+/*******************************************************************************
+ * Read a test data file.
+ *
+ * Each line holds the inputs, the expected return code, and the expected
+ * result, separated by commas. Lines which cannot be parsed (e.g., headers)
+ * are skipped.
+ *
+ * @param[in]  path      Path of the test data file
+ * @param[in]  n_inputs  Number of input columns
+ * @param[out] data      Dataset holding the test data
+ * @return               False if the file could not be opened
+ ******************************************************************************/
+bool ReadTestData(
+    const std::string &path, const std::size_t n_inputs, Dataset &data
+) {
+    std::ifstream file(path);
+    if (!file) {
+        return false;
+    }
+    data.name = "test-data";
+    data.inputs.assign(n_inputs, std::vector<double>());
+    std::vector<double> row(n_inputs + 2);
+    std::string line;
+    while (std::getline(file, line)) {
+        std::istringstream iss(line);
+        char c;  // single-character representing the comma (delimiter)
+        bool ok = static_cast<bool>(iss >> row[0]);
+        for (std::size_t j = 1; ok && j < row.size(); j++) {
+            ok = static_cast<bool>(iss >> c >> row[j]);
+        }
+        if (!ok) {
+            continue;
+        }
+        for (std::size_t j = 0; j < n_inputs; j++) {
+            data.inputs[j].push_back(row[j]);
+        }
+        data.rtn.push_back(static_cast<int>(row[n_inputs]));
+        data.expected.push_back(row[n_inputs + 1]);
+    }
+    return true;
+}
+
+/*******************************************************************************
+ * Draw random records from the valid input domain of a function.
+ *
+ * @param[in] model  Model function
+ * @param[in] n      Number of records
+ * @return           Dataset holding the records
+ ******************************************************************************/
+Dataset RandomDataset(const ModelFunction model, const std::size_t n) {
+    Dataset data;
+    data.name = "random";
+    switch (model) {
+        case ModelFunction::ASM:
+            data.inputs = {
+                UniformSamples(ASM_F__GHZ, n, 1),
+                UniformSamples(ASM_THETA__DEG, n, 2),
+                UniformSamples(PERCENTAGE, n, 3)
+            };
+            break;
+        case ModelFunction::TSM:
+            data.inputs = {
+                UniformSamples(TSM_F__GHZ, n, 1),
+                UniformSamples(TSM_D__KM, n, 2),
+                UniformSamples(PERCENTAGE, n, 3)
+            };
+            break;
+        case ModelFunction::HGTCM:
+            data.inputs = {
+                UniformSamples(HGTCM_F__GHZ, n, 1),
+                UniformSamples(HGTCM_H__METER, n, 2),
+                UniformSamples(HGTCM_W_S__METER, n, 3),
+                UniformSamples(HGTCM_R__METER, n, 4),
+                UniformSamples(CLUTTER_TYPE, n, 5)
+            };
+            for (double &type : data.inputs[4]) {
+                type = static_cast<double>(static_cast<int>(type));
+            }
+            break;
+        case ModelFunction::ICCD:
+            data.inputs = {UniformSamples(PROBABILITY, n, 1)};
+            break;
+    }
+    return data;
+}
+
+/*******************************************************************************
+ * Compare results to the expected results of a dataset.
+ *
+ * Values are only compared where both return codes indicate success.
+ *
+ * @param[in] rtn           Return codes of the implementation
+ * @param[in] out           Results of the implementation
+ * @param[in] expected_rtn  Expected return codes
+ * @param[in] expected      Expected results
+ * @return                  Error statistics
+ ******************************************************************************/
+ErrorStats Compare(
+    const std::vector<int> &rtn,
+    const std::vector<double> &out,
+    const std::vector<int> &expected_rtn,
+    const std::vector<double> &expected
+) {
+    ErrorStats stats;
+    for (std::size_t i = 0; i < out.size(); i++) {
+        if (rtn[i] != expected_rtn[i]) {
+            stats.n_mismatched++;
+            continue;
+        }
+        if (rtn[i] != SUCCESS || !std::isfinite(expected[i])) {
+            continue;
+        }
+        const double abs_err = std::abs(out[i] - expected[i]);
+        const std::uint64_t ulp = UlpDistance(out[i], expected[i]);
+        stats.n_compared++;
+        stats.sum_abs += abs_err;
+        stats.sum_ulp += static_cast<double>(ulp);
+        if (abs_err > stats.max_abs) {
+            stats.max_abs = abs_err;
+        }
+        if (ulp > stats.max_ulp) {
+            stats.max_ulp = ulp;
+        }
+    }
+    return stats;
+}
+
+/*******************************************************************************
+ * Run an implementation over a dataset, and measure its throughput.
+ *
+ * The dataset is evaluated once untimed, so that one-time setup (e.g., of a
+ * surface file) is excluded, then repeatedly for at least `MIN_TIMING__SEC`.
+ *
+ * @param[in]  impl  Implementation to run
+ * @param[in]  data  Dataset to evaluate
+ * @param[out] rtn   Return code of each record
+ * @param[out] out   Result of each record
+ * @return           Throughput, in records per second
+ ******************************************************************************/
+double Run(
+    const Implementation &impl,
+    const Dataset &data,
+    std::vector<int> &rtn,
+    std::vector<double> &out
+) {
+    const std::size_t n = data.inputs.front().size();
+    std::vector<const double *> columns;
+    for (const std::vector<double> &column : data.inputs) {
+        columns.push_back(column.data());
+    }
+    rtn.assign(n, 0);
+    out.assign(n, 0);
+    if (n == 0) {
+        return 0;
+    }
+
+    impl.kernel(columns.data(), n, rtn.data(), out.data());
+    typedef std::chrono::steady_clock Clock;
+    const Clock::time_point start = Clock::now();
+    std::size_t repetitions = 0;
+    double elapsed__sec;
+    do {
+        impl.kernel(columns.data(), n, rtn.data(), out.data());
+        repetitions++;
+        elapsed__sec
+            = std::chrono::duration<double>(Clock::now() - start).count();
+    } while (elapsed__sec < MIN_TIMING__SEC);
+    return static_cast<double>(repetitions * n) / elapsed__sec;
+}
+
+/** Write one row of the results table */
+void WriteRow(
+    std::ostream &os,
+    const Implementation &impl,
+    const Dataset &data,
+    const ErrorStats &stats,
+    const double throughput
+) {
+    char buf[256];
+    const double n = (stats.n_compared > 0) ? stats.n_compared : 1;
+    std::snprintf(
+        buf,
+        sizeof(buf),
+        "| %-11s | %-14s | %-9s | %9zu | %8zu | %10.3e | %10.3e | %8llu | "
+        "%8.3g | %9.3e |",
+        GetModelFunctionName(impl.model),
+        impl.name,
+        data.name.c_str(),
+        data.inputs.front().size(),
+        stats.n_mismatched,
+        stats.max_abs,
+        stats.sum_abs / n,
+        static_cast<unsigned long long>(stats.max_ulp),
+        stats.sum_ulp / n,
+        throughput
+    );
+    os << buf << std::endl;
+}
+
+/** Print usage information */
+void Usage(std::ostream &os) {
+    os << "Usage: " << LIBRARY_NAME << "Accuracy [Options]" << std::endl;
+    os << "\t-n     :: Number of random samples per function [default: "
+       << DEFAULT_SAMPLES << "]" << std::endl;
+    os << "\t-o     :: Output file name [default: standard output]"
+       << std::endl;
+    os << "\t-data  :: Directory containing the test data files" << std::endl;
+}
+}  // namespace
+
+/*******************************************************************************
+ * Main function of the accuracy harness
+ *
+ * @param[in] argc  Number of arguments entered on the command line
+ * @param[in] argv  Array containing the provided command-line arguments
+ * @return          Exit code
+ ******************************************************************************/
+int main(int argc, char **argv) {
+    std::size_t n_samples = DEFAULT_SAMPLES;
+    std::string out_file;
+    std::string data_dir = TEST_DATA_DIRECTORY;
+    for (int i = 1; i < argc; i++) {
+        const std::string arg(argv[i]);
+        if (i + 1 >= argc) {
+            Usage(std::cerr);
+            return 1;
+        }
+        if (arg == "-n") {
+            n_samples = std::strtoul(argv[++i], nullptr, 10);
+        } else if (arg == "-o") {
+            out_file = argv[++i];
+        } else if (arg == "-data") {
+            data_dir = argv[++i];
+        } else {
+            Usage(std::cerr);
+            return 1;
+        }
+    }
+
+    std::ofstream file;
+    if (!out_file.empty()) {
+        file.open(out_file);
+        if (!file) {
+            std::cerr << "Error opening output file " << out_file << std::endl;
+            return 1;
+        }
+    }
+    std::ostream &os = file.is_open() ? file : std::cout;
+
+    os << "# " << LIBRARY_NAME << " v" << LIBRARY_VERSION
+       << " accuracy and throughput" << std::endl
+       << std::endl;
+    os << "Errors are relative to the test data (`test-data`) or to the "
+          "scalar reference"
+       << std::endl
+       << "implementation (`random`, " << n_samples
+       << " samples). Throughput is in records per second." << std::endl
+       << std::endl;
+    os << "| Function    | Implementation | Dataset   |   Records | "
+          "Code err | Max abs    | Mean abs   |  Max ULP | Mean ULP | "
+          "Rec/s     |"
+       << std::endl;
+    os << "|-------------|----------------|-----------|----------:|"
+          "---------:|-----------:|-----------:|---------:|---------:|"
+          "----------:|"
+       << std::endl;
+
+    const ModelFunction models[] = {
+        ModelFunction::ASM,
+        ModelFunction::TSM,
+        ModelFunction::HGTCM,
+        ModelFunction::ICCD
+    };
+    const std::vector<Implementation> &impls = GetImplementations();
+    for (const ModelFunction model : models) {
+        std::vector<Dataset> datasets;
+        const std::string test_file = GetTestDataFileName(model);
+        Dataset test_data;
+        if (!test_file.empty()) {
+            if (ReadTestData(
+                    data_dir + "/" + test_file,
+                    GetModelFunctionInputCount(model),
+                    test_data
+                )) {
+                datasets.push_back(test_data);
+            } else {
+                std::cerr << "Skipping missing test data file " << test_file
+                          << std::endl;
+            }
+        }
+        datasets.push_back(RandomDataset(model, n_samples));
+
+        for (const Dataset &data : datasets) {
+            std::vector<int> ref_rtn = data.rtn;
+            std::vector<double> ref_out = data.expected;
+            std::vector<int> rtn;
+            std::vector<double> out;
+            for (const Implementation &impl : impls) {
+                if (impl.model != model) {
+                    continue;
+                }
+                const double throughput = Run(impl, data, rtn, out);
+                if (ref_out.empty()) {
+                    // The first implementation is the reference
+                    ref_rtn = rtn;
+                    ref_out = out;
+                }
+                const ErrorStats stats = Compare(rtn, out, ref_rtn, ref_out);
+                WriteRow(os, impl, data, stats, throughput);
+            }
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,138 @@
+/** @file BenchAeronauticalStatisticalModel.cpp
+ * Benchmarks for the Aeronautical Statistical Model
+ */
+#include "BenchUtils.h"
+
+#include "P2108Batch.h"
+#include "P2108Tracks.h"
+
+#include <cstddef>  // for std::size_t
+#include <cstdint>  // for std::uint64_t
+#include <vector>   // for std::vector
+
+/** Latency of a single call, cycling through random valid inputs */
+static void BM_ASM_Single(benchmark::State &state) {
+    const std::size_t n = SINGLE_CALL_SAMPLES;
+    const std::vector<double> f__ghz = UniformSamples(ASM_F__GHZ, n, 1);
+    const std::vector<double> theta = UniformSamples(ASM_THETA__DEG, n, 2);
+    const std::vector<double> p = UniformSamples(PERCENTAGE, n, 3);
+    std::size_t i = 0;
+    double L_ces__db;
+    for (auto _ : state) {
+        ReturnCode rtn = AeronauticalStatisticalModel(
+            f__ghz[i], theta[i], p[i], L_ces__db
+        );
+        benchmark::DoNotOptimize(rtn);
+        benchmark::DoNotOptimize(L_ces__db);
+        i = (i + 1) % n;
+    }
+}
+BENCHMARK(BM_ASM_Single);
+
+/** Throughput of a loop over a batch of random valid inputs */
+static void BM_ASM_Batch(benchmark::State &state) {
+    const std::size_t n = static_cast<std::size_t>(state.range(0));
+    const std::vector<double> f__ghz = UniformSamples(ASM_F__GHZ, n, 1);
+    const std::vector<double> theta = UniformSamples(ASM_THETA__DEG, n, 2);
+    const std::vector<double> p = UniformSamples(PERCENTAGE, n, 3);
+    std::vector<double> L_ces__db(n);
+    for (auto _ : state) {
+        for (std::size_t i = 0; i < n; i++) {
+            AeronauticalStatisticalModel(
+                f__ghz[i], theta[i], p[i], L_ces__db[i]
+            );
+        }
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_ASM_Batch)->Apply(SetBatchArguments);
+
+/** Throughput of the tiled batch API, over batch and tile sizes */
+static void BM_ASM_BatchAPI(benchmark::State &state) {
+    const std::size_t n = static_cast<std::size_t>(state.range(0));
+    const std::vector<double> f__ghz = UniformSamples(ASM_F__GHZ, n, 1);
+    const std::vector<double> theta = UniformSamples(ASM_THETA__DEG, n, 2);
+    const std::vector<double> p = UniformSamples(PERCENTAGE, n, 3);
+    std::vector<double> L_ces__db(n);
+    std::vector<int> rtn(n);
+    P2108SetBatchTileSize(static_cast<std::size_t>(state.range(1)));
+    for (auto _ : state) {
+        P2108AeronauticalStatisticalModelBatch(
+            n,
+            f__ghz.data(),
+            sizeof(double),
+            theta.data(),
+            sizeof(double),
+            p.data(),
+            sizeof(double),
+            ABRAMOWITZ_STEGUN,
+            L_ces__db.data(),
+            sizeof(double),
+            rtn.data(),
+            sizeof(int)
+        );
+        benchmark::ClobberMemory();
+    }
+    state.counters["tile"] = static_cast<double>(P2108GetBatchTileSize());
+    P2108SetBatchTileSize(0);
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_ASM_BatchAPI)->Apply(SetTiledBatchArguments);
+
+/** Throughput of a track replay, with samples of 10000 tracks interleaved */
+static void BM_ASM_TrackReplay(benchmark::State &state) {
+    const std::size_t n = static_cast<std::size_t>(state.range(0));
+    const std::size_t n_tracks = 10000;
+    const std::vector<double> f__ghz = UniformSamples(ASM_F__GHZ, n_tracks, 1);
+    const std::vector<double> p = UniformSamples(PERCENTAGE, n_tracks, 3);
+    const std::vector<double> theta = UniformSamples(ASM_THETA__DEG, n, 2);
+    P2108TrackReplay *replay = P2108TrackReplayCreate();
+    for (std::size_t k = 0; k < n_tracks; k++) {
+        P2108TrackReplaySetTrack(replay, k, f__ghz[k], p[k], ABRAMOWITZ_STEGUN);
+    }
+    std::vector<std::uint64_t> track(n);
+    for (std::size_t i = 0; i < n; i++) {
+        track[i] = (i * 7919) % n_tracks;
+    }
+    std::vector<double> L_ces__db(n);
+    for (auto _ : state) {
+        P2108TrackReplayEvaluate(
+            replay, n, track.data(), theta.data(), L_ces__db.data(), nullptr
+        );
+        benchmark::ClobberMemory();
+    }
+    P2108TrackReplayFree(replay);
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_ASM_TrackReplay)->Apply(SetBatchArguments);
+
+/** Throughput of interpolation in a precomputed surface file */
+static void BM_ASM_Surface(benchmark::State &state) {
+    const std::size_t n = static_cast<std::size_t>(state.range(0));
+    const std::vector<double> f__ghz = UniformSamples(ASM_F__GHZ, n, 1);
+    const std::vector<double> theta = UniformSamples(ASM_THETA__DEG, n, 2);
+    const std::vector<double> p = UniformSamples(PERCENTAGE, n, 3);
+    std::vector<double> L_ces__db(n);
+    P2108Surface *surface = OpenDefaultSurface();
+    if (surface == nullptr) {
+        state.SkipWithError("Failed to open the surface file");
+        return;
+    }
+    for (auto _ : state) {
+        P2108SurfaceAeronauticalStatisticalModel(
+            surface,
+            n,
+            f__ghz.data(),
+            theta.data(),
+            p.data(),
+            ABRAMOWITZ_STEGUN,
+            L_ces__db.data(),
+            nullptr
+        );
+        benchmark::ClobberMemory();
+    }
+    P2108SurfaceClose(surface);
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_ASM_Surface)->Apply(SetBatchArguments);
@@ -0,0 +1,137 @@
+/** @file BenchHeightGainTerminalCorrectionModel.cpp
+ * Benchmarks for the Height Gain Terminal Correction Model
+ */
+#include "BenchUtils.h"
+
+#include "P2108Link.h"
+
+#include <cstddef>  // for std::size_t
+#include <vector>   // for std::vector
+
+/** Latency of a single call, cycling through random valid inputs */
+static void BM_HGTCM_Single(benchmark::State &state, const ClutterType type) {
+    const std::size_t n = SINGLE_CALL_SAMPLES;
+    const std::vector<double> f__ghz = UniformSamples(HGTCM_F__GHZ, n, 1);
+    const std::vector<double> h__meter = UniformSamples(HGTCM_H__METER, n, 2);
+    const std::vector<double> w_s = UniformSamples(HGTCM_W_S__METER, n, 3);
+    const std::vector<double> R__meter = UniformSamples(HGTCM_R__METER, n, 4);
+    std::size_t i = 0;
+    double A_h__db;
+    for (auto _ : state) {
+        ReturnCode rtn = HeightGainTerminalCorrectionModel(
+            f__ghz[i], h__meter[i], w_s[i], R__meter[i], type, A_h__db
+        );
+        benchmark::DoNotOptimize(rtn);
+        benchmark::DoNotOptimize(A_h__db);
+        i = (i + 1) % n;
+    }
+}
+BENCHMARK_CAPTURE(BM_HGTCM_Single, WATER_SEA, ClutterType::WATER_SEA);
+BENCHMARK_CAPTURE(BM_HGTCM_Single, OPEN_RURAL, ClutterType::OPEN_RURAL);
+BENCHMARK_CAPTURE(BM_HGTCM_Single, SUBURBAN, ClutterType::SUBURBAN);
+BENCHMARK_CAPTURE(BM_HGTCM_Single, URBAN, ClutterType::URBAN);
+BENCHMARK_CAPTURE(BM_HGTCM_Single, TREES_FOREST, ClutterType::TREES_FOREST);
+BENCHMARK_CAPTURE(BM_HGTCM_Single, DENSE_URBAN, ClutterType::DENSE_URBAN);
+
+/** Throughput of a loop over a batch of random valid inputs */
+static void BM_HGTCM_Batch(benchmark::State &state, const ClutterType type) {
+    const std::size_t n = static_cast<std::size_t>(state.range(0));
+    const std::vector<double> f__ghz = UniformSamples(HGTCM_F__GHZ, n, 1);
+    const std::vector<double> h__meter = UniformSamples(HGTCM_H__METER, n, 2);
+    const std::vector<double> w_s = UniformSamples(HGTCM_W_S__METER, n, 3);
+    const std::vector<double> R__meter = UniformSamples(HGTCM_R__METER, n, 4);
+    std::vector<double> A_h__db(n);
+    for (auto _ : state) {
+        for (std::size_t i = 0; i < n; i++) {
+            HeightGainTerminalCorrectionModel(
+                f__ghz[i], h__meter[i], w_s[i], R__meter[i], type, A_h__db[i]
+            );
+        }
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK_CAPTURE(BM_HGTCM_Batch, WATER_SEA, ClutterType::WATER_SEA)
+    ->Apply(SetBatchArguments);
+BENCHMARK_CAPTURE(BM_HGTCM_Batch, OPEN_RURAL, ClutterType::OPEN_RURAL)
+    ->Apply(SetBatchArguments);
+BENCHMARK_CAPTURE(BM_HGTCM_Batch, SUBURBAN, ClutterType::SUBURBAN)
+    ->Apply(SetBatchArguments);
+BENCHMARK_CAPTURE(BM_HGTCM_Batch, URBAN, ClutterType::URBAN)
+    ->Apply(SetBatchArguments);
+BENCHMARK_CAPTURE(BM_HGTCM_Batch, TREES_FOREST, ClutterType::TREES_FOREST)
+    ->Apply(SetBatchArguments);
+BENCHMARK_CAPTURE(BM_HGTCM_Batch, DENSE_URBAN, ClutterType::DENSE_URBAN)
+    ->Apply(SetBatchArguments);
+
+/** Random valid links, with urban terminals over the bands of both models */
+static std::vector<P2108Link> LinkSamples(const std::size_t n) {
+    const Domain f__ghz = {0.5, 3};
+    const std::vector<double> f = UniformSamples(f__ghz, n, 1);
+    const std::vector<double> d__km = UniformSamples(TSM_D__KM, n, 2);
+    const std::vector<double> p = UniformSamples(PERCENTAGE, n, 3);
+    const std::vector<double> h__meter = UniformSamples(HGTCM_H__METER, n, 4);
+    std::vector<P2108Link> links(n);
+    for (std::size_t i = 0; i < n; i++) {
+        links[i].f__ghz = f[i];
+        links[i].d__km = d__km[i];
+        links[i].p = p[i];
+        links[i].tx = {h__meter[i], 27, 20, ClutterType::URBAN};
+        links[i].rx = {h__meter[n - 1 - i], 27, 20, ClutterType::URBAN};
+    }
+    return links;
+}
+
+/** Throughput of the three model calls of each link of a batch */
+static void BM_Link_Models(benchmark::State &state) {
+    const std::size_t n = static_cast<std::size_t>(state.range(0));
+    const std::vector<P2108Link> links = LinkSamples(n);
+    std::vector<double> total__db(n);
+    for (auto _ : state) {
+        for (std::size_t i = 0; i < n; i++) {
+            const P2108Link &link = links[i];
+            double A_h_tx__db, A_h_rx__db, L_ctt__db = 0;
+            HeightGainTerminalCorrectionModel(
+                link.f__ghz,
+                link.tx.h__meter,
+                link.tx.w_s__meter,
+                link.tx.R__meter,
+                ClutterType::URBAN,
+                A_h_tx__db
+            );
+            HeightGainTerminalCorrectionModel(
+                link.f__ghz,
+                link.rx.h__meter,
+                link.rx.w_s__meter,
+                link.rx.R__meter,
+                ClutterType::URBAN,
+                A_h_rx__db
+            );
+            if (link.tx.h__meter < link.tx.R__meter
+                && link.rx.h__meter < link.rx.R__meter) {
+                TerrestrialStatisticalModel(
+                    link.f__ghz, link.d__km, link.p, L_ctt__db
+                );
+            }
+            total__db[i] = A_h_tx__db + A_h_rx__db + L_ctt__db;
+        }
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_Link_Models)->Apply(SetBatchArguments);
+
+/** Throughput of the fused link batch API */
+static void BM_Link_Batch(benchmark::State &state) {
+    const std::size_t n = static_cast<std::size_t>(state.range(0));
+    const std::vector<P2108Link> links = LinkSamples(n);
+    std::vector<P2108LinkCorrection> corrections(n);
+    for (auto _ : state) {
+        P2108LinkClutterCorrectionBatch(
+            n, links.data(), ABRAMOWITZ_STEGUN, corrections.data(), nullptr
+        );
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_Link_Batch)->Apply(SetBatchArguments);
@@ -0,0 +1,84 @@
+/** @file BenchInverseComplementaryCumulativeDistribution.cpp
+ * Benchmarks for the inverse complementary cumulative distribution function
+ */
+#include "BenchUtils.h"
+
+#include "P2108Kernels.h"
+
+#include <cstddef>  // for std::size_t
+#include <vector>   // for std::vector
+
+/** Latency of a single call, cycling through random valid inputs */
+static void BM_InverseCCDF_Single(benchmark::State &state) {
+    const std::size_t n = SINGLE_CALL_SAMPLES;
+    const std::vector<double> q = UniformSamples(PROBABILITY, n, 1);
+    std::size_t i = 0;
+    for (auto _ : state) {
+        double x = InverseComplementaryCumulativeDistribution(q[i]);
+        benchmark::DoNotOptimize(x);
+        i = (i + 1) % n;
+    }
+}
+BENCHMARK(BM_InverseCCDF_Single);
+
+/** Throughput of a loop over a batch of random valid inputs */
+static void BM_InverseCCDF_Batch(benchmark::State &state) {
+    const std::size_t n = static_cast<std::size_t>(state.range(0));
+    const std::vector<double> q = UniformSamples(PROBABILITY, n, 1);
+    std::vector<double> x(n);
+    for (auto _ : state) {
+        for (std::size_t i = 0; i < n; i++) {
+            x[i] = InverseComplementaryCumulativeDistribution(q[i]);
+        }
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_InverseCCDF_Batch)->Apply(SetBatchArguments);
+
+/** Throughput of a loop over a batch, by the given algorithm */
+static void BM_InverseCCDF_Algorithm(
+    benchmark::State &state,
+    const InverseCCDFAlgorithm algorithm,
+    const Domain domain
+) {
+    const std::size_t n = static_cast<std::size_t>(state.range(0));
+    const std::vector<double> q = UniformSamples(domain, n, 1);
+    std::vector<double> x(n);
+    for (auto _ : state) {
+        for (std::size_t i = 0; i < n; i++) {
+            x[i] = Inline::InverseComplementaryCumulativeDistribution(
+                q[i], algorithm
+            );
+        }
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+/** Percentages of the central region of PPND7, 7.5% to 92.5% */
+constexpr Domain CENTRAL_PROBABILITY = {0.075, 0.925};
+
+BENCHMARK_CAPTURE(
+    BM_InverseCCDF_Algorithm, AbramowitzStegun, ABRAMOWITZ_STEGUN, PROBABILITY
+)
+    ->Apply(SetBatchArguments);
+BENCHMARK_CAPTURE(
+    BM_InverseCCDF_Algorithm, PPND7, WICHURA_PPND7, PROBABILITY
+)
+    ->Apply(SetBatchArguments);
+BENCHMARK_CAPTURE(
+    BM_InverseCCDF_Algorithm, AS241, WICHURA_AS241, PROBABILITY
+)
+    ->Apply(SetBatchArguments);
+BENCHMARK_CAPTURE(
+    BM_InverseCCDF_Algorithm,
+    AbramowitzStegunCentral,
+    ABRAMOWITZ_STEGUN,
+    CENTRAL_PROBABILITY
+)
+    ->Apply(SetBatchArguments);
+BENCHMARK_CAPTURE(
+    BM_InverseCCDF_Algorithm, PPND7Central, WICHURA_PPND7, CENTRAL_PROBABILITY
+)
+    ->Apply(SetBatchArguments);
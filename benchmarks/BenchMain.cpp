@@ -0,0 +1,44 @@
+/** @file BenchMain.cpp
+ * Entry point of the benchmark executable
+ */
+#include "BenchUtils.h"
+
+#include <cstring>  // for std::strncmp
+#include <vector>   // for std::vector
+
+/*******************************************************************************
+ * Run the benchmarks, writing results to the console as JSON.
+ *
+ * JSON is used unless another format is selected with `--benchmark_format`.
+ * Use `--benchmark_out=<file>` to also write the results to a file, and
+ * `--benchmark_filter=<regex>` to select benchmarks.
+ *
+ * @param[in] argc  Number of arguments entered on the command line
+ * @param[in] argv  Array containing the provided command-line arguments
+ * @return          Exit code
+ ******************************************************************************/
+int main(int argc, char **argv) {
+    static char json_format[] = "--benchmark_format=json";
+    std::vector<char *> args(argv, argv + argc);
+    bool format_set = false;
+    for (int i = 1; i < argc; i++) {
+        if (std::strncmp(argv[i], "--benchmark_format", 18) == 0) {
+            format_set = true;
+        }
+    }
+    if (!format_set) {
+        args.push_back(json_format);
+    }
+    int n_args = static_cast<int>(args.size());
+    args.push_back(nullptr);
+
+    benchmark::Initialize(&n_args, args.data());
+    if (benchmark::ReportUnrecognizedArguments(n_args, args.data())) {
+        return 1;
+    }
+    benchmark::AddCustomContext("library", LIBRARY_NAME);
+    benchmark::AddCustomContext("library_version", LIBRARY_VERSION);
+    benchmark::RunSpecifiedBenchmarks();
+    benchmark::Shutdown();
+    return 0;
+}
@@ -0,0 +1,195 @@
+/** @file BenchTerrestrialStatisticalModel.cpp
+ * Benchmarks for the Terrestrial Statistical Model
+ */
+#include "BenchUtils.h"
+
+#include "P2108Batch.h"
+#include "P2108Jacobian.h"
+#include "P2108Sampler.h"
+
+#include <cstddef>  // for std::size_t
+#include <cstdint>  // for std::uint64_t
+#include <vector>   // for std::vector
+
+/** Latency of a single call, cycling through random valid inputs */
+static void BM_TSM_Single(benchmark::State &state) {
+    const std::size_t n = SINGLE_CALL_SAMPLES;
+    const std::vector<double> f__ghz = UniformSamples(TSM_F__GHZ, n, 1);
+    const std::vector<double> d__km = UniformSamples(TSM_D__KM, n, 2);
+    const std::vector<double> p = UniformSamples(PERCENTAGE, n, 3);
+    std::size_t i = 0;
+    double L_ctt__db;
+    for (auto _ : state) {
+        ReturnCode rtn
+            = TerrestrialStatisticalModel(f__ghz[i], d__km[i], p[i], L_ctt__db);
+        benchmark::DoNotOptimize(rtn);
+        benchmark::DoNotOptimize(L_ctt__db);
+        i = (i + 1) % n;
+    }
+}
+BENCHMARK(BM_TSM_Single);
+
+/** Throughput of a loop over a batch of random valid inputs */
+static void BM_TSM_Batch(benchmark::State &state) {
+    const std::size_t n = static_cast<std::size_t>(state.range(0));
+    const std::vector<double> f__ghz = UniformSamples(TSM_F__GHZ, n, 1);
+    const std::vector<double> d__km = UniformSamples(TSM_D__KM, n, 2);
+    const std::vector<double> p = UniformSamples(PERCENTAGE, n, 3);
+    std::vector<double> L_ctt__db(n);
+    for (auto _ : state) {
+        for (std::size_t i = 0; i < n; i++) {
+            TerrestrialStatisticalModel(
+                f__ghz[i], d__km[i], p[i], L_ctt__db[i]
+            );
+        }
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_TSM_Batch)->Apply(SetBatchArguments);
+
+/** Throughput of the tiled batch API, over batch and tile sizes */
+static void BM_TSM_BatchAPI(benchmark::State &state) {
+    const std::size_t n = static_cast<std::size_t>(state.range(0));
+    const std::vector<double> f__ghz = UniformSamples(TSM_F__GHZ, n, 1);
+    const std::vector<double> d__km = UniformSamples(TSM_D__KM, n, 2);
+    const std::vector<double> p = UniformSamples(PERCENTAGE, n, 3);
+    std::vector<double> L_ctt__db(n);
+    std::vector<int> rtn(n);
+    P2108SetBatchTileSize(static_cast<std::size_t>(state.range(1)));
+    for (auto _ : state) {
+        P2108TerrestrialStatisticalModelBatch(
+            n,
+            f__ghz.data(),
+            sizeof(double),
+            d__km.data(),
+            sizeof(double),
+            p.data(),
+            sizeof(double),
+            ABRAMOWITZ_STEGUN,
+            L_ctt__db.data(),
+            sizeof(double),
+            rtn.data(),
+            sizeof(int)
+        );
+        benchmark::ClobberMemory();
+    }
+    state.counters["tile"] = static_cast<double>(P2108GetBatchTileSize());
+    P2108SetBatchTileSize(0);
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_TSM_BatchAPI)->Apply(SetTiledBatchArguments);
+
+/** Throughput of Monte Carlo draws at one geometry, by uniform percentages */
+static void BM_TSM_MonteCarloUniform(benchmark::State &state) {
+    const std::size_t n = static_cast<std::size_t>(state.range(0));
+    const std::vector<double> p = UniformSamples(PERCENTAGE, n, 3);
+    std::vector<double> L_ctt__db(n);
+    for (auto _ : state) {
+        for (std::size_t i = 0; i < n; i++) {
+            TerrestrialStatisticalModel(26.6, 15.8, p[i], L_ctt__db[i]);
+        }
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_TSM_MonteCarloUniform)->Apply(SetBatchArguments);
+
+/** Throughput of Monte Carlo draws at one geometry, by the sampler */
+static void BM_TSM_MonteCarloSampler(benchmark::State &state) {
+    const std::size_t n = static_cast<std::size_t>(state.range(0));
+    std::vector<double> L_ctt__db(n);
+    std::uint64_t first = 0;
+    for (auto _ : state) {
+        P2108TerrestrialStatisticalModelSamples(
+            26.6, 15.8, 1, 0, first, n, L_ctt__db.data()
+        );
+        first += n;
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_TSM_MonteCarloSampler)->Apply(SetBatchArguments);
+
+/** Throughput of gradients by central finite differences of the model */
+static void BM_TSM_FiniteDifferenceGradient(benchmark::State &state) {
+    const std::size_t n = static_cast<std::size_t>(state.range(0));
+    const std::vector<double> f__ghz = UniformSamples(TSM_F__GHZ, n, 1);
+    const std::vector<double> d__km = UniformSamples(TSM_D__KM, n, 2);
+    const std::vector<double> p = UniformSamples(PERCENTAGE, n, 3);
+    std::vector<P2108TSMJacobian> jacobian(n);
+    const double h = 1e-6;
+    const auto model = [](const double f, const double d, const double q) {
+        double L_ctt__db;
+        TerrestrialStatisticalModel(f, d, q, L_ctt__db);
+        return L_ctt__db;
+    };
+    for (auto _ : state) {
+        for (std::size_t i = 0; i < n; i++) {
+            const double f = f__ghz[i], d = d__km[i], q = p[i];
+            jacobian[i].L_ctt__db = model(f, d, q);
+            jacobian[i].dL_ctt__df
+                = (model(f + h, d, q) - model(f - h, d, q)) / (2 * h);
+            jacobian[i].dL_ctt__dd
+                = (model(f, d + h, q) - model(f, d - h, q)) / (2 * h);
+            jacobian[i].dL_ctt__dp
+                = (model(f, d, q + h) - model(f, d, q - h)) / (2 * h);
+        }
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_TSM_FiniteDifferenceGradient)->Apply(SetBatchArguments);
+
+/** Throughput of gradients by the analytic Jacobian API */
+static void BM_TSM_Jacobian(benchmark::State &state) {
+    const std::size_t n = static_cast<std::size_t>(state.range(0));
+    const std::vector<double> f__ghz = UniformSamples(TSM_F__GHZ, n, 1);
+    const std::vector<double> d__km = UniformSamples(TSM_D__KM, n, 2);
+    const std::vector<double> p = UniformSamples(PERCENTAGE, n, 3);
+    std::vector<P2108TSMJacobian> jacobian(n);
+    for (auto _ : state) {
+        P2108TerrestrialStatisticalModelJacobian(
+            n,
+            f__ghz.data(),
+            d__km.data(),
+            p.data(),
+            ABRAMOWITZ_STEGUN,
+            jacobian.data(),
+            nullptr
+        );
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_TSM_Jacobian)->Apply(SetBatchArguments);
+
+/** Throughput of interpolation in a precomputed surface file */
+static void BM_TSM_Surface(benchmark::State &state) {
+    const std::size_t n = static_cast<std::size_t>(state.range(0));
+    const std::vector<double> f__ghz = UniformSamples(TSM_F__GHZ, n, 1);
+    const std::vector<double> d__km = UniformSamples(TSM_D__KM, n, 2);
+    const std::vector<double> p = UniformSamples(PERCENTAGE, n, 3);
+    std::vector<double> L_ctt__db(n);
+    P2108Surface *surface = OpenDefaultSurface();
+    if (surface == nullptr) {
+        state.SkipWithError("Failed to open the surface file");
+        return;
+    }
+    for (auto _ : state) {
+        P2108SurfaceTerrestrialStatisticalModel(
+            surface,
+            n,
+            f__ghz.data(),
+            d__km.data(),
+            p.data(),
+            ABRAMOWITZ_STEGUN,
+            L_ctt__db.data(),
+            nullptr
+        );
+        benchmark::ClobberMemory();
+    }
+    P2108SurfaceClose(surface);
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_TSM_Surface)->Apply(SetBatchArguments);
@@ -0,0 +1,56 @@
+/** @file BenchUtils.cpp
+ * Primary implementations for common functions used by benchmarks.
+ */
+#include "BenchUtils.h"
+
+#include <cstdio>  // for std::remove
+
+/*******************************************************************************
+ * Configure a batch throughput benchmark to run over all batch sizes.
+ *
+ * Batch sizes run from 1 to `MAX_BATCH_SIZE` in powers of 10, and throughput
+ * is reported as records per second.
+ *
+ * @param[in] bench  Benchmark to configure
+ ******************************************************************************/
+void SetBatchArguments(benchmark::internal::Benchmark *bench) {
+    bench->ArgName("n")->RangeMultiplier(10)->Range(1, MAX_BATCH_SIZE);
+    bench->Unit(benchmark::kMicrosecond);
+}
+
+/*******************************************************************************
+ * Configure a batch API benchmark to run over batch and tile sizes.
+ *
+ * Batch sizes run from 1000 to `MAX_TILED_BATCH_SIZE` in powers of 10. Tile
+ * sizes run from 64 to 65536 records in powers of 4, and each run reports
+ * its tile size as the `tile` counter.
+ *
+ * @param[in] bench  Benchmark to configure
+ ******************************************************************************/
+void SetTiledBatchArguments(benchmark::internal::Benchmark *bench) {
+    bench->ArgNames({"n", "tile"});
+    for (std::int64_t n = 1000; n <= MAX_TILED_BATCH_SIZE; n *= 10) {
+        for (std::int64_t tile = 64; tile <= 65536; tile *= 4) {
+            bench->Args({n, tile});
+        }
+    }
+    bench->Unit(benchmark::kMicrosecond);
+}
+
+/*******************************************************************************
+ * Write a surface file with the default grids, and open it.
+ *
+ * The file is removed once it is open, so the caller need only close it.
+ *
+ * @return  Surface handle, or `NULL` if the file could not be opened
+ ******************************************************************************/
+P2108Surface *OpenDefaultSurface() {
+    const char *path = "bench_surface.p2108";
+    P2108SurfaceSpec spec;
+    P2108SurfaceDefaultSpec(P2108_SURFACE_DEFAULT_NODES, &spec);
+    P2108SurfaceWrite(path, &spec);
+    P2108Surface *surface;
+    P2108SurfaceOpen(path, &surface);
+    std::remove(path);
+    return surface;
+}
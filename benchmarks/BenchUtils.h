@@ -0,0 +1,28 @@
+/** @file BenchUtils.h
+ * Primary header for common functions and constants used by benchmarks.
+ */
+#pragma once
+
+#include "P2108.h"
+#include "P2108Surface.h"
+#include "Samples.h"
+
+#include <benchmark/benchmark.h>  // Google Benchmark
+
+#include <cstddef>  // for std::size_t
+#include <cstdint>  // for std::int64_t
+
+using namespace ITS::ITU::PSeries::P2108;
+
+/** Number of distinct input sets cycled through by single-call benchmarks */
+constexpr std::size_t SINGLE_CALL_SAMPLES = 4096;
+
+/** Largest batch size used by batch throughput benchmarks */
+constexpr std::int64_t MAX_BATCH_SIZE = 10000000;
+
+/** Largest batch size used by tiled batch benchmarks */
+constexpr std::int64_t MAX_TILED_BATCH_SIZE = 1000000;
+
+void SetBatchArguments(benchmark::internal::Benchmark *bench);
+void SetTiledBatchArguments(benchmark::internal::Benchmark *bench);
+P2108Surface *OpenDefaultSurface();
@@ -0,0 +1,560 @@
+/** @file Implementations.cpp
+ * Implements the registry of model implementations.
+ *
+ * The first implementation registered for each function is the scalar
+ * reference implementation, against which all others are compared.
+ *
+ * The library has no kernels written with SIMD intrinsics for any
+ * instruction set. The nearest are the "pack4" implementations, which run
+ * the generic kernels over `Pack<double, 4>` lanes that the compiler may
+ * vectorize for the target it builds for. The Height Gain Terminal
+ * Correction Model, which branches on the clutter type of each record, has no
+ * packed implementation.
+ */
+#include "Implementations.h"
+
+#include "P2108.h"
+#include "P2108Batch.h"
+#include "P2108Generic.h"
+#include "P2108Kernels.h"
+#include "P2108Numeric.h"
+#include "P2108Surface.h"
+
+#include <cstddef>   // for std::ptrdiff_t, std::size_t
+#include <cstdio>    // for std::remove
+#include <cstdlib>   // for std::exit
+#include <iostream>  // for std::cerr
+#include <ostream>   // for std::endl
+#include <string>    // for std::string, std::to_string
+#include <vector>    // for std::vector
+
+#ifdef _WIN32
+    #include <process.h>  // for _getpid
+    #define getpid _getpid
+#else
+    #include <unistd.h>  // for getpid
+#endif
+
+using namespace ITS::ITU::PSeries::P2108;
+
+namespace {
+/** Scalar reference implementation of the Aeronautical Statistical Model */
+void ScalarASM(
+    const double *const *inputs, const std::size_t n, int *rtn, double *out
+) {
+    for (std::size_t i = 0; i < n; i++) {
+        rtn[i] = AeronauticalStatisticalModel(
+            inputs[0][i], inputs[1][i], inputs[2][i], out[i]
+        );
+    }
+}
+
+/** Scalar reference implementation of the Terrestrial Statistical Model */
+void ScalarTSM(
+    const double *const *inputs, const std::size_t n, int *rtn, double *out
+) {
+    for (std::size_t i = 0; i < n; i++) {
+        rtn[i] = TerrestrialStatisticalModel(
+            inputs[0][i], inputs[1][i], inputs[2][i], out[i]
+        );
+    }
+}
+
+/** Scalar reference implementation of the Height Gain Terminal Correction
+ *  Model */
+void ScalarHGTCM(
+    const double *const *inputs, const std::size_t n, int *rtn, double *out
+) {
+    for (std::size_t i = 0; i < n; i++) {
+        rtn[i] = HeightGainTerminalCorrectionModel(
+            inputs[0][i],
+            inputs[1][i],
+            inputs[2][i],
+            inputs[3][i],
+            static_cast<ClutterType>(static_cast<int>(inputs[4][i])),
+            out[i]
+        );
+    }
+}
+
+/** Scalar reference implementation of the inverse CCDF */
+void ScalarICCD(
+    const double *const *inputs, const std::size_t n, int *rtn, double *out
+) {
+    for (std::size_t i = 0; i < n; i++) {
+        out[i] = InverseComplementaryCumulativeDistribution(inputs[0][i]);
+        rtn[i] = SUCCESS;
+    }
+}
+
+/** Header-only implementation of the Aeronautical Statistical Model */
+void InlineASM(
+    const double *const *inputs, const std::size_t n, int *rtn, double *out
+) {
+    for (std::size_t i = 0; i < n; i++) {
+        rtn[i] = Inline::AeronauticalStatisticalModel(
+            inputs[0][i], inputs[1][i], inputs[2][i], out[i]
+        );
+    }
+}
+
+/** Header-only implementation of the Terrestrial Statistical Model */
+void InlineTSM(
+    const double *const *inputs, const std::size_t n, int *rtn, double *out
+) {
+    for (std::size_t i = 0; i < n; i++) {
+        rtn[i] = Inline::TerrestrialStatisticalModel(
+            inputs[0][i], inputs[1][i], inputs[2][i], out[i]
+        );
+    }
+}
+
+/** Header-only implementation of the Height Gain Terminal Correction Model */
+void InlineHGTCM(
+    const double *const *inputs, const std::size_t n, int *rtn, double *out
+) {
+    for (std::size_t i = 0; i < n; i++) {
+        rtn[i] = Inline::HeightGainTerminalCorrectionModel(
+            inputs[0][i],
+            inputs[1][i],
+            inputs[2][i],
+            inputs[3][i],
+            static_cast<ClutterType>(static_cast<int>(inputs[4][i])),
+            out[i]
+        );
+    }
+}
+
+/** Header-only implementation of the inverse CCDF */
+void InlineICCD(
+    const double *const *inputs, const std::size_t n, int *rtn, double *out
+) {
+    for (std::size_t i = 0; i < n; i++) {
+        out[i] = Inline::InverseComplementaryCumulativeDistribution(
+            inputs[0][i]
+        );
+        rtn[i] = SUCCESS;
+    }
+}
+
+/** Inverse CCDF by algorithm PPND7 of Wichura (AS241) */
+void PPND7ICCD(
+    const double *const *inputs, const std::size_t n, int *rtn, double *out
+) {
+    for (std::size_t i = 0; i < n; i++) {
+        out[i] = Inline::InverseComplementaryCumulativeDistributionPPND7(
+            inputs[0][i]
+        );
+        rtn[i] = SUCCESS;
+    }
+}
+
+/** Inverse CCDF by algorithm PPND16 of Wichura (AS241) */
+void AS241ICCD(
+    const double *const *inputs, const std::size_t n, int *rtn, double *out
+) {
+    for (std::size_t i = 0; i < n; i++) {
+        out[i] = Inline::InverseComplementaryCumulativeDistributionAS241(
+            inputs[0][i]
+        );
+        rtn[i] = SUCCESS;
+    }
+}
+
+/** Single precision implementation of the Aeronautical Statistical Model */
+void Float32ASM(
+    const double *const *inputs, const std::size_t n, int *rtn, double *out
+) {
+    for (std::size_t i = 0; i < n; i++) {
+        rtn[i] = Inline::Section3p3_InputValidation(
+            inputs[0][i], inputs[1][i], inputs[2][i]
+        );
+        if (rtn[i] == SUCCESS) {
+            out[i] = Generic::AeronauticalStatisticalModel(
+                static_cast<float>(inputs[0][i]),
+                static_cast<float>(inputs[1][i]),
+                static_cast<float>(inputs[2][i])
+            );
+        }
+    }
+}
+
+/** Single precision implementation of the Terrestrial Statistical Model */
+void Float32TSM(
+    const double *const *inputs, const std::size_t n, int *rtn, double *out
+) {
+    for (std::size_t i = 0; i < n; i++) {
+        rtn[i] = Inline::Section3p2_InputValidation(
+            inputs[0][i], inputs[1][i], inputs[2][i]
+        );
+        if (rtn[i] == SUCCESS) {
+            out[i] = Generic::TerrestrialStatisticalModel(
+                static_cast<float>(inputs[0][i]),
+                static_cast<float>(inputs[1][i]),
+                static_cast<float>(inputs[2][i])
+            );
+        }
+    }
+}
+
+/** Single precision implementation of the Height Gain Terminal Correction
+ *  Model */
+void Float32HGTCM(
+    const double *const *inputs, const std::size_t n, int *rtn, double *out
+) {
+    for (std::size_t i = 0; i < n; i++) {
+        rtn[i] = Inline::Section3p1_InputValidation(
+            inputs[0][i], inputs[1][i], inputs[2][i], inputs[3][i]
+        );
+        if (rtn[i] != SUCCESS) {
+            continue;
+        }
+        const float f__ghz = static_cast<float>(inputs[0][i]);
+        const float h__meter = static_cast<float>(inputs[1][i]);
+        const float w_s__meter = static_cast<float>(inputs[2][i]);
+        const float R__meter = static_cast<float>(inputs[3][i]);
+        if (h__meter >= R__meter) {
+            out[i] = 0;
+            continue;
+        }
+        const float h_dif__meter = R__meter - h__meter;  // Equation (2d)
+        switch (static_cast<ClutterType>(static_cast<int>(inputs[4][i]))) {
+            case ClutterType::WATER_SEA:
+            case ClutterType::OPEN_RURAL:
+                out[i] = Generic::Equation_2b(
+                    Generic::Equation_2f(f__ghz), h__meter, R__meter
+                );
+                break;
+
+            case ClutterType::SUBURBAN:
+            case ClutterType::URBAN:
+            case ClutterType::TREES_FOREST:
+            case ClutterType::DENSE_URBAN:
+                out[i] = Generic::Equation_2a(Generic::Equation_2c(
+                    Generic::Equation_2g(f__ghz),
+                    h_dif__meter,
+                    Generic::Equation_2e(h_dif__meter, w_s__meter)
+                ));
+                break;
+            default:
+                rtn[i] = ERROR31__CLUTTER_TYPE;
+        }
+    }
+}
+
+/** Single precision implementation of the inverse CCDF */
+void Float32ICCD(
+    const double *const *inputs, const std::size_t n, int *rtn, double *out
+) {
+    for (std::size_t i = 0; i < n; i++) {
+        out[i] = Generic::InverseComplementaryCumulativeDistribution(
+            static_cast<float>(inputs[0][i])
+        );
+        rtn[i] = SUCCESS;
+    }
+}
+
+/** Number of records evaluated together by the packed implementations */
+constexpr std::size_t PACK_LANES = 4;
+
+/** Lanes of the packed implementations */
+typedef Pack<double, PACK_LANES> Pack4;
+
+/** Packed implementation of the Aeronautical Statistical Model */
+void Pack4ASM(
+    const double *const *inputs, const std::size_t n, int *rtn, double *out
+) {
+    for (std::size_t i = 0; i < n; i++) {
+        rtn[i] = Inline::Section3p3_InputValidation(
+            inputs[0][i], inputs[1][i], inputs[2][i]
+        );
+    }
+    // Invalid records are evaluated too, and their results ignored
+    std::size_t i = 0;
+    for (; i + PACK_LANES <= n; i += PACK_LANES) {
+        const Pack4 loss = Generic::AeronauticalStatisticalModel(
+            Pack4::Load(inputs[0] + i),
+            Pack4::Load(inputs[1] + i),
+            Pack4::Load(inputs[2] + i)
+        );
+        loss.Store(out + i);
+    }
+    for (; i < n; i++) {
+        out[i] = Generic::AeronauticalStatisticalModel(
+            inputs[0][i], inputs[1][i], inputs[2][i]
+        );
+    }
+}
+
+/** Packed implementation of the Terrestrial Statistical Model */
+void Pack4TSM(
+    const double *const *inputs, const std::size_t n, int *rtn, double *out
+) {
+    for (std::size_t i = 0; i < n; i++) {
+        rtn[i] = Inline::Section3p2_InputValidation(
+            inputs[0][i], inputs[1][i], inputs[2][i]
+        );
+    }
+    // Invalid records are evaluated too, and their results ignored
+    std::size_t i = 0;
+    for (; i + PACK_LANES <= n; i += PACK_LANES) {
+        const Pack4 loss = Generic::TerrestrialStatisticalModel(
+            Pack4::Load(inputs[0] + i),
+            Pack4::Load(inputs[1] + i),
+            Pack4::Load(inputs[2] + i)
+        );
+        loss.Store(out + i);
+    }
+    for (; i < n; i++) {
+        out[i] = Generic::TerrestrialStatisticalModel(
+            inputs[0][i], inputs[1][i], inputs[2][i]
+        );
+    }
+}
+
+/** Packed implementation of the inverse CCDF */
+void Pack4ICCD(
+    const double *const *inputs, const std::size_t n, int *rtn, double *out
+) {
+    std::size_t i = 0;
+    for (; i + PACK_LANES <= n; i += PACK_LANES) {
+        const Pack4 q = Generic::InverseComplementaryCumulativeDistribution(
+            Pack4::Load(inputs[0] + i)
+        );
+        q.Store(out + i);
+    }
+    for (; i < n; i++) {
+        out[i] = Generic::InverseComplementaryCumulativeDistribution(
+            inputs[0][i]
+        );
+    }
+    for (std::size_t j = 0; j < n; j++) {
+        rtn[j] = SUCCESS;
+    }
+}
+
+/** Strided batch implementation of the Aeronautical Statistical Model */
+void BatchASM(
+    const double *const *inputs, const std::size_t n, int *rtn, double *out
+) {
+    const std::ptrdiff_t stride = sizeof(double);
+    P2108AeronauticalStatisticalModelBatch(
+        n,
+        inputs[0],
+        stride,
+        inputs[1],
+        stride,
+        inputs[2],
+        stride,
+        ABRAMOWITZ_STEGUN,
+        out,
+        stride,
+        rtn,
+        sizeof(int)
+    );
+}
+
+/** Strided batch implementation of the Terrestrial Statistical Model */
+void BatchTSM(
+    const double *const *inputs, const std::size_t n, int *rtn, double *out
+) {
+    const std::ptrdiff_t stride = sizeof(double);
+    P2108TerrestrialStatisticalModelBatch(
+        n,
+        inputs[0],
+        stride,
+        inputs[1],
+        stride,
+        inputs[2],
+        stride,
+        ABRAMOWITZ_STEGUN,
+        out,
+        stride,
+        rtn,
+        sizeof(int)
+    );
+}
+
+/** Strided batch implementation of the Height Gain Terminal Correction
+ *  Model */
+void BatchHGTCM(
+    const double *const *inputs, const std::size_t n, int *rtn, double *out
+) {
+    const std::ptrdiff_t stride = sizeof(double);
+    const std::vector<int> clutter_type(inputs[4], inputs[4] + n);
+    P2108HeightGainTerminalCorrectionModelBatch(
+        n,
+        inputs[0],
+        stride,
+        inputs[1],
+        stride,
+        inputs[2],
+        stride,
+        inputs[3],
+        stride,
+        clutter_type.data(),
+        sizeof(int),
+        out,
+        stride,
+        rtn,
+        sizeof(int)
+    );
+}
+
+/*******************************************************************************
+ * Get the surface with the default grids, written and opened on first use.
+ *
+ * The file is removed once it is open, and the surface stays open until the
+ * process exits. Exits the process if the file cannot be written or opened.
+ *
+ * @return  Surface handle
+ ******************************************************************************/
+const P2108Surface *GetDefaultSurface() {
+    static P2108Surface *surface = nullptr;
+    if (surface == nullptr) {
+        const std::string path = "accuracy_surface_"
+                               + std::to_string(static_cast<long>(getpid()))
+                               + ".p2108";
+        P2108SurfaceSpec spec;
+        P2108SurfaceDefaultSpec(P2108_SURFACE_DEFAULT_NODES, &spec);
+        int status = P2108SurfaceWrite(path.c_str(), &spec);
+        if (status == P2108_SURFACE_SUCCESS) {
+            status = P2108SurfaceOpen(path.c_str(), &surface);
+        }
+        std::remove(path.c_str());
+        if (status != P2108_SURFACE_SUCCESS) {
+            std::cerr << "Error creating surface file " << path << " (status "
+                      << status << ")" << std::endl;
+            std::exit(1);
+        }
+    }
+    return surface;
+}
+
+/** Surface lookup implementation of the Aeronautical Statistical Model */
+void SurfaceASM(
+    const double *const *inputs, const std::size_t n, int *rtn, double *out
+) {
+    P2108SurfaceAeronauticalStatisticalModel(
+        GetDefaultSurface(),
+        n,
+        inputs[0],
+        inputs[1],
+        inputs[2],
+        ABRAMOWITZ_STEGUN,
+        out,
+        rtn
+    );
+}
+
+/** Surface lookup implementation of the Terrestrial Statistical Model */
+void SurfaceTSM(
+    const double *const *inputs, const std::size_t n, int *rtn, double *out
+) {
+    P2108SurfaceTerrestrialStatisticalModel(
+        GetDefaultSurface(),
+        n,
+        inputs[0],
+        inputs[1],
+        inputs[2],
+        ABRAMOWITZ_STEGUN,
+        out,
+        rtn
+    );
+}
+
+/** Surface lookup implementation of the Height Gain Terminal Correction
+ *  Model */
+void SurfaceHGTCM(
+    const double *const *inputs, const std::size_t n, int *rtn, double *out
+) {
+    const std::vector<int> clutter_type(inputs[4], inputs[4] + n);
+    P2108SurfaceHeightGainTerminalCorrectionModel(
+        GetDefaultSurface(),
+        n,
+        inputs[0],
+        inputs[1],
+        inputs[2],
+        inputs[3],
+        clutter_type.data(),
+        out,
+        rtn
+    );
+}
+}  // namespace
+
+/*******************************************************************************
+ * Get the display name of a model function.
+ *
+ * @param[in] model  Model function
+ * @return           Display name
+ ******************************************************************************/
+const char *GetModelFunctionName(const ModelFunction model) {
+    switch (model) {
+        case ModelFunction::ASM:
+            return "ASM";
+        case ModelFunction::TSM:
+            return "TSM";
+        case ModelFunction::HGTCM:
+            return "HGTCM";
+        case ModelFunction::ICCD:
+            return "InverseCCDF";
+    }
+    return "";
+}
+
+/*******************************************************************************
+ * Get the number of input columns of a model function.
+ *
+ * @param[in] model  Model function
+ * @return           Number of inputs
+ ******************************************************************************/
+std::size_t GetModelFunctionInputCount(const ModelFunction model) {
+    switch (model) {
+        case ModelFunction::ASM:
+        case ModelFunction::TSM:
+            return 3;
+        case ModelFunction::HGTCM:
+            return 5;
+        case ModelFunction::ICCD:
+            return 1;
+    }
+    return 0;
+}
+
+/*******************************************************************************
+ * Get all registered implementations.
+ *
+ * New implementations (e.g., batch or reduced-precision variants) should be
+ * added to this list. The first entry for each function is its reference.
+ *
+ * @return  Registered implementations
+ ******************************************************************************/
+const std::vector<Implementation> &GetImplementations() {
+    static const std::vector<Implementation> implementations = {
+        {ModelFunction::ASM, "scalar", ScalarASM},
+        {ModelFunction::TSM, "scalar", ScalarTSM},
+        {ModelFunction::HGTCM, "scalar", ScalarHGTCM},
+        {ModelFunction::ICCD, "scalar", ScalarICCD},
+        {ModelFunction::ASM, "inline", InlineASM},
+        {ModelFunction::TSM, "inline", InlineTSM},
+        {ModelFunction::HGTCM, "inline", InlineHGTCM},
+        {ModelFunction::ICCD, "inline", InlineICCD},
+        {ModelFunction::ASM, "batch", BatchASM},
+        {ModelFunction::TSM, "batch", BatchTSM},
+        {ModelFunction::HGTCM, "batch", BatchHGTCM},
+        {ModelFunction::ASM, "surface", SurfaceASM},
+        {ModelFunction::TSM, "surface", SurfaceTSM},
+        {ModelFunction::HGTCM, "surface", SurfaceHGTCM},
+        {ModelFunction::ICCD, "ppnd7", PPND7ICCD},
+        {ModelFunction::ICCD, "as241", AS241ICCD},
+        {ModelFunction::ASM, "float32", Float32ASM},
+        {ModelFunction::TSM, "float32", Float32TSM},
+        {ModelFunction::HGTCM, "float32", Float32HGTCM},
+        {ModelFunction::ICCD, "float32", Float32ICCD},
+        {ModelFunction::ASM, "pack4", Pack4ASM},
+        {ModelFunction::TSM, "pack4", Pack4TSM},
+        {ModelFunction::ICCD, "pack4", Pack4ICCD},
+    };
+    return implementations;
+}
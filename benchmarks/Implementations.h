@@ -0,0 +1,42 @@
+/** @file Implementations.h
+ * Registry of the model implementations compared by the accuracy harness.
+ */
+#pragma once
+
+#include <cstddef>  // for std::size_t
+#include <vector>   // for std::vector
+
+/** Functions whose implementations may be compared */
+enum class ModelFunction {
+    ASM,   /**< Aeronautical Statistical Model */
+    TSM,   /**< Terrestrial Statistical Model */
+    HGTCM, /**< Height Gain Terminal Correction Model */
+    ICCD,  /**< Inverse complementary cumulative distribution */
+};
+
+/*******************************************************************************
+ * Evaluate a batch of records.
+ *
+ * Inputs are given as columns, in the order of the parameters of the library
+ * function. Clutter types are stored as doubles. The inverse complementary
+ * cumulative distribution has no return code, and always writes `SUCCESS`.
+ *
+ * @param[in]  inputs  Input columns, each of length `n`
+ * @param[in]  n       Number of records
+ * @param[out] rtn     Return code of each record
+ * @param[out] out     Result of each record
+ ******************************************************************************/
+typedef void (*ModelKernel)(
+    const double *const *inputs, const std::size_t n, int *rtn, double *out
+);
+
+/** A named implementation of one of the model functions */
+struct Implementation {
+        ModelFunction model; /**< Function which is implemented */
+        const char *name;    /**< Short, unique name of the implementation */
+        ModelKernel kernel;  /**< Batch evaluation function */
+};
+
+const char *GetModelFunctionName(const ModelFunction model);
+std::size_t GetModelFunctionInputCount(const ModelFunction model);
+const std::vector<Implementation> &GetImplementations();
@@ -0,0 +1,36 @@
+/** @file Samples.cpp
+ * Implements random sampling of the valid input domains.
+ */
+#include "Samples.h"
+
+#include <cmath>    // for std::nextafter
+#include <cstddef>  // for std::size_t
+#include <cstdint>  // for std::uint64_t
+#include <random>   // for std::mt19937_64, std::uniform_real_distribution
+#include <vector>   // for std::vector
+
+/*******************************************************************************
+ * Draw uniformly distributed samples from the open interval of a domain.
+ *
+ * The endpoints are excluded so that every sample is valid for inputs with
+ * exclusive limits (e.g., percentages, or heights which must be positive).
+ * A fixed seed keeps the inputs identical from run to run.
+ *
+ * @param[in] domain  Interval from which to draw samples
+ * @param[in] n       Number of samples
+ * @param[in] seed    Seed of the random number generator
+ * @return            The samples
+ ******************************************************************************/
+std::vector<double> UniformSamples(
+    const Domain &domain, const std::size_t n, const std::uint64_t seed
+) {
+    std::mt19937_64 rng(seed);
+    std::uniform_real_distribution<double> dist(
+        std::nextafter(domain.min, domain.max), domain.max
+    );
+    std::vector<double> samples(n);
+    for (double &x : samples) {
+        x = dist(rng);
+    }
+    return samples;
+}
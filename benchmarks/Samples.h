@@ -0,0 +1,37 @@
+/** @file Samples.h
+ * Valid input domains and random sampling used by benchmarks and the accuracy
+ * harness.
+ */
+#pragma once
+
+#include <cstddef>  // for std::size_t
+#include <cstdint>  // for std::uint64_t
+#include <vector>   // for std::vector
+
+/*******************************************************************************
+ * Interval from which benchmark inputs are drawn.
+ *
+ * Where the valid domain of an input is unbounded (e.g., the path distance of
+ * the terrestrial statistical model), a representative upper limit is used.
+ ******************************************************************************/
+struct Domain {
+        double min; /**< Lower limit of the interval */
+        double max; /**< Upper limit of the interval */
+};
+
+// Valid domains of the model inputs (see the input validation functions)
+constexpr Domain ASM_F__GHZ = {10, 100};
+constexpr Domain ASM_THETA__DEG = {0, 90};
+constexpr Domain TSM_F__GHZ = {0.5, 67};
+constexpr Domain TSM_D__KM = {0.25, 100};
+constexpr Domain HGTCM_F__GHZ = {0.03, 3};
+constexpr Domain HGTCM_H__METER = {0, 30};
+constexpr Domain HGTCM_W_S__METER = {0, 50};
+constexpr Domain HGTCM_R__METER = {0, 30};
+constexpr Domain CLUTTER_TYPE = {1, 7};  // Truncate samples to get the enum
+constexpr Domain PERCENTAGE = {0, 100};
+constexpr Domain PROBABILITY = {0, 1};
+
+std::vector<double> UniformSamples(
+    const Domain &domain, const std::size_t n, const std::uint64_t seed
+);
@@ -3,6 +3,7 @@
  */
 #pragma once
 
+#include <cstddef>        // for std::size_t
 #include <string>         // for std::string
 #include <unordered_map>  // for std::unordered_map
 
@@ -51,6 +52,17 @@ enum RepresentativeClutterHeight {
     R__DENSE_URBAN = 20,  /**< @f$ R @f$ for the dense urban clutter type */
 };
 
+/*******************************************************************************
+ * Algorithms of the inverse complementary cumulative distribution function,
+ * selected per call by the batch, Jacobian, link, raster, track and surface
+ * functions. The scalar models always use `ABRAMOWITZ_STEGUN`.
+ ******************************************************************************/
+enum InverseCCDFAlgorithm {
+    ABRAMOWITZ_STEGUN = 0, /**< A&S 26.2.23, per ITU-R P.1057 (default) */
+    WICHURA_PPND7 = 1,     /**< AS241 PPND7, ~1e-7, no log near the median */
+    WICHURA_AS241 = 2,     /**< AS241 PPND16, ~1e-16, for reference */
+};
+
 /*******************************************************************************
  * Return Codes defined by this software (0-127)
  ******************************************************************************/
@@ -77,6 +89,16 @@ enum ReturnCode {
 };
 // clang-format on
 
+////////////////////////////////////////////////////////////////////////////////
+// Data Structures
+
+/** Number of occurrences of one return code, from `GetReturnStatusHistogram` */
+struct ReturnStatusCount {
+        ReturnCode code;     /**< Return code */
+        std::size_t count;   /**< Number of occurrences of the code */
+        const char *message; /**< Interned status message */
+};
+
 ////////////////////////////////////////////////////////////////////////////////
 // Constants
 /** Approximate value of @f$ \pi @f$ */
@@ -103,12 +125,22 @@ PROPLIB_API ReturnCode HeightGainTerminalCorrectionModel(
 );
 PROPLIB_API char *GetReturnStatusCharArray(const int code);
 PROPLIB_API void FreeReturnStatusCharArray(char *c_msg);
+PROPLIB_API const char *GetReturnStatusMessage(const int code);
+PROPLIB_API std::size_t GetReturnStatusHistogram(
+    const ReturnCode *codes,
+    const std::size_t n,
+    ReturnStatusCount *counts,
+    const std::size_t max_counts
+);
 
 ////////////////////////////////////////////////////////////////////////////////
 // Private Functions
 std::string GetReturnStatus(const int code);
 double cot(const double x);
 double InverseComplementaryCumulativeDistribution(const double q);
+double InverseComplementaryCumulativeDistribution(
+    const double q, const InverseCCDFAlgorithm algorithm
+);
 double Equation_2a(const double nu);
 double Equation_2b(
     const double K_h2, const double h__meter, const double R__meter
@@ -0,0 +1,22 @@
+/** @file P2108Api.h
+ * Export macro for the C interfaces of the library.
+ *
+ * `P2108.h` declares its exported functions with `PROPLIB_API`, which
+ * includes `extern "C"` and so is only valid in C++. The headers which may
+ * also be included from C declare their exported functions with
+ * `PROPLIB_C_API` instead, inside an `extern "C"` block.
+ *
+ * This header may be included from C or C++.
+ */
+#pragma once
+
+// Define cross-platform PROPLIB_C_API to export functions
+#ifndef DOXYGEN_SHOULD_SKIP
+    #ifndef PROPLIB_C_API
+        #ifdef _WIN32
+            #define PROPLIB_C_API __declspec(dllexport)
+        #else
+            #define PROPLIB_C_API
+        #endif
+    #endif
+#endif
@@ -0,0 +1,388 @@
+/** @file P2108Generic.h
+ * Equations of the models, written once as templates over a numeric type.
+ *
+ * Each template evaluates an equation for any numeric type `T` described in
+ * P2108Numeric.h, calling math functions through `Math<T>`: `double` and
+ * `float`, `Pack` for several inputs at once, and `Dual` for derivatives.
+ * Constants are converted to `T` before use, so a `float` evaluation stays in
+ * single precision.
+ *
+ * The kernels of P2108Kernels.h, and so the exported functions, evaluate
+ * these templates with `double`. The templates do not validate their inputs,
+ * and where an equation has branches, both are evaluated and the result is
+ * chosen by `Math<T>::Select`, so that each lane of a pack may take its own
+ * branch. The piecewise choice of the Height Gain Terminal Correction Model
+ * by antenna height and clutter type remains with its kernel.
+ */
+#pragma once
+
+#include "P2108.h"
+#include "P2108Numeric.h"
+
+namespace ITS {
+namespace ITU {
+namespace PSeries {
+namespace P2108 {
+namespace Generic {
+
+////////////////////////////////////////////////////////////////////////////////
+// Helper Functions
+
+/*******************************************************************************
+ * Helper function to calculate @f$ \cot(x) @f$, as @f$ 1 / \tan(x) @f$.
+ *
+ * @param[in] x  Argument, in radians
+ * @return       Cotangent of the argument, @f$ \cot(x) @f$
+ ******************************************************************************/
+template<typename T>
+inline T cot(const T &x) {
+    return T(1) / Math<T>::Tan(x);
+}
+
+/*******************************************************************************
+ * Inverse complementary cumulative distribution function approximation of
+ * Formula 26.2.23 in Abramowitz & Stegun.
+ *
+ * @param q  Percentage, @f$ 0.0 < q < 1.0 @f$, not validated
+ * @return   Q(q)^-1
+ ******************************************************************************/
+template<typename T>
+inline T InverseComplementaryCumulativeDistribution(const T &q) {
+    typedef Math<T> M;
+
+    // Constants from Abramowitz & Stegun 26.2.23
+    const T C_0 = T(2.515517);
+    const T C_1 = T(0.802853);
+    const T C_2 = T(0.010328);
+    const T D_1 = T(1.432788);
+    const T D_2 = T(0.189269);
+    const T D_3 = T(0.001308);
+
+    const auto upper = q > T(0.5);
+    const T x = M::Select(upper, T(1.0) - q, q);
+
+    const T T_x = M::Sqrt(T(-2.0) * M::Log(x));
+
+    const T zeta_x = ((C_2 * T_x + C_1) * T_x + C_0)
+                   / (((D_3 * T_x + D_2) * T_x + D_1) * T_x + T(1.0));
+
+    const T Q_q = T_x - zeta_x;
+
+    return M::Select(upper, -Q_q, Q_q);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// Section 3.1: Height Gain Terminal Correction Model
+
+/*******************************************************************************
+ * Equation (2a) of Section 3.1
+ *
+ * @param[in] nu  Dimensionless diffraction parameter
+ * @return        Additional loss (clutter loss), in dB
+ ******************************************************************************/
+template<typename T>
+inline T Equation_2a(const T &nu) {
+    typedef Math<T> M;
+
+    const T term1 = M::Sqrt(M::Pow(nu - T(0.1), T(2)) + T(1));
+    const T J_nu__db = M::Select(
+        nu <= T(-0.78), T(0), T(6.9) + T(20) * M::Log10(term1 + nu - T(0.1))
+    );
+
+    return J_nu__db - T(6.03);
+}
+
+/*******************************************************************************
+ * Equation (2b) of Section 3.1
+ *
+ * @param[in] K_h2      Intermediate parameter
+ * @param[in] h__meter  Antenna height, in meters
+ * @param[in] R__meter  Representative clutter height, in meters
+ * @return              Additional loss (clutter loss), in dB
+ ******************************************************************************/
+template<typename T>
+inline T Equation_2b(const T &K_h2, const T &h__meter, const T &R__meter) {
+    return -K_h2 * Math<T>::Log10(h__meter / R__meter);
+}
+
+/*******************************************************************************
+ * Equation (2c) of Section 3.1
+ *
+ * @param[in] K_nu             Intermediate parameter
+ * @param[in] h_dif__meter     Height difference, from Equation (2d)
+ * @param[in] theta_clut__deg  Clutter angle, from Equation (2e), in degrees
+ * @return                     Dimensionless diffraction parameter
+ ******************************************************************************/
+template<typename T>
+inline T Equation_2c(
+    const T &K_nu, const T &h_dif__meter, const T &theta_clut__deg
+) {
+    return K_nu * Math<T>::Sqrt(h_dif__meter * theta_clut__deg);
+}
+
+/*******************************************************************************
+ * Equation (2e) of Section 3.1
+ *
+ * @param[in] h_dif__meter  Height difference, from Equation (2d)
+ * @param[in] w_s__meter    Street width, in meters
+ * @return                  Clutter angle, in degrees
+ ******************************************************************************/
+template<typename T>
+inline T Equation_2e(const T &h_dif__meter, const T &w_s__meter) {
+    return Math<T>::Atan(h_dif__meter / w_s__meter) * T(180.0) / T(PI);
+}
+
+/*******************************************************************************
+ * Equation (2f) of Section 3.1
+ *
+ * @param[in] f__ghz  Frequency, in GHz
+ * @return            Intermediate parameter @f$ K_{h2} @f$
+ ******************************************************************************/
+template<typename T>
+inline T Equation_2f(const T &f__ghz) {
+    return T(21.8) + T(6.2) * Math<T>::Log10(f__ghz);
+}
+
+/*******************************************************************************
+ * Equation (2g) of Section 3.1
+ *
+ * @param[in] f__ghz  Frequency, in GHz
+ * @return            Intermediate parameter @f$ K_{\nu} @f$
+ ******************************************************************************/
+template<typename T>
+inline T Equation_2g(const T &f__ghz) {
+    return T(0.342) * Math<T>::Sqrt(f__ghz);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// Section 3.2: Terrestrial Statistical Model
+
+/*******************************************************************************
+ * Equations (4a) and (4b) of Section 3.2
+ *
+ * @param[in] f__ghz  Frequency, in GHz
+ * @return            Location loss @f$ L_l @f$, in dB
+ ******************************************************************************/
+template<typename T>
+inline T Equation_4(const T &f__ghz) {
+    typedef Math<T> M;
+
+    const T term1 = M::Pow(T(10), T(-5) * M::Log10(f__ghz) - T(12.5));
+
+    return T(-2) * M::Log10(term1 + M::Pow(T(10), T(-16.5)));
+}
+
+/*******************************************************************************
+ * Equations (5a) and (5b) of Section 3.2
+ *
+ * @param[in] f__ghz  Frequency, in GHz
+ * @param[in] d__km   Path distance, in km
+ * @return            Slope loss @f$ L_s @f$, in dB
+ ******************************************************************************/
+template<typename T>
+inline T Equation_5(const T &f__ghz, const T &d__km) {
+    typedef Math<T> M;
+
+    return T(32.98) + T(23.9) * M::Log10(d__km) + T(3) * M::Log10(f__ghz);
+}
+
+/*******************************************************************************
+ * Median clutter loss of Equation (3a) of Section 3.2, given the location and
+ * slope losses as powers, @f$ 10^{-0.2 L} @f$.
+ *
+ * @param[in] P_l  Location loss power, @f$ 10^{-0.2 L_l} @f$
+ * @param[in] P_s  Slope loss power, @f$ 10^{-0.2 L_s} @f$
+ * @return         Clutter loss at 50% of locations, in dB
+ ******************************************************************************/
+template<typename T>
+inline T Equation_3a_Median(const T &P_l, const T &P_s) {
+    return T(-5) * Math<T>::Log10(P_l + P_s);
+}
+
+/*******************************************************************************
+ * Equation (3b) of Section 3.2, given the location and slope losses as
+ * powers, @f$ 10^{-0.2 L} @f$.
+ *
+ * @param[in] P_l  Location loss power, @f$ 10^{-0.2 L_l} @f$
+ * @param[in] P_s  Slope loss power, @f$ 10^{-0.2 L_s} @f$
+ * @return         Standard deviation of the clutter loss, in dB
+ ******************************************************************************/
+template<typename T>
+inline T Equation_3b(const T &P_l, const T &P_s) {
+    constexpr double sigma_l__db = 4;  // Equation 4b
+    constexpr double sigma_s__db = 6;  // Equation 5b
+
+    const T numerator = T(sigma_l__db * sigma_l__db) * P_l
+                      + T(sigma_s__db * sigma_s__db) * P_s;
+    const T denominator = P_l + P_s;
+    return Math<T>::Sqrt(numerator / denominator);
+}
+
+/*******************************************************************************
+ * Equations (3a) and (3b) of Section 3.2, given the location and slope losses
+ * as powers, @f$ 10^{-0.2 L} @f$.
+ *
+ * @param[in] P_l  Location loss power, @f$ 10^{-0.2 L_l} @f$
+ * @param[in] P_s  Slope loss power, @f$ 10^{-0.2 L_s} @f$
+ * @param[in] Q_p  Inverse CCDF of the percentage of locations, p / 100
+ * @return         Clutter loss, in dB
+ ******************************************************************************/
+template<typename T>
+inline T Equation_3_Powers(const T &P_l, const T &P_s, const T &Q_p) {
+    return Equation_3a_Median(P_l, P_s) - Equation_3b(P_l, P_s) * Q_p;
+}
+
+/*******************************************************************************
+ * Equations (3a) and (3b) of Section 3.2
+ *
+ * @param[in] L_l__db  Location loss, from Equation (4), in dB
+ * @param[in] L_s__db  Slope loss, from Equation (5), in dB
+ * @param[in] Q_p      Inverse CCDF of the percentage of locations, p / 100
+ * @return             Clutter loss, in dB
+ ******************************************************************************/
+template<typename T>
+inline T Equation_3(const T &L_l__db, const T &L_s__db, const T &Q_p) {
+    typedef Math<T> M;
+
+    return Equation_3_Powers(
+        M::Pow(T(10), T(-0.2) * L_l__db), M::Pow(T(10), T(-0.2) * L_s__db), Q_p
+    );
+}
+
+/*******************************************************************************
+ * Clutter loss of Equation (3) at one path distance
+ *
+ * @param[in] f__ghz  Frequency, in GHz
+ * @param[in] d__km   Path distance, in km
+ * @param[in] p       Percentage of locations, in %
+ * @return            Clutter loss, in dB
+ ******************************************************************************/
+template<typename T>
+inline T TerrestrialStatisticalModelHelper(
+    const T &f__ghz, const T &d__km, const T &p
+) {
+    return Equation_3(
+        Equation_4(f__ghz),
+        Equation_5(f__ghz, d__km),
+        InverseComplementaryCumulativeDistribution(p / T(100))
+    );
+}
+
+/*******************************************************************************
+ * Statistical clutter loss model for terrestrial paths as described in
+ * Section 3.2, for validated inputs.
+ *
+ * @param[in] f__ghz  Frequency, in GHz
+ * @param[in] d__km   Path distance, in km
+ * @param[in] p       Percentage of locations, in %
+ * @return            Additional loss (clutter loss), in dB
+ ******************************************************************************/
+template<typename T>
+inline T TerrestrialStatisticalModel(
+    const T &f__ghz, const T &d__km, const T &p
+) {
+    // Equation (6), the lesser of the losses at 2 km and at the distance
+    return Math<T>::Min(
+        TerrestrialStatisticalModelHelper(f__ghz, T(2), p),
+        TerrestrialStatisticalModelHelper(f__ghz, d__km, p)
+    );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// Section 3.3: Aeronautical Statistical Model
+
+/*******************************************************************************
+ * Frequency term of Equation (7) of Section 3.3.
+ *
+ * @param[in] f__ghz  Frequency, in GHz
+ * @return            @f$ K_1 @f$
+ ******************************************************************************/
+template<typename T>
+inline T Equation_7_K_1(const T &f__ghz) {
+    return T(93) * Math<T>::Pow(f__ghz, T(0.175));
+}
+
+/*******************************************************************************
+ * Terms of Equation (7) of Section 3.3 which depend only on the frequency and
+ * percentage of locations.
+ *
+ * @param[in] f__ghz  Frequency, in GHz
+ * @param[in] p       Percentage of locations, in %
+ * @return            Scale of Equation (7), @f$ -K_1 \ln(1 - p/100) @f$
+ ******************************************************************************/
+template<typename T>
+inline T Equation_7_Scale(const T &f__ghz, const T &p) {
+    const T K_1 = Equation_7_K_1(f__ghz);
+    const T part1 = Math<T>::Log(T(1) - p / T(100.0));
+
+    return -K_1 * part1;
+}
+
+/*******************************************************************************
+ * Terms of Equation (7) of Section 3.3 which depend only on the elevation
+ * angle.
+ *
+ * @param[in]  theta__deg  Elevation angle, in degrees
+ * @param[out] cot_term    Cotangent term of Equation (7)
+ * @param[out] exponent    Exponent of Equation (7)
+ ******************************************************************************/
+template<typename T>
+inline void Equation_7_AngleTerms(
+    const T &theta__deg, T &cot_term, T &exponent
+) {
+    constexpr double A_1 = 0.05;
+
+    const T part2 = T(A_1) * (T(1) - theta__deg / T(90.0))
+                  + T(PI) * theta__deg / T(180.0);
+    cot_term = cot(part2);
+    exponent = T(0.5) * (T(90.0) - theta__deg) / T(90.0);
+}
+
+/*******************************************************************************
+ * Equation (7) of Section 3.3, given its frequency, percentage and angle
+ * terms.
+ *
+ * @param[in] scale     Scale of Equation (7), from `Equation_7_Scale`
+ * @param[in] cot_term  Cotangent term, from `Equation_7_AngleTerms`
+ * @param[in] exponent  Exponent, from `Equation_7_AngleTerms`
+ * @param[in] Q_p       Inverse CCDF of the percentage of locations, p / 100
+ * @return              Additional loss (clutter loss), in dB
+ ******************************************************************************/
+template<typename T>
+inline T Equation_7_Combine(
+    const T &scale, const T &cot_term, const T &exponent, const T &Q_p
+) {
+    const T part4 = T(0.6) * Q_p;
+
+    return Math<T>::Pow(scale * cot_term, exponent) - T(1) - part4;
+}
+
+/*******************************************************************************
+ * The Earth-space and aeronautical statistical clutter loss model as described
+ * in Section 3.3, for validated inputs.
+ *
+ * @param[in] f__ghz      Frequency, in GHz
+ * @param[in] theta__deg  Elevation angle, in degrees
+ * @param[in] p           Percentage of locations, in %
+ * @return                Additional loss (clutter loss), in dB
+ ******************************************************************************/
+template<typename T>
+inline T AeronauticalStatisticalModel(
+    const T &f__ghz, const T &theta__deg, const T &p
+) {
+    T cot_term, exponent;
+    Equation_7_AngleTerms(theta__deg, cot_term, exponent);
+
+    return Equation_7_Combine(
+        Equation_7_Scale(f__ghz, p),
+        cot_term,
+        exponent,
+        InverseComplementaryCumulativeDistribution(p / T(100))
+    );
+}
+
+}  // namespace Generic
+}  // namespace P2108
+}  // namespace PSeries
+}  // namespace ITU
+}  // namespace ITS
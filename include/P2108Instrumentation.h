@@ -0,0 +1,168 @@
+/** @file P2108Instrumentation.h
+ * Opt-in call counters and timing histograms for the library entry points.
+ *
+ * Instrumentation is compiled in only when the library is built with the
+ * `ENABLE_INSTRUMENTATION` CMake option. Each thread counts calls, return
+ * codes, and call durations in its own cache-line-aligned counters, which are
+ * summed when a snapshot is taken. When instrumentation is compiled out, the
+ * entry points carry no overhead, `P2108GetStats` returns zeroed counters, and
+ * `P2108_STATS_ENABLED` is not set in the snapshot.
+ *
+ * The snapshot and reset functions may be called from C or C++.
+ */
+#pragma once
+
+#include "P2108Api.h"
+
+#include <stdint.h>  // for uint32_t, uint64_t
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** Number of return codes counted per function (library codes are 0-127) */
+#define P2108_STATS_MAX_CODES 128
+/** Number of buckets in each timing histogram */
+#define P2108_STATS_HIST_BUCKETS 32
+/** Flag set in `P2108Stats::flags` when instrumentation is compiled in */
+#define P2108_STATS_ENABLED 1u
+
+/** Instrumented library entry points */
+enum P2108StatsFunction {
+    P2108_STATS_ASM = 0,         /**< `AeronauticalStatisticalModel` */
+    P2108_STATS_TSM = 1,         /**< `TerrestrialStatisticalModel` */
+    P2108_STATS_HGTCM = 2,       /**< `HeightGainTerminalCorrectionModel` */
+    P2108_STATS_ASM_BATCH = 3,   /**< Strided batch ASM (`P2108Batch.h`) */
+    P2108_STATS_TSM_BATCH = 4,   /**< Strided batch TSM (`P2108Batch.h`) */
+    P2108_STATS_HGTCM_BATCH = 5, /**< Strided batch HGTCM (`P2108Batch.h`) */
+
+    // Raster engines (`P2108Raster.h`)
+    P2108_STATS_TSM_COVERAGE = 6,      /**< `P2108TerrestrialCoverage` */
+    P2108_STATS_TSM_COVERAGE_FILE = 7, /**< `P2108TerrestrialCoverageFile` */
+    P2108_STATS_HGTCM_RASTER = 8,      /**< `P2108HeightGainRaster` */
+    P2108_STATS_HGTCM_RASTER_FILE = 9, /**< `P2108HeightGainRasterFile` */
+
+    // Track replay (`P2108Tracks.h`)
+    P2108_STATS_TRACK_SET = 10,      /**< `P2108TrackReplaySetTrack` */
+    P2108_STATS_TRACK_EVALUATE = 11, /**< `P2108TrackReplayEvaluate` */
+
+    // Location-variability samplers (`P2108Sampler.h`)
+    P2108_STATS_TSM_SAMPLES = 12, /**< Terrestrial Statistical Model samples */
+    P2108_STATS_ASM_SAMPLES = 13, /**< Aeronautical Statistical Model samples */
+
+    // Link correction (`P2108Link.h`)
+    P2108_STATS_LINK_BATCH = 14, /**< `P2108LinkClutterCorrectionBatch` */
+
+    // Partial derivatives (`P2108Jacobian.h`)
+    P2108_STATS_HGTCM_JACOBIAN = 15, /**< Batch HGTCM with derivatives */
+    P2108_STATS_TSM_JACOBIAN = 16,   /**< Batch TSM with derivatives */
+    P2108_STATS_ASM_JACOBIAN = 17,   /**< Batch ASM with derivatives */
+
+    // Surface queries (`P2108Surface.h`)
+    P2108_STATS_ASM_SURFACE = 18,   /**< Batch ASM from a surface file */
+    P2108_STATS_TSM_SURFACE = 19,   /**< Batch TSM from a surface file */
+    P2108_STATS_HGTCM_SURFACE = 20, /**< Batch HGTCM from a surface file */
+
+    P2108_STATS_N_FUNCTIONS, /**< Number of instrumented functions */
+};
+
+/*******************************************************************************
+ * Counters of a single instrumented function.
+ *
+ * Bucket `i` of the timing histogram counts calls which took at least
+ * @f$ 2^i @f$ ns and less than @f$ 2^{i+1} @f$ ns (bucket 0 also counts calls
+ * measured as 0 ns, and the last bucket counts all longer calls). A batch
+ * call is counted once, under the return code of its first invalid record, or
+ * `SUCCESS` if every record is valid. A raster call is counted under the
+ * status it returns.
+ ******************************************************************************/
+typedef struct P2108FunctionStats {
+    uint64_t calls;                              /**< Number of calls */
+    uint64_t total__ns;                          /**< Total time, in ns */
+    uint64_t codes[P2108_STATS_MAX_CODES];       /**< Calls by return code */
+    uint64_t histogram[P2108_STATS_HIST_BUCKETS]; /**< Calls by duration */
+} P2108FunctionStats;
+
+/** Snapshot of the counters of all instrumented functions */
+typedef struct P2108Stats {
+    uint32_t flags; /**< `P2108_STATS_ENABLED` if counters are compiled in */
+    P2108FunctionStats functions[P2108_STATS_N_FUNCTIONS]; /**< By function */
+} P2108Stats;
+
+PROPLIB_C_API void P2108GetStats(P2108Stats *stats);
+PROPLIB_C_API void P2108ResetStats(void);
+PROPLIB_C_API const char *P2108GetStatsFunctionName(int function);
+
+#ifdef __cplusplus
+}
+#endif
+
+// Internal hooks used by the library entry points
+#if defined(__cplusplus) && !defined(DOXYGEN_SHOULD_SKIP)
+    #ifdef P2108_INSTRUMENTATION
+        #include <chrono>  // for std::chrono::steady_clock
+
+namespace ITS {
+namespace ITU {
+namespace PSeries {
+namespace P2108 {
+
+void RecordCall(
+    const P2108StatsFunction function, const int code, const uint64_t ns
+);
+
+/*******************************************************************************
+ * Records the duration and return code of an instrumented call on exit.
+ ******************************************************************************/
+class InstrumentScope {
+    public:
+        explicit InstrumentScope(const P2108StatsFunction function):
+            function_(function),
+            code_(-1),
+            start_(std::chrono::steady_clock::now()) {}
+
+        ~InstrumentScope() {
+            const auto elapsed = std::chrono::steady_clock::now() - start_;
+            RecordCall(
+                function_,
+                code_,
+                static_cast<uint64_t>(
+                    std::chrono::duration_cast<std::chrono::nanoseconds>(
+                        elapsed
+                    )
+                        .count()
+                )
+            );
+        }
+
+        /** Store the return code of the call, and pass it through */
+        template<typename T>
+        T Exit(const T code) {
+            code_ = static_cast<int>(code);
+            return code;
+        }
+    private:
+        P2108StatsFunction function_;                 /**< Function called */
+        int code_;                                    /**< Return code */
+        std::chrono::steady_clock::time_point start_; /**< Time of entry */
+};
+
+}  // namespace P2108
+}  // namespace PSeries
+}  // namespace ITU
+}  // namespace ITS
+
+        /** Start instrumenting the enclosing function */
+        #define P2108_INSTRUMENT(function) \
+            ::ITS::ITU::PSeries::P2108::InstrumentScope p2108_scope_(function)
+        /** Record a return code of an instrumented function */
+        #define P2108_INSTRUMENT_RETURN(code) p2108_scope_.Exit(code)
+        /** Record a return code without returning it */
+        #define P2108_INSTRUMENT_CODE(code) \
+            static_cast<void>(p2108_scope_.Exit(code))
+    #else
+        #define P2108_INSTRUMENT(function)
+        #define P2108_INSTRUMENT_RETURN(code) (code)
+        #define P2108_INSTRUMENT_CODE(code) static_cast<void>(code)
+    #endif
+#endif
@@ -0,0 +1,99 @@
+/** @file P2108Jacobian.h
+ * Batch evaluation of the models together with the partial derivatives of
+ * the loss with respect to each continuous input.
+ *
+ * The derivatives are analytic, computed in the same pass as the loss, so a
+ * gradient costs about one model call rather than two per input as with
+ * central finite differences. Each loss is identical to that of the model.
+ * Records are evaluated in tiles of `P2108GetBatchTileSize` records.
+ *
+ * The models are piecewise, and each derivative is that of the branch which
+ * computes the loss:
+ *
+ * - Height Gain Terminal Correction Model: at and above the clutter
+ *   (`h__meter >= R__meter`) the loss is 0 dB, and every derivative is 0.
+ *   For diffraction parameters `nu <= -0.78`, the knife-edge loss is
+ *   constant, and its derivatives are 0.
+ * - Terrestrial Statistical Model: the loss is the lesser of the losses at
+ *   the path distance and at 2 km (Equation 6). Where they are equal, at
+ *   2 km, the 2 km branch is used, so the derivative with respect to the
+ *   distance is that for increasing distance, 0.
+ * - The inverse CCDF is differentiated as the approximation used by the
+ *   models, so the derivatives match finite differences of the models. With
+ *   the Wichura algorithms (`InverseCCDFAlgorithm`, passed to the
+ *   statistical models), the derivative of the exact inverse CCDF is used
+ *   instead.
+ *
+ * Records which fail validation get NaN outputs, and their error code in
+ * the return code output, which may be `NULL`. Each function returns the
+ * number of invalid records.
+ *
+ * This header may be included from C or C++.
+ */
+#pragma once
+
+#include "P2108Api.h"
+
+#include <stddef.h>  // for size_t
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** Height Gain Terminal Correction Model loss and its partial derivatives */
+typedef struct P2108HGTCMJacobian {
+    double A_h__db;    /**< Additional loss (clutter loss), in dB */
+    double dA_h__df;   /**< With respect to frequency, in dB/GHz */
+    double dA_h__dh;   /**< With respect to antenna height, in dB/m */
+    double dA_h__dw_s; /**< With respect to street width, in dB/m */
+    double dA_h__dR;   /**< With respect to clutter height, in dB/m */
+} P2108HGTCMJacobian;
+
+/** Terrestrial Statistical Model loss and its partial derivatives */
+typedef struct P2108TSMJacobian {
+    double L_ctt__db;  /**< Additional loss (clutter loss), in dB */
+    double dL_ctt__df; /**< With respect to frequency, in dB/GHz */
+    double dL_ctt__dd; /**< With respect to path distance, in dB/km */
+    double dL_ctt__dp; /**< With respect to percentage, in dB/% */
+} P2108TSMJacobian;
+
+/** Aeronautical Statistical Model loss and its partial derivatives */
+typedef struct P2108ASMJacobian {
+    double L_ces__db;      /**< Additional loss (clutter loss), in dB */
+    double dL_ces__df;     /**< With respect to frequency, in dB/GHz */
+    double dL_ces__dtheta; /**< With respect to elevation angle, in dB/deg */
+    double dL_ces__dp;     /**< With respect to percentage, in dB/% */
+} P2108ASMJacobian;
+
+PROPLIB_C_API size_t P2108HeightGainTerminalCorrectionModelJacobian(
+    size_t n,
+    const double *f__ghz,
+    const double *h__meter,
+    const double *w_s__meter,
+    const double *R__meter,
+    const int *clutter_type,
+    P2108HGTCMJacobian *jacobian,
+    int *rtn
+);
+PROPLIB_C_API size_t P2108TerrestrialStatisticalModelJacobian(
+    size_t n,
+    const double *f__ghz,
+    const double *d__km,
+    const double *p,
+    int algorithm,
+    P2108TSMJacobian *jacobian,
+    int *rtn
+);
+PROPLIB_C_API size_t P2108AeronauticalStatisticalModelJacobian(
+    size_t n,
+    const double *f__ghz,
+    const double *theta__deg,
+    const double *p,
+    int algorithm,
+    P2108ASMJacobian *jacobian,
+    int *rtn
+);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,800 @@
+/** @file P2108Kernels.h
+ * Header-only, inlineable implementation of the models.
+ *
+ * The exported library functions are built from these kernels, so both give
+ * identical results. C++ callers may use the kernels directly, without
+ * linking the library, to let the compiler inline and vectorize the models in
+ * their own loops. The kernels do not record instrumentation or fire probes.
+ */
+#pragma once
+
+#include "P2108.h"
+#include "P2108Generic.h"
+
+#include <cmath>      // for std::exp, std::fabs, std::fmin, std::log, ...
+#include <stdexcept>  // for std::out_of_range
+
+namespace ITS {
+namespace ITU {
+namespace PSeries {
+namespace P2108 {
+namespace Inline {
+
+////////////////////////////////////////////////////////////////////////////////
+// Helper Functions
+
+/*******************************************************************************
+ * Helper function to calculate @f$ \cot(x) @f$.
+ *
+ * The calculation is implemented simply as @f$ 1 / \tan(x) @f$.
+ *
+ * @param[in] x  Argument, in radians
+ * @return       Cotangent of the argument, @f$ \cot(x) @f$
+ ******************************************************************************/
+inline double cot(const double x) {
+    return Generic::cot(x);
+}
+
+/*******************************************************************************
+ * Compute the inverse complementary cumulative distribution function
+ * approximation as described in Recommendation ITU-R P.1057.
+ *
+ * This approximation is sourced from Formula 26.2.23 in Abramowitz & Stegun.
+ * This approximation has an error of @f$ |\epsilon(p)| < 4.5\times 10^{-4} @f$
+ *
+ * @param q  Percentage, @f$ 0.0 < q < 1.0 @f$
+ * @return   Q(q)^-1
+ * @throw    std::out_of_range if the input is outside the range [0.0, 1.0]
+ ******************************************************************************/
+inline double InverseComplementaryCumulativeDistribution(const double q) {
+    if (q <= 0.0 || q >= 1.0) {
+        throw std::out_of_range("Input q must be between 0.0 and 1.0");
+    }
+
+    return Generic::InverseComplementaryCumulativeDistribution(q);
+}
+
+/*******************************************************************************
+ * Compute the derivative of the inverse complementary cumulative distribution
+ * function approximation of `InverseComplementaryCumulativeDistribution`.
+ *
+ * The derivative is that of the approximation, rather than of the exact
+ * inverse CCDF, so it is consistent with the values of the approximation.
+ *
+ * @param q  Percentage, @f$ 0.0 < q < 1.0 @f$
+ * @return   @f$ d Q^{-1}(q) / dq @f$
+ ******************************************************************************/
+inline double InverseComplementaryCumulativeDistributionDerivative(
+    const double q
+) {
+    // Constants from Abramowitz & Stegun 26.2.23
+    constexpr double C_0 = 2.515517;
+    constexpr double C_1 = 0.802853;
+    constexpr double C_2 = 0.010328;
+    constexpr double D_1 = 1.432788;
+    constexpr double D_2 = 0.189269;
+    constexpr double D_3 = 0.001308;
+
+    // The sign of the reflection for q > 0.5 cancels that of dx/dq
+    const double x = (q > 0.5) ? 1.0 - q : q;
+    const double T_x = std::sqrt(-2.0 * std::log(x));
+
+    const double numerator = (C_2 * T_x + C_1) * T_x + C_0;
+    const double denominator = ((D_3 * T_x + D_2) * T_x + D_1) * T_x + 1.0;
+    const double d_numerator = 2 * C_2 * T_x + C_1;
+    const double d_denominator = (3 * D_3 * T_x + 2 * D_2) * T_x + D_1;
+    const double d_zeta
+        = (d_numerator * denominator - numerator * d_denominator)
+        / (denominator * denominator);
+
+    // dT/dx = -1 / (x T)
+    return -(1 - d_zeta) / (x * T_x);
+}
+
+/*******************************************************************************
+ * Compute the inverse complementary cumulative distribution function with
+ * algorithm PPND7 of Wichura, "Algorithm AS 241: The Percentage Points of the
+ * Normal Distribution" (Applied Statistics, 1988).
+ *
+ * For @f$ |q - 0.5| \leq 0.425 @f$, which covers 7.5% to 92.5%, a rational
+ * function of degree 3 is evaluated without a logarithm or square root. The
+ * tails use rational functions of @f$ \sqrt{-\ln(\min(q, 1 - q))} @f$. This
+ * approximation has a relative error of about @f$ 10^{-7} @f$.
+ *
+ * @param q  Percentage, @f$ 0.0 < q < 1.0 @f$
+ * @return   Q(q)^-1
+ * @throw    std::out_of_range if the input is outside the range [0.0, 1.0]
+ ******************************************************************************/
+inline double InverseComplementaryCumulativeDistributionPPND7(const double q) {
+    if (q <= 0.0 || q >= 1.0) {
+        throw std::out_of_range("Input q must be between 0.0 and 1.0");
+    }
+
+    // Q^-1(q) is the lower tail quantile of 1 - q, the negated one of q
+    const double x = q - 0.5;
+    if (std::fabs(x) <= 0.425) {
+        const double r = 0.180625 - x * x;
+        return -x * (((59.109374720 * r + 159.29113202) * r + 50.434271938) * r
+                     + 3.3871327179)
+             / (((67.187563600 * r + 78.757757664) * r + 17.895169469) * r
+                + 1.0);
+    }
+
+    double r = std::sqrt(-std::log((x < 0) ? q : 1.0 - q));
+    double Q_q;
+    if (r <= 5.0) {
+        r -= 1.6;
+        Q_q = (((0.17023821103 * r + 1.3067284816) * r + 2.7568153900) * r
+               + 1.4234372777)
+            / ((0.12021132975 * r + 0.73700164250) * r + 1.0);
+    } else {
+        r -= 5.0;
+        Q_q = (((0.017337203997 * r + 0.42868294337) * r + 3.0812263860) * r
+               + 6.6579051150)
+            / ((0.012258202635 * r + 0.24197894225) * r + 1.0);
+    }
+    return (x < 0) ? Q_q : -Q_q;
+}
+
+/*******************************************************************************
+ * Compute the inverse complementary cumulative distribution function with
+ * algorithm PPND16 of Wichura, "Algorithm AS 241: The Percentage Points of the
+ * Normal Distribution" (Applied Statistics, 1988).
+ *
+ * This approximation has a relative error of about @f$ 10^{-16} @f$, and
+ * serves as a reference for the faster approximations.
+ *
+ * @param q  Percentage, @f$ 0.0 < q < 1.0 @f$
+ * @return   Q(q)^-1
+ * @throw    std::out_of_range if the input is outside the range [0.0, 1.0]
+ ******************************************************************************/
+inline double InverseComplementaryCumulativeDistributionAS241(const double q) {
+    if (q <= 0.0 || q >= 1.0) {
+        throw std::out_of_range("Input q must be between 0.0 and 1.0");
+    }
+
+    // Coefficients for |q - 0.5| <= 0.425
+    constexpr double A[8] = {
+        3.3871328727963666080e0,
+        1.3314166789178437745e+2,
+        1.9715909503065514427e+3,
+        1.3731693765509461125e+4,
+        4.5921953931549871457e+4,
+        6.7265770927008700853e+4,
+        3.3430575583588128105e+4,
+        2.5090809287301226727e+3
+    };
+    constexpr double B[8] = {
+        1.0,
+        4.2313330701600911252e+1,
+        6.8718700749205790830e+2,
+        5.3941960214247511077e+3,
+        2.1213794301586595867e+4,
+        3.9307895800092710610e+4,
+        2.8729085735721942674e+4,
+        5.2264952788528545610e+3
+    };
+
+    // Coefficients for r <= 5
+    constexpr double C[8] = {
+        1.42343711074968357734e0,
+        4.63033784615654529590e0,
+        5.76949722146069140550e0,
+        3.64784832476320460504e0,
+        1.27045825245236838258e0,
+        2.41780725177450611770e-1,
+        2.27238449892691845833e-2,
+        7.74545014278341407640e-4
+    };
+    constexpr double D[8] = {
+        1.0,
+        2.05319162663775882187e0,
+        1.67638483018380384940e0,
+        6.89767334985100004550e-1,
+        1.48103976427480074590e-1,
+        1.51986665636164571966e-2,
+        5.47593808499534494600e-4,
+        1.05075007164441684324e-9
+    };
+
+    // Coefficients for r > 5
+    constexpr double E[8] = {
+        6.65790464350110377720e0,
+        5.46378491116411436990e0,
+        1.78482653991729133580e0,
+        2.96560571828504891230e-1,
+        2.65321895265761230930e-2,
+        1.24266094738807843860e-3,
+        2.71155556874348757815e-5,
+        2.01033439929228813265e-7
+    };
+    constexpr double F[8] = {
+        1.0,
+        5.99832206555887937690e-1,
+        1.36929880922735805310e-1,
+        1.48753612908506148525e-2,
+        7.86869131145613259100e-4,
+        1.84631831751005468180e-5,
+        1.42151175831644588870e-7,
+        2.04426310338993978564e-15
+    };
+
+    // Ratio of two polynomials of degree 7, by Horner's method
+    const auto rational = [](const double *num, const double *den, double r) {
+        double n = num[7], d = den[7];
+        for (int i = 6; i >= 0; i--) {
+            n = n * r + num[i];
+            d = d * r + den[i];
+        }
+        return n / d;
+    };
+
+    // Q^-1(q) is the lower tail quantile of 1 - q, the negated one of q
+    const double x = q - 0.5;
+    if (std::fabs(x) <= 0.425) {
+        return -x * rational(A, B, 0.180625 - x * x);
+    }
+
+    const double r = std::sqrt(-std::log((x < 0) ? q : 1.0 - q));
+    const double Q_q
+        = (r <= 5.0) ? rational(C, D, r - 1.6) : rational(E, F, r - 5.0);
+    return (x < 0) ? Q_q : -Q_q;
+}
+
+/*******************************************************************************
+ * Convert an algorithm passed through the C interfaces as an `int`.
+ *
+ * @param algorithm  `InverseCCDFAlgorithm` value
+ * @return           Algorithm, or `ABRAMOWITZ_STEGUN` if the value is unknown
+ ******************************************************************************/
+inline InverseCCDFAlgorithm ToInverseCCDFAlgorithm(const int algorithm) {
+    switch (algorithm) {
+        case WICHURA_PPND7:
+            return WICHURA_PPND7;
+        case WICHURA_AS241:
+            return WICHURA_AS241;
+        default:
+            return ABRAMOWITZ_STEGUN;
+    }
+}
+
+/*******************************************************************************
+ * Compute the inverse complementary cumulative distribution function with the
+ * given algorithm.
+ *
+ * @param q          Percentage, @f$ 0.0 < q < 1.0 @f$
+ * @param algorithm  Algorithm
+ * @return           Q(q)^-1
+ * @throw            std::out_of_range if the input is outside [0.0, 1.0]
+ ******************************************************************************/
+inline double InverseComplementaryCumulativeDistribution(
+    const double q, const InverseCCDFAlgorithm algorithm
+) {
+    switch (algorithm) {
+        case InverseCCDFAlgorithm::WICHURA_PPND7:
+            return InverseComplementaryCumulativeDistributionPPND7(q);
+        case InverseCCDFAlgorithm::WICHURA_AS241:
+            return InverseComplementaryCumulativeDistributionAS241(q);
+        default:
+            return InverseComplementaryCumulativeDistribution(q);
+    }
+}
+
+/*******************************************************************************
+ * Compute the derivative of the inverse complementary cumulative distribution
+ * function with the given algorithm.
+ *
+ * The Abramowitz & Stegun approximation is differentiated as such. The
+ * others approximate the exact inverse closely, so the derivative of the
+ * exact inverse, @f$ -\sqrt{2 \pi} e^{z^2 / 2} @f$ at @f$ z = Q^{-1}(q) @f$,
+ * is used.
+ *
+ * @param q          Percentage, @f$ 0.0 < q < 1.0 @f$
+ * @param algorithm  Algorithm
+ * @return           @f$ d Q^{-1}(q) / dq @f$
+ ******************************************************************************/
+inline double InverseComplementaryCumulativeDistributionDerivative(
+    const double q, const InverseCCDFAlgorithm algorithm
+) {
+    if (algorithm != InverseCCDFAlgorithm::WICHURA_PPND7
+        && algorithm != InverseCCDFAlgorithm::WICHURA_AS241) {
+        return InverseComplementaryCumulativeDistributionDerivative(q);
+    }
+    const double z
+        = Inline::InverseComplementaryCumulativeDistribution(q, algorithm);
+    return -std::sqrt(2 * PI) * std::exp(z * z / 2);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// Section 3.1: Height Gain Terminal Correction Model
+
+/*******************************************************************************
+ * Input validation for the height gain terminal correction model (Section 3.1).
+ *
+ * Note: Input parameter 'clutter_type' is validated in the main function's
+ * switch statement through the use of default to simplify code structure.
+ *
+ * @param[in] f__ghz      Frequency, in GHz
+ * @param[in] h__meter    Antenna height, in meters
+ * @param[in] w_s__meter  Street width, in meters
+ * @param[in] R__meter    Representative clutter height, in meters
+ * @return                Return code
+ ******************************************************************************/
+inline ReturnCode Section3p1_InputValidation(
+    const double f__ghz,
+    const double h__meter,
+    const double w_s__meter,
+    const double R__meter
+) {
+    if (f__ghz < 0.03 || f__ghz > 3)
+        return ERROR31__FREQUENCY;
+
+    if (h__meter <= 0)
+        return ERROR31__ANTENNA_HEIGHT;
+
+    if (w_s__meter <= 0)
+        return ERROR31__STREET_WIDTH;
+
+    if (R__meter <= 0)
+        return ERROR31__CLUTTER_HEIGHT;
+
+    return SUCCESS;
+}
+
+/*******************************************************************************
+ * Equation (2a) of Section 3.1
+ *
+ * @param[in] nu  Dimensionless diffraction parameter
+ * @return        Additional loss (clutter loss), in dB
+ ******************************************************************************/
+inline double Equation_2a(const double nu) {
+    return Generic::Equation_2a(nu);
+}
+
+/*******************************************************************************
+ * Equation (2b) of Section 3.1
+ *
+ * @param[in] K_h2      Intermediate parameter
+ * @param[in] h__meter  Antenna height, in meters
+ * @param[in] R__meter  Representative clutter height, in meters
+ * @return              Additional loss (clutter loss), in dB
+ ******************************************************************************/
+inline double Equation_2b(
+    const double K_h2, const double h__meter, const double R__meter
+) {
+    return Generic::Equation_2b(K_h2, h__meter, R__meter);
+}
+
+/*******************************************************************************
+ * Equation (2f) of Section 3.1
+ *
+ * @param[in] f__ghz  Frequency, in GHz
+ * @return            Intermediate parameter @f$ K_{h2} @f$
+ ******************************************************************************/
+inline double Equation_2f(const double f__ghz) {
+    return Generic::Equation_2f(f__ghz);
+}
+
+/*******************************************************************************
+ * Equation (2g) of Section 3.1
+ *
+ * @param[in] f__ghz  Frequency, in GHz
+ * @return            Intermediate parameter @f$ K_{\nu} @f$
+ ******************************************************************************/
+inline double Equation_2g(const double f__ghz) {
+    return Generic::Equation_2g(f__ghz);
+}
+
+/*******************************************************************************
+ * Height gain terminal correction model as described in Section 3.1, given
+ * its frequency terms. Callers which evaluate many terminals at one frequency
+ * may compute the terms once. The inputs other than the clutter type must
+ * already be validated.
+ *
+ * @param[in]  K_h2          Intermediate parameter, from Equation (2f)
+ * @param[in]  K_nu          Intermediate parameter, from Equation (2g)
+ * @param[in]  h__meter      Antenna height, in meters
+ * @param[in]  w_s__meter    Street width, in meters
+ * @param[in]  R__meter      Representative clutter height, in meters
+ * @param[in]  clutter_type  Clutter type
+ * @param[out] A_h__db       Additional loss (clutter loss), in dB
+ * @return                   Return code
+ ******************************************************************************/
+inline ReturnCode HeightGainTerminalCorrectionModelTerms(
+    const double K_h2,
+    const double K_nu,
+    const double h__meter,
+    const double w_s__meter,
+    const double R__meter,
+    const ClutterType clutter_type,
+    double &A_h__db
+) {
+    if (h__meter >= R__meter) {
+        A_h__db = 0;
+        return SUCCESS;
+    }
+
+    const double h_dif__meter = R__meter - h__meter;  // Equation (2d)
+    const double theta_clut__deg
+        = Generic::Equation_2e(h_dif__meter, w_s__meter);
+
+    switch (clutter_type) {
+        case ClutterType::WATER_SEA:
+        case ClutterType::OPEN_RURAL:
+            A_h__db = Equation_2b(K_h2, h__meter, R__meter);
+            break;
+
+        case ClutterType::SUBURBAN:
+        case ClutterType::URBAN:
+        case ClutterType::TREES_FOREST:
+        case ClutterType::DENSE_URBAN:
+            A_h__db = Equation_2a(
+                Generic::Equation_2c(K_nu, h_dif__meter, theta_clut__deg)
+            );
+            break;
+        default:
+            return ERROR31__CLUTTER_TYPE;
+    }
+
+    return SUCCESS;
+}
+
+/*******************************************************************************
+ * Height gain terminal correction model as described in Section 3.1.
+ *
+ * Inline equivalent of the exported `HeightGainTerminalCorrectionModel`.
+ *
+ * @param[in]  f__ghz        Frequency, in GHz
+ * @param[in]  h__meter      Antenna height, in meters
+ * @param[in]  w_s__meter    Street width, in meters
+ * @param[in]  R__meter      Representative clutter height, in meters
+ * @param[in]  clutter_type  Clutter type
+ * @param[out] A_h__db       Additional loss (clutter loss), in dB
+ * @return                   Return code
+ ******************************************************************************/
+inline ReturnCode HeightGainTerminalCorrectionModel(
+    const double f__ghz,
+    const double h__meter,
+    const double w_s__meter,
+    const double R__meter,
+    const ClutterType clutter_type,
+    double &A_h__db
+) {
+    const ReturnCode rtn
+        = Section3p1_InputValidation(f__ghz, h__meter, w_s__meter, R__meter);
+    if (rtn != SUCCESS)
+        return rtn;
+
+    return HeightGainTerminalCorrectionModelTerms(
+        Equation_2f(f__ghz),
+        Equation_2g(f__ghz),
+        h__meter,
+        w_s__meter,
+        R__meter,
+        clutter_type,
+        A_h__db
+    );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// Section 3.2: Terrestrial Statistical Model
+
+/*******************************************************************************
+ * Input validation for the statistical clutter loss model for terrestrial paths
+ * (Section 3.2).
+ *
+ * @param[in] f__ghz  Frequency, in GHz
+ * @param[in] d__km   Path distance, in km
+ * @param[in] p       Percentage of locations, in %
+ * @return            Return code
+ ******************************************************************************/
+inline ReturnCode Section3p2_InputValidation(
+    const double f__ghz, const double d__km, const double p
+) {
+    if (f__ghz < 0.5 || f__ghz > 67)
+        return ERROR32__FREQUENCY;
+
+    if (d__km < 0.25)
+        return ERROR32__DISTANCE;
+
+    if (p <= 0 || p >= 100)
+        return ERROR32__PERCENTAGE;
+
+    return SUCCESS;
+}
+
+/*******************************************************************************
+ * Equations (4a) and (4b) of Section 3.2: the loss from local clutter, which
+ * depends only on the frequency.
+ *
+ * @param[in] f__ghz  Frequency, in GHz
+ * @return            Location loss @f$ L_l @f$, in dB
+ ******************************************************************************/
+inline double Equation_4(const double f__ghz) {
+    return Generic::Equation_4(f__ghz);
+}
+
+/*******************************************************************************
+ * Equations (5a) and (5b) of Section 3.2: the loss along the path.
+ *
+ * @param[in] f__ghz  Frequency, in GHz
+ * @param[in] d__km   Path distance, in km
+ * @return            Slope loss @f$ L_s @f$, in dB
+ ******************************************************************************/
+inline double Equation_5(const double f__ghz, const double d__km) {
+    return Generic::Equation_5(f__ghz, d__km);
+}
+
+/*******************************************************************************
+ * Median clutter loss of Equation (3a) of Section 3.2, given the location and
+ * slope losses as powers, @f$ 10^{-0.2 L} @f$.
+ *
+ * @param[in] P_l  Location loss power, @f$ 10^{-0.2 L_l} @f$
+ * @param[in] P_s  Slope loss power, @f$ 10^{-0.2 L_s} @f$
+ * @return         Clutter loss at 50% of locations, in dB
+ ******************************************************************************/
+inline double Equation_3a_Median(const double P_l, const double P_s) {
+    return Generic::Equation_3a_Median(P_l, P_s);
+}
+
+/*******************************************************************************
+ * Equation (3b) of Section 3.2, given the location and slope losses as
+ * powers, @f$ 10^{-0.2 L} @f$.
+ *
+ * @param[in] P_l  Location loss power, @f$ 10^{-0.2 L_l} @f$
+ * @param[in] P_s  Slope loss power, @f$ 10^{-0.2 L_s} @f$
+ * @return         Standard deviation of the clutter loss, in dB
+ ******************************************************************************/
+inline double Equation_3b(const double P_l, const double P_s) {
+    return Generic::Equation_3b(P_l, P_s);
+}
+
+/*******************************************************************************
+ * Equations (3a) and (3b) of Section 3.2, given the location and slope losses
+ * as powers, @f$ 10^{-0.2 L} @f$. Callers which evaluate many slope losses
+ * for one location loss may compute its power once, and callers which
+ * evaluate many percentages for one path may compute the median and standard
+ * deviation once.
+ *
+ * @param[in] P_l  Location loss power, @f$ 10^{-0.2 L_l} @f$
+ * @param[in] P_s  Slope loss power, @f$ 10^{-0.2 L_s} @f$
+ * @param[in] Q_p  Inverse CCDF of the percentage of locations, p / 100
+ * @return         Clutter loss, in dB
+ ******************************************************************************/
+inline double Equation_3_Powers(
+    const double P_l, const double P_s, const double Q_p
+) {
+    return Generic::Equation_3_Powers(P_l, P_s, Q_p);
+}
+
+/*******************************************************************************
+ * Equations (3a) and (3b) of Section 3.2: combine the location and slope
+ * losses into the clutter loss at a percentage of locations.
+ *
+ * @param[in] L_l__db  Location loss, from Equation (4), in dB
+ * @param[in] L_s__db  Slope loss, from Equation (5), in dB
+ * @param[in] Q_p      Inverse CCDF of the percentage of locations, p / 100
+ * @return             Clutter loss, in dB
+ ******************************************************************************/
+inline double Equation_3(
+    const double L_l__db, const double L_s__db, const double Q_p
+) {
+    return Generic::Equation_3(L_l__db, L_s__db, Q_p);
+}
+
+/*******************************************************************************
+ * Compute the clutter loss
+ *
+ * @param[in] f__ghz     Frequency, in GHz
+ * @param[in] d__km      Path distance, in km
+ * @param[in] p          Percentage of locations, in %
+ * @param[in] algorithm  Algorithm of the inverse CCDF
+ * @return               Clutter loss, in dB
+ ******************************************************************************/
+inline double TerrestrialStatisticalModelHelper(
+    const double f__ghz,
+    const double d__km,
+    const double p,
+    const InverseCCDFAlgorithm algorithm = ABRAMOWITZ_STEGUN
+) {
+    return Equation_3(
+        Equation_4(f__ghz),
+        Equation_5(f__ghz, d__km),
+        Inline::InverseComplementaryCumulativeDistribution(p / 100, algorithm)
+    );
+}
+
+/*******************************************************************************
+ * Statistical clutter loss model for terrestrial paths as described in
+ * Section 3.2.
+ *
+ * Inline equivalent of the exported `TerrestrialStatisticalModel`.
+ *
+ * @param[in]  f__ghz     Frequency, in GHz
+ * @param[in]  d__km      Path distance, in km
+ * @param[in]  p          Percentage of locations, in %
+ * @param[out] L_ctt__db  Additional loss (clutter loss), in dB
+ * @param[in]  algorithm  Algorithm of the inverse CCDF
+ * @return                Return code
+ ******************************************************************************/
+inline ReturnCode TerrestrialStatisticalModel(
+    const double f__ghz,
+    const double d__km,
+    const double p,
+    double &L_ctt__db,
+    const InverseCCDFAlgorithm algorithm = ABRAMOWITZ_STEGUN
+) {
+    const ReturnCode rtn = Section3p2_InputValidation(f__ghz, d__km, p);
+    if (rtn != SUCCESS)
+        return rtn;
+
+    // compute clutter loss at 2 km
+    const double L_ctt_2km__db
+        = TerrestrialStatisticalModelHelper(f__ghz, 2, p, algorithm);
+
+    // compute clutter loss at requested distance
+    const double L_ctt_d__db
+        = TerrestrialStatisticalModelHelper(f__ghz, d__km, p, algorithm);
+
+    // "clutter loss must not exceed a maximum value given by [Equation 6]"
+    L_ctt__db = std::fmin(L_ctt_2km__db, L_ctt_d__db);
+
+    return SUCCESS;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// Section 3.3: Aeronautical Statistical Model
+
+/*******************************************************************************
+ * Inputs-in-range validation for the Earth-space and aeronautical statistical
+ * clutter loss model (Section 3.3).
+ *
+ * @param[in] f__ghz      Frequency, in GHz
+ * @param[in] theta__deg  Elevation angle, in degrees
+ * @param[in] p           Percentage of locations, in %
+ * @return                Return code
+ ******************************************************************************/
+inline ReturnCode Section3p3_InputValidation(
+    const double f__ghz, const double theta__deg, const double p
+) {
+    if (f__ghz < 10 || f__ghz > 100)
+        return ERROR33__FREQUENCY;
+
+    if (theta__deg < 0 || theta__deg > 90)
+        return ERROR33__THETA;
+
+    if (p <= 0 || p >= 100)
+        return ERROR33__PERCENTAGE;
+
+    return SUCCESS;
+}
+
+/*******************************************************************************
+ * Frequency term of Equation (7) of Section 3.3.
+ *
+ * @param[in] f__ghz  Frequency, in GHz
+ * @return            @f$ K_1 @f$
+ ******************************************************************************/
+inline double Equation_7_K_1(const double f__ghz) {
+    return Generic::Equation_7_K_1(f__ghz);
+}
+
+/*******************************************************************************
+ * Terms of Equation (7) of Section 3.3 which depend only on the frequency and
+ * percentage of locations, for validated inputs.
+ *
+ * @param[in] f__ghz  Frequency, in GHz
+ * @param[in] p       Percentage of locations, in %
+ * @return            Scale of Equation (7), @f$ -K_1 \ln(1 - p/100) @f$
+ ******************************************************************************/
+inline double Equation_7_Scale(const double f__ghz, const double p) {
+    return Generic::Equation_7_Scale(f__ghz, p);
+}
+
+/*******************************************************************************
+ * Terms of Equation (7) of Section 3.3 which depend only on the elevation
+ * angle, for validated inputs.
+ *
+ * @param[in]  theta__deg  Elevation angle, in degrees
+ * @param[out] cot_term    Cotangent term of Equation (7)
+ * @param[out] exponent    Exponent of Equation (7)
+ ******************************************************************************/
+inline void Equation_7_AngleTerms(
+    const double theta__deg, double &cot_term, double &exponent
+) {
+    Generic::Equation_7_AngleTerms(theta__deg, cot_term, exponent);
+}
+
+/*******************************************************************************
+ * Equation (7) of Section 3.3, given its frequency, percentage and angle
+ * terms.
+ *
+ * @param[in] scale     Scale of Equation (7), from `Equation_7_Scale`
+ * @param[in] cot_term  Cotangent term, from `Equation_7_AngleTerms`
+ * @param[in] exponent  Exponent, from `Equation_7_AngleTerms`
+ * @param[in] Q_p       Inverse CCDF of the percentage of locations, p / 100
+ * @return              Additional loss (clutter loss), in dB
+ ******************************************************************************/
+inline double Equation_7_Combine(
+    const double scale,
+    const double cot_term,
+    const double exponent,
+    const double Q_p
+) {
+    return Generic::Equation_7_Combine(scale, cot_term, exponent, Q_p);
+}
+
+/*******************************************************************************
+ * Equation (7) of Section 3.3, given the terms which do not depend on the
+ * elevation angle, for validated inputs.
+ *
+ * @param[in] scale       Scale of Equation (7), from `Equation_7_Scale`
+ * @param[in] theta__deg  Elevation angle, in degrees
+ * @param[in] Q_p         Inverse CCDF of the percentage of locations, p / 100
+ * @return                Additional loss (clutter loss), in dB
+ ******************************************************************************/
+inline double Equation_7_Angle(
+    const double scale, const double theta__deg, const double Q_p
+) {
+    double cot_term, exponent;
+    Equation_7_AngleTerms(theta__deg, cot_term, exponent);
+
+    return Equation_7_Combine(scale, cot_term, exponent, Q_p);
+}
+
+/*******************************************************************************
+ * Equation (7) of Section 3.3, for validated inputs.
+ *
+ * @param[in] f__ghz      Frequency, in GHz
+ * @param[in] theta__deg  Elevation angle, in degrees
+ * @param[in] p           Percentage of locations, in %
+ * @param[in] Q_p         Inverse CCDF of the percentage of locations, p / 100
+ * @return                Additional loss (clutter loss), in dB
+ ******************************************************************************/
+inline double Equation_7(
+    const double f__ghz,
+    const double theta__deg,
+    const double p,
+    const double Q_p
+) {
+    return Equation_7_Angle(Equation_7_Scale(f__ghz, p), theta__deg, Q_p);
+}
+
+/*******************************************************************************
+ * The Earth-space and aeronautical statistical clutter loss model as described
+ * in Section 3.3.
+ *
+ * Inline equivalent of the exported `AeronauticalStatisticalModel`.
+ *
+ * @param[in]  f__ghz      Frequency, in GHz
+ * @param[in]  theta__deg  Elevation angle, in degrees
+ * @param[in]  p           Percentage of locations, in %
+ * @param[out] L_ces__db   Additional loss (clutter loss), in dB
+ * @param[in]  algorithm   Algorithm of the inverse CCDF
+ * @return                 Return code
+ ******************************************************************************/
+inline ReturnCode AeronauticalStatisticalModel(
+    const double f__ghz,
+    const double theta__deg,
+    const double p,
+    double &L_ces__db,
+    const InverseCCDFAlgorithm algorithm = ABRAMOWITZ_STEGUN
+) {
+    ReturnCode rtn = Section3p3_InputValidation(f__ghz, theta__deg, p);
+    if (rtn != SUCCESS)
+        return rtn;
+
+    L_ces__db = Equation_7(
+        f__ghz,
+        theta__deg,
+        p,
+        Inline::InverseComplementaryCumulativeDistribution(p / 100, algorithm)
+    );
+    return rtn;
+}
+
+}  // namespace Inline
+}  // namespace P2108
+}  // namespace PSeries
+}  // namespace ITU
+}  // namespace ITS
@@ -0,0 +1,67 @@
+/** @file P2108Link.h
+ * End-to-end clutter correction of terrestrial links.
+ *
+ * A terrestrial link calculation corrects for clutter at the transmitter and
+ * at the receiver with the Height Gain Terminal Correction Model, and adds
+ * the Terrestrial Statistical Model when both terminals are in clutter. The
+ * link batch evaluates all three for each link in one pass. The terms which
+ * depend only on the frequency (@f$ K_{h2} @f$, @f$ K_{\nu} @f$ and the
+ * location loss @f$ L_l @f$) are computed once per link and shared by the
+ * three models, and links are processed in tiles of `P2108GetBatchTileSize`
+ * links, each stage running over a tile while it is in cache. Each component
+ * is identical to the corresponding model.
+ *
+ * A terminal is in clutter when its antenna is below the representative
+ * clutter height. Links with a terminal above the clutter get a Terrestrial
+ * Statistical Model component of 0 dB, and its inputs (path distance and
+ * percentage of locations) are not validated. The algorithm of the inverse
+ * CCDF of the percentage is an `InverseCCDFAlgorithm` value.
+ *
+ * This header may be included from C or C++.
+ */
+#pragma once
+
+#include "P2108Api.h"
+
+#include <stddef.h>  // for size_t
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** Clutter around one terminal of a link */
+typedef struct P2108LinkTerminal {
+    double h__meter;   /**< Antenna height, in meters */
+    double w_s__meter; /**< Street width, in meters */
+    double R__meter;   /**< Representative clutter height, in meters */
+    int clutter_type;  /**< Clutter type (`ClutterType` value) */
+} P2108LinkTerminal;
+
+/** Inputs of one link */
+typedef struct P2108Link {
+    double f__ghz;        /**< Frequency, in GHz */
+    double d__km;         /**< Path distance, in km */
+    double p;             /**< Percentage of locations, in % */
+    P2108LinkTerminal tx; /**< Clutter around the transmitter */
+    P2108LinkTerminal rx; /**< Clutter around the receiver */
+} P2108Link;
+
+/** Clutter correction of one link, and its components */
+typedef struct P2108LinkCorrection {
+    double A_h_tx__db; /**< Height gain correction at the transmitter, in dB */
+    double A_h_rx__db; /**< Height gain correction at the receiver, in dB */
+    double L_ctt__db;  /**< Terrestrial statistical clutter loss, in dB */
+    double total__db;  /**< Sum of the components, in dB */
+} P2108LinkCorrection;
+
+PROPLIB_C_API size_t P2108LinkClutterCorrectionBatch(
+    size_t n,
+    const P2108Link *links,
+    int algorithm,
+    P2108LinkCorrection *corrections,
+    int *rtn
+);
+
+#ifdef __cplusplus
+}
+#endif
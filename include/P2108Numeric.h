@@ -0,0 +1,308 @@
+/** @file P2108Numeric.h
+ * Numeric types and math functions for the generic kernels of
+ * P2108Generic.h.
+ *
+ * The generic kernels are templates over a numeric type `T`, and call math
+ * functions only through `Math<T>`. A numeric type supports `+`, `-`, `*`
+ * and `/` with itself, unary `-`, construction from a `double` constant, and
+ * comparisons whose result `Math<T>::Select` accepts. The primary `Math`
+ * template uses the `<cmath>` functions, so `double` and `float` work as is.
+ * This header adds two more types:
+ *
+ * - `Pack<T, N>`: `N` lanes of `T`, evaluated element-wise in loops which
+ *   the compiler may vectorize. A pack backed by SIMD intrinsics plugs in the
+ *   same way, with its own `Math` specialization.
+ * - `Dual<T>`: a dual number, carrying a value and its derivative with
+ *   respect to one input, for forward-mode automatic differentiation.
+ */
+#pragma once
+
+#include <cmath>    // for std::atan, std::fmin, std::log, std::pow, ...
+#include <cstddef>  // for std::size_t
+
+namespace ITS {
+namespace ITU {
+namespace PSeries {
+namespace P2108 {
+
+/*******************************************************************************
+ * Math functions of a numeric type, used by the generic kernels.
+ *
+ * The primary template serves the floating point types through `<cmath>`.
+ * Other numeric types specialize it.
+ ******************************************************************************/
+template<typename T>
+struct Math {
+        static T Sqrt(const T &x) { return std::sqrt(x); }
+        static T Log(const T &x) { return std::log(x); }
+        static T Log10(const T &x) { return std::log10(x); }
+        static T Pow(const T &x, const T &y) { return std::pow(x, y); }
+        static T Tan(const T &x) { return std::tan(x); }
+        static T Atan(const T &x) { return std::atan(x); }
+        static T Min(const T &x, const T &y) { return std::fmin(x, y); }
+
+        /** Choose `x` where `mask` is true, and `y` elsewhere */
+        static T Select(const bool mask, const T &x, const T &y) {
+            return mask ? x : y;
+        }
+};
+
+////////////////////////////////////////////////////////////////////////////////
+// Pack
+
+/*******************************************************************************
+ * Mask of the lanes of a `Pack`, the result of comparing two packs.
+ ******************************************************************************/
+template<std::size_t N>
+struct PackMask {
+        bool lane[N]; /**< Result of the comparison in each lane */
+};
+
+/*******************************************************************************
+ * Fixed number of values of a floating point type, operated on together.
+ *
+ * Each operation applies to every lane in a loop of fixed length, which the
+ * compiler may vectorize.
+ ******************************************************************************/
+template<typename T, std::size_t N>
+struct Pack {
+        T lane[N]; /**< Value of each lane */
+
+        Pack() = default;
+
+        /** Broadcast a value to every lane */
+        Pack(const T value) {
+            for (std::size_t i = 0; i < N; i++) {
+                lane[i] = value;
+            }
+        }
+
+        /** Load `N` values */
+        static Pack Load(const T *values) {
+            Pack result;
+            for (std::size_t i = 0; i < N; i++) {
+                result.lane[i] = values[i];
+            }
+            return result;
+        }
+
+        /** Store the lanes to `N` values */
+        void Store(T *values) const {
+            for (std::size_t i = 0; i < N; i++) {
+                values[i] = lane[i];
+            }
+        }
+
+        /** Apply a function of one value to each lane */
+        template<typename Function>
+        Pack Map(const Function &function) const {
+            Pack result;
+            for (std::size_t i = 0; i < N; i++) {
+                result.lane[i] = function(lane[i]);
+            }
+            return result;
+        }
+
+        /** Apply a function of two values to each pair of lanes */
+        template<typename Function>
+        Pack Zip(const Pack &other, const Function &function) const {
+            Pack result;
+            for (std::size_t i = 0; i < N; i++) {
+                result.lane[i] = function(lane[i], other.lane[i]);
+            }
+            return result;
+        }
+
+        /** Compare each pair of lanes */
+        template<typename Function>
+        PackMask<N> Compare(const Pack &other, const Function &function) const {
+            PackMask<N> result;
+            for (std::size_t i = 0; i < N; i++) {
+                result.lane[i] = function(lane[i], other.lane[i]);
+            }
+            return result;
+        }
+};
+
+template<typename T, std::size_t N>
+inline Pack<T, N> operator-(const Pack<T, N> &x) {
+    return x.Map([](const T a) { return -a; });
+}
+
+template<typename T, std::size_t N>
+inline Pack<T, N> operator+(const Pack<T, N> &x, const Pack<T, N> &y) {
+    return x.Zip(y, [](const T a, const T b) { return a + b; });
+}
+
+template<typename T, std::size_t N>
+inline Pack<T, N> operator-(const Pack<T, N> &x, const Pack<T, N> &y) {
+    return x.Zip(y, [](const T a, const T b) { return a - b; });
+}
+
+template<typename T, std::size_t N>
+inline Pack<T, N> operator*(const Pack<T, N> &x, const Pack<T, N> &y) {
+    return x.Zip(y, [](const T a, const T b) { return a * b; });
+}
+
+template<typename T, std::size_t N>
+inline Pack<T, N> operator/(const Pack<T, N> &x, const Pack<T, N> &y) {
+    return x.Zip(y, [](const T a, const T b) { return a / b; });
+}
+
+template<typename T, std::size_t N>
+inline PackMask<N> operator<(const Pack<T, N> &x, const Pack<T, N> &y) {
+    return x.Compare(y, [](const T a, const T b) { return a < b; });
+}
+
+template<typename T, std::size_t N>
+inline PackMask<N> operator<=(const Pack<T, N> &x, const Pack<T, N> &y) {
+    return x.Compare(y, [](const T a, const T b) { return a <= b; });
+}
+
+template<typename T, std::size_t N>
+inline PackMask<N> operator>(const Pack<T, N> &x, const Pack<T, N> &y) {
+    return x.Compare(y, [](const T a, const T b) { return a > b; });
+}
+
+/*******************************************************************************
+ * Math functions of a `Pack`, applying those of its lane type to each lane.
+ ******************************************************************************/
+template<typename T, std::size_t N>
+struct Math<Pack<T, N>> {
+        typedef Pack<T, N> P;
+
+        static P Sqrt(const P &x) { return x.Map(Math<T>::Sqrt); }
+        static P Log(const P &x) { return x.Map(Math<T>::Log); }
+        static P Log10(const P &x) { return x.Map(Math<T>::Log10); }
+        static P Pow(const P &x, const P &y) { return x.Zip(y, Math<T>::Pow); }
+        static P Tan(const P &x) { return x.Map(Math<T>::Tan); }
+        static P Atan(const P &x) { return x.Map(Math<T>::Atan); }
+        static P Min(const P &x, const P &y) { return x.Zip(y, Math<T>::Min); }
+
+        /** Choose the lanes of `x` where `mask` is true, else those of `y` */
+        static P Select(const PackMask<N> &mask, const P &x, const P &y) {
+            P result;
+            for (std::size_t i = 0; i < N; i++) {
+                result.lane[i] = mask.lane[i] ? x.lane[i] : y.lane[i];
+            }
+            return result;
+        }
+};
+
+////////////////////////////////////////////////////////////////////////////////
+// Dual
+
+/*******************************************************************************
+ * Dual number @f$ v + d \epsilon @f$, with @f$ \epsilon^2 = 0 @f$.
+ *
+ * Evaluating a function on a dual number with `d = 1` gives its value and
+ * its derivative with respect to that input. Constants have `d = 0`.
+ * Comparisons compare the values, so a piecewise function is differentiated
+ * along the branch which computes its value.
+ ******************************************************************************/
+template<typename T>
+struct Dual {
+        T v; /**< Value */
+        T d; /**< Derivative */
+
+        Dual() = default;
+
+        /** A constant */
+        Dual(const T value): v(value), d(0) {}
+
+        /** A value with its derivative */
+        Dual(const T value, const T derivative): v(value), d(derivative) {}
+};
+
+template<typename T>
+inline Dual<T> operator-(const Dual<T> &x) {
+    return Dual<T>(-x.v, -x.d);
+}
+
+template<typename T>
+inline Dual<T> operator+(const Dual<T> &x, const Dual<T> &y) {
+    return Dual<T>(x.v + y.v, x.d + y.d);
+}
+
+template<typename T>
+inline Dual<T> operator-(const Dual<T> &x, const Dual<T> &y) {
+    return Dual<T>(x.v - y.v, x.d - y.d);
+}
+
+template<typename T>
+inline Dual<T> operator*(const Dual<T> &x, const Dual<T> &y) {
+    return Dual<T>(x.v * y.v, x.d * y.v + x.v * y.d);
+}
+
+template<typename T>
+inline Dual<T> operator/(const Dual<T> &x, const Dual<T> &y) {
+    return Dual<T>(x.v / y.v, (x.d * y.v - x.v * y.d) / (y.v * y.v));
+}
+
+template<typename T>
+inline bool operator<(const Dual<T> &x, const Dual<T> &y) {
+    return x.v < y.v;
+}
+
+template<typename T>
+inline bool operator<=(const Dual<T> &x, const Dual<T> &y) {
+    return x.v <= y.v;
+}
+
+template<typename T>
+inline bool operator>(const Dual<T> &x, const Dual<T> &y) {
+    return x.v > y.v;
+}
+
+/*******************************************************************************
+ * Math functions of a `Dual`, by the chain rule.
+ ******************************************************************************/
+template<typename T>
+struct Math<Dual<T>> {
+        typedef Dual<T> D;
+        typedef Math<T> M;
+
+        static D Sqrt(const D &x) {
+            const T root = M::Sqrt(x.v);
+            return D(root, x.d / (2 * root));
+        }
+
+        static D Log(const D &x) { return D(M::Log(x.v), x.d / x.v); }
+
+        static D Log10(const D &x) {
+            return D(M::Log10(x.v), x.d / (x.v * M::Log(T(10))));
+        }
+
+        /** Power; the term of the exponent is omitted if it is constant, so a
+         * negative base may be raised to a constant power */
+        static D Pow(const D &x, const D &y) {
+            const T value = M::Pow(x.v, y.v);
+            T derivative = y.v * M::Pow(x.v, y.v - 1) * x.d;
+            if (y.d != 0) {
+                derivative += value * M::Log(x.v) * y.d;
+            }
+            return D(value, derivative);
+        }
+
+        static D Tan(const D &x) {
+            const T tan = M::Tan(x.v);
+            return D(tan, (1 + tan * tan) * x.d);
+        }
+
+        static D Atan(const D &x) {
+            return D(M::Atan(x.v), x.d / (1 + x.v * x.v));
+        }
+
+        /** Lesser of two numbers; `x` where their values are equal */
+        static D Min(const D &x, const D &y) { return (y.v < x.v) ? y : x; }
+
+        /** Choose `x` where `mask` is true, and `y` elsewhere */
+        static D Select(const bool mask, const D &x, const D &y) {
+            return mask ? x : y;
+        }
+};
+
+}  // namespace P2108
+}  // namespace PSeries
+}  // namespace ITU
+}  // namespace ITS
@@ -0,0 +1,99 @@
+/** @file P2108Probes.h
+ * USDT static tracepoints at the library entry points (internal).
+ *
+ * Probes are compiled in on Linux when `sys/sdt.h` is found and the
+ * `ENABLE_USDT` CMake option is on. Each probe is a single `nop` instruction
+ * plus an ELF note, so a probe costs nothing until a tracer such as
+ * `bpftrace` or `perf` attaches to it. Otherwise the macros expand to nothing.
+ *
+ * All probes belong to the `p2108` provider. Floating point arguments are
+ * passed as the 64-bit pattern of their IEEE 754 representation, since USDT
+ * arguments are integers. Probes for each model are:
+ *
+ * - `asm__entry(f__ghz, theta__deg, p)`
+ * - `asm__return(rtn, L_ces__db)`
+ * - `tsm__entry(f__ghz, d__km, p)`
+ * - `tsm__return(rtn, L_ctt__db)`
+ * - `hgtcm__entry(f__ghz, h__meter, w_s__meter, R__meter, clutter_type)`
+ * - `hgtcm__return(rtn, A_h__db)`
+ *
+ * The strided batch functions fire `asm_batch__entry(n)`,
+ * `tsm_batch__entry(n)` and `hgtcm_batch__entry(n)` with the number of
+ * records, and the matching `*_batch__return(n_failed)` probes with the
+ * number of invalid records.
+ *
+ * The raster functions fire `tsm_coverage__entry(n)`,
+ * `tsm_coverage_file__entry(n)`, `hgtcm_raster__entry(n)` and
+ * `hgtcm_raster_file__entry(n)` with the number of cells in the grid, and the
+ * matching `*__return(rtn)` probes with the status returned.
+ *
+ * Track replays fire `track_set__entry(track, f__ghz, p)` and
+ * `track_set__return(rtn)` when a track is set, and
+ * `track_evaluate__entry(n)` and `track_evaluate__return(n_failed)` with the
+ * number of samples and of invalid samples.
+ *
+ * The samplers fire `tsm_samples__entry(f__ghz, d__km, n)` and
+ * `asm_samples__entry(f__ghz, theta__deg, n)`, and the matching
+ * `*_samples__return(rtn)` probes with the status returned.
+ *
+ * The link batch fires `link_batch__entry(n)` and
+ * `link_batch__return(n_failed)` with the number of links and of invalid
+ * links.
+ *
+ * The Jacobian functions fire `hgtcm_jacobian__entry(n)`,
+ * `tsm_jacobian__entry(n)` and `asm_jacobian__entry(n)` with the number of
+ * records, and the matching `*_jacobian__return(n_failed)` probes with the
+ * number of invalid records.
+ *
+ * The surface queries fire `asm_surface__entry(n)`, `tsm_surface__entry(n)`
+ * and `hgtcm_surface__entry(n)` with the number of records, and the matching
+ * `*_surface__return(n_failed)` probes with the number of invalid records.
+ *
+ * The loss passed to a return probe is unspecified unless `rtn` is `SUCCESS`.
+ */
+#pragma once
+
+#if defined(P2108_USDT) && !defined(DOXYGEN_SHOULD_SKIP)
+    #include <cstdint>  // for std::int64_t, std::uint64_t
+    #include <cstring>  // for std::memcpy
+    #include <sys/sdt.h>
+
+namespace ITS {
+namespace ITU {
+namespace PSeries {
+namespace P2108 {
+
+/** Get the bit pattern of a double, to pass it as a probe argument */
+inline std::uint64_t ProbeBits(const double value) {
+    std::uint64_t bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+    return bits;
+}
+
+/** Pass an integer or enumeration as a probe argument */
+template<typename T>
+inline std::int64_t ProbeInt(const T value) {
+    return static_cast<std::int64_t>(value);
+}
+
+}  // namespace P2108
+}  // namespace PSeries
+}  // namespace ITU
+}  // namespace ITS
+
+    /** Fire a probe with one argument */
+    #define P2108_PROBE1(name, a1) DTRACE_PROBE1(p2108, name, a1)
+    /** Fire a probe with two arguments */
+    #define P2108_PROBE2(name, a1, a2) DTRACE_PROBE2(p2108, name, a1, a2)
+    /** Fire a probe with three arguments */
+    #define P2108_PROBE3(name, a1, a2, a3) \
+        DTRACE_PROBE3(p2108, name, a1, a2, a3)
+    /** Fire a probe with five arguments */
+    #define P2108_PROBE5(name, a1, a2, a3, a4, a5) \
+        DTRACE_PROBE5(p2108, name, a1, a2, a3, a4, a5)
+#else
+    #define P2108_PROBE1(name, a1)
+    #define P2108_PROBE2(name, a1, a2)
+    #define P2108_PROBE3(name, a1, a2, a3)
+    #define P2108_PROBE5(name, a1, a2, a3, a4, a5)
+#endif
@@ -0,0 +1,482 @@
+/** @file P2108Range.h
+ * Lazy range views over model evaluations, for C++ callers.
+ *
+ * A range view evaluates a model over its input ranges on demand, as its
+ * results are consumed. Records are evaluated in chunks into a small fixed
+ * buffer owned by the view, so memory use is constant regardless of the
+ * number of records. The first chunk is small and later chunks grow up to
+ * `LazyModelRange::MAX_CHUNK` records, so stopping early (for example, from
+ * `std::find_if`) wastes little work while long traversals keep a tight
+ * inner loop.
+ *
+ * Each input may be any range with `begin()` and `end()`, or a single value,
+ * which is repeated for every record. Evaluation stops at the end of the
+ * shortest input range. For example, the first distance at which the median
+ * terrestrial clutter loss at 3 GHz exceeds 20 dB is found with:
+ *
+ * @code
+ * auto losses = TerrestrialStatisticalModelRange(3.0, d__km, 50.0);
+ * auto it = std::find_if(losses.begin(), losses.end(),
+ *     [](const ModelResult &r) { return r.loss__db > 20.0; });
+ * @endcode
+ *
+ * Records which fail validation yield their error code and a NaN loss. The
+ * views use the kernels in `P2108Kernels.h`, so they do not record
+ * instrumentation or fire probes.
+ */
+#pragma once
+
+#include "P2108.h"
+#include "P2108Kernels.h"
+
+#include <cstddef>      // for std::ptrdiff_t, std::size_t
+#include <iterator>     // for std::begin, std::end, std::input_iterator_tag
+#include <limits>       // for std::numeric_limits
+#include <type_traits>  // for std::enable_if, std::is_arithmetic, ...
+#include <utility>      // for std::declval
+
+namespace ITS {
+namespace ITU {
+namespace PSeries {
+namespace P2108 {
+
+/** Result of evaluating one record of a model */
+struct ModelResult {
+        ReturnCode rtn;  /**< Return code of the record */
+        double loss__db; /**< Loss, in dB, or NaN if `rtn` is not `SUCCESS` */
+};
+
+/*******************************************************************************
+ * @class RepeatIterator
+ * An endless iterator which yields the same value, used to broadcast a single
+ * input value to every record of a range view.
+ ******************************************************************************/
+template<typename T>
+class RepeatIterator {
+    public:
+        /** Construct an iterator yielding `value` */
+        explicit RepeatIterator(const T value): value_(value) {}
+
+        /** Get the repeated value */
+        const T &operator*() const {
+            return value_;
+        }
+
+        /** Advance the iterator, which has no effect */
+        RepeatIterator &operator++() {
+            return *this;
+        }
+
+        /** A repeated value never reaches its end */
+        bool operator!=(const RepeatIterator &) const {
+            return true;
+        }
+    private:
+        T value_; /**< Repeated value */
+};
+
+/*******************************************************************************
+ * Adapts a model input, either a range or a single value, to a pair of
+ * iterators. Single values are repeated endlessly.
+ ******************************************************************************/
+template<typename T, typename Enable = void>
+struct InputTraits {
+        /** Type of iterator over the input */
+        using iterator = decltype(std::begin(std::declval<const T &>()));
+
+        /** Get an iterator to the first element of the input */
+        static iterator Begin(const T &input) {
+            return std::begin(input);
+        }
+
+        /** Get an iterator past the last element of the input */
+        static iterator End(const T &input) {
+            return std::end(input);
+        }
+};
+
+/** Adapts a single arithmetic or enumeration value to a repeated input */
+template<typename T>
+struct InputTraits<
+    T,
+    typename std::enable_if<
+        std::is_arithmetic<T>::value || std::is_enum<T>::value>::type> {
+        /** Type of iterator over the input */
+        using iterator = RepeatIterator<T>;
+
+        /** Get an iterator which repeats the value */
+        static iterator Begin(const T &input) {
+            return iterator(input);
+        }
+
+        /** Get the (unreachable) end of the repeated value */
+        static iterator End(const T &input) {
+            return iterator(input);
+        }
+};
+
+/** Type of iterator used to read a model input */
+template<typename T>
+using InputIterator = typename InputTraits<T>::iterator;
+
+/*******************************************************************************
+ * @class LazyModelRange
+ * A single-pass range which evaluates a model on demand.
+ *
+ * The `Source` evaluates consecutive records. It must provide a member
+ * function `std::size_t Fill(ModelResult *results, std::size_t max)` which
+ * evaluates up to `max` records into `results` and returns the number
+ * evaluated, which is 0 once the inputs are exhausted.
+ *
+ * Like `std::istream_iterator`, all iterators of a view share its position,
+ * so the view must outlive its iterators and may be traversed only once.
+ ******************************************************************************/
+template<typename Source>
+class LazyModelRange {
+    public:
+        /** Number of records evaluated by the first chunk */
+        static constexpr std::size_t MIN_CHUNK = 16;
+        /** Maximum number of records evaluated by one chunk */
+        static constexpr std::size_t MAX_CHUNK = 256;
+
+        /***********************************************************************
+         * @class iterator
+         * Input iterator over the results of a lazy model range view.
+         **********************************************************************/
+        class iterator {
+            public:
+                using iterator_category = std::input_iterator_tag;
+                using value_type = ModelResult;
+                using difference_type = std::ptrdiff_t;
+                using pointer = const ModelResult *;
+                using reference = const ModelResult &;
+
+                /** Construct an end iterator */
+                iterator(): range_(nullptr) {}
+
+                /** Get the current result */
+                reference operator*() const {
+                    return range_->buffer_[range_->pos_];
+                }
+
+                /** Access a member of the current result */
+                pointer operator->() const {
+                    return &range_->buffer_[range_->pos_];
+                }
+
+                /** Advance to the next result, evaluating a chunk if needed */
+                iterator &operator++() {
+                    if (!range_->Advance()) {
+                        range_ = nullptr;
+                    }
+                    return *this;
+                }
+
+                /** Holds a copy of a result, returned by post-increment */
+                class proxy {
+                    public:
+                        /** Get the copied result */
+                        const ModelResult &operator*() const {
+                            return result_;
+                        }
+                    private:
+                        friend class iterator;
+
+                        /** Construct a proxy holding a copy of a result */
+                        explicit proxy(const ModelResult &result):
+                            result_(result) {}
+
+                        ModelResult result_; /**< Copied result */
+                };
+
+                /** Advance to the next result, returning the previous one */
+                proxy operator++(int) {
+                    const proxy previous(**this);
+                    ++*this;
+                    return previous;
+                }
+
+                /** Iterators compare equal if both are at the end */
+                bool operator==(const iterator &other) const {
+                    return range_ == other.range_;
+                }
+
+                /** Iterators compare unequal unless both are at the end */
+                bool operator!=(const iterator &other) const {
+                    return range_ != other.range_;
+                }
+            private:
+                friend class LazyModelRange;
+
+                /** Construct an iterator at the current result of a view */
+                explicit iterator(LazyModelRange *range): range_(range) {}
+
+                LazyModelRange *range_; /**< View, or null at the end */
+        };
+
+        /** Construct a view which evaluates records from `source` */
+        explicit LazyModelRange(const Source &source):
+            source_(source), size_(0), pos_(0), chunk_(MIN_CHUNK) {}
+
+        /** Get an iterator to the current result, evaluating it if needed */
+        iterator begin() {
+            if (pos_ >= size_ && !Refill()) {
+                return end();
+            }
+            return iterator(this);
+        }
+
+        /** Get the end iterator */
+        iterator end() {
+            return iterator();
+        }
+    private:
+        /** Move to the next result. Returns false if there are no more */
+        bool Advance() {
+            return ++pos_ < size_ || Refill();
+        }
+
+        /** Evaluate the next chunk. Returns false if there are no more */
+        bool Refill() {
+            size_ = source_.Fill(buffer_, chunk_);
+            pos_ = 0;
+            if (chunk_ < MAX_CHUNK) {
+                chunk_ *= 2;
+            }
+            return size_ > 0;
+        }
+
+        Source source_;                 /**< Evaluates the records */
+        ModelResult buffer_[MAX_CHUNK]; /**< Results of the current chunk */
+        std::size_t size_;              /**< Number of results in buffer */
+        std::size_t pos_;               /**< Position of current result */
+        std::size_t chunk_;             /**< Size of the next chunk */
+};
+
+template<typename Source>
+constexpr std::size_t LazyModelRange<Source>::MIN_CHUNK;
+template<typename Source>
+constexpr std::size_t LazyModelRange<Source>::MAX_CHUNK;
+
+/** Set the loss of an invalid record to NaN */
+inline void SetInvalidLossToNaN(ModelResult &result) {
+    if (result.rtn != SUCCESS) {
+        result.loss__db = std::numeric_limits<double>::quiet_NaN();
+    }
+}
+
+/** Source of Aeronautical Statistical Model results for `LazyModelRange` */
+template<typename F, typename Theta, typename P>
+class ASMSource {
+    public:
+        /** Construct a source from the begin and end of each input */
+        ASMSource(F f, F f_end, Theta theta, Theta theta_end, P p, P p_end):
+            f_(f),
+            f_end_(f_end),
+            theta_(theta),
+            theta_end_(theta_end),
+            p_(p),
+            p_end_(p_end) {}
+
+        /** Evaluate up to `max` records, returning the number evaluated */
+        std::size_t Fill(ModelResult *results, const std::size_t max) {
+            std::size_t n = 0;
+            for (; n < max && f_ != f_end_ && theta_ != theta_end_
+                   && p_ != p_end_;
+                 n++, ++f_, ++theta_, ++p_) {
+                results[n].rtn = Inline::AeronauticalStatisticalModel(
+                    *f_, *theta_, *p_, results[n].loss__db
+                );
+                SetInvalidLossToNaN(results[n]);
+            }
+            return n;
+        }
+    private:
+        F f_, f_end_;             /**< Frequency input, in GHz */
+        Theta theta_, theta_end_; /**< Elevation angle input, in degrees */
+        P p_, p_end_;             /**< Percentage input */
+};
+
+/** Source of Terrestrial Statistical Model results for `LazyModelRange` */
+template<typename F, typename D, typename P>
+class TSMSource {
+    public:
+        /** Construct a source from the begin and end of each input */
+        TSMSource(F f, F f_end, D d, D d_end, P p, P p_end):
+            f_(f), f_end_(f_end), d_(d), d_end_(d_end), p_(p), p_end_(p_end) {}
+
+        /** Evaluate up to `max` records, returning the number evaluated */
+        std::size_t Fill(ModelResult *results, const std::size_t max) {
+            std::size_t n = 0;
+            for (; n < max && f_ != f_end_ && d_ != d_end_ && p_ != p_end_;
+                 n++, ++f_, ++d_, ++p_) {
+                results[n].rtn = Inline::TerrestrialStatisticalModel(
+                    *f_, *d_, *p_, results[n].loss__db
+                );
+                SetInvalidLossToNaN(results[n]);
+            }
+            return n;
+        }
+    private:
+        F f_, f_end_; /**< Frequency input, in GHz */
+        D d_, d_end_; /**< Path distance input, in km */
+        P p_, p_end_; /**< Percentage input */
+};
+
+/** Source of Height Gain Terminal Correction Model results for
+ *  `LazyModelRange` */
+template<typename F, typename H, typename W, typename R, typename C>
+class HGTCMSource {
+    public:
+        /** Construct a source from the begin and end of each input */
+        HGTCMSource(
+            F f,
+            F f_end,
+            H h,
+            H h_end,
+            W w_s,
+            W w_s_end,
+            R R__meter,
+            R R__meter_end,
+            C clutter_type,
+            C clutter_type_end
+        ):
+            f_(f),
+            f_end_(f_end),
+            h_(h),
+            h_end_(h_end),
+            w_s_(w_s),
+            w_s_end_(w_s_end),
+            R_(R__meter),
+            R_end_(R__meter_end),
+            clutter_type_(clutter_type),
+            clutter_type_end_(clutter_type_end) {}
+
+        /** Evaluate up to `max` records, returning the number evaluated */
+        std::size_t Fill(ModelResult *results, const std::size_t max) {
+            std::size_t n = 0;
+            for (; n < max && f_ != f_end_ && h_ != h_end_ && w_s_ != w_s_end_
+                   && R_ != R_end_ && clutter_type_ != clutter_type_end_;
+                 n++, ++f_, ++h_, ++w_s_, ++R_, ++clutter_type_) {
+                results[n].rtn = Inline::HeightGainTerminalCorrectionModel(
+                    *f_,
+                    *h_,
+                    *w_s_,
+                    *R_,
+                    static_cast<ClutterType>(*clutter_type_),
+                    results[n].loss__db
+                );
+                SetInvalidLossToNaN(results[n]);
+            }
+            return n;
+        }
+    private:
+        F f_, f_end_;     /**< Frequency input, in GHz */
+        H h_, h_end_;     /**< Antenna height input, in meters */
+        W w_s_, w_s_end_; /**< Street width input, in meters */
+        R R_, R_end_;     /**< Representative clutter height, in meters */
+        C clutter_type_, clutter_type_end_; /**< Clutter type input */
+};
+
+/*******************************************************************************
+ * Lazily evaluate the Aeronautical Statistical Model.
+ *
+ * @param[in] f__ghz      Frequencies, in GHz, or a single frequency
+ * @param[in] theta__deg  Elevation angles, in degrees, or a single angle
+ * @param[in] p           Percentages, or a single percentage
+ * @return                Range view of the results, as `ModelResult`s
+ ******************************************************************************/
+template<typename F, typename Theta, typename P>
+LazyModelRange<
+    ASMSource<InputIterator<F>, InputIterator<Theta>, InputIterator<P>>>
+    AeronauticalStatisticalModelRange(
+        const F &f__ghz, const Theta &theta__deg, const P &p
+    ) {
+    using Source = ASMSource<
+        InputIterator<F>,
+        InputIterator<Theta>,
+        InputIterator<P>>;
+    return LazyModelRange<Source>(Source(
+        InputTraits<F>::Begin(f__ghz),
+        InputTraits<F>::End(f__ghz),
+        InputTraits<Theta>::Begin(theta__deg),
+        InputTraits<Theta>::End(theta__deg),
+        InputTraits<P>::Begin(p),
+        InputTraits<P>::End(p)
+    ));
+}
+
+/*******************************************************************************
+ * Lazily evaluate the Terrestrial Statistical Model.
+ *
+ * @param[in] f__ghz  Frequencies, in GHz, or a single frequency
+ * @param[in] d__km   Path distances, in km, or a single distance
+ * @param[in] p       Percentages, or a single percentage
+ * @return            Range view of the results, as `ModelResult`s
+ ******************************************************************************/
+template<typename F, typename D, typename P>
+LazyModelRange<TSMSource<InputIterator<F>, InputIterator<D>, InputIterator<P>>>
+    TerrestrialStatisticalModelRange(
+        const F &f__ghz, const D &d__km, const P &p
+    ) {
+    using Source
+        = TSMSource<InputIterator<F>, InputIterator<D>, InputIterator<P>>;
+    return LazyModelRange<Source>(Source(
+        InputTraits<F>::Begin(f__ghz),
+        InputTraits<F>::End(f__ghz),
+        InputTraits<D>::Begin(d__km),
+        InputTraits<D>::End(d__km),
+        InputTraits<P>::Begin(p),
+        InputTraits<P>::End(p)
+    ));
+}
+
+/*******************************************************************************
+ * Lazily evaluate the Height Gain Terminal Correction Model.
+ *
+ * @param[in] f__ghz        Frequencies, in GHz, or a single frequency
+ * @param[in] h__meter      Antenna heights, in meters, or a single height
+ * @param[in] w_s__meter    Street widths, in meters, or a single width
+ * @param[in] R__meter      Representative clutter heights, in meters, or a
+ *                          single height
+ * @param[in] clutter_type  Clutter types, or a single clutter type
+ * @return                  Range view of the results, as `ModelResult`s
+ ******************************************************************************/
+template<typename F, typename H, typename W, typename R, typename C>
+LazyModelRange<HGTCMSource<
+    InputIterator<F>,
+    InputIterator<H>,
+    InputIterator<W>,
+    InputIterator<R>,
+    InputIterator<C>>>
+    HeightGainTerminalCorrectionModelRange(
+        const F &f__ghz,
+        const H &h__meter,
+        const W &w_s__meter,
+        const R &R__meter,
+        const C &clutter_type
+    ) {
+    using Source = HGTCMSource<
+        InputIterator<F>,
+        InputIterator<H>,
+        InputIterator<W>,
+        InputIterator<R>,
+        InputIterator<C>>;
+    return LazyModelRange<Source>(Source(
+        InputTraits<F>::Begin(f__ghz),
+        InputTraits<F>::End(f__ghz),
+        InputTraits<H>::Begin(h__meter),
+        InputTraits<H>::End(h__meter),
+        InputTraits<W>::Begin(w_s__meter),
+        InputTraits<W>::End(w_s__meter),
+        InputTraits<R>::Begin(R__meter),
+        InputTraits<R>::End(R__meter),
+        InputTraits<C>::Begin(clutter_type),
+        InputTraits<C>::End(clutter_type)
+    ));
+}
+
+}  // namespace P2108
+}  // namespace PSeries
+}  // namespace ITU
+}  // namespace ITS
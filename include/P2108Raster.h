@@ -0,0 +1,108 @@
+/** @file P2108Raster.h
+ * Raster engines which evaluate a model over a regular grid of locations.
+ *
+ * A grid has `n_rows` rows of `n_cols` cells. The center of the cell in row
+ * `r` and column `c` is at `(x0__km + c * dx__km, y0__km + r * dy__km)` in a
+ * planar (projected) coordinate system, with distances in km. For a
+ * north-up raster, `y0__km` is the northern edge row and `dy__km` is
+ * negative.
+ *
+ * Rasters are arrays of `float` values in row-major order, starting with the
+ * first cell of row 0. Cells which fail validation (for example, receivers
+ * closer to the transmitter than the model allows) are NaN. The `*File`
+ * functions stream the raster to a raw binary file in the host byte order,
+ * so rasters larger than memory may be produced. Each raw file is described
+ * by a sidecar header, in the ENVI format read by GDAL and most GIS tools,
+ * at the same path with `.hdr` appended.
+ *
+ * Input rasters are raw binary files in the same layout: a `uint8_t`
+ * land-cover code or a `float` value per cell, in row-major order and the
+ * host byte order. Input files are memory-mapped and read in blocks as the
+ * output is streamed, and pages already read are released, so inputs larger
+ * than memory may also be used. Memory-mapped inputs require a POSIX system.
+ *
+ * The engines evaluate rows in parallel on `n_threads` threads, or on one
+ * thread per hardware thread if `n_threads` is 0. Results are the same for
+ * any number of threads.
+ *
+ * This header may be included from C or C++.
+ */
+#pragma once
+
+#include "P2108Api.h"
+
+#include <stddef.h>  // for size_t
+#include <stdint.h>  // for uint8_t, uint32_t
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** Status codes returned by the raster functions, other than model errors */
+enum P2108RasterStatus {
+    P2108_RASTER_SUCCESS = 0,           /**< Successful execution */
+    P2108_RASTER_ERROR_ARGUMENT = 1,    /**< Invalid grid, or null pointer */
+    P2108_RASTER_ERROR_IO = 2,          /**< Failed to read or write a file */
+    P2108_RASTER_ERROR_SIZE = 3,        /**< Input file size does not match */
+    P2108_RASTER_ERROR_UNSUPPORTED = 4, /**< Not supported on this platform */
+};
+
+/** Number of entries in a table of land-cover codes */
+#define P2108_LAND_COVER_CODES 256
+
+/** Geometry of a regular grid of cells */
+typedef struct P2108RasterGeometry {
+    uint32_t n_rows; /**< Number of rows */
+    uint32_t n_cols; /**< Number of cells in each row */
+    double x0__km;   /**< x coordinate of the center of the first cell, in km */
+    double y0__km;   /**< y coordinate of the center of the first cell, in km */
+    double dx__km;   /**< Distance between columns along x, in km */
+    double dy__km;   /**< Distance between rows along y, in km */
+} P2108RasterGeometry;
+
+PROPLIB_C_API int P2108TerrestrialCoverage(
+    const P2108RasterGeometry *grid,
+    double tx_x__km,
+    double tx_y__km,
+    double f__ghz,
+    double p,
+    int algorithm,
+    float *L_ctt__db,
+    size_t n_threads
+);
+PROPLIB_C_API int P2108TerrestrialCoverageFile(
+    const P2108RasterGeometry *grid,
+    double tx_x__km,
+    double tx_y__km,
+    double f__ghz,
+    double p,
+    int algorithm,
+    const char *path,
+    size_t n_threads
+);
+PROPLIB_C_API int P2108HeightGainRaster(
+    const P2108RasterGeometry *grid,
+    const uint8_t *land_cover,
+    const int *clutter_types,
+    const float *R__meter,
+    double f__ghz,
+    double h__meter,
+    double w_s__meter,
+    float *A_h__db,
+    size_t n_threads
+);
+PROPLIB_C_API int P2108HeightGainRasterFile(
+    const P2108RasterGeometry *grid,
+    const char *land_cover_path,
+    const int *clutter_types,
+    const char *R__meter_path,
+    double f__ghz,
+    double h__meter,
+    double w_s__meter,
+    const char *path,
+    size_t n_threads
+);
+
+#ifdef __cplusplus
+}
+#endif
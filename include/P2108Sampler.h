@@ -0,0 +1,59 @@
+/** @file P2108Sampler.h
+ * Monte Carlo sampling of the location variability of the statistical models.
+ *
+ * Drawing a uniform percentage of locations and evaluating a model at it
+ * re-derives the terms of the model which do not depend on the percentage,
+ * and inverts the normal CCDF, for every draw. The samplers instead compute
+ * those terms once per geometry and draw the standard normal deviate
+ * @f$ Q^{-1}(p/100) @f$ directly, so each sample costs a few operations. The
+ * samples have the distribution of the model at a uniformly distributed
+ * percentage, with the exact inverse CCDF in place of its approximation.
+ *
+ * Normal deviates are generated by the Box-Muller transform from the
+ * counter-based Philox4x32-10 generator. Sample `i` of stream `stream` with
+ * key `seed` depends only on those three values, so samples may be drawn in
+ * any order, on any number of threads, and in any number of calls, with
+ * identical results. Use a different stream for each independent geometry
+ * or trial set, and the same seed for a reproducible study.
+ *
+ * This header may be included from C or C++.
+ */
+#pragma once
+
+#include "P2108Api.h"
+
+#include <stddef.h>  // for size_t
+#include <stdint.h>  // for uint32_t, uint64_t
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+PROPLIB_C_API void P2108Philox4x32(
+    const uint32_t counter[4], const uint32_t key[2], uint32_t output[4]
+);
+PROPLIB_C_API void P2108StandardNormalSamples(
+    uint64_t seed, uint64_t stream, uint64_t first, size_t n, double *z
+);
+PROPLIB_C_API int P2108TerrestrialStatisticalModelSamples(
+    double f__ghz,
+    double d__km,
+    uint64_t seed,
+    uint64_t stream,
+    uint64_t first,
+    size_t n,
+    double *L_ctt__db
+);
+PROPLIB_C_API int P2108AeronauticalStatisticalModelSamples(
+    double f__ghz,
+    double theta__deg,
+    uint64_t seed,
+    uint64_t stream,
+    uint64_t first,
+    size_t n,
+    double *L_ces__db
+);
+
+#ifdef __cplusplus
+}
+#endif
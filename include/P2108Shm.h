@@ -0,0 +1,136 @@
+/** @file P2108Shm.h
+ * C interface for the shared-memory transport of the driver service mode.
+ *
+ * A service started with `P2108Driver -shm <name>` creates a POSIX shared
+ * memory region containing a ring of request/response slots. A client claims
+ * a free slot, writes model input columns directly into it, and submits it.
+ * The service evaluates the model and writes return codes and clutter loss
+ * values back into the same slot, so records are never copied between the
+ * processes. Futexes on words in the region are used for signalling.
+ *
+ * This header may be included from C or C++. The transport is available on
+ * Linux only; elsewhere, every function returns `P2108_SHM_ERROR_UNSUPPORTED`.
+ */
+#pragma once
+
+#include "P2108Api.h"
+
+#include <stdint.h>  // for int32_t, uint32_t, uint64_t
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** Identifies a P2108 shared-memory region (ASCII "P21S") */
+#define P2108_SHM_MAGIC 0x50323153u
+/** Version of the region layout described in this header */
+#define P2108_SHM_VERSION 1u
+/** Maximum number of input columns used by any model */
+#define P2108_SHM_MAX_INPUTS 5
+/** Alignment, in bytes, of the header, slots, and columns in the region */
+#define P2108_SHM_ALIGNMENT 64
+
+/** Status codes returned by the shared-memory client functions */
+enum P2108ShmStatus {
+    P2108_SHM_SUCCESS = 0,           /**< Successful execution */
+    P2108_SHM_ERROR_UNSUPPORTED = 1, /**< Not supported on this platform */
+    P2108_SHM_ERROR_CONNECT = 2,     /**< Failed to open or map the region */
+    P2108_SHM_ERROR_VERSION = 3,     /**< Region has an incompatible layout */
+    P2108_SHM_ERROR_ARGUMENT = 4,    /**< Invalid model or record count */
+    P2108_SHM_ERROR_SHUTDOWN = 5,    /**< The service is shutting down */
+};
+
+/** Life cycle of a slot. The service only reads slots in the REQUEST state. */
+enum P2108ShmSlotState {
+    P2108_SHM_SLOT_FREE = 0,     /**< Available to be claimed by a client */
+    P2108_SHM_SLOT_CLAIMED = 1,  /**< Owned by a client writing inputs */
+    P2108_SHM_SLOT_REQUEST = 2,  /**< Submitted, waiting for the service */
+    P2108_SHM_SLOT_BUSY = 3,     /**< Being evaluated by the service */
+    P2108_SHM_SLOT_RESPONSE = 4, /**< Results written, owned by the client */
+};
+
+/*******************************************************************************
+ * Header at the start of the shared-memory region.
+ *
+ * Slot `i` begins `slot_offset + i * slot_stride` bytes from the start of
+ * the region, where `slot_offset` is `P2108_SHM_ALIGNMENT` and `slot_stride`
+ * is `P2108ShmSlotStride(capacity)`; clients check both on connecting. Within
+ * a slot, the P2108ShmSlot header is followed (at `P2108_SHM_ALIGNMENT` byte
+ * offsets) by `P2108_SHM_MAX_INPUTS` input columns of `capacity` doubles, one
+ * column of `capacity` double loss values, and one column of `capacity` int32
+ * return codes.
+ *
+ * Every process mapping the region can write to it, so neither side trusts
+ * the other with addresses: the service and each client locate slots and
+ * columns from the layout they validated when creating or connecting to the
+ * region, and the service checks the model and record count of each request.
+ ******************************************************************************/
+typedef struct P2108ShmHeader {
+    uint32_t magic;        /**< Equal to `P2108_SHM_MAGIC` when initialized */
+    uint32_t version;      /**< Equal to `P2108_SHM_VERSION` */
+    uint32_t n_slots;      /**< Number of slots in the ring */
+    uint32_t capacity;     /**< Maximum number of records per slot */
+    uint64_t slot_offset;  /**< Offset of the first slot, in bytes */
+    uint64_t slot_stride;  /**< Distance between slots, in bytes */
+    uint32_t request_seq;  /**< Futex word, bumped when a slot is submitted */
+    uint32_t release_seq;  /**< Futex word, bumped when a slot is released */
+    uint32_t shutdown;     /**< Nonzero once the service is stopping */
+} P2108ShmHeader;
+
+/*******************************************************************************
+ * Header at the start of each slot.
+ *
+ * A slot stays claimed until its client releases it. The service does not
+ * reclaim the slots of a client which exits without releasing them, so each
+ * such slot is unavailable until the service is restarted.
+ ******************************************************************************/
+typedef struct P2108ShmSlot {
+    uint32_t state;  /**< Futex word holding a `P2108ShmSlotState` value */
+    int32_t model;   /**< Model to run (1: HGTCM, 2: TSM, 3: ASM) */
+    uint32_t count;  /**< Number of records in the request */
+    int32_t status;  /**< `P2108_SHM_SUCCESS` or a `P2108ShmStatus` error */
+} P2108ShmSlot;
+
+/** A claimed slot, with pointers to its columns in the shared region */
+typedef struct P2108ShmBatch {
+    double *inputs[P2108_SHM_MAX_INPUTS]; /**< Input columns, in model order */
+    double *loss;                         /**< Clutter loss results, in dB */
+    int32_t *rtn;                         /**< Return code of each record */
+    uint32_t capacity;                    /**< Maximum number of records */
+    uint32_t slot;                        /**< Index of the claimed slot */
+} P2108ShmBatch;
+
+/** Opaque handle to a connection to the shared-memory region */
+typedef struct P2108ShmClient P2108ShmClient;
+
+PROPLIB_C_API int P2108ShmConnect(const char *name, P2108ShmClient **client);
+PROPLIB_C_API void P2108ShmDisconnect(P2108ShmClient *client);
+PROPLIB_C_API int P2108ShmAcquire(P2108ShmClient *client, P2108ShmBatch *batch);
+PROPLIB_C_API int P2108ShmSubmit(
+    P2108ShmClient *client,
+    P2108ShmBatch *batch,
+    int32_t model,
+    uint32_t count
+);
+PROPLIB_C_API void P2108ShmRelease(
+    P2108ShmClient *client, P2108ShmBatch *batch
+);
+
+PROPLIB_C_API uint64_t P2108ShmSlotStride(uint32_t capacity);
+PROPLIB_C_API P2108ShmSlot *P2108ShmGetSlot(
+    void *region, uint32_t capacity, uint32_t slot
+);
+PROPLIB_C_API void P2108ShmGetBatch(
+    void *region,
+    uint32_t capacity,
+    uint32_t slot,
+    P2108ShmBatch *batch
+);
+PROPLIB_C_API int P2108ShmWait(
+    uint32_t *word, uint32_t expected, int32_t timeout__ms
+);
+PROPLIB_C_API void P2108ShmWake(uint32_t *word, int32_t n_waiters);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,171 @@
+/** @file P2108Surface.h
+ * C interface for precomputed loss surfaces, persisted in a file which many
+ * processes map read-only.
+ *
+ * A surface file holds the models tabulated on regular grids, written once by
+ * `P2108SurfaceWrite` (or `P2108Driver -surface <file>`). Opening the file
+ * maps it into memory, so processes which open the same file share its pages,
+ * and startup costs one `mmap` and a checksum pass rather than evaluating the
+ * grids again. Queries interpolate linearly between the grid nodes:
+ *
+ * - Terrestrial Statistical Model: the median (Equation 3a) and standard
+ *   deviation (Equation 3b) of the loss over frequency and path distance.
+ *   The inverse CCDF of the percentage is applied at query time, with the
+ *   algorithm passed to the query.
+ * - Aeronautical Statistical Model: the logarithm of the power term of
+ *   Equation (7), over frequency, elevation angle and percentage. It is
+ *   linear in the logarithm of the frequency and, on the
+ *   `P2108_SURFACE_PERCENTAGE` scale, in the percentage, so only the
+ *   elevation angle contributes interpolation error. The inverse CCDF term is
+ *   added at query time.
+ * - Height Gain Terminal Correction Model: for the clutter types which use
+ *   Equation (2a), the loss depends on the four continuous inputs only
+ *   through the diffraction parameter @f$ \nu @f$, so the surface is the
+ *   loss over @f$ \nu @f$. Equation (2b) is evaluated directly.
+ *
+ * Inputs are validated as by the models. Valid inputs outside a grid are
+ * evaluated by the model, so every query returns a loss. The header records
+ * the maximum interpolation error of each surface, measured at the centers
+ * of the grid cells when the file is written.
+ *
+ * Files are rejected when opened if their layout version or the version of
+ * the library which wrote them differ from this library, or if a checksum
+ * fails. Files are in the byte order of the host which wrote them.
+ *
+ * Memory mapping is used on POSIX platforms; elsewhere, the file is read
+ * into memory when opened. This header may be included from C or C++.
+ */
+#pragma once
+
+#include "P2108Api.h"
+
+#include <stddef.h>  // for size_t
+#include <stdint.h>  // for uint32_t, uint64_t
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** Identifies a P2108 surface file (ASCII "P21T") */
+#define P2108_SURFACE_MAGIC 0x50323154u
+/** Version of the file layout described in this header */
+#define P2108_SURFACE_VERSION 1u
+/** Size of the library version string in the header, in bytes */
+#define P2108_SURFACE_LIBRARY_VERSION_SIZE 16
+/** Default number of grid nodes along each axis */
+#define P2108_SURFACE_DEFAULT_NODES 64
+
+/** Status codes returned by the surface file functions */
+enum P2108SurfaceStatus {
+    P2108_SURFACE_SUCCESS = 0,        /**< Successful execution */
+    P2108_SURFACE_ERROR_OPEN = 1,     /**< Failed to open or map the file */
+    P2108_SURFACE_ERROR_FORMAT = 2,   /**< Not a surface file, or truncated */
+    P2108_SURFACE_ERROR_VERSION = 3,  /**< Incompatible layout version */
+    P2108_SURFACE_ERROR_STALE = 4,    /**< Written by another library version */
+    P2108_SURFACE_ERROR_CHECKSUM = 5, /**< Contents fail a checksum */
+    P2108_SURFACE_ERROR_ARGUMENT = 6, /**< Invalid grid specification */
+    P2108_SURFACE_ERROR_WRITE = 7,    /**< Failed to write the file */
+};
+
+/** Spacing of the nodes of a grid axis */
+enum P2108SurfaceScale {
+    P2108_SURFACE_LINEAR = 0, /**< Evenly spaced values */
+    P2108_SURFACE_LOG = 1,    /**< Evenly spaced logarithms of the values */
+    /** Evenly spaced @f$ \ln(-\ln(1 - x/100)) @f$, for percentages */
+    P2108_SURFACE_PERCENTAGE = 2,
+};
+
+/** One axis of a grid */
+typedef struct P2108SurfaceAxis {
+    double min;     /**< Value of the first node */
+    double max;     /**< Value of the last node */
+    uint32_t count; /**< Number of nodes, at least 2 */
+    uint32_t scale; /**< Spacing of the nodes (`P2108SurfaceScale`) */
+} P2108SurfaceAxis;
+
+/** Grids of the surfaces in a file */
+typedef struct P2108SurfaceSpec {
+    P2108SurfaceAxis tsm_f__ghz;     /**< TSM frequency, in GHz */
+    P2108SurfaceAxis tsm_d__km;      /**< TSM path distance, in km */
+    P2108SurfaceAxis asm_f__ghz;     /**< ASM frequency, in GHz */
+    P2108SurfaceAxis asm_theta__deg; /**< ASM elevation angle, in degrees */
+    P2108SurfaceAxis asm_p;          /**< ASM percentage of locations, in % */
+    P2108SurfaceAxis hgtcm_nu;       /**< HGTCM diffraction parameter */
+} P2108SurfaceSpec;
+
+/*******************************************************************************
+ * Location of one surface in a file. The values are stored as doubles in
+ * row-major order of the axes of the surface, as listed in
+ * `P2108SurfaceSpec`.
+ ******************************************************************************/
+typedef struct P2108SurfaceSection {
+    uint64_t offset;   /**< Offset of the first value, in bytes */
+    uint64_t count;    /**< Number of values */
+    uint64_t checksum; /**< FNV-1a hash of the values */
+    double max_error;  /**< Maximum interpolation error found, in dB */
+} P2108SurfaceSection;
+
+/** Header at the start of a surface file */
+typedef struct P2108SurfaceHeader {
+    uint32_t magic;   /**< Equal to `P2108_SURFACE_MAGIC` */
+    uint32_t version; /**< Equal to `P2108_SURFACE_VERSION` */
+    char library_version[P2108_SURFACE_LIBRARY_VERSION_SIZE]; /**< Writer */
+    P2108SurfaceSpec spec;           /**< Grids of the surfaces */
+    P2108SurfaceSection tsm_median;  /**< TSM median loss, in dB */
+    P2108SurfaceSection tsm_sigma;   /**< TSM standard deviation, in dB */
+    P2108SurfaceSection asm_loss;    /**< ASM log of the power term */
+    P2108SurfaceSection hgtcm_loss;  /**< HGTCM loss of Equation (2a), in dB */
+    uint64_t file_size;              /**< Size of the file, in bytes */
+    uint64_t header_checksum;        /**< FNV-1a hash of the fields above */
+} P2108SurfaceHeader;
+
+/** Opaque handle to an open surface file */
+typedef struct P2108Surface P2108Surface;
+
+PROPLIB_C_API void P2108SurfaceDefaultSpec(
+    uint32_t nodes, P2108SurfaceSpec *spec
+);
+PROPLIB_C_API int P2108SurfaceWrite(
+    const char *path, const P2108SurfaceSpec *spec
+);
+PROPLIB_C_API int P2108SurfaceOpen(const char *path, P2108Surface **surface);
+PROPLIB_C_API void P2108SurfaceClose(P2108Surface *surface);
+PROPLIB_C_API const P2108SurfaceHeader *P2108SurfaceGetHeader(
+    const P2108Surface *surface
+);
+
+PROPLIB_C_API size_t P2108SurfaceAeronauticalStatisticalModel(
+    const P2108Surface *surface,
+    size_t n,
+    const double *f__ghz,
+    const double *theta__deg,
+    const double *p,
+    int algorithm,
+    double *L_ces__db,
+    int *rtn
+);
+PROPLIB_C_API size_t P2108SurfaceTerrestrialStatisticalModel(
+    const P2108Surface *surface,
+    size_t n,
+    const double *f__ghz,
+    const double *d__km,
+    const double *p,
+    int algorithm,
+    double *L_ctt__db,
+    int *rtn
+);
+PROPLIB_C_API size_t P2108SurfaceHeightGainTerminalCorrectionModel(
+    const P2108Surface *surface,
+    size_t n,
+    const double *f__ghz,
+    const double *h__meter,
+    const double *w_s__meter,
+    const double *R__meter,
+    const int *clutter_type,
+    double *A_h__db,
+    int *rtn
+);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,73 @@
+/** @file P2108Tracks.h
+ * Replay of aircraft tracks through the Aeronautical Statistical Model.
+ *
+ * A replay holds the state of many tracks, such as the aircraft visible from
+ * a set of ground stations. Each track has a frequency, percentage of
+ * locations and inverse CCDF algorithm (`InverseCCDFAlgorithm` value), and
+ * the terms of the model which depend only on them are computed once, when
+ * the track is set. Samples of any mix of tracks, for example a time-ordered
+ * stream of position reports, are then evaluated together in tiles, so each
+ * sample costs only the terms which depend on its elevation angle. With
+ * `ABRAMOWITZ_STEGUN`, results are identical to
+ * `AeronauticalStatisticalModel`.
+ *
+ * Tracks may be set and removed as aircraft appear and disappear. A replay
+ * may be evaluated from several threads at once, but must not be evaluated
+ * while tracks are being set or removed.
+ *
+ * This header may be included from C or C++.
+ */
+#pragma once
+
+#include "P2108Api.h"
+
+#include <stddef.h>  // for size_t
+#include <stdint.h>  // for uint64_t
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** Status codes of the track replay functions, other than model errors */
+enum P2108TrackStatus {
+    P2108_TRACK_SUCCESS = 0,        /**< Successful execution */
+    P2108_TRACK_ERROR_ARGUMENT = 1, /**< Null pointer */
+    P2108_TRACK_ERROR_UNKNOWN = 2,  /**< Sample of a track which is not set */
+};
+
+/** State of the tracks of a replay */
+typedef struct P2108TrackReplay P2108TrackReplay;
+
+PROPLIB_C_API P2108TrackReplay *P2108TrackReplayCreate(void);
+PROPLIB_C_API void P2108TrackReplayFree(P2108TrackReplay *replay);
+PROPLIB_C_API int P2108TrackReplaySetTrack(
+    P2108TrackReplay *replay,
+    uint64_t track,
+    double f__ghz,
+    double p,
+    int algorithm
+);
+PROPLIB_C_API int P2108TrackReplayRemoveTrack(
+    P2108TrackReplay *replay, uint64_t track
+);
+PROPLIB_C_API size_t P2108TrackReplayCount(const P2108TrackReplay *replay);
+PROPLIB_C_API size_t P2108TrackReplayEvaluate(
+    const P2108TrackReplay *replay,
+    size_t n,
+    const uint64_t *track,
+    const double *theta__deg,
+    double *L_ces__db,
+    int *rtn
+);
+PROPLIB_C_API double P2108ElevationAngle(
+    double station_lat__deg,
+    double station_lon__deg,
+    double station_h__meter,
+    double lat__deg,
+    double lon__deg,
+    double h__meter
+);
+
+#ifdef __cplusplus
+}
+#endif
@@ -2,8 +2,9 @@
  * Implements the model from ITU-R P.2108 Section 3.3.
  */
 #include "P2108.h"
-
-#include <cmath>  // for std::pow, std::log, std::tan
+#include "P2108Instrumentation.h"
+#include "P2108Kernels.h"
+#include "P2108Probes.h"
 
 namespace ITS {
 namespace ITU {
@@ -34,22 +35,15 @@ ReturnCode AeronauticalStatisticalModel(
     const double p,
     double &L_ces__db
 ) {
-    ReturnCode rtn = Section3p3_InputValidation(f__ghz, theta__deg, p);
-    if (rtn != SUCCESS)
-        return rtn;
-
-    constexpr double A_1 = 0.05;
-    const double K_1 = 93 * std::pow(f__ghz, 0.175);
-
-    const double part1 = std::log(1 - p / 100.0);
-    const double part2
-        = A_1 * (1 - theta__deg / 90.0) + PI * theta__deg / 180.0;
-    const double part3 = 0.5 * (90.0 - theta__deg) / 90.0;
-    const double part4
-        = 0.6 * InverseComplementaryCumulativeDistribution(p / 100);
-
-    L_ces__db = std::pow(-K_1 * part1 * cot(part2), part3) - 1 - part4;
-    return rtn;
+    P2108_INSTRUMENT(P2108_STATS_ASM);
+    P2108_PROBE3(
+        asm__entry, ProbeBits(f__ghz), ProbeBits(theta__deg), ProbeBits(p)
+    );
+    const ReturnCode rtn = Inline::AeronauticalStatisticalModel(
+        f__ghz, theta__deg, p, L_ces__db
+    );
+    P2108_PROBE2(asm__return, ProbeInt(rtn), ProbeBits(L_ces__db));
+    return P2108_INSTRUMENT_RETURN(rtn);
 }
 
 /*******************************************************************************
@@ -71,16 +65,7 @@ ReturnCode AeronauticalStatisticalModel(
 ReturnCode Section3p3_InputValidation(
     const double f__ghz, const double theta__deg, const double p
 ) {
-    if (f__ghz < 10 || f__ghz > 100)
-        return ERROR33__FREQUENCY;
-
-    if (theta__deg < 0 || theta__deg > 90)
-        return ERROR33__THETA;
-
-    if (p <= 0 || p >= 100)
-        return ERROR33__PERCENTAGE;
-
-    return SUCCESS;
+    return Inline::Section3p3_InputValidation(f__ghz, theta__deg, p);
 }
 
 /*******************************************************************************
@@ -92,7 +77,7 @@ ReturnCode Section3p3_InputValidation(
  * @return       Cotangent of the argument, @f$ \cot(x) @f$
  ******************************************************************************/
 double cot(const double x) {
-    return 1 / std::tan(x);
+    return Inline::cot(x);
 }
 
 }  // namespace P2108
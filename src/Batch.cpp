@@ -0,0 +1,501 @@
+/** @file Batch.cpp
+ * Implements the strided batch interface to the models.
+ */
+#include "P2108Batch.h"
+
+#include "P2108.h"
+#include "P2108Instrumentation.h"
+#include "P2108Kernels.h"
+#include "P2108Probes.h"
+
+#include <algorithm>    // for std::min
+#include <atomic>       // for std::atomic
+#include <cmath>        // for std::fmin
+#include <cstddef>      // for std::ptrdiff_t, std::size_t
+#include <limits>       // for std::numeric_limits
+#include <type_traits>  // for std::conditional, std::is_const
+#include <vector>       // for std::vector
+
+using namespace ITS::ITU::PSeries::P2108;
+
+namespace {
+/** Number of records evaluated by each stage before moving to the next */
+std::atomic<std::size_t> tile_size(P2108_DEFAULT_BATCH_TILE_SIZE);
+
+/*******************************************************************************
+ * Intermediate results of one tile, reused between calls on a thread.
+ ******************************************************************************/
+struct Tile {
+        std::vector<ReturnCode> code; /**< Validation result of each record */
+        std::vector<double> Q_p;      /**< Inverse CCDF of each percentage */
+        std::vector<double> L_l__db;  /**< TSM location loss, in dB */
+
+        /** Get the tile of this thread, with room for `n` records */
+        static Tile &Get(const std::size_t n) {
+            static thread_local Tile tile;
+            if (tile.code.size() < n) {
+                tile.code.resize(n);
+                tile.Q_p.resize(n);
+                tile.L_l__db.resize(n);
+            }
+            return tile;
+        }
+};
+
+/** Array of elements stored one after the other */
+template<typename T>
+class Contiguous {
+    public:
+        Contiguous(T *data, std::ptrdiff_t): data_(data) {}
+
+        T &operator[](const std::size_t i) const {
+            return data_[i];
+        }
+
+        explicit operator bool() const {
+            return data_ != nullptr;
+        }
+    private:
+        T *data_; /**< First element */
+};
+
+/** Array of elements separated by a fixed number of bytes */
+template<typename T>
+class Strided {
+    public:
+        Strided(T *data, const std::ptrdiff_t stride):
+            data_(data), stride_(stride) {}
+
+        T &operator[](const std::size_t i) const {
+            typedef typename std::conditional<
+                std::is_const<T>::value,
+                const char,
+                char>::type Byte;
+            return *reinterpret_cast<T *>(
+                reinterpret_cast<Byte *>(data_)
+                + stride_ * static_cast<std::ptrdiff_t>(i)
+            );
+        }
+
+        explicit operator bool() const {
+            return data_ != nullptr;
+        }
+    private:
+        T *data_;               /**< First element */
+        std::ptrdiff_t stride_; /**< Distance between elements, in bytes */
+};
+
+/** Check whether an array is contiguous, or may be treated as such */
+template<typename T>
+bool IsContiguous(const T *data, const std::ptrdiff_t stride) {
+    return data == nullptr
+        || stride == static_cast<std::ptrdiff_t>(sizeof(T));
+}
+
+/*******************************************************************************
+ * Store the result of one record.
+ *
+ * @param[in]  code    Return code of the record
+ * @param[in]  i       Index of the record
+ * @param[out] loss    Loss output, set to NaN if the record is invalid
+ * @param[out] rtn     Return code output, if not null
+ * @param[out] first   First invalid return code seen so far
+ * @param[out] failed  Number of invalid records seen so far
+ ******************************************************************************/
+template<typename Loss, typename Rtn>
+inline void Store(
+    const ReturnCode code,
+    const std::size_t i,
+    const Loss &loss,
+    const Rtn &rtn,
+    ReturnCode &first,
+    std::size_t &failed
+) {
+    if (code != SUCCESS) {
+        loss[i] = std::numeric_limits<double>::quiet_NaN();
+        if (failed++ == 0) {
+            first = code;
+        }
+    }
+    if (rtn) {
+        rtn[i] = code;
+    }
+}
+
+/*******************************************************************************
+ * Evaluate the Aeronautical Statistical Model over arrays of one layout.
+ *
+ * Records are evaluated one tile at a time. Each stage runs over the whole
+ * tile before the next, while the inputs and intermediates are in cache.
+ ******************************************************************************/
+template<template<typename> class Array>
+std::size_t EvaluateASM(
+    const std::size_t n,
+    const Array<const double> f__ghz,
+    const Array<const double> theta__deg,
+    const Array<const double> p,
+    const InverseCCDFAlgorithm algorithm,
+    const Array<double> L_ces__db,
+    const Array<int> rtn,
+    ReturnCode &first
+) {
+    const std::size_t tile_n = std::min(n, tile_size.load());
+    Tile &tile = Tile::Get(tile_n);
+    std::size_t failed = 0;
+    for (std::size_t start = 0; start < n; start += tile_n) {
+        const std::size_t m = std::min(tile_n, n - start);
+
+        // Validate the inputs
+        for (std::size_t t = 0, i = start; t < m; t++, i++) {
+            tile.code[t] = Inline::Section3p3_InputValidation(
+                f__ghz[i], theta__deg[i], p[i]
+            );
+        }
+
+        // Inverse CCDF of the valid percentages
+        for (std::size_t t = 0, i = start; t < m; t++, i++) {
+            tile.Q_p[t] = 0;
+            if (tile.code[t] == SUCCESS) {
+                tile.Q_p[t]
+                    = Inline::InverseComplementaryCumulativeDistribution(
+                        p[i] / 100, algorithm
+                    );
+            }
+        }
+
+        // Clutter loss
+        for (std::size_t t = 0, i = start; t < m; t++, i++) {
+            if (tile.code[t] == SUCCESS) {
+                L_ces__db[i] = Inline::Equation_7(
+                    f__ghz[i], theta__deg[i], p[i], tile.Q_p[t]
+                );
+            }
+            Store(tile.code[t], i, L_ces__db, rtn, first, failed);
+        }
+    }
+    return failed;
+}
+
+/*******************************************************************************
+ * Evaluate the Terrestrial Statistical Model over arrays of one layout.
+ *
+ * Records are evaluated one tile at a time. Each stage runs over the whole
+ * tile before the next, while the inputs and intermediates are in cache.
+ ******************************************************************************/
+template<template<typename> class Array>
+std::size_t EvaluateTSM(
+    const std::size_t n,
+    const Array<const double> f__ghz,
+    const Array<const double> d__km,
+    const Array<const double> p,
+    const InverseCCDFAlgorithm algorithm,
+    const Array<double> L_ctt__db,
+    const Array<int> rtn,
+    ReturnCode &first
+) {
+    const std::size_t tile_n = std::min(n, tile_size.load());
+    Tile &tile = Tile::Get(tile_n);
+    std::size_t failed = 0;
+    for (std::size_t start = 0; start < n; start += tile_n) {
+        const std::size_t m = std::min(tile_n, n - start);
+
+        // Validate the inputs
+        for (std::size_t t = 0, i = start; t < m; t++, i++) {
+            tile.code[t]
+                = Inline::Section3p2_InputValidation(f__ghz[i], d__km[i], p[i]);
+        }
+
+        // Inverse CCDF of the valid percentages
+        for (std::size_t t = 0, i = start; t < m; t++, i++) {
+            tile.Q_p[t] = 0;
+            if (tile.code[t] == SUCCESS) {
+                tile.Q_p[t]
+                    = Inline::InverseComplementaryCumulativeDistribution(
+                        p[i] / 100, algorithm
+                    );
+            }
+        }
+
+        // Location loss, shared by the losses at 2 km and at the distance
+        for (std::size_t t = 0, i = start; t < m; t++, i++) {
+            tile.L_l__db[t] = Inline::Equation_4(f__ghz[i]);
+        }
+
+        // Clutter loss, limited by the loss at 2 km (Equation 6)
+        for (std::size_t t = 0, i = start; t < m; t++, i++) {
+            if (tile.code[t] == SUCCESS) {
+                const double L_ctt_2km__db = Inline::Equation_3(
+                    tile.L_l__db[t],
+                    Inline::Equation_5(f__ghz[i], 2),
+                    tile.Q_p[t]
+                );
+                const double L_ctt_d__db = Inline::Equation_3(
+                    tile.L_l__db[t],
+                    Inline::Equation_5(f__ghz[i], d__km[i]),
+                    tile.Q_p[t]
+                );
+                L_ctt__db[i] = std::fmin(L_ctt_2km__db, L_ctt_d__db);
+            }
+            Store(tile.code[t], i, L_ctt__db, rtn, first, failed);
+        }
+    }
+    return failed;
+}
+
+/** Evaluate the Height Gain Terminal Correction Model over arrays of one
+ *  layout */
+template<template<typename> class Array>
+std::size_t EvaluateHGTCM(
+    const std::size_t n,
+    const Array<const double> f__ghz,
+    const Array<const double> h__meter,
+    const Array<const double> w_s__meter,
+    const Array<const double> R__meter,
+    const Array<const int> clutter_type,
+    const Array<double> A_h__db,
+    const Array<int> rtn,
+    ReturnCode &first
+) {
+    std::size_t failed = 0;
+    for (std::size_t i = 0; i < n; i++) {
+        const ReturnCode code = Inline::HeightGainTerminalCorrectionModel(
+            f__ghz[i],
+            h__meter[i],
+            w_s__meter[i],
+            R__meter[i],
+            static_cast<ClutterType>(clutter_type[i]),
+            A_h__db[i]
+        );
+        Store(code, i, A_h__db, rtn, first, failed);
+    }
+    return failed;
+}
+}  // namespace
+
+/*******************************************************************************
+ * Get the number of records per tile used by the batch functions.
+ *
+ * @return  Number of records per tile
+ ******************************************************************************/
+size_t P2108GetBatchTileSize(void) {
+    return tile_size.load();
+}
+
+/*******************************************************************************
+ * Set the number of records per tile used by the batch functions.
+ *
+ * @param[in] records  Number of records per tile, or 0 for the default
+ ******************************************************************************/
+void P2108SetBatchTileSize(size_t records) {
+    tile_size.store((records == 0) ? P2108_DEFAULT_BATCH_TILE_SIZE : records);
+}
+
+/*******************************************************************************
+ * Evaluate the Aeronautical Statistical Model for a batch of records.
+ *
+ * @param[in]  n                  Number of records
+ * @param[in]  f__ghz             Frequency, in GHz
+ * @param[in]  f__ghz_stride      Stride of `f__ghz`, in bytes
+ * @param[in]  theta__deg         Elevation angle, in degrees
+ * @param[in]  theta__deg_stride  Stride of `theta__deg`, in bytes
+ * @param[in]  p                  Percentage of locations, in %
+ * @param[in]  p_stride           Stride of `p`, in bytes
+ * @param[in]  algorithm          Inverse CCDF (`InverseCCDFAlgorithm` value)
+ * @param[out] L_ces__db          Additional loss (clutter loss), in dB
+ * @param[in]  L_ces__db_stride   Stride of `L_ces__db`, in bytes
+ * @param[out] rtn                Return code of each record (may be `NULL`)
+ * @param[in]  rtn_stride         Stride of `rtn`, in bytes
+ * @return                        Number of records which failed validation
+ ******************************************************************************/
+size_t P2108AeronauticalStatisticalModelBatch(
+    size_t n,
+    const double *f__ghz,
+    ptrdiff_t f__ghz_stride,
+    const double *theta__deg,
+    ptrdiff_t theta__deg_stride,
+    const double *p,
+    ptrdiff_t p_stride,
+    int algorithm,
+    double *L_ces__db,
+    ptrdiff_t L_ces__db_stride,
+    int *rtn,
+    ptrdiff_t rtn_stride
+) {
+    P2108_INSTRUMENT(P2108_STATS_ASM_BATCH);
+    P2108_PROBE1(asm_batch__entry, ProbeInt(n));
+    ReturnCode first = SUCCESS;
+    std::size_t failed;
+    if (IsContiguous(f__ghz, f__ghz_stride)
+        && IsContiguous(theta__deg, theta__deg_stride)
+        && IsContiguous(p, p_stride)
+        && IsContiguous(L_ces__db, L_ces__db_stride)
+        && IsContiguous(rtn, rtn_stride)) {
+        failed = EvaluateASM<Contiguous>(
+            n,
+            {f__ghz, f__ghz_stride},
+            {theta__deg, theta__deg_stride},
+            {p, p_stride},
+            Inline::ToInverseCCDFAlgorithm(algorithm),
+            {L_ces__db, L_ces__db_stride},
+            {rtn, rtn_stride},
+            first
+        );
+    } else {
+        failed = EvaluateASM<Strided>(
+            n,
+            {f__ghz, f__ghz_stride},
+            {theta__deg, theta__deg_stride},
+            {p, p_stride},
+            Inline::ToInverseCCDFAlgorithm(algorithm),
+            {L_ces__db, L_ces__db_stride},
+            {rtn, rtn_stride},
+            first
+        );
+    }
+    P2108_PROBE1(asm_batch__return, ProbeInt(failed));
+    P2108_INSTRUMENT_CODE(first);
+    return failed;
+}
+
+/*******************************************************************************
+ * Evaluate the Terrestrial Statistical Model for a batch of records.
+ *
+ * @param[in]  n                 Number of records
+ * @param[in]  f__ghz            Frequency, in GHz
+ * @param[in]  f__ghz_stride     Stride of `f__ghz`, in bytes
+ * @param[in]  d__km             Path distance, in km
+ * @param[in]  d__km_stride      Stride of `d__km`, in bytes
+ * @param[in]  p                 Percentage of locations, in %
+ * @param[in]  p_stride          Stride of `p`, in bytes
+ * @param[in]  algorithm         Inverse CCDF (`InverseCCDFAlgorithm` value)
+ * @param[out] L_ctt__db         Additional loss (clutter loss), in dB
+ * @param[in]  L_ctt__db_stride  Stride of `L_ctt__db`, in bytes
+ * @param[out] rtn               Return code of each record (may be `NULL`)
+ * @param[in]  rtn_stride        Stride of `rtn`, in bytes
+ * @return                       Number of records which failed validation
+ ******************************************************************************/
+size_t P2108TerrestrialStatisticalModelBatch(
+    size_t n,
+    const double *f__ghz,
+    ptrdiff_t f__ghz_stride,
+    const double *d__km,
+    ptrdiff_t d__km_stride,
+    const double *p,
+    ptrdiff_t p_stride,
+    int algorithm,
+    double *L_ctt__db,
+    ptrdiff_t L_ctt__db_stride,
+    int *rtn,
+    ptrdiff_t rtn_stride
+) {
+    P2108_INSTRUMENT(P2108_STATS_TSM_BATCH);
+    P2108_PROBE1(tsm_batch__entry, ProbeInt(n));
+    ReturnCode first = SUCCESS;
+    std::size_t failed;
+    if (IsContiguous(f__ghz, f__ghz_stride)
+        && IsContiguous(d__km, d__km_stride) && IsContiguous(p, p_stride)
+        && IsContiguous(L_ctt__db, L_ctt__db_stride)
+        && IsContiguous(rtn, rtn_stride)) {
+        failed = EvaluateTSM<Contiguous>(
+            n,
+            {f__ghz, f__ghz_stride},
+            {d__km, d__km_stride},
+            {p, p_stride},
+            Inline::ToInverseCCDFAlgorithm(algorithm),
+            {L_ctt__db, L_ctt__db_stride},
+            {rtn, rtn_stride},
+            first
+        );
+    } else {
+        failed = EvaluateTSM<Strided>(
+            n,
+            {f__ghz, f__ghz_stride},
+            {d__km, d__km_stride},
+            {p, p_stride},
+            Inline::ToInverseCCDFAlgorithm(algorithm),
+            {L_ctt__db, L_ctt__db_stride},
+            {rtn, rtn_stride},
+            first
+        );
+    }
+    P2108_PROBE1(tsm_batch__return, ProbeInt(failed));
+    P2108_INSTRUMENT_CODE(first);
+    return failed;
+}
+
+/*******************************************************************************
+ * Evaluate the Height Gain Terminal Correction Model for a batch of records.
+ *
+ * @param[in]  n                    Number of records
+ * @param[in]  f__ghz               Frequency, in GHz
+ * @param[in]  f__ghz_stride        Stride of `f__ghz`, in bytes
+ * @param[in]  h__meter             Antenna height, in meters
+ * @param[in]  h__meter_stride      Stride of `h__meter`, in bytes
+ * @param[in]  w_s__meter           Street width, in meters
+ * @param[in]  w_s__meter_stride    Stride of `w_s__meter`, in bytes
+ * @param[in]  R__meter             Representative clutter height, in meters
+ * @param[in]  R__meter_stride      Stride of `R__meter`, in bytes
+ * @param[in]  clutter_type         Clutter type (`ClutterType` value)
+ * @param[in]  clutter_type_stride  Stride of `clutter_type`, in bytes
+ * @param[out] A_h__db              Additional loss (clutter loss), in dB
+ * @param[in]  A_h__db_stride       Stride of `A_h__db`, in bytes
+ * @param[out] rtn                  Return code of each record (may be `NULL`)
+ * @param[in]  rtn_stride           Stride of `rtn`, in bytes
+ * @return                          Number of records which failed validation
+ ******************************************************************************/
+size_t P2108HeightGainTerminalCorrectionModelBatch(
+    size_t n,
+    const double *f__ghz,
+    ptrdiff_t f__ghz_stride,
+    const double *h__meter,
+    ptrdiff_t h__meter_stride,
+    const double *w_s__meter,
+    ptrdiff_t w_s__meter_stride,
+    const double *R__meter,
+    ptrdiff_t R__meter_stride,
+    const int *clutter_type,
+    ptrdiff_t clutter_type_stride,
+    double *A_h__db,
+    ptrdiff_t A_h__db_stride,
+    int *rtn,
+    ptrdiff_t rtn_stride
+) {
+    P2108_INSTRUMENT(P2108_STATS_HGTCM_BATCH);
+    P2108_PROBE1(hgtcm_batch__entry, ProbeInt(n));
+    ReturnCode first = SUCCESS;
+    std::size_t failed;
+    if (IsContiguous(f__ghz, f__ghz_stride)
+        && IsContiguous(h__meter, h__meter_stride)
+        && IsContiguous(w_s__meter, w_s__meter_stride)
+        && IsContiguous(R__meter, R__meter_stride)
+        && IsContiguous(clutter_type, clutter_type_stride)
+        && IsContiguous(A_h__db, A_h__db_stride)
+        && IsContiguous(rtn, rtn_stride)) {
+        failed = EvaluateHGTCM<Contiguous>(
+            n,
+            {f__ghz, f__ghz_stride},
+            {h__meter, h__meter_stride},
+            {w_s__meter, w_s__meter_stride},
+            {R__meter, R__meter_stride},
+            {clutter_type, clutter_type_stride},
+            {A_h__db, A_h__db_stride},
+            {rtn, rtn_stride},
+            first
+        );
+    } else {
+        failed = EvaluateHGTCM<Strided>(
+            n,
+            {f__ghz, f__ghz_stride},
+            {h__meter, h__meter_stride},
+            {w_s__meter, w_s__meter_stride},
+            {R__meter, R__meter_stride},
+            {clutter_type, clutter_type_stride},
+            {A_h__db, A_h__db_stride},
+            {rtn, rtn_stride},
+            first
+        );
+    }
+    P2108_PROBE1(hgtcm_batch__return, ProbeInt(failed));
+    P2108_INSTRUMENT_CODE(first);
+    return failed;
+}
@@ -2,8 +2,9 @@
  * Implements the model from ITU-R P.2108 Section 3.1.
  */
 #include "P2108.h"
-
-#include <cmath>  // for std::atan, std::log10, std::pow, std::sqrt
+#include "P2108Instrumentation.h"
+#include "P2108Kernels.h"
+#include "P2108Probes.h"
 
 namespace ITS {
 namespace ITU {
@@ -38,46 +39,20 @@ ReturnCode HeightGainTerminalCorrectionModel(
     const ClutterType clutter_type,
     double &A_h__db
 ) {
-    const ReturnCode rtn
-        = Section3p1_InputValidation(f__ghz, h__meter, w_s__meter, R__meter);
-    if (rtn != SUCCESS)
-        return rtn;
-
-    if (h__meter >= R__meter) {
-        A_h__db = 0;
-        return SUCCESS;
-    }
-
-    const double h_dif__meter = R__meter - h__meter;  // Equation (2d)
-    const double theta_clut__deg
-        = std::atan(h_dif__meter / w_s__meter) * 180.0 / PI;  // Equation (2e)
-    const double K_h2 = 21.8 + 6.2 * std::log10(f__ghz);      // Equation (2f)
-
-    switch (clutter_type) {
-        case ClutterType::WATER_SEA:
-        case ClutterType::OPEN_RURAL:
-            A_h__db = Equation_2b(K_h2, h__meter, R__meter);
-            break;
-
-        case ClutterType::SUBURBAN:
-        case ClutterType::URBAN:
-        case ClutterType::TREES_FOREST:
-        case ClutterType::DENSE_URBAN:
-            {
-                const double K_nu = 0.342 * std::sqrt(f__ghz);  // Equation (2g)
-                const double nu = K_nu
-                                * std::sqrt(
-                                      h_dif__meter * theta_clut__deg
-                                );  // Equation (2c)
-
-                A_h__db = Equation_2a(nu);
-                break;
-            }
-        default:
-            return ERROR31__CLUTTER_TYPE;
-    }
-
-    return SUCCESS;
+    P2108_INSTRUMENT(P2108_STATS_HGTCM);
+    P2108_PROBE5(
+        hgtcm__entry,
+        ProbeBits(f__ghz),
+        ProbeBits(h__meter),
+        ProbeBits(w_s__meter),
+        ProbeBits(R__meter),
+        ProbeInt(clutter_type)
+    );
+    const ReturnCode rtn = Inline::HeightGainTerminalCorrectionModel(
+        f__ghz, h__meter, w_s__meter, R__meter, clutter_type, A_h__db
+    );
+    P2108_PROBE2(hgtcm__return, ProbeInt(rtn), ProbeBits(A_h__db));
+    return P2108_INSTRUMENT_RETURN(rtn);
 }
 
 /*******************************************************************************
@@ -98,19 +73,9 @@ ReturnCode Section3p1_InputValidation(
     const double w_s__meter,
     const double R__meter
 ) {
-    if (f__ghz < 0.03 || f__ghz > 3)
-        return ERROR31__FREQUENCY;
-
-    if (h__meter <= 0)
-        return ERROR31__ANTENNA_HEIGHT;
-
-    if (w_s__meter <= 0)
-        return ERROR31__STREET_WIDTH;
-
-    if (R__meter <= 0)
-        return ERROR31__CLUTTER_HEIGHT;
-
-    return SUCCESS;
+    return Inline::Section3p1_InputValidation(
+        f__ghz, h__meter, w_s__meter, R__meter
+    );
 }
 
 /*******************************************************************************
@@ -120,16 +85,7 @@ ReturnCode Section3p1_InputValidation(
  * @return        Additional loss (clutter loss), in dB
  ******************************************************************************/
 double Equation_2a(const double nu) {
-    double J_nu__db;
-    if (nu <= -0.78) {
-        J_nu__db = 0;
-    } else {
-        const double term1 = std::sqrt(std::pow(nu - 0.1, 2) + 1);
-        J_nu__db = 6.9 + 20 * std::log10(term1 + nu - 0.1);
-    }
-    const double A_h__db = J_nu__db - 6.03;
-
-    return A_h__db;
+    return Inline::Equation_2a(nu);
 }
 
 /*******************************************************************************
@@ -143,9 +99,7 @@ double Equation_2a(const double nu) {
 double Equation_2b(
     const double K_h2, const double h__meter, const double R__meter
 ) {
-    const double A_h__db = -K_h2 * std::log10(h__meter / R__meter);
-
-    return A_h__db;
+    return Inline::Equation_2b(K_h2, h__meter, R__meter);
 }
 
 }  // namespace P2108
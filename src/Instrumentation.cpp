@@ -0,0 +1,255 @@
+/** @file Instrumentation.cpp
+ * Implements the opt-in call counters of the library entry points.
+ */
+#include "P2108Instrumentation.h"
+
+#include <cstring>  // for std::memset
+
+#ifdef P2108_INSTRUMENTATION
+    #include <atomic>   // for std::atomic, std::memory_order_relaxed
+    #include <cstddef>  // for std::size_t
+    #include <cstdint>  // for std::uint64_t
+    #include <mutex>    // for std::lock_guard, std::mutex
+    #include <vector>   // for std::vector
+
+namespace ITS {
+namespace ITU {
+namespace PSeries {
+namespace P2108 {
+
+namespace {
+/** A counter which is only written by its owning thread */
+typedef std::atomic<std::uint64_t> Counter;
+
+/** Counters of one function in one thread, on their own cache lines */
+struct alignas(64) FunctionCounters {
+        Counter calls;
+        Counter total__ns;
+        Counter codes[P2108_STATS_MAX_CODES];
+        Counter histogram[P2108_STATS_HIST_BUCKETS];
+};
+
+/** Add to a counter owned by the calling thread, without a locked operation */
+inline void Add(Counter &counter, const std::uint64_t n) {
+    counter.store(
+        counter.load(std::memory_order_relaxed) + n, std::memory_order_relaxed
+    );
+}
+
+/** Add the values of a set of counters to a snapshot */
+void Accumulate(const FunctionCounters &from, P2108FunctionStats &to) {
+    to.calls += from.calls.load(std::memory_order_relaxed);
+    to.total__ns += from.total__ns.load(std::memory_order_relaxed);
+    for (std::size_t i = 0; i < P2108_STATS_MAX_CODES; i++) {
+        to.codes[i] += from.codes[i].load(std::memory_order_relaxed);
+    }
+    for (std::size_t i = 0; i < P2108_STATS_HIST_BUCKETS; i++) {
+        to.histogram[i] += from.histogram[i].load(std::memory_order_relaxed);
+    }
+}
+
+/** Subtract the values of one snapshot from another */
+void Subtract(const P2108FunctionStats &from, P2108FunctionStats &to) {
+    to.calls -= from.calls;
+    to.total__ns -= from.total__ns;
+    for (std::size_t i = 0; i < P2108_STATS_MAX_CODES; i++) {
+        to.codes[i] -= from.codes[i];
+    }
+    for (std::size_t i = 0; i < P2108_STATS_HIST_BUCKETS; i++) {
+        to.histogram[i] -= from.histogram[i];
+    }
+}
+
+struct ThreadCounters;
+
+/*******************************************************************************
+ * Registry of the counters of all live threads.
+ *
+ * Counters of threads which have exited are folded into `retired`. Resetting
+ * stores the current totals in `baseline`, which snapshots subtract, so that
+ * the owning threads never need to synchronize with a reset.
+ ******************************************************************************/
+struct Registry {
+        std::mutex mutex;
+        std::vector<ThreadCounters *> threads;
+        P2108Stats retired;
+        P2108Stats baseline;
+};
+
+/** Get the registry, which is never destroyed so exiting threads can use it */
+Registry &GetRegistry() {
+    static Registry *registry = new Registry();
+    return *registry;
+}
+
+/** Counters of all functions in one thread */
+struct ThreadCounters {
+        FunctionCounters functions[P2108_STATS_N_FUNCTIONS];
+
+        ThreadCounters() {
+            for (FunctionCounters &f : functions) {
+                f.calls.store(0, std::memory_order_relaxed);
+                f.total__ns.store(0, std::memory_order_relaxed);
+                for (Counter &c : f.codes) {
+                    c.store(0, std::memory_order_relaxed);
+                }
+                for (Counter &c : f.histogram) {
+                    c.store(0, std::memory_order_relaxed);
+                }
+            }
+            Registry &registry = GetRegistry();
+            std::lock_guard<std::mutex> lock(registry.mutex);
+            registry.threads.push_back(this);
+        }
+
+        ~ThreadCounters() {
+            Registry &registry = GetRegistry();
+            std::lock_guard<std::mutex> lock(registry.mutex);
+            for (std::size_t i = 0; i < P2108_STATS_N_FUNCTIONS; i++) {
+                Accumulate(functions[i], registry.retired.functions[i]);
+            }
+            for (std::size_t i = 0; i < registry.threads.size(); i++) {
+                if (registry.threads[i] == this) {
+                    registry.threads.erase(registry.threads.begin() + i);
+                    break;
+                }
+            }
+        }
+};
+
+/** Sum the counters of all threads. The registry mutex must be held. */
+void SumAll(Registry &registry, P2108Stats &stats) {
+    stats = registry.retired;
+    for (const ThreadCounters *t : registry.threads) {
+        for (std::size_t i = 0; i < P2108_STATS_N_FUNCTIONS; i++) {
+            Accumulate(t->functions[i], stats.functions[i]);
+        }
+    }
+}
+
+/** Get the histogram bucket of a duration: floor(log2(ns)), clamped */
+std::size_t GetBucket(std::uint64_t ns) {
+    std::size_t bucket = 0;
+    while (ns > 1 && bucket + 1 < P2108_STATS_HIST_BUCKETS) {
+        ns >>= 1;
+        bucket++;
+    }
+    return bucket;
+}
+}  // namespace
+
+/*******************************************************************************
+ * Record a completed call in the counters of the calling thread.
+ *
+ * @param[in] function  Function which was called
+ * @param[in] code      Return code, or -1 if the call did not return normally
+ * @param[in] ns        Duration of the call, in ns
+ ******************************************************************************/
+void RecordCall(
+    const P2108StatsFunction function, const int code, const uint64_t ns
+) {
+    static thread_local ThreadCounters counters;
+    FunctionCounters &f = counters.functions[function];
+    Add(f.calls, 1);
+    Add(f.total__ns, ns);
+    if (code >= 0 && code < P2108_STATS_MAX_CODES) {
+        Add(f.codes[code], 1);
+    }
+    Add(f.histogram[GetBucket(ns)], 1);
+}
+
+}  // namespace P2108
+}  // namespace PSeries
+}  // namespace ITU
+}  // namespace ITS
+#endif
+
+/*******************************************************************************
+ * Take a snapshot of the counters of all instrumented functions.
+ *
+ * Counters are summed over all threads, including threads which have exited,
+ * since the last call to `P2108ResetStats`. Calls in progress on other
+ * threads may or may not be included.
+ *
+ * @param[out] stats  Snapshot of the counters
+ ******************************************************************************/
+void P2108GetStats(P2108Stats *stats) {
+    std::memset(stats, 0, sizeof(*stats));
+#ifdef P2108_INSTRUMENTATION
+    using namespace ITS::ITU::PSeries::P2108;
+    Registry &registry = GetRegistry();
+    std::lock_guard<std::mutex> lock(registry.mutex);
+    SumAll(registry, *stats);
+    for (int i = 0; i < P2108_STATS_N_FUNCTIONS; i++) {
+        Subtract(registry.baseline.functions[i], stats->functions[i]);
+    }
+    stats->flags = P2108_STATS_ENABLED;
+#endif
+}
+
+/*******************************************************************************
+ * Reset the counters of all instrumented functions to zero.
+ ******************************************************************************/
+void P2108ResetStats(void) {
+#ifdef P2108_INSTRUMENTATION
+    using namespace ITS::ITU::PSeries::P2108;
+    Registry &registry = GetRegistry();
+    std::lock_guard<std::mutex> lock(registry.mutex);
+    SumAll(registry, registry.baseline);
+#endif
+}
+
+/*******************************************************************************
+ * Get the name of an instrumented function.
+ *
+ * @param[in] function  A `P2108StatsFunction` value
+ * @return              Name of the function, or an empty string if invalid
+ ******************************************************************************/
+const char *P2108GetStatsFunctionName(int function) {
+    switch (function) {
+        case P2108_STATS_ASM:
+            return "AeronauticalStatisticalModel";
+        case P2108_STATS_TSM:
+            return "TerrestrialStatisticalModel";
+        case P2108_STATS_HGTCM:
+            return "HeightGainTerminalCorrectionModel";
+        case P2108_STATS_ASM_BATCH:
+            return "P2108AeronauticalStatisticalModelBatch";
+        case P2108_STATS_TSM_BATCH:
+            return "P2108TerrestrialStatisticalModelBatch";
+        case P2108_STATS_HGTCM_BATCH:
+            return "P2108HeightGainTerminalCorrectionModelBatch";
+        case P2108_STATS_TSM_COVERAGE:
+            return "P2108TerrestrialCoverage";
+        case P2108_STATS_TSM_COVERAGE_FILE:
+            return "P2108TerrestrialCoverageFile";
+        case P2108_STATS_HGTCM_RASTER:
+            return "P2108HeightGainRaster";
+        case P2108_STATS_HGTCM_RASTER_FILE:
+            return "P2108HeightGainRasterFile";
+        case P2108_STATS_TRACK_SET:
+            return "P2108TrackReplaySetTrack";
+        case P2108_STATS_TRACK_EVALUATE:
+            return "P2108TrackReplayEvaluate";
+        case P2108_STATS_TSM_SAMPLES:
+            return "P2108TerrestrialStatisticalModelSamples";
+        case P2108_STATS_ASM_SAMPLES:
+            return "P2108AeronauticalStatisticalModelSamples";
+        case P2108_STATS_LINK_BATCH:
+            return "P2108LinkClutterCorrectionBatch";
+        case P2108_STATS_HGTCM_JACOBIAN:
+            return "P2108HeightGainTerminalCorrectionModelJacobian";
+        case P2108_STATS_TSM_JACOBIAN:
+            return "P2108TerrestrialStatisticalModelJacobian";
+        case P2108_STATS_ASM_JACOBIAN:
+            return "P2108AeronauticalStatisticalModelJacobian";
+        case P2108_STATS_ASM_SURFACE:
+            return "P2108SurfaceAeronauticalStatisticalModel";
+        case P2108_STATS_TSM_SURFACE:
+            return "P2108SurfaceTerrestrialStatisticalModel";
+        case P2108_STATS_HGTCM_SURFACE:
+            return "P2108SurfaceHeightGainTerminalCorrectionModel";
+        default:
+            return "";
+    }
+}
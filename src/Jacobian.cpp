@@ -0,0 +1,465 @@
+/** @file Jacobian.cpp
+ * Implements batch evaluation of the models with the partial derivatives of
+ * the loss.
+ */
+#include "P2108Jacobian.h"
+
+#include "P2108.h"
+#include "P2108Batch.h"
+#include "P2108Instrumentation.h"
+#include "P2108Kernels.h"
+#include "P2108Probes.h"
+
+#include <algorithm>  // for std::min
+#include <cmath>      // for std::atan, std::fmin, std::log, std::pow, ...
+#include <cstddef>    // for std::size_t
+#include <limits>     // for std::numeric_limits
+#include <vector>     // for std::vector
+
+using namespace ITS::ITU::PSeries::P2108;
+
+namespace {
+/** Natural logarithm of 10 */
+constexpr double LN10 = 2.30258509299404568402;
+
+/*******************************************************************************
+ * Intermediate results of one tile, reused between calls on a thread.
+ ******************************************************************************/
+struct JacobianTile {
+        std::vector<ReturnCode> code; /**< Validation result of each record */
+        std::vector<double> Q_p;      /**< Inverse CCDF of each percentage */
+        std::vector<double> dQ_dp;    /**< Its derivative, per % */
+
+        /** Get the tile of this thread, with room for `n` records */
+        static JacobianTile &Get(const std::size_t n) {
+            static thread_local JacobianTile tile;
+            if (tile.code.size() < n) {
+                tile.code.resize(n);
+                tile.Q_p.resize(n);
+                tile.dQ_dp.resize(n);
+            }
+            return tile;
+        }
+};
+
+/*******************************************************************************
+ * Compute the inverse CCDF of the valid percentages of a tile, and its
+ * derivative with respect to the percentage.
+ *
+ * @param[in, out] tile       Tile, with the validation result of each record
+ * @param[in]      m          Number of records in the tile
+ * @param[in]      p          Percentage of each record of the tile, in %
+ * @param[in]      algorithm  Algorithm of the inverse CCDF
+ ******************************************************************************/
+void InverseCCDFStage(
+    JacobianTile &tile,
+    const std::size_t m,
+    const double *p,
+    const InverseCCDFAlgorithm algorithm
+) {
+    for (std::size_t t = 0; t < m; t++) {
+        tile.Q_p[t] = 0;
+        tile.dQ_dp[t] = 0;
+        if (tile.code[t] == SUCCESS) {
+            const double q = p[t] / 100;
+            tile.Q_p[t] = Inline::InverseComplementaryCumulativeDistribution(
+                q, algorithm
+            );
+            tile.dQ_dp[t] = Inline::
+                InverseComplementaryCumulativeDistributionDerivative(
+                    q, algorithm
+                )
+                / 100;
+        }
+    }
+}
+
+/** Clutter loss of Equation (3) and its derivatives */
+struct Equation3Jacobian {
+        double L__db;     /**< Clutter loss, in dB */
+        double dL_dL_l;   /**< With respect to the location loss */
+        double dL_dL_s;   /**< With respect to the slope loss */
+        double sigma__db; /**< Standard deviation, the negated dL/dQ_p */
+};
+
+/*******************************************************************************
+ * Equation (3) of Section 3.2 and its derivatives with respect to the
+ * location and slope losses, given the losses as powers.
+ *
+ * @param[in] P_l  Location loss power, @f$ 10^{-0.2 L_l} @f$
+ * @param[in] P_s  Slope loss power, @f$ 10^{-0.2 L_s} @f$
+ * @param[in] Q_p  Inverse CCDF of the percentage of locations, p / 100
+ * @return         Clutter loss and its derivatives
+ ******************************************************************************/
+inline Equation3Jacobian Equation_3_Jacobian(
+    const double P_l, const double P_s, const double Q_p
+) {
+    const double sum = P_l + P_s;
+    const double sigma__db = Inline::Equation_3b(P_l, P_s);
+
+    // With dP/dL = -0.2 ln(10) P, the median has dL/dL_l = P_l / sum, and
+    // the variances of Equations (4b) and (5b), 16 and 36, give
+    // dsigma/dL_l = -dsigma/dL_s = 2 ln(10) P_l P_s / (sigma sum^2)
+    const double dsigma = 2 * LN10 * P_l * P_s / (sigma__db * sum * sum);
+    Equation3Jacobian result;
+    result.L__db = Inline::Equation_3a_Median(P_l, P_s) - sigma__db * Q_p;
+    result.dL_dL_l = P_l / sum - dsigma * Q_p;
+    result.dL_dL_s = P_s / sum + dsigma * Q_p;
+    result.sigma__db = sigma__db;
+    return result;
+}
+
+/** Set the outputs of a record which failed validation to NaN */
+inline void SetInvalid(P2108HGTCMJacobian &jacobian) {
+    constexpr double NaN = std::numeric_limits<double>::quiet_NaN();
+    jacobian = {NaN, NaN, NaN, NaN, NaN};
+}
+
+/** Set the outputs of a record which failed validation to NaN */
+inline void SetInvalid(P2108TSMJacobian &jacobian) {
+    constexpr double NaN = std::numeric_limits<double>::quiet_NaN();
+    jacobian = {NaN, NaN, NaN, NaN};
+}
+
+/** Set the outputs of a record which failed validation to NaN */
+inline void SetInvalid(P2108ASMJacobian &jacobian) {
+    constexpr double NaN = std::numeric_limits<double>::quiet_NaN();
+    jacobian = {NaN, NaN, NaN, NaN};
+}
+
+/*******************************************************************************
+ * Evaluate the Height Gain Terminal Correction Model and its derivatives for
+ * one record.
+ ******************************************************************************/
+ReturnCode HGTCMJacobian(
+    const double f__ghz,
+    const double h__meter,
+    const double w_s__meter,
+    const double R__meter,
+    const ClutterType clutter_type,
+    P2108HGTCMJacobian &jacobian
+) {
+    ReturnCode rtn = Inline::Section3p1_InputValidation(
+        f__ghz, h__meter, w_s__meter, R__meter
+    );
+    if (rtn != SUCCESS) {
+        return rtn;
+    }
+    const double K_h2 = Inline::Equation_2f(f__ghz);
+    const double K_nu = Inline::Equation_2g(f__ghz);
+    rtn = Inline::HeightGainTerminalCorrectionModelTerms(
+        K_h2,
+        K_nu,
+        h__meter,
+        w_s__meter,
+        R__meter,
+        clutter_type,
+        jacobian.A_h__db
+    );
+    jacobian.dA_h__df = 0;
+    jacobian.dA_h__dh = 0;
+    jacobian.dA_h__dw_s = 0;
+    jacobian.dA_h__dR = 0;
+    if (rtn != SUCCESS || h__meter >= R__meter) {
+        return rtn;
+    }
+
+    if (clutter_type == ClutterType::WATER_SEA
+        || clutter_type == ClutterType::OPEN_RURAL) {
+        // Equation (2b), with dK_h2/df = 6.2 / (f ln 10)
+        jacobian.dA_h__df
+            = -6.2 / (f__ghz * LN10) * std::log10(h__meter / R__meter);
+        jacobian.dA_h__dh = -K_h2 / (h__meter * LN10);
+        jacobian.dA_h__dR = K_h2 / (R__meter * LN10);
+        return rtn;
+    }
+
+    // Equations (2a), (2c) and (2e), through nu = K_nu sqrt(g), where
+    // g = h_dif theta_clut
+    const double h_dif__meter = R__meter - h__meter;
+    const double theta_clut__deg
+        = std::atan(h_dif__meter / w_s__meter) * 180.0 / PI;
+    const double g = h_dif__meter * theta_clut__deg;
+    const double nu = K_nu * std::sqrt(g);
+    if (nu <= -0.78) {
+        return rtn;
+    }
+    const double dJ_dnu
+        = 20 / (LN10 * std::sqrt(std::pow(nu - 0.1, 2) + 1));
+    const double dnu_dg = K_nu / (2 * std::sqrt(g));
+    const double r2 = w_s__meter * w_s__meter + h_dif__meter * h_dif__meter;
+    const double dtheta_dh_dif = 180.0 / PI * w_s__meter / r2;
+    const double dtheta_dw_s = -180.0 / PI * h_dif__meter / r2;
+    const double dg_dh_dif = theta_clut__deg + h_dif__meter * dtheta_dh_dif;
+    const double dg_dw_s = h_dif__meter * dtheta_dw_s;
+
+    // dK_nu/df = K_nu / (2 f)
+    jacobian.dA_h__df = dJ_dnu * nu / (2 * f__ghz);
+    jacobian.dA_h__dh = -dJ_dnu * dnu_dg * dg_dh_dif;
+    jacobian.dA_h__dR = dJ_dnu * dnu_dg * dg_dh_dif;
+    jacobian.dA_h__dw_s = dJ_dnu * dnu_dg * dg_dw_s;
+    return rtn;
+}
+
+/*******************************************************************************
+ * Evaluate the Terrestrial Statistical Model and its derivatives for one
+ * validated record.
+ ******************************************************************************/
+void TSMJacobian(
+    const double f__ghz,
+    const double d__km,
+    const double Q_p,
+    const double dQ_dp,
+    P2108TSMJacobian &jacobian
+) {
+    // Location loss of Equation (4a), with the term of its derivative
+    const double term1 = std::pow(10, -5 * std::log10(f__ghz) - 12.5);
+    const double dL_l_df
+        = 10 * term1 / (f__ghz * LN10 * (term1 + std::pow(10, -16.5)));
+    const double P_l = std::pow(10, -0.2 * Inline::Equation_4(f__ghz));
+
+    // Slope loss of Equation (5a)
+    const double dL_s_df = 3 / (f__ghz * LN10);
+    const double dL_s_dd = 23.9 / (d__km * LN10);
+
+    const Equation3Jacobian at_2km = Equation_3_Jacobian(
+        P_l, std::pow(10, -0.2 * Inline::Equation_5(f__ghz, 2)), Q_p
+    );
+    const Equation3Jacobian at_d = Equation_3_Jacobian(
+        P_l, std::pow(10, -0.2 * Inline::Equation_5(f__ghz, d__km)), Q_p
+    );
+
+    // Equation (6), using the 2 km branch where the losses are equal
+    const bool use_d = at_d.L__db < at_2km.L__db;
+    const Equation3Jacobian &used = use_d ? at_d : at_2km;
+    jacobian.L_ctt__db = std::fmin(at_2km.L__db, at_d.L__db);
+    jacobian.dL_ctt__df = used.dL_dL_l * dL_l_df + used.dL_dL_s * dL_s_df;
+    jacobian.dL_ctt__dd = use_d ? used.dL_dL_s * dL_s_dd : 0;
+    jacobian.dL_ctt__dp = -used.sigma__db * dQ_dp;
+}
+
+/*******************************************************************************
+ * Evaluate the Aeronautical Statistical Model and its derivatives for one
+ * validated record.
+ ******************************************************************************/
+void ASMJacobian(
+    const double f__ghz,
+    const double theta__deg,
+    const double p,
+    const double Q_p,
+    const double dQ_dp,
+    P2108ASMJacobian &jacobian
+) {
+    constexpr double A_1 = 0.05;
+
+    const double scale = Inline::Equation_7_Scale(f__ghz, p);
+    double cot_term, exponent;
+    Inline::Equation_7_AngleTerms(theta__deg, cot_term, exponent);
+    jacobian.L_ces__db
+        = Inline::Equation_7_Combine(scale, cot_term, exponent, Q_p);
+
+    // L = X^e - 1 - 0.6 Q_p, with X = scale cot_term, so that
+    // dL/dv = X^e (de/dv ln X + e dX/dv / X) - 0.6 dQ_p/dv
+    const double X = scale * cot_term;
+    const double X_e = std::pow(X, exponent);
+
+    // dK_1/df / K_1 = 0.175 / f
+    jacobian.dL_ces__df = exponent * X_e * 0.175 / f__ghz;
+
+    // dscale/dp / scale = -1 / ((100 - p) ln(1 - p / 100))
+    const double dscale_dp
+        = -1 / ((100 - p) * std::log(1 - p / 100.0));
+    jacobian.dL_ces__dp = exponent * X_e * dscale_dp - 0.6 * dQ_dp;
+
+    // d cot(x)/dx = -(1 + cot^2(x)), and de/dtheta = -0.5 / 90
+    const double dpart2_dtheta = -A_1 / 90.0 + PI / 180.0;
+    const double dcot_dtheta = -(1 + cot_term * cot_term) * dpart2_dtheta;
+    jacobian.dL_ces__dtheta
+        = X_e
+        * (-0.5 / 90.0 * std::log(X) + exponent * dcot_dtheta / cot_term);
+}
+}  // namespace
+
+/*******************************************************************************
+ * Evaluate the Height Gain Terminal Correction Model and the partial
+ * derivatives of its loss for a batch of records.
+ *
+ * @param[in]  n             Number of records
+ * @param[in]  f__ghz        Frequency, in GHz
+ * @param[in]  h__meter      Antenna height, in meters
+ * @param[in]  w_s__meter    Street width, in meters
+ * @param[in]  R__meter      Representative clutter height, in meters
+ * @param[in]  clutter_type  Clutter type (`ClutterType` value)
+ * @param[out] jacobian      Loss and its derivatives of each record
+ * @param[out] rtn           Return code of each record (may be `NULL`)
+ * @return                   Number of records which failed validation
+ ******************************************************************************/
+size_t P2108HeightGainTerminalCorrectionModelJacobian(
+    size_t n,
+    const double *f__ghz,
+    const double *h__meter,
+    const double *w_s__meter,
+    const double *R__meter,
+    const int *clutter_type,
+    P2108HGTCMJacobian *jacobian,
+    int *rtn
+) {
+    P2108_INSTRUMENT(P2108_STATS_HGTCM_JACOBIAN);
+    P2108_PROBE1(hgtcm_jacobian__entry, ProbeInt(n));
+    int first = SUCCESS;
+    std::size_t failed = 0;
+    for (std::size_t i = 0; i < n; i++) {
+        const ReturnCode code = HGTCMJacobian(
+            f__ghz[i],
+            h__meter[i],
+            w_s__meter[i],
+            R__meter[i],
+            static_cast<ClutterType>(clutter_type[i]),
+            jacobian[i]
+        );
+        if (code != SUCCESS) {
+            SetInvalid(jacobian[i]);
+            if (failed++ == 0) {
+                first = code;
+            }
+        }
+        if (rtn != nullptr) {
+            rtn[i] = code;
+        }
+    }
+    P2108_PROBE1(hgtcm_jacobian__return, ProbeInt(failed));
+    P2108_INSTRUMENT_CODE(first);
+    return failed;
+}
+
+/*******************************************************************************
+ * Evaluate the Terrestrial Statistical Model and the partial derivatives of
+ * its loss for a batch of records.
+ *
+ * @param[in]  n          Number of records
+ * @param[in]  f__ghz     Frequency, in GHz
+ * @param[in]  d__km      Path distance, in km
+ * @param[in]  p          Percentage of locations, in %
+ * @param[in]  algorithm  Inverse CCDF (`InverseCCDFAlgorithm` value)
+ * @param[out] jacobian   Loss and its derivatives of each record
+ * @param[out] rtn        Return code of each record (may be `NULL`)
+ * @return                Number of records which failed validation
+ ******************************************************************************/
+size_t P2108TerrestrialStatisticalModelJacobian(
+    size_t n,
+    const double *f__ghz,
+    const double *d__km,
+    const double *p,
+    int algorithm,
+    P2108TSMJacobian *jacobian,
+    int *rtn
+) {
+    P2108_INSTRUMENT(P2108_STATS_TSM_JACOBIAN);
+    P2108_PROBE1(tsm_jacobian__entry, ProbeInt(n));
+    const std::size_t tile_n = std::min(n, P2108GetBatchTileSize());
+    const InverseCCDFAlgorithm iccd_algorithm
+        = Inline::ToInverseCCDFAlgorithm(algorithm);
+    JacobianTile &tile = JacobianTile::Get(tile_n);
+    int first = SUCCESS;
+    std::size_t failed = 0;
+    for (std::size_t start = 0; start < n; start += tile_n) {
+        const std::size_t m = std::min(tile_n, n - start);
+
+        // Validate the inputs
+        for (std::size_t t = 0, i = start; t < m; t++, i++) {
+            tile.code[t]
+                = Inline::Section3p2_InputValidation(f__ghz[i], d__km[i], p[i]);
+        }
+
+        InverseCCDFStage(tile, m, p + start, iccd_algorithm);
+
+        // Clutter loss and its derivatives
+        for (std::size_t t = 0, i = start; t < m; t++, i++) {
+            if (tile.code[t] == SUCCESS) {
+                TSMJacobian(
+                    f__ghz[i], d__km[i], tile.Q_p[t], tile.dQ_dp[t], jacobian[i]
+                );
+            } else {
+                SetInvalid(jacobian[i]);
+                if (failed++ == 0) {
+                    first = tile.code[t];
+                }
+            }
+            if (rtn != nullptr) {
+                rtn[i] = tile.code[t];
+            }
+        }
+    }
+    P2108_PROBE1(tsm_jacobian__return, ProbeInt(failed));
+    P2108_INSTRUMENT_CODE(first);
+    return failed;
+}
+
+/*******************************************************************************
+ * Evaluate the Aeronautical Statistical Model and the partial derivatives of
+ * its loss for a batch of records.
+ *
+ * @param[in]  n           Number of records
+ * @param[in]  f__ghz      Frequency, in GHz
+ * @param[in]  theta__deg  Elevation angle, in degrees
+ * @param[in]  p           Percentage of locations, in %
+ * @param[in]  algorithm   Inverse CCDF (`InverseCCDFAlgorithm` value)
+ * @param[out] jacobian    Loss and its derivatives of each record
+ * @param[out] rtn         Return code of each record (may be `NULL`)
+ * @return                 Number of records which failed validation
+ ******************************************************************************/
+size_t P2108AeronauticalStatisticalModelJacobian(
+    size_t n,
+    const double *f__ghz,
+    const double *theta__deg,
+    const double *p,
+    int algorithm,
+    P2108ASMJacobian *jacobian,
+    int *rtn
+) {
+    P2108_INSTRUMENT(P2108_STATS_ASM_JACOBIAN);
+    P2108_PROBE1(asm_jacobian__entry, ProbeInt(n));
+    const std::size_t tile_n = std::min(n, P2108GetBatchTileSize());
+    const InverseCCDFAlgorithm iccd_algorithm
+        = Inline::ToInverseCCDFAlgorithm(algorithm);
+    JacobianTile &tile = JacobianTile::Get(tile_n);
+    int first = SUCCESS;
+    std::size_t failed = 0;
+    for (std::size_t start = 0; start < n; start += tile_n) {
+        const std::size_t m = std::min(tile_n, n - start);
+
+        // Validate the inputs
+        for (std::size_t t = 0, i = start; t < m; t++, i++) {
+            tile.code[t] = Inline::Section3p3_InputValidation(
+                f__ghz[i], theta__deg[i], p[i]
+            );
+        }
+
+        InverseCCDFStage(tile, m, p + start, iccd_algorithm);
+
+        // Clutter loss and its derivatives
+        for (std::size_t t = 0, i = start; t < m; t++, i++) {
+            if (tile.code[t] == SUCCESS) {
+                ASMJacobian(
+                    f__ghz[i],
+                    theta__deg[i],
+                    p[i],
+                    tile.Q_p[t],
+                    tile.dQ_dp[t],
+                    jacobian[i]
+                );
+            } else {
+                SetInvalid(jacobian[i]);
+                if (failed++ == 0) {
+                    first = tile.code[t];
+                }
+            }
+            if (rtn != nullptr) {
+                rtn[i] = tile.code[t];
+            }
+        }
+    }
+    P2108_PROBE1(asm_jacobian__return, ProbeInt(failed));
+    P2108_INSTRUMENT_CODE(first);
+    return failed;
+}
@@ -0,0 +1,208 @@
+/** @file Link.cpp
+ * Implements the end-to-end clutter correction of terrestrial links.
+ */
+#include "P2108Link.h"
+
+#include "P2108.h"
+#include "P2108Batch.h"
+#include "P2108Instrumentation.h"
+#include "P2108Kernels.h"
+#include "P2108Probes.h"
+
+#include <algorithm>  // for std::min
+#include <cmath>      // for std::fmin, std::pow
+#include <cstddef>    // for std::size_t
+#include <limits>     // for std::numeric_limits
+#include <vector>     // for std::vector
+
+using namespace ITS::ITU::PSeries::P2108;
+
+namespace {
+/*******************************************************************************
+ * Intermediate results of one tile of links, reused between calls on a
+ * thread.
+ ******************************************************************************/
+struct LinkTile {
+        std::vector<ReturnCode> code; /**< Validation result of each link */
+        std::vector<char> in_clutter; /**< Whether both terminals are */
+        std::vector<double> K_h2;     /**< Equation (2f) of each link */
+        std::vector<double> K_nu;     /**< Equation (2g) of each link */
+        std::vector<double> Q_p;      /**< Inverse CCDF of each percentage */
+
+        /** Get the tile of this thread, with room for `n` links */
+        static LinkTile &Get(const std::size_t n) {
+            static thread_local LinkTile tile;
+            if (tile.code.size() < n) {
+                tile.code.resize(n);
+                tile.in_clutter.resize(n);
+                tile.K_h2.resize(n);
+                tile.K_nu.resize(n);
+                tile.Q_p.resize(n);
+            }
+            return tile;
+        }
+};
+
+/** Validate the inputs of one link */
+ReturnCode ValidateLink(const P2108Link &link, const bool in_clutter) {
+    ReturnCode code = Inline::Section3p1_InputValidation(
+        link.f__ghz, link.tx.h__meter, link.tx.w_s__meter, link.tx.R__meter
+    );
+    if (code == SUCCESS) {
+        code = Inline::Section3p1_InputValidation(
+            link.f__ghz, link.rx.h__meter, link.rx.w_s__meter, link.rx.R__meter
+        );
+    }
+    if (code == SUCCESS && in_clutter) {
+        code = Inline::Section3p2_InputValidation(
+            link.f__ghz, link.d__km, link.p
+        );
+    }
+    return code;
+}
+
+/*******************************************************************************
+ * Evaluate the Terrestrial Statistical Model for one link, computing the
+ * location loss once for the losses at 2 km and at the path distance.
+ *
+ * @param[in] f__ghz  Frequency, in GHz
+ * @param[in] d__km   Path distance, in km
+ * @param[in] Q_p     Inverse CCDF of the percentage of locations, p / 100
+ * @return            Clutter loss, in dB
+ ******************************************************************************/
+inline double StatisticalLoss(
+    const double f__ghz, const double d__km, const double Q_p
+) {
+    const double P_l = std::pow(10, -0.2 * Inline::Equation_4(f__ghz));
+    const double P_s_2km = std::pow(10, -0.2 * Inline::Equation_5(f__ghz, 2));
+    const double P_s_d
+        = std::pow(10, -0.2 * Inline::Equation_5(f__ghz, d__km));
+    return std::fmin(
+        Inline::Equation_3_Powers(P_l, P_s_2km, Q_p),
+        Inline::Equation_3_Powers(P_l, P_s_d, Q_p)
+    );
+}
+
+/** Evaluate the height gain correction at one terminal of a link */
+inline ReturnCode TerminalCorrection(
+    const double K_h2,
+    const double K_nu,
+    const P2108LinkTerminal &terminal,
+    double &A_h__db
+) {
+    return Inline::HeightGainTerminalCorrectionModelTerms(
+        K_h2,
+        K_nu,
+        terminal.h__meter,
+        terminal.w_s__meter,
+        terminal.R__meter,
+        static_cast<ClutterType>(terminal.clutter_type),
+        A_h__db
+    );
+}
+}  // namespace
+
+/*******************************************************************************
+ * Evaluate the clutter correction of a batch of links.
+ *
+ * Links which fail validation get NaN components, and the return code of
+ * the first model which rejected them.
+ *
+ * @param[in]  n            Number of links
+ * @param[in]  links        Inputs of each link
+ * @param[in]  algorithm    Inverse CCDF (`InverseCCDFAlgorithm` value)
+ * @param[out] corrections  Clutter correction of each link
+ * @param[out] rtn          Return code of each link (may be `NULL`)
+ * @return                  Number of links which failed validation
+ ******************************************************************************/
+size_t P2108LinkClutterCorrectionBatch(
+    size_t n,
+    const P2108Link *links,
+    int algorithm,
+    P2108LinkCorrection *corrections,
+    int *rtn
+) {
+    P2108_INSTRUMENT(P2108_STATS_LINK_BATCH);
+    P2108_PROBE1(link_batch__entry, ProbeInt(n));
+    const std::size_t tile_n = std::min(n, P2108GetBatchTileSize());
+    const InverseCCDFAlgorithm iccd_algorithm
+        = Inline::ToInverseCCDFAlgorithm(algorithm);
+    LinkTile &tile = LinkTile::Get(tile_n);
+    int first = SUCCESS;
+    std::size_t failed = 0;
+    for (std::size_t start = 0; start < n; start += tile_n) {
+        const std::size_t m = std::min(tile_n, n - start);
+
+        // Validate the inputs, and compute the terms shared by the terminals
+        for (std::size_t t = 0, i = start; t < m; t++, i++) {
+            const P2108Link &link = links[i];
+            tile.in_clutter[t] = link.tx.h__meter < link.tx.R__meter
+                              && link.rx.h__meter < link.rx.R__meter;
+            tile.code[t] = ValidateLink(link, tile.in_clutter[t] != 0);
+            tile.K_h2[t] = Inline::Equation_2f(link.f__ghz);
+            tile.K_nu[t] = Inline::Equation_2g(link.f__ghz);
+        }
+
+        // Height gain correction at each terminal
+        for (std::size_t t = 0, i = start; t < m; t++, i++) {
+            if (tile.code[t] != SUCCESS) {
+                continue;
+            }
+            P2108LinkCorrection &correction = corrections[i];
+            tile.code[t] = TerminalCorrection(
+                tile.K_h2[t], tile.K_nu[t], links[i].tx, correction.A_h_tx__db
+            );
+            if (tile.code[t] == SUCCESS) {
+                tile.code[t] = TerminalCorrection(
+                    tile.K_h2[t],
+                    tile.K_nu[t],
+                    links[i].rx,
+                    correction.A_h_rx__db
+                );
+            }
+        }
+
+        // Inverse CCDF of the percentages of links in clutter
+        for (std::size_t t = 0, i = start; t < m; t++, i++) {
+            tile.Q_p[t] = 0;
+            if (tile.code[t] == SUCCESS && tile.in_clutter[t]) {
+                tile.Q_p[t]
+                    = Inline::InverseComplementaryCumulativeDistribution(
+                        links[i].p / 100, iccd_algorithm
+                    );
+            }
+        }
+
+        // Terrestrial statistical clutter loss, and the total
+        for (std::size_t t = 0, i = start; t < m; t++, i++) {
+            const P2108Link &link = links[i];
+            P2108LinkCorrection &correction = corrections[i];
+            if (tile.code[t] == SUCCESS) {
+                correction.L_ctt__db = 0;
+                if (tile.in_clutter[t]) {
+                    correction.L_ctt__db = StatisticalLoss(
+                        link.f__ghz, link.d__km, tile.Q_p[t]
+                    );
+                }
+                correction.total__db = correction.A_h_tx__db
+                                     + correction.A_h_rx__db
+                                     + correction.L_ctt__db;
+            } else {
+                const double nan = std::numeric_limits<double>::quiet_NaN();
+                correction.A_h_tx__db = nan;
+                correction.A_h_rx__db = nan;
+                correction.L_ctt__db = nan;
+                correction.total__db = nan;
+                if (failed++ == 0) {
+                    first = tile.code[t];
+                }
+            }
+            if (rtn != nullptr) {
+                rtn[i] = tile.code[t];
+            }
+        }
+    }
+    P2108_PROBE1(link_batch__return, ProbeInt(failed));
+    P2108_INSTRUMENT_CODE(first);
+    return failed;
+}
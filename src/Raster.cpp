@@ -0,0 +1,834 @@
+/** @file Raster.cpp
+ * Implements the raster engines, which evaluate a model over a grid.
+ */
+#include "P2108Raster.h"
+
+#include "P2108.h"
+#include "P2108Batch.h"
+#include "P2108Instrumentation.h"
+#include "P2108Kernels.h"
+#include "P2108Probes.h"
+
+#include <algorithm>  // for std::max, std::min
+#include <atomic>     // for std::atomic
+#include <cmath>      // for std::fmin, std::isfinite, std::log10, std::pow, ...
+#include <cstddef>    // for std::size_t
+#include <cstdint>    // for std::uint16_t, std::uint64_t, std::uint8_t
+#include <cstring>    // for std::memcpy
+#include <fstream>    // for std::ofstream
+#include <future>     // for std::async, std::future
+#include <limits>     // for std::numeric_limits
+#include <sstream>    // for std::ostringstream
+#include <string>     // for std::string
+#include <thread>     // for std::thread
+#include <vector>     // for std::vector
+
+#ifndef _WIN32
+    #include <fcntl.h>     // for open, O_RDONLY
+    #include <sys/mman.h>  // for madvise, mmap, munmap
+    #include <sys/stat.h>  // for fstat
+    #include <unistd.h>    // for close, sysconf
+#endif
+
+using namespace ITS::ITU::PSeries::P2108;
+
+namespace {
+/** Number of consecutive rows claimed by a thread at a time */
+constexpr std::size_t ROWS_PER_TILE = 4;
+
+/** Approximate number of cells held in memory by each buffer of a file */
+constexpr std::size_t CELLS_PER_BLOCK = std::size_t(1) << 22;
+
+/** Check that a grid is non-empty with finite coordinates */
+bool IsValidGrid(const P2108RasterGeometry *grid) {
+    return grid != nullptr && grid->n_rows > 0 && grid->n_cols > 0
+        && std::isfinite(grid->x0__km) && std::isfinite(grid->y0__km)
+        && std::isfinite(grid->dx__km) && std::isfinite(grid->dy__km);
+}
+
+/** Get the number of cells of a grid, or 0 if there is no grid */
+inline std::uint64_t CellCount(const P2108RasterGeometry *grid) {
+    return grid != nullptr ? std::uint64_t(grid->n_rows) * grid->n_cols : 0;
+}
+
+/** Get the number of threads to use, given the requested number */
+std::size_t ResolveThreads(const std::size_t n_threads) {
+    if (n_threads > 0) {
+        return n_threads;
+    }
+    return std::max<std::size_t>(1, std::thread::hardware_concurrency());
+}
+
+/*******************************************************************************
+ * Evaluate rows of a raster in parallel.
+ *
+ * Threads claim tiles of `ROWS_PER_TILE` consecutive rows until all rows
+ * have been evaluated. The calling thread is one of the `n_threads` threads.
+ *
+ * @param[in]  engine     Evaluates one row: `engine.EvaluateRow(row, out)`
+ * @param[in]  first_row  First row to evaluate
+ * @param[in]  n_rows     Number of rows to evaluate
+ * @param[in]  n_cols     Number of cells in each row
+ * @param[out] out        Raster of the evaluated rows, starting at first_row
+ * @param[in]  n_threads  Number of threads
+ ******************************************************************************/
+template<typename Engine>
+void EvaluateRows(
+    const Engine &engine,
+    const std::size_t first_row,
+    const std::size_t n_rows,
+    const std::size_t n_cols,
+    float *out,
+    const std::size_t n_threads
+) {
+    std::atomic<std::size_t> next(0);
+    const auto work = [&]() {
+        std::size_t start;
+        while ((start = next.fetch_add(ROWS_PER_TILE)) < n_rows) {
+            const std::size_t end = std::min(start + ROWS_PER_TILE, n_rows);
+            for (std::size_t r = start; r < end; r++) {
+                engine.EvaluateRow(first_row + r, out + r * n_cols);
+            }
+        }
+    };
+    const std::size_t n_tiles = (n_rows + ROWS_PER_TILE - 1) / ROWS_PER_TILE;
+    std::vector<std::thread> threads;
+    for (std::size_t t = 1; t < std::min(n_threads, n_tiles); t++) {
+        threads.emplace_back(work);
+    }
+    work();
+    for (std::thread &thread : threads) {
+        thread.join();
+    }
+}
+
+/*******************************************************************************
+ * Write the ENVI sidecar header describing a raw `float` raster.
+ *
+ * A map location is included when the grid is north-up (`dx__km > 0` and
+ * `dy__km < 0`), which is the only orientation ENVI describes without a
+ * rotation. The geometry is always recorded in the description.
+ *
+ * @param[in] path         Path of the raw raster; `.hdr` is appended
+ * @param[in] grid         Geometry of the raster
+ * @param[in] description  Description of the raster contents
+ * @return                 True if the header was written
+ ******************************************************************************/
+bool WriteRasterHeader(
+    const std::string &path,
+    const P2108RasterGeometry &grid,
+    const std::string &description
+) {
+    const std::uint16_t one = 1;
+    unsigned char low_byte;
+    std::memcpy(&low_byte, &one, 1);
+    const int byte_order = (low_byte == 1) ? 0 : 1;  // 0: little endian
+
+    std::ofstream hdr(path + ".hdr");
+    hdr.precision(std::numeric_limits<double>::max_digits10);
+    hdr << "ENVI\n"
+        << "description = {" << description << " Cell (row, col) center at"
+        << " x = " << grid.x0__km << " + col * " << grid.dx__km << " km,"
+        << " y = " << grid.y0__km << " + row * " << grid.dy__km << " km.}\n"
+        << "samples = " << grid.n_cols << "\n"
+        << "lines = " << grid.n_rows << "\n"
+        << "bands = 1\n"
+        << "header offset = 0\n"
+        << "file type = ENVI Standard\n"
+        << "data type = 4\n"
+        << "interleave = bsq\n"
+        << "byte order = " << byte_order << "\n"
+        << "data ignore value = NaN\n";
+    if (grid.dx__km > 0 && grid.dy__km < 0) {
+        // Tie the upper-left corner of the first cell, in meters
+        hdr << "map info = {Arbitrary, 1, 1, "
+            << (grid.x0__km - grid.dx__km / 2) * 1000 << ", "
+            << (grid.y0__km - grid.dy__km / 2) * 1000 << ", "
+            << grid.dx__km * 1000 << ", " << -grid.dy__km * 1000
+            << ", units=Meters}\n";
+    }
+    hdr.close();
+    return !hdr.fail();
+}
+
+/*******************************************************************************
+ * Stream a raster to a raw binary file, with its sidecar header.
+ *
+ * Rows are evaluated in blocks of about `CELLS_PER_BLOCK` cells. Each block
+ * is written on a background thread while the next block is evaluated, and
+ * the engine may then release its inputs for the rows of the block, so
+ * memory use is bounded for any raster size.
+ *
+ * @param[in] engine       Evaluates one row: `engine.EvaluateRow(row, out)`,
+ *                         and releases inputs: `engine.ReleaseRows(row, n)`
+ * @param[in] grid         Geometry of the raster
+ * @param[in] path         Path of the raw raster
+ * @param[in] description  Description of the raster contents
+ * @param[in] n_threads    Number of threads evaluating rows
+ * @return                 `P2108_RASTER_SUCCESS` or `P2108_RASTER_ERROR_IO`
+ ******************************************************************************/
+template<typename Engine>
+int WriteRasterFile(
+    const Engine &engine,
+    const P2108RasterGeometry &grid,
+    const char *path,
+    const std::string &description,
+    const std::size_t n_threads
+) {
+    std::ofstream file(path, std::ios::binary | std::ios::trunc);
+    if (!file || !WriteRasterHeader(path, grid, description)) {
+        return P2108_RASTER_ERROR_IO;
+    }
+
+    const std::size_t n_cols = grid.n_cols;
+    const std::size_t n_rows = grid.n_rows;
+    const std::size_t block_rows
+        = std::min(n_rows, std::max<std::size_t>(1, CELLS_PER_BLOCK / n_cols));
+    std::vector<float> buffers[2];
+    buffers[0].resize(block_rows * n_cols);
+    buffers[1].resize(block_rows * n_cols);
+
+    std::future<bool> pending;
+    std::size_t b = 0;
+    for (std::size_t row = 0; row < n_rows; row += block_rows, b ^= 1) {
+        const std::size_t rows = std::min(block_rows, n_rows - row);
+        EvaluateRows(engine, row, rows, n_cols, buffers[b].data(), n_threads);
+        engine.ReleaseRows(row, rows);
+        if (pending.valid() && !pending.get()) {
+            return P2108_RASTER_ERROR_IO;
+        }
+        const float *data = buffers[b].data();
+        const std::streamsize bytes = rows * n_cols * sizeof(float);
+        pending = std::async(std::launch::async, [&file, data, bytes]() {
+            file.write(reinterpret_cast<const char *>(data), bytes);
+            return !file.fail();
+        });
+    }
+    if (pending.valid() && !pending.get()) {
+        return P2108_RASTER_ERROR_IO;
+    }
+    file.close();
+    return file.fail() ? P2108_RASTER_ERROR_IO : P2108_RASTER_SUCCESS;
+}
+
+/*******************************************************************************
+ * @class TSMCoverage
+ * Evaluates the Terrestrial Statistical Model from one transmitter to the
+ * cells of a grid.
+ *
+ * Every term which does not depend on the distance (the location loss, the
+ * inverse CCDF, the frequency term of the slope loss, and the loss at 2 km)
+ * is computed once. The squared x offset of each column is computed once,
+ * so the distance to each cell of a row costs one addition and one square
+ * root. Results are identical to the Terrestrial Statistical Model with the
+ * same inverse CCDF algorithm at the same distance.
+ ******************************************************************************/
+class TSMCoverage {
+    public:
+        /** Precompute the terms shared by every cell */
+        TSMCoverage(
+            const P2108RasterGeometry &grid,
+            const double tx_x__km,
+            const double tx_y__km,
+            const double f__ghz,
+            const double p,
+            const InverseCCDFAlgorithm algorithm
+        ):
+            grid_(grid), tx_y__km_(tx_y__km), x2__km2_(grid.n_cols) {
+            for (std::size_t c = 0; c < x2__km2_.size(); c++) {
+                const double x__km = grid.x0__km + c * grid.dx__km - tx_x__km;
+                x2__km2_[c] = x__km * x__km;
+            }
+            const double L_l__db = Inline::Equation_4(f__ghz);
+            P_l_ = std::pow(10, -0.2 * L_l__db);
+            Q_p_ = Inline::InverseComplementaryCumulativeDistribution(
+                p / 100, algorithm
+            );
+            L_s_f__db_ = 3 * std::log10(f__ghz);
+            L_ctt_2km__db_ = Inline::Equation_3(
+                L_l__db, Inline::Equation_5(f__ghz, 2), Q_p_
+            );
+        }
+
+        /** Evaluate the cells of one row */
+        void EvaluateRow(const std::size_t row, float *L_ctt__db) const {
+            const double y__km = grid_.y0__km + row * grid_.dy__km - tx_y__km_;
+            const double y2__km2 = y__km * y__km;
+            for (std::size_t c = 0; c < x2__km2_.size(); c++) {
+                const double d__km = std::sqrt(x2__km2_[c] + y2__km2);
+                if (d__km < 0.25) {  // Section 3.2 distance validation
+                    L_ctt__db[c] = std::numeric_limits<float>::quiet_NaN();
+                    continue;
+                }
+                // Equation (5a), with the frequency term precomputed
+                const double L_s__db
+                    = 32.98 + 23.9 * std::log10(d__km) + L_s_f__db_;
+                const double L_ctt_d__db = Inline::Equation_3_Powers(
+                    P_l_, std::pow(10, -0.2 * L_s__db), Q_p_
+                );
+                L_ctt__db[c] = static_cast<float>(
+                    std::fmin(L_ctt_2km__db_, L_ctt_d__db)
+                );
+            }
+        }
+
+        /** Release inputs of rows; the engine has no input rasters */
+        void ReleaseRows(const std::size_t, const std::size_t) const {}
+    private:
+        P2108RasterGeometry grid_;      /**< Geometry of the grid */
+        double tx_y__km_;               /**< Transmitter y coordinate, in km */
+        std::vector<double> x2__km2_;   /**< Squared x offset of each column */
+        double P_l_;                    /**< Location loss power */
+        double Q_p_;                    /**< Inverse CCDF of p / 100 */
+        double L_s_f__db_;              /**< Frequency term of Equation 5a */
+        double L_ctt_2km__db_;          /**< Clutter loss at 2 km, in dB */
+};
+
+/*******************************************************************************
+ * @class MappedFile
+ * A read-only memory mapping of a whole input raster file.
+ *
+ * Pages are read on demand, and read ahead sequentially. Ranges which are no
+ * longer needed may be released, which drops their pages from memory; they
+ * would be read again from the file if accessed later.
+ ******************************************************************************/
+class MappedFile {
+    public:
+        MappedFile() = default;
+        MappedFile(const MappedFile &) = delete;
+        MappedFile &operator=(const MappedFile &) = delete;
+
+        /** Unmap the file */
+        ~MappedFile() {
+#ifndef _WIN32
+            if (data_ != nullptr) {
+                munmap(data_, size_);
+            }
+#endif
+        }
+
+        /***********************************************************************
+         * Map a file, which must be exactly the expected size.
+         *
+         * @param[in] path  Path of the file
+         * @param[in] size  Expected size of the file, in bytes
+         * @return          `P2108RasterStatus` code
+         **********************************************************************/
+        int Open(const char *path, const std::size_t size) {
+#ifndef _WIN32
+            const int fd = open(path, O_RDONLY);
+            if (fd < 0) {
+                return P2108_RASTER_ERROR_IO;
+            }
+            struct stat st;
+            if (fstat(fd, &st) != 0) {
+                close(fd);
+                return P2108_RASTER_ERROR_IO;
+            }
+            if (static_cast<std::size_t>(st.st_size) != size) {
+                close(fd);
+                return P2108_RASTER_ERROR_SIZE;
+            }
+            void *data = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+            close(fd);
+            if (data == MAP_FAILED) {
+                return P2108_RASTER_ERROR_IO;
+            }
+            madvise(data, size, MADV_SEQUENTIAL);
+            data_ = data;
+            size_ = size;
+            page_ = static_cast<std::size_t>(sysconf(_SC_PAGESIZE));
+            return P2108_RASTER_SUCCESS;
+#else
+            (void)path;
+            (void)size;
+            return P2108_RASTER_ERROR_UNSUPPORTED;
+#endif
+        }
+
+        /** Get the start of the mapped file */
+        const void *Data() const {
+            return data_;
+        }
+
+        /***********************************************************************
+         * Release the whole pages within a range of the file.
+         *
+         * @param[in] offset  Start of the range, in bytes
+         * @param[in] length  Length of the range, in bytes
+         **********************************************************************/
+        void Release(const std::size_t offset, const std::size_t length) const {
+#ifndef _WIN32
+            const std::size_t start = (offset + page_ - 1) / page_ * page_;
+            const std::size_t end = std::min(offset + length, size_);
+            if (data_ != nullptr && start < end) {
+                madvise(
+                    static_cast<char *>(data_) + start,
+                    (end - start) / page_ * page_,
+                    MADV_DONTNEED
+                );
+            }
+#else
+            (void)offset;
+            (void)length;
+#endif
+        }
+    private:
+        void *data_ = nullptr;  /**< Start of the mapping */
+        std::size_t size_ = 0;  /**< Size of the mapping, in bytes */
+        std::size_t page_ = 1;  /**< Size of a page, in bytes */
+};
+
+/** Get the default representative clutter height of a clutter type */
+double DefaultRepresentativeClutterHeight(const int clutter_type) {
+    switch (clutter_type) {
+        case ClutterType::WATER_SEA:
+            return RepresentativeClutterHeight::R__WATER_SEA;
+        case ClutterType::OPEN_RURAL:
+            return RepresentativeClutterHeight::R__OPEN_RURAL;
+        case ClutterType::SUBURBAN:
+            return RepresentativeClutterHeight::R__SUBURBAN;
+        case ClutterType::URBAN:
+            return RepresentativeClutterHeight::R__URBAN;
+        case ClutterType::TREES_FOREST:
+            return RepresentativeClutterHeight::R__TREES_FOREST;
+        case ClutterType::DENSE_URBAN:
+            return RepresentativeClutterHeight::R__DENSE_URBAN;
+        default:
+            return 0;  // Fails validation, so the cell is NaN
+    }
+}
+
+/*******************************************************************************
+ * @class HGTCMRaster
+ * Evaluates the Height Gain Terminal Correction Model at the cells of a
+ * land-cover raster, for one antenna height, street width and frequency.
+ *
+ * The clutter type and default representative clutter height of every
+ * land-cover code are looked up once. Each row is gathered into contiguous
+ * arrays and evaluated by the batch interface, with the scalar inputs
+ * broadcast. Results are identical to `HeightGainTerminalCorrectionModel`.
+ ******************************************************************************/
+class HGTCMRaster {
+    public:
+        /** Build the land-cover lookup tables */
+        HGTCMRaster(
+            const P2108RasterGeometry &grid,
+            const std::uint8_t *land_cover,
+            const int *clutter_types,
+            const float *R__meter,
+            const double f__ghz,
+            const double h__meter,
+            const double w_s__meter
+        ):
+            n_cols_(grid.n_cols),
+            land_cover_(land_cover),
+            R__meter_(R__meter),
+            f__ghz_(f__ghz),
+            h__meter_(h__meter),
+            w_s__meter_(w_s__meter) {
+            for (std::size_t code = 0; code < P2108_LAND_COVER_CODES; code++) {
+                clutter_type_[code] = clutter_types[code];
+                R_default__meter_[code]
+                    = DefaultRepresentativeClutterHeight(clutter_types[code]);
+            }
+        }
+
+        /** Release input pages as rows are completed */
+        void SetMappedFiles(const MappedFile *land_cover, const MappedFile *R) {
+            land_cover_file_ = land_cover;
+            R_file_ = R;
+        }
+
+        /** Evaluate the cells of one row */
+        void EvaluateRow(const std::size_t row, float *A_h__db) const {
+            thread_local std::vector<int> clutter_type;
+            thread_local std::vector<double> R__meter, A_h_row__db;
+            clutter_type.resize(n_cols_);
+            R__meter.resize(n_cols_);
+            A_h_row__db.resize(n_cols_);
+
+            const std::uint8_t *codes = land_cover_ + row * n_cols_;
+            for (std::size_t c = 0; c < n_cols_; c++) {
+                clutter_type[c] = clutter_type_[codes[c]];
+                R__meter[c] = R_default__meter_[codes[c]];
+            }
+            if (R__meter_ != nullptr) {
+                // Heights override the defaults, except where missing. Cells
+                // of unmapped codes keep an invalid height, so that they fail
+                // validation even if the antenna is above the clutter.
+                const float *heights = R__meter_ + row * n_cols_;
+                for (std::size_t c = 0; c < n_cols_; c++) {
+                    if (std::isfinite(heights[c]) && R__meter[c] > 0) {
+                        R__meter[c] = heights[c];
+                    }
+                }
+            }
+            P2108HeightGainTerminalCorrectionModelBatch(
+                n_cols_,
+                &f__ghz_,
+                0,
+                &h__meter_,
+                0,
+                &w_s__meter_,
+                0,
+                R__meter.data(),
+                sizeof(double),
+                clutter_type.data(),
+                sizeof(int),
+                A_h_row__db.data(),
+                sizeof(double),
+                nullptr,
+                0
+            );
+            for (std::size_t c = 0; c < n_cols_; c++) {
+                A_h__db[c] = static_cast<float>(A_h_row__db[c]);
+            }
+        }
+
+        /** Release the mapped input pages of completed rows */
+        void ReleaseRows(const std::size_t row, const std::size_t n) const {
+            if (land_cover_file_ != nullptr) {
+                land_cover_file_->Release(
+                    row * n_cols_ * sizeof(std::uint8_t),
+                    n * n_cols_ * sizeof(std::uint8_t)
+                );
+            }
+            if (R_file_ != nullptr) {
+                R_file_->Release(
+                    row * n_cols_ * sizeof(float), n * n_cols_ * sizeof(float)
+                );
+            }
+        }
+    private:
+        std::size_t n_cols_;             /**< Number of cells in each row */
+        const std::uint8_t *land_cover_; /**< Land-cover code raster */
+        const float *R__meter_;          /**< Clutter height raster, or null */
+        double f__ghz_;                  /**< Frequency, in GHz */
+        double h__meter_;                /**< Antenna height, in meters */
+        double w_s__meter_;              /**< Street width, in meters */
+        /** Clutter type of each land-cover code */
+        int clutter_type_[P2108_LAND_COVER_CODES];
+        /** Default representative clutter height of each land-cover code */
+        double R_default__meter_[P2108_LAND_COVER_CODES];
+        const MappedFile *land_cover_file_ = nullptr; /**< Mapped codes */
+        const MappedFile *R_file_ = nullptr; /**< Mapped heights, or null */
+};
+
+/** Validate the arguments of the height gain raster functions */
+int ValidateHeightGainRaster(
+    const P2108RasterGeometry *grid,
+    const int *clutter_types,
+    const double f__ghz,
+    const double h__meter,
+    const double w_s__meter
+) {
+    if (!IsValidGrid(grid) || clutter_types == nullptr) {
+        return P2108_RASTER_ERROR_ARGUMENT;
+    }
+    // Validate the scalar inputs with a valid clutter height
+    return Inline::Section3p1_InputValidation(
+        f__ghz, h__meter, w_s__meter, RepresentativeClutterHeight::R__URBAN
+    );
+}
+
+/** Validate the arguments of the terrestrial coverage functions */
+int ValidateTerrestrialCoverage(
+    const P2108RasterGeometry *grid, const double f__ghz, const double p
+) {
+    if (!IsValidGrid(grid)) {
+        return P2108_RASTER_ERROR_ARGUMENT;
+    }
+    // Validate the frequency and percentage at a valid distance
+    return Inline::Section3p2_InputValidation(f__ghz, 2, p);
+}
+
+/*******************************************************************************
+ * Write a raster of the Height Gain Terminal Correction Model, computed from
+ * land-cover and height raster files, to a file. Implements
+ * `P2108HeightGainRasterFile`, which documents the parameters.
+ ******************************************************************************/
+int WriteHeightGainRasterFile(
+    const P2108RasterGeometry *grid,
+    const char *land_cover_path,
+    const int *clutter_types,
+    const char *R__meter_path,
+    const double f__ghz,
+    const double h__meter,
+    const double w_s__meter,
+    const char *path,
+    const std::size_t n_threads
+) {
+    int rtn = ValidateHeightGainRaster(
+        grid, clutter_types, f__ghz, h__meter, w_s__meter
+    );
+    if (rtn != SUCCESS) {
+        return rtn;
+    }
+    if (land_cover_path == nullptr || path == nullptr) {
+        return P2108_RASTER_ERROR_ARGUMENT;
+    }
+    const std::size_t n_cells = static_cast<std::size_t>(CellCount(grid));
+    MappedFile land_cover, heights;
+    rtn = land_cover.Open(land_cover_path, n_cells * sizeof(std::uint8_t));
+    if (rtn == P2108_RASTER_SUCCESS && R__meter_path != nullptr) {
+        rtn = heights.Open(R__meter_path, n_cells * sizeof(float));
+    }
+    if (rtn != P2108_RASTER_SUCCESS) {
+        return rtn;
+    }
+
+    std::ostringstream description;
+    description.precision(std::numeric_limits<double>::max_digits10);
+    description << "P.2108 height gain terminal correction A_h (dB) at f = "
+                << f__ghz << " GHz, h = " << h__meter << " m, w_s = "
+                << w_s__meter << " m.";
+    HGTCMRaster engine(
+        *grid,
+        static_cast<const std::uint8_t *>(land_cover.Data()),
+        clutter_types,
+        static_cast<const float *>(heights.Data()),
+        f__ghz,
+        h__meter,
+        w_s__meter
+    );
+    engine.SetMappedFiles(
+        &land_cover, R__meter_path != nullptr ? &heights : nullptr
+    );
+    return WriteRasterFile(
+        engine, *grid, path, description.str(), ResolveThreads(n_threads)
+    );
+}
+}  // namespace
+
+/*******************************************************************************
+ * Compute a coverage raster of the Terrestrial Statistical Model.
+ *
+ * Each cell holds the clutter loss over the path from the transmitter to the
+ * center of the cell. Cells less than 0.25 km from the transmitter are NaN.
+ *
+ * @param[in]  grid       Geometry of the raster
+ * @param[in]  tx_x__km   Transmitter x coordinate, in km
+ * @param[in]  tx_y__km   Transmitter y coordinate, in km
+ * @param[in]  f__ghz     Frequency, in GHz
+ * @param[in]  p          Percentage of locations, in %
+ * @param[in]  algorithm  Inverse CCDF (`InverseCCDFAlgorithm` value)
+ * @param[out] L_ctt__db  Clutter loss raster, `n_rows * n_cols` values, in dB
+ * @param[in]  n_threads  Number of threads, or 0 for all hardware threads
+ * @return                `P2108_RASTER_SUCCESS`, a `P2108RasterStatus` error,
+ *                        or the `ReturnCode` of an invalid frequency or
+ *                        percentage
+ ******************************************************************************/
+int P2108TerrestrialCoverage(
+    const P2108RasterGeometry *grid,
+    double tx_x__km,
+    double tx_y__km,
+    double f__ghz,
+    double p,
+    int algorithm,
+    float *L_ctt__db,
+    size_t n_threads
+) {
+    P2108_INSTRUMENT(P2108_STATS_TSM_COVERAGE);
+    P2108_PROBE1(tsm_coverage__entry, ProbeInt(CellCount(grid)));
+    int rtn = ValidateTerrestrialCoverage(grid, f__ghz, p);
+    if (rtn == SUCCESS && L_ctt__db == nullptr) {
+        rtn = P2108_RASTER_ERROR_ARGUMENT;
+    }
+    if (rtn == SUCCESS) {
+        const TSMCoverage engine(
+            *grid,
+            tx_x__km,
+            tx_y__km,
+            f__ghz,
+            p,
+            Inline::ToInverseCCDFAlgorithm(algorithm)
+        );
+        EvaluateRows(
+            engine,
+            0,
+            grid->n_rows,
+            grid->n_cols,
+            L_ctt__db,
+            ResolveThreads(n_threads)
+        );
+    }
+    P2108_PROBE1(tsm_coverage__return, ProbeInt(rtn));
+    return P2108_INSTRUMENT_RETURN(rtn);
+}
+
+/*******************************************************************************
+ * Write a coverage raster of the Terrestrial Statistical Model to a file.
+ *
+ * The raster is as computed by `P2108TerrestrialCoverage`, streamed to a raw
+ * `float` file with an ENVI sidecar header at `path` with `.hdr` appended.
+ *
+ * @param[in] grid       Geometry of the raster
+ * @param[in] tx_x__km   Transmitter x coordinate, in km
+ * @param[in] tx_y__km   Transmitter y coordinate, in km
+ * @param[in] f__ghz     Frequency, in GHz
+ * @param[in] p          Percentage of locations, in %
+ * @param[in] algorithm  Inverse CCDF (`InverseCCDFAlgorithm` value)
+ * @param[in] path       Path of the raw raster file
+ * @param[in] n_threads  Number of threads, or 0 for all hardware threads
+ * @return               `P2108_RASTER_SUCCESS`, a `P2108RasterStatus` error,
+ *                       or the `ReturnCode` of an invalid frequency or
+ *                       percentage
+ ******************************************************************************/
+int P2108TerrestrialCoverageFile(
+    const P2108RasterGeometry *grid,
+    double tx_x__km,
+    double tx_y__km,
+    double f__ghz,
+    double p,
+    int algorithm,
+    const char *path,
+    size_t n_threads
+) {
+    P2108_INSTRUMENT(P2108_STATS_TSM_COVERAGE_FILE);
+    P2108_PROBE1(tsm_coverage_file__entry, ProbeInt(CellCount(grid)));
+    int rtn = ValidateTerrestrialCoverage(grid, f__ghz, p);
+    if (rtn == SUCCESS && path == nullptr) {
+        rtn = P2108_RASTER_ERROR_ARGUMENT;
+    }
+    if (rtn == SUCCESS) {
+        std::ostringstream description;
+        description.precision(std::numeric_limits<double>::max_digits10);
+        description << "P.2108 terrestrial clutter loss L_ctt (dB) at f = "
+                    << f__ghz << " GHz, p = " << p
+                    << " %, from a transmitter at (" << tx_x__km << ", "
+                    << tx_y__km << ") km.";
+        const TSMCoverage engine(
+            *grid,
+            tx_x__km,
+            tx_y__km,
+            f__ghz,
+            p,
+            Inline::ToInverseCCDFAlgorithm(algorithm)
+        );
+        rtn = WriteRasterFile(
+            engine, *grid, path, description.str(), ResolveThreads(n_threads)
+        );
+    }
+    P2108_PROBE1(tsm_coverage_file__return, ProbeInt(rtn));
+    return P2108_INSTRUMENT_RETURN(rtn);
+}
+
+/*******************************************************************************
+ * Compute a raster of the Height Gain Terminal Correction Model from a
+ * land-cover raster.
+ *
+ * The clutter type of each cell is `clutter_types[code]`, where `code` is
+ * its land-cover code. Codes with no clutter model may be mapped to 0, and
+ * their cells are NaN. The representative clutter height of each cell is
+ * taken from the height raster, if given, and otherwise, or where the height
+ * is NaN, is the default from `RepresentativeClutterHeight` for the clutter
+ * type. Cells which fail validation are NaN.
+ *
+ * @param[in]  grid           Geometry of the rasters
+ * @param[in]  land_cover     Land-cover code raster, `n_rows * n_cols` values
+ * @param[in]  clutter_types  `ClutterType` of each of the
+ *                            `P2108_LAND_COVER_CODES` land-cover codes
+ * @param[in]  R__meter       Representative clutter height raster, in meters,
+ *                            or `NULL` to use the defaults
+ * @param[in]  f__ghz         Frequency, in GHz
+ * @param[in]  h__meter       Antenna height, in meters
+ * @param[in]  w_s__meter     Street width, in meters
+ * @param[out] A_h__db        Additional loss raster, in dB
+ * @param[in]  n_threads      Number of threads, or 0 for all hardware threads
+ * @return                    `P2108_RASTER_SUCCESS`, a `P2108RasterStatus`
+ *                            error, or the `ReturnCode` of an invalid
+ *                            frequency, antenna height or street width
+ ******************************************************************************/
+int P2108HeightGainRaster(
+    const P2108RasterGeometry *grid,
+    const uint8_t *land_cover,
+    const int *clutter_types,
+    const float *R__meter,
+    double f__ghz,
+    double h__meter,
+    double w_s__meter,
+    float *A_h__db,
+    size_t n_threads
+) {
+    P2108_INSTRUMENT(P2108_STATS_HGTCM_RASTER);
+    P2108_PROBE1(hgtcm_raster__entry, ProbeInt(CellCount(grid)));
+    int rtn = ValidateHeightGainRaster(
+        grid, clutter_types, f__ghz, h__meter, w_s__meter
+    );
+    if (rtn == SUCCESS && (land_cover == nullptr || A_h__db == nullptr)) {
+        rtn = P2108_RASTER_ERROR_ARGUMENT;
+    }
+    if (rtn == SUCCESS) {
+        const HGTCMRaster engine(
+            *grid,
+            land_cover,
+            clutter_types,
+            R__meter,
+            f__ghz,
+            h__meter,
+            w_s__meter
+        );
+        EvaluateRows(
+            engine,
+            0,
+            grid->n_rows,
+            grid->n_cols,
+            A_h__db,
+            ResolveThreads(n_threads)
+        );
+    }
+    P2108_PROBE1(hgtcm_raster__return, ProbeInt(rtn));
+    return P2108_INSTRUMENT_RETURN(rtn);
+}
+
+/*******************************************************************************
+ * Write a raster of the Height Gain Terminal Correction Model, computed from
+ * land-cover and height raster files, to a file.
+ *
+ * The raster is as computed by `P2108HeightGainRaster`. The input files are
+ * memory-mapped, and the output is streamed to a raw `float` file with an
+ * ENVI sidecar header at `path` with `.hdr` appended.
+ *
+ * @param[in] grid             Geometry of the rasters
+ * @param[in] land_cover_path  Path of the raw `uint8_t` land-cover raster
+ * @param[in] clutter_types    `ClutterType` of each of the
+ *                             `P2108_LAND_COVER_CODES` land-cover codes
+ * @param[in] R__meter_path    Path of the raw `float` representative clutter
+ *                             height raster, or `NULL` to use the defaults
+ * @param[in] f__ghz           Frequency, in GHz
+ * @param[in] h__meter         Antenna height, in meters
+ * @param[in] w_s__meter       Street width, in meters
+ * @param[in] path             Path of the raw output raster file
+ * @param[in] n_threads        Number of threads, or 0 for all hardware threads
+ * @return                     `P2108_RASTER_SUCCESS`, a `P2108RasterStatus`
+ *                             error, or the `ReturnCode` of an invalid
+ *                             frequency, antenna height or street width
+ ******************************************************************************/
+int P2108HeightGainRasterFile(
+    const P2108RasterGeometry *grid,
+    const char *land_cover_path,
+    const int *clutter_types,
+    const char *R__meter_path,
+    double f__ghz,
+    double h__meter,
+    double w_s__meter,
+    const char *path,
+    size_t n_threads
+) {
+    P2108_INSTRUMENT(P2108_STATS_HGTCM_RASTER_FILE);
+    P2108_PROBE1(hgtcm_raster_file__entry, ProbeInt(CellCount(grid)));
+    const int rtn = WriteHeightGainRasterFile(
+        grid,
+        land_cover_path,
+        clutter_types,
+        R__meter_path,
+        f__ghz,
+        h__meter,
+        w_s__meter,
+        path,
+        n_threads
+    );
+    P2108_PROBE1(hgtcm_raster_file__return, ProbeInt(rtn));
+    return P2108_INSTRUMENT_RETURN(rtn);
+}
@@ -14,15 +14,63 @@
     #endif
 #endif
 
-#include <cstring>        // for strcpy, strcpy_s
-#include <string>         // for std::string
-#include <unordered_map>  // for std::unordered_map
+#include <cstddef>  // for std::size_t
+#include <cstring>  // for std::strlen, strcpy, strcpy_s
+#include <string>   // for std::string
 
 namespace ITS {
 namespace ITU {
 namespace PSeries {
 namespace P2108 {
 
+/** Prefix of status messages for successful execution */
+#define P2108_STATUS_PREFIX LIBRARY_NAME " v" LIBRARY_VERSION " Status: "
+/** Prefix of status messages for errors */
+#define P2108_ERROR_PREFIX LIBRARY_NAME " v" LIBRARY_VERSION " Error: "
+
+/*******************************************************************************
+ * Get a status message from a return code, without allocating.
+ *
+ * Messages are string literals which live for the duration of the program,
+ * so the returned pointer must not be freed.
+ *
+ * @param[in] code  Integer return code.
+ * @return          A status message corresponding to the input code.
+ ******************************************************************************/
+const char *GetReturnStatusMessage(const int code) {
+    switch (code) {
+        case SUCCESS:
+            return P2108_STATUS_PREFIX "Successful execution";
+        case ERROR31__FREQUENCY:
+            return P2108_ERROR_PREFIX "Frequency must be between 0.3 and 3 GHz";
+        case ERROR31__ANTENNA_HEIGHT:
+            return P2108_ERROR_PREFIX "Antenna height must be >= 0 meters";
+        case ERROR31__STREET_WIDTH:
+            return P2108_ERROR_PREFIX "Street width must be > 0 meters";
+        case ERROR31__CLUTTER_HEIGHT:
+            return P2108_ERROR_PREFIX
+                "Representative clutter height must be > 0 meters";
+        case ERROR31__CLUTTER_TYPE:
+            return P2108_ERROR_PREFIX "Invalid value for clutter type";
+        case ERROR32__FREQUENCY:
+            return P2108_ERROR_PREFIX "Frequency must be between 2 and 67 GHz";
+        case ERROR32__DISTANCE:
+            return P2108_ERROR_PREFIX "Path distance must be >= 0.25 km";
+        case ERROR32__PERCENTAGE:
+            return P2108_ERROR_PREFIX "Percentage must be between 0 and 100";
+        case ERROR33__FREQUENCY:
+            return P2108_ERROR_PREFIX
+                "Frequency must be between 10 and 100 GHz";
+        case ERROR33__THETA:
+            return P2108_ERROR_PREFIX
+                "Elevation angle must be between 0 and 100 GHz";
+        case ERROR33__PERCENTAGE:
+            return P2108_ERROR_PREFIX "Percentage must be between 0 and 100";
+        default:
+            return P2108_ERROR_PREFIX "Undefined return code";
+    }
+}
+
 /*******************************************************************************
  * Get an error message string from a return code.
  * 
@@ -30,37 +78,54 @@ namespace P2108 {
  * @return          A status message corresponding to the input code.
  ******************************************************************************/
 std::string GetReturnStatus(const int code) {
-    static const std::unordered_map<ReturnCode, std::string> messages
-        = {{SUCCESS, "Successful execution"},
-           {ERROR31__FREQUENCY, "Frequency must be between 0.3 and 3 GHz"},
-           {ERROR31__ANTENNA_HEIGHT, "Antenna height must be >= 0 meters"},
-           {ERROR31__STREET_WIDTH, "Street width must be > 0 meters"},
-           {ERROR31__CLUTTER_HEIGHT,
-            "Representative clutter height must be > 0 meters"},
-           {ERROR31__CLUTTER_TYPE, "Invalid value for clutter type"},
-           {ERROR32__FREQUENCY, "Frequency must be between 2 and 67 GHz"},
-           {ERROR32__DISTANCE, "Path distance must be >= 0.25 km"},
-           {ERROR32__PERCENTAGE, "Percentage must be between 0 and 100"},
-           {ERROR33__FREQUENCY, "Frequency must be between 10 and 100 GHz"},
-           {ERROR33__THETA, "Elevation angle must be between 0 and 100 GHz"},
-           {ERROR33__PERCENTAGE, "Percentage must be between 0 and 100"}};
-    // Construct status message
-    std::string msg = LIBRARY_NAME;
-    msg += " v";
-    msg += LIBRARY_VERSION;
-    if (code == SUCCESS) {
-        msg += " Status: ";
-    } else {
-        msg += " Error: ";
+    return std::string(GetReturnStatusMessage(code));
+}
+
+/*******************************************************************************
+ * Count the occurrences of each return code in an array of return codes.
+ *
+ * Counts are written in ascending order of return code, for the codes which
+ * occur at least once, along with their status messages. Return codes outside
+ * of the range of library codes (0-127) are not counted. Like `snprintf`, the
+ * number of distinct codes is returned even if it exceeds `max_counts`, in
+ * which case only the first `max_counts` counts are written. This function
+ * does not allocate.
+ *
+ * @param[in]  codes       Array of return codes
+ * @param[in]  n           Number of return codes
+ * @param[out] counts      Array to write the counts to (may be `nullptr` if
+ *                         `max_counts` is zero)
+ * @param[in]  max_counts  Capacity of the `counts` array
+ * @return                 Number of distinct return codes in `codes`
+ ******************************************************************************/
+std::size_t GetReturnStatusHistogram(
+    const ReturnCode *codes,
+    const std::size_t n,
+    ReturnStatusCount *counts,
+    const std::size_t max_counts
+) {
+    constexpr int MAX_CODES = 128;
+    std::size_t histogram[MAX_CODES] = {};
+    for (std::size_t i = 0; i < n; i++) {
+        const int code = static_cast<int>(codes[i]);
+        if (code >= 0 && code < MAX_CODES) {
+            histogram[code]++;
+        }
     }
 
-    auto it = messages.find(static_cast<ReturnCode>(code));
-    if (it != messages.end()) {
-        msg += it->second;
-    } else {
-        msg += "Undefined return code";
+    std::size_t n_distinct = 0;
+    for (int code = 0; code < MAX_CODES; code++) {
+        if (histogram[code] == 0) {
+            continue;
+        }
+        if (n_distinct < max_counts) {
+            counts[n_distinct].code = static_cast<ReturnCode>(code);
+            counts[n_distinct].count = histogram[code];
+            counts[n_distinct].message = GetReturnStatusMessage(code);
+        }
+        n_distinct++;
     }
-    return msg;
+    return n_distinct;
 }
 
 /*******************************************************************************
@@ -70,12 +135,13 @@ std::string GetReturnStatus(const int code) {
  * @return          A status message corresponding to the input code.
  ******************************************************************************/
 char *GetReturnStatusCharArray(const int code) {
-    const std::string msg = GetReturnStatus(code);
-    char *c_msg = new char[msg.size() + 1];
+    const char *msg = GetReturnStatusMessage(code);
+    const std::size_t size = std::strlen(msg) + 1;
+    char *c_msg = new char[size];
 #ifdef _WIN32
-    strcpy_s(c_msg, msg.size() + 1, msg.c_str());
+    strcpy_s(c_msg, size, msg);
 #else
-    strcpy(c_msg, msg.c_str());
+    strcpy(c_msg, msg);
 #endif
     return c_msg;
 }
@@ -0,0 +1,328 @@
+/** @file Sampler.cpp
+ * Implements Monte Carlo sampling of the location variability of the
+ * statistical models.
+ */
+#include "P2108Sampler.h"
+
+#include "P2108.h"
+#include "P2108Instrumentation.h"
+#include "P2108Kernels.h"
+#include "P2108Probes.h"
+
+#include <algorithm>  // for std::min
+#include <cmath>      // for std::cos, std::erfc, std::log, std::sqrt, ...
+#include <cstddef>    // for std::size_t
+#include <cstdint>    // for std::uint32_t, std::uint64_t
+
+using namespace ITS::ITU::PSeries::P2108;
+
+namespace {
+/** Number of Philox blocks, each giving two normal deviates, per tile */
+constexpr std::size_t TILE_BLOCKS = 128;
+
+/** Number of samples generated and transformed together */
+constexpr std::size_t TILE_SAMPLES = 2 * TILE_BLOCKS;
+
+/** Multiply two 32-bit words into the high and low words of the product */
+inline void MulHiLo(
+    const std::uint32_t a,
+    const std::uint32_t b,
+    std::uint32_t &hi,
+    std::uint32_t &lo
+) {
+    const std::uint64_t product = static_cast<std::uint64_t>(a) * b;
+    hi = static_cast<std::uint32_t>(product >> 32);
+    lo = static_cast<std::uint32_t>(product);
+}
+
+/*******************************************************************************
+ * The Philox4x32-10 counter-based generator of Salmon et al., "Parallel
+ * Random Numbers: As Easy as 1, 2, 3" (SC11).
+ *
+ * @param[in]  counter  Counter
+ * @param[in]  key      Key
+ * @param[out] output   Random words
+ ******************************************************************************/
+inline void Philox4x32_10(
+    const std::uint32_t counter[4],
+    const std::uint32_t key[2],
+    std::uint32_t output[4]
+) {
+    constexpr std::uint32_t M0 = 0xD2511F53, M1 = 0xCD9E8D57;
+    constexpr std::uint32_t W0 = 0x9E3779B9, W1 = 0xBB67AE85;
+    std::uint32_t c0 = counter[0], c1 = counter[1];
+    std::uint32_t c2 = counter[2], c3 = counter[3];
+    std::uint32_t k0 = key[0], k1 = key[1];
+    for (int round = 0; round < 10; round++) {
+        std::uint32_t hi0, lo0, hi1, lo1;
+        MulHiLo(M0, c0, hi0, lo0);
+        MulHiLo(M1, c2, hi1, lo1);
+        c0 = hi1 ^ c1 ^ k0;
+        c1 = lo1;
+        c2 = hi0 ^ c3 ^ k1;
+        c3 = lo0;
+        k0 += W0;
+        k1 += W1;
+    }
+    output[0] = c0;
+    output[1] = c1;
+    output[2] = c2;
+    output[3] = c3;
+}
+
+/** Convert two random words to a uniform value in (0, 1] */
+inline double ToUniform(const std::uint32_t hi, const std::uint32_t lo) {
+    constexpr double ULP = 1.0 / 9007199254740992.0;  // 2^-53
+    const std::uint64_t bits = (static_cast<std::uint64_t>(hi) << 32) | lo;
+    return static_cast<double>((bits >> 11) + 1) * ULP;
+}
+
+/*******************************************************************************
+ * Generate at most one tile of standard normal deviates.
+ *
+ * Each Philox block of the stream gives two uniform values, which the
+ * Box-Muller transform turns into two deviates: samples `2b` and `2b + 1`.
+ * The transform runs in stages over the blocks of the tile.
+ *
+ * @param[in]  seed    Key of the generator
+ * @param[in]  stream  Stream of the generator
+ * @param[in]  first   Index of the first sample in the stream
+ * @param[in]  n       Number of samples, at most `TILE_SAMPLES - 1`
+ * @param[out] z       Standard normal deviates
+ ******************************************************************************/
+void GenerateNormalTile(
+    const std::uint64_t seed,
+    const std::uint64_t stream,
+    const std::uint64_t first,
+    const std::size_t n,
+    double *z
+) {
+    const std::uint32_t key[2] = {
+        static_cast<std::uint32_t>(seed), static_cast<std::uint32_t>(seed >> 32)
+    };
+    const std::uint64_t first_block = first / 2;
+    const std::size_t n_blocks
+        = static_cast<std::size_t>((first + n + 1) / 2 - first_block);
+    double radius[TILE_BLOCKS], angle[TILE_BLOCKS], pair[TILE_SAMPLES];
+
+    // Random words of each block, as uniform values
+    for (std::size_t b = 0; b < n_blocks; b++) {
+        const std::uint64_t block = first_block + b;
+        const std::uint32_t counter[4] = {
+            static_cast<std::uint32_t>(block),
+            static_cast<std::uint32_t>(block >> 32),
+            static_cast<std::uint32_t>(stream),
+            static_cast<std::uint32_t>(stream >> 32)
+        };
+        std::uint32_t words[4];
+        Philox4x32_10(counter, key, words);
+        radius[b] = ToUniform(words[0], words[1]);
+        angle[b] = ToUniform(words[2], words[3]);
+    }
+
+    // Box-Muller transform
+    for (std::size_t b = 0; b < n_blocks; b++) {
+        radius[b] = std::sqrt(-2 * std::log(radius[b]));
+        angle[b] *= 2 * PI;
+    }
+    for (std::size_t b = 0; b < n_blocks; b++) {
+        pair[2 * b] = radius[b] * std::cos(angle[b]);
+        pair[2 * b + 1] = radius[b] * std::sin(angle[b]);
+    }
+
+    const std::size_t offset = static_cast<std::size_t>(first % 2);
+    for (std::size_t i = 0; i < n; i++) {
+        z[i] = pair[offset + i];
+    }
+}
+
+/*******************************************************************************
+ * Generate samples of a model, one tile at a time.
+ *
+ * Each tile of standard normal deviates is transformed to losses in place,
+ * while it is in cache.
+ *
+ * @param[in]  seed       Key of the generator
+ * @param[in]  stream     Stream of the generator
+ * @param[in]  first      Index of the first sample in the stream
+ * @param[in]  n          Number of samples
+ * @param[out] loss__db   Loss samples, in dB
+ * @param[in]  transform  Converts a deviate to a loss: `transform(z)`
+ ******************************************************************************/
+template<typename Transform>
+void GenerateSamples(
+    const std::uint64_t seed,
+    const std::uint64_t stream,
+    const std::uint64_t first,
+    const std::size_t n,
+    double *loss__db,
+    const Transform &transform
+) {
+    constexpr std::size_t TILE_N = TILE_SAMPLES - 1;
+    for (std::size_t start = 0; start < n; start += TILE_N) {
+        const std::size_t m = std::min(TILE_N, n - start);
+        double *tile = loss__db + start;
+        GenerateNormalTile(seed, stream, first + start, m, tile);
+        for (std::size_t i = 0; i < m; i++) {
+            tile[i] = transform(tile[i]);
+        }
+    }
+}
+
+/*******************************************************************************
+ * Natural log of the standard normal CDF, @f$ \ln \Phi(z) @f$, accurate in
+ * both tails.
+ *
+ * @param[in] z  Standard normal deviate
+ * @return       @f$ \ln(1 - Q(z)) @f$
+ ******************************************************************************/
+inline double LogNormalCDF(const double z) {
+    constexpr double SQRT1_2 = 0.70710678118654752440;
+    if (z < 0) {
+        return std::log(0.5 * std::erfc(-z * SQRT1_2));
+    }
+    return std::log1p(-0.5 * std::erfc(z * SQRT1_2));
+}
+}  // namespace
+
+/*******************************************************************************
+ * Evaluate the Philox4x32-10 generator used by the samplers.
+ *
+ * The samplers use the key `{seed, seed >> 32}` and the counter
+ * `{block, block >> 32, stream, stream >> 32}`, where samples `2 * block`
+ * and `2 * block + 1` are drawn from the output of each block.
+ *
+ * @param[in]  counter  Counter
+ * @param[in]  key      Key
+ * @param[out] output   Random words
+ ******************************************************************************/
+void P2108Philox4x32(
+    const uint32_t counter[4], const uint32_t key[2], uint32_t output[4]
+) {
+    Philox4x32_10(counter, key, output);
+}
+
+/*******************************************************************************
+ * Draw standard normal deviates.
+ *
+ * @param[in]  seed    Key of the generator
+ * @param[in]  stream  Stream of the generator
+ * @param[in]  first   Index of the first sample in the stream
+ * @param[in]  n       Number of samples
+ * @param[out] z       Standard normal deviates
+ ******************************************************************************/
+void P2108StandardNormalSamples(
+    uint64_t seed, uint64_t stream, uint64_t first, size_t n, double *z
+) {
+    GenerateSamples(seed, stream, first, n, z, [](const double x) {
+        return x;
+    });
+}
+
+/*******************************************************************************
+ * Draw samples of the clutter loss of the Terrestrial Statistical Model over
+ * uniformly distributed locations.
+ *
+ * The median and standard deviation of Equation (3) at the path distance
+ * and at 2 km are computed once. Each sample with standard normal deviate
+ * `z` is then `fmin(L_2km - sigma_2km * z, L_d - sigma_d * z)`, which is the
+ * model with `z` as the inverse CCDF of the percentage of locations.
+ *
+ * @param[in]  f__ghz     Frequency, in GHz
+ * @param[in]  d__km      Path distance, in km
+ * @param[in]  seed       Key of the generator
+ * @param[in]  stream     Stream of the generator
+ * @param[in]  first      Index of the first sample in the stream
+ * @param[in]  n          Number of samples
+ * @param[out] L_ctt__db  Clutter loss samples, in dB
+ * @return                Return code
+ ******************************************************************************/
+int P2108TerrestrialStatisticalModelSamples(
+    double f__ghz,
+    double d__km,
+    uint64_t seed,
+    uint64_t stream,
+    uint64_t first,
+    size_t n,
+    double *L_ctt__db
+) {
+    P2108_INSTRUMENT(P2108_STATS_TSM_SAMPLES);
+    P2108_PROBE3(
+        tsm_samples__entry, ProbeBits(f__ghz), ProbeBits(d__km), ProbeInt(n)
+    );
+    const int rtn = Inline::Section3p2_InputValidation(f__ghz, d__km, 50);
+    if (rtn == SUCCESS) {
+        const double P_l = std::pow(10, -0.2 * Inline::Equation_4(f__ghz));
+        const double P_s_2km
+            = std::pow(10, -0.2 * Inline::Equation_5(f__ghz, 2));
+        const double P_s_d
+            = std::pow(10, -0.2 * Inline::Equation_5(f__ghz, d__km));
+        const double median_2km__db
+            = Inline::Equation_3a_Median(P_l, P_s_2km);
+        const double sigma_2km__db = Inline::Equation_3b(P_l, P_s_2km);
+        const double median_d__db = Inline::Equation_3a_Median(P_l, P_s_d);
+        const double sigma_d__db = Inline::Equation_3b(P_l, P_s_d);
+        GenerateSamples(
+            seed, stream, first, n, L_ctt__db, [&](const double z) {
+                return std::fmin(
+                    median_2km__db - sigma_2km__db * z,
+                    median_d__db - sigma_d__db * z
+                );
+            }
+        );
+    }
+    P2108_PROBE1(tsm_samples__return, ProbeInt(rtn));
+    return P2108_INSTRUMENT_RETURN(rtn);
+}
+
+/*******************************************************************************
+ * Draw samples of the clutter loss of the Aeronautical Statistical Model over
+ * uniformly distributed locations.
+ *
+ * The frequency and elevation angle terms of Equation (7) are computed once.
+ * Each sample with standard normal deviate `z` is then the model with `z` as
+ * the inverse CCDF of the percentage of locations, and the percentage
+ * `p / 100 = Q(z)` in its scale term.
+ *
+ * @param[in]  f__ghz      Frequency, in GHz
+ * @param[in]  theta__deg  Elevation angle, in degrees
+ * @param[in]  seed        Key of the generator
+ * @param[in]  stream      Stream of the generator
+ * @param[in]  first       Index of the first sample in the stream
+ * @param[in]  n           Number of samples
+ * @param[out] L_ces__db   Clutter loss samples, in dB
+ * @return                 Return code
+ ******************************************************************************/
+int P2108AeronauticalStatisticalModelSamples(
+    double f__ghz,
+    double theta__deg,
+    uint64_t seed,
+    uint64_t stream,
+    uint64_t first,
+    size_t n,
+    double *L_ces__db
+) {
+    P2108_INSTRUMENT(P2108_STATS_ASM_SAMPLES);
+    P2108_PROBE3(
+        asm_samples__entry,
+        ProbeBits(f__ghz),
+        ProbeBits(theta__deg),
+        ProbeInt(n)
+    );
+    const int rtn
+        = Inline::Section3p3_InputValidation(f__ghz, theta__deg, 50);
+    if (rtn == SUCCESS) {
+        const double K_1 = Inline::Equation_7_K_1(f__ghz);
+        double cot_term, exponent;
+        Inline::Equation_7_AngleTerms(theta__deg, cot_term, exponent);
+        GenerateSamples(
+            seed, stream, first, n, L_ces__db, [&](const double z) {
+                return Inline::Equation_7_Combine(
+                    -K_1 * LogNormalCDF(z), cot_term, exponent, z
+                );
+            }
+        );
+    }
+    P2108_PROBE1(asm_samples__return, ProbeInt(rtn));
+    return P2108_INSTRUMENT_RETURN(rtn);
+}
@@ -0,0 +1,376 @@
+/** @file ShmClient.cpp
+ * Implements the C client for the shared-memory transport of the driver
+ * service mode.
+ */
+#include "P2108Shm.h"
+
+#include <cstddef>  // for std::size_t
+#include <cstdint>  // for std::int32_t, std::uint32_t, std::uint64_t
+#include <new>      // for std::nothrow
+
+#ifdef __linux__
+    #include <climits>        // for INT_MAX
+    #include <ctime>          // for timespec
+    #include <fcntl.h>        // for O_RDWR
+    #include <linux/futex.h>  // for FUTEX_WAIT, FUTEX_WAKE
+    #include <sys/mman.h>     // for mmap, munmap, shm_open
+    #include <sys/stat.h>     // for fstat
+    #include <sys/syscall.h>  // for SYS_futex
+    #include <unistd.h>       // for close, syscall
+#endif
+
+/** Connection to a shared-memory region */
+struct P2108ShmClient {
+        void *region;           /**< Start of the mapped region */
+        std::size_t size;       /**< Size of the mapped region, in bytes */
+        P2108ShmHeader *header; /**< Region header */
+        std::uint32_t n_slots;  /**< Number of slots, validated on connect */
+        std::uint32_t capacity; /**< Records per slot, validated on connect */
+};
+
+namespace {
+/** Round a size up to a multiple of `P2108_SHM_ALIGNMENT` */
+std::uint64_t AlignUp(const std::uint64_t n) {
+    constexpr std::uint64_t a = P2108_SHM_ALIGNMENT;
+    return (n + a - 1) / a * a;
+}
+}  // namespace
+
+/*******************************************************************************
+ * Get the size of one slot for a given capacity.
+ *
+ * @param[in] capacity  Maximum number of records per slot
+ * @return              Size of the slot, in bytes
+ ******************************************************************************/
+std::uint64_t P2108ShmSlotStride(std::uint32_t capacity) {
+    const std::uint64_t column = AlignUp(capacity * sizeof(double));
+    const std::uint64_t rtn_column = AlignUp(capacity * sizeof(std::int32_t));
+    return P2108_SHM_ALIGNMENT + (P2108_SHM_MAX_INPUTS + 1) * column
+         + rtn_column;
+}
+
+/*******************************************************************************
+ * Get the header of a slot in a mapped region.
+ *
+ * The address is computed from `capacity` rather than from the header of the
+ * region, which any process mapping it can overwrite.
+ *
+ * @param[in] region    Start of the mapped region
+ * @param[in] capacity  Maximum number of records per slot
+ * @param[in] slot      Index of the slot
+ * @return              Header of the slot
+ ******************************************************************************/
+P2108ShmSlot *P2108ShmGetSlot(
+    void *region, std::uint32_t capacity, std::uint32_t slot
+) {
+    return reinterpret_cast<P2108ShmSlot *>(
+        static_cast<char *>(region) + P2108_SHM_ALIGNMENT
+        + slot * P2108ShmSlotStride(capacity)
+    );
+}
+
+/*******************************************************************************
+ * Locate the columns of a slot in a mapped region.
+ *
+ * @param[in]  region    Start of the mapped region
+ * @param[in]  capacity  Maximum number of records per slot
+ * @param[in]  slot      Index of the slot
+ * @param[out] batch     Column pointers of the slot
+ ******************************************************************************/
+void P2108ShmGetBatch(
+    void *region,
+    std::uint32_t capacity,
+    std::uint32_t slot,
+    P2108ShmBatch *batch
+) {
+    char *base
+        = reinterpret_cast<char *>(P2108ShmGetSlot(region, capacity, slot));
+    const std::uint64_t column = AlignUp(capacity * sizeof(double));
+    char *data = base + P2108_SHM_ALIGNMENT;
+    for (int i = 0; i < P2108_SHM_MAX_INPUTS; i++) {
+        batch->inputs[i] = reinterpret_cast<double *>(data + i * column);
+    }
+    batch->loss
+        = reinterpret_cast<double *>(data + P2108_SHM_MAX_INPUTS * column);
+    batch->rtn = reinterpret_cast<std::int32_t *>(
+        data + (P2108_SHM_MAX_INPUTS + 1) * column
+    );
+    batch->capacity = capacity;
+    batch->slot = slot;
+}
+
+/*******************************************************************************
+ * Wait until a futex word in the region no longer holds an expected value.
+ *
+ * Spurious wake-ups are possible, so callers must re-check the word.
+ *
+ * @param[in] word         Futex word in the shared region
+ * @param[in] expected     Value the word is expected to hold
+ * @param[in] timeout__ms  Maximum time to wait, in ms (negative: no limit)
+ * @return                 Status code
+ ******************************************************************************/
+int P2108ShmWait(
+    std::uint32_t *word, std::uint32_t expected, int32_t timeout__ms
+) {
+#ifdef __linux__
+    timespec ts;
+    ts.tv_sec = timeout__ms / 1000;
+    ts.tv_nsec = (timeout__ms % 1000) * 1000000L;
+    syscall(
+        SYS_futex,
+        word,
+        FUTEX_WAIT,
+        expected,
+        timeout__ms < 0 ? nullptr : &ts,
+        nullptr,
+        0
+    );
+    return P2108_SHM_SUCCESS;
+#else
+    (void)word;
+    (void)expected;
+    (void)timeout__ms;
+    return P2108_SHM_ERROR_UNSUPPORTED;
+#endif
+}
+
+/*******************************************************************************
+ * Wake processes waiting on a futex word in the region.
+ *
+ * @param[in] word       Futex word in the shared region
+ * @param[in] n_waiters  Maximum number of waiters to wake
+ ******************************************************************************/
+void P2108ShmWake(std::uint32_t *word, int32_t n_waiters) {
+#ifdef __linux__
+    syscall(SYS_futex, word, FUTEX_WAKE, n_waiters, nullptr, nullptr, 0);
+#else
+    (void)word;
+    (void)n_waiters;
+#endif
+}
+
+/*******************************************************************************
+ * Connect to the shared-memory region created by a running service.
+ *
+ * @param[in]  name    Name of the region, as passed to the driver `-shm` option
+ * @param[out] client  Connection handle, freed with `P2108ShmDisconnect`
+ * @return             Status code
+ ******************************************************************************/
+int P2108ShmConnect(const char *name, P2108ShmClient **client) {
+#ifdef __linux__
+    *client = nullptr;
+    const int fd = shm_open(name, O_RDWR, 0);
+    if (fd < 0) {
+        return P2108_SHM_ERROR_CONNECT;
+    }
+    struct stat st;
+    if (fstat(fd, &st) != 0
+        || static_cast<std::size_t>(st.st_size) < sizeof(P2108ShmHeader)) {
+        close(fd);
+        return P2108_SHM_ERROR_CONNECT;
+    }
+    const std::size_t size = static_cast<std::size_t>(st.st_size);
+    void *region
+        = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    close(fd);
+    if (region == MAP_FAILED) {
+        return P2108_SHM_ERROR_CONNECT;
+    }
+
+    // The service publishes the magic number last, once the layout is valid.
+    // The layout is read once and kept, since other processes can change it.
+    P2108ShmHeader *header = static_cast<P2108ShmHeader *>(region);
+    int rtn = P2108_SHM_SUCCESS;
+    if (__atomic_load_n(&header->magic, __ATOMIC_ACQUIRE) != P2108_SHM_MAGIC) {
+        rtn = P2108_SHM_ERROR_CONNECT;
+    } else {
+        const std::uint32_t version
+            = __atomic_load_n(&header->version, __ATOMIC_RELAXED);
+        const std::uint32_t n_slots
+            = __atomic_load_n(&header->n_slots, __ATOMIC_RELAXED);
+        const std::uint32_t capacity
+            = __atomic_load_n(&header->capacity, __ATOMIC_RELAXED);
+        const std::uint64_t offset
+            = __atomic_load_n(&header->slot_offset, __ATOMIC_RELAXED);
+        const std::uint64_t stride
+            = __atomic_load_n(&header->slot_stride, __ATOMIC_RELAXED);
+        if (version != P2108_SHM_VERSION || offset != P2108_SHM_ALIGNMENT
+            || stride != P2108ShmSlotStride(capacity) || offset > size
+            || n_slots > (size - offset) / stride) {
+            rtn = P2108_SHM_ERROR_VERSION;
+        } else {
+            *client = new (std::nothrow)
+                P2108ShmClient {region, size, header, n_slots, capacity};
+            if (*client == nullptr) {
+                rtn = P2108_SHM_ERROR_CONNECT;
+            }
+        }
+    }
+    if (rtn != P2108_SHM_SUCCESS) {
+        munmap(region, size);
+    }
+    return rtn;
+#else
+    (void)name;
+    *client = nullptr;
+    return P2108_SHM_ERROR_UNSUPPORTED;
+#endif
+}
+
+/*******************************************************************************
+ * Unmap the region and free a connection handle.
+ *
+ * Any claimed slots should be released first.
+ *
+ * @param[in] client  Connection handle
+ ******************************************************************************/
+void P2108ShmDisconnect(P2108ShmClient *client) {
+#ifdef __linux__
+    if (client != nullptr) {
+        munmap(client->region, client->size);
+        delete client;
+    }
+#else
+    (void)client;
+#endif
+}
+
+/*******************************************************************************
+ * Claim a free slot, waiting for one to be released if necessary.
+ *
+ * On success, the caller owns the slot and may write up to `batch->capacity`
+ * records into the input columns of `batch`.
+ *
+ * @param[in]  client  Connection handle
+ * @param[out] batch   Column pointers of the claimed slot
+ * @return             Status code
+ ******************************************************************************/
+int P2108ShmAcquire(P2108ShmClient *client, P2108ShmBatch *batch) {
+#ifdef __linux__
+    P2108ShmHeader *header = client->header;
+    while (true) {
+        if (__atomic_load_n(&header->shutdown, __ATOMIC_ACQUIRE) != 0) {
+            return P2108_SHM_ERROR_SHUTDOWN;
+        }
+        const std::uint32_t seq
+            = __atomic_load_n(&header->release_seq, __ATOMIC_ACQUIRE);
+        for (std::uint32_t i = 0; i < client->n_slots; i++) {
+            P2108ShmSlot *slot
+                = P2108ShmGetSlot(client->region, client->capacity, i);
+            std::uint32_t expected = P2108_SHM_SLOT_FREE;
+            if (__atomic_compare_exchange_n(
+                    &slot->state,
+                    &expected,
+                    static_cast<std::uint32_t>(P2108_SHM_SLOT_CLAIMED),
+                    false,
+                    __ATOMIC_ACQ_REL,
+                    __ATOMIC_RELAXED
+                )) {
+                P2108ShmGetBatch(client->region, client->capacity, i, batch);
+                return P2108_SHM_SUCCESS;
+            }
+        }
+        // All slots are in use; wait for a release (re-checking shutdown)
+        P2108ShmWait(&header->release_seq, seq, 100);
+    }
+#else
+    (void)client;
+    (void)batch;
+    return P2108_SHM_ERROR_UNSUPPORTED;
+#endif
+}
+
+/*******************************************************************************
+ * Submit the records written to a claimed slot and wait for the results.
+ *
+ * On success, `batch->rtn` and `batch->loss` hold the return code and clutter
+ * loss (NaN on error) of each record. The slot remains owned by the caller,
+ * which may write new inputs and submit it again.
+ *
+ * @param[in] client  Connection handle
+ * @param[in] batch   A slot claimed with `P2108ShmAcquire`
+ * @param[in] model   Model to run (1: HGTCM, 2: TSM, 3: ASM)
+ * @param[in] count   Number of records, at most `batch->capacity`
+ * @return            Status code
+ ******************************************************************************/
+int P2108ShmSubmit(
+    P2108ShmClient *client,
+    P2108ShmBatch *batch,
+    int32_t model,
+    std::uint32_t count
+) {
+#ifdef __linux__
+    if (model < 1 || model > 3 || count > client->capacity
+        || batch->slot >= client->n_slots) {
+        return P2108_SHM_ERROR_ARGUMENT;
+    }
+    P2108ShmHeader *header = client->header;
+    P2108ShmSlot *slot
+        = P2108ShmGetSlot(client->region, client->capacity, batch->slot);
+    slot->model = model;
+    slot->count = count;
+    slot->status = P2108_SHM_SUCCESS;
+    __atomic_store_n(
+        &slot->state,
+        static_cast<std::uint32_t>(P2108_SHM_SLOT_REQUEST),
+        __ATOMIC_RELEASE
+    );
+    __atomic_add_fetch(&header->request_seq, 1, __ATOMIC_ACQ_REL);
+    P2108ShmWake(&header->request_seq, 1);
+
+    while (true) {
+        std::uint32_t state = __atomic_load_n(&slot->state, __ATOMIC_ACQUIRE);
+        if (state == P2108_SHM_SLOT_RESPONSE) {
+            return slot->status;
+        }
+        if (state == P2108_SHM_SLOT_REQUEST
+            && __atomic_load_n(&header->shutdown, __ATOMIC_ACQUIRE) != 0) {
+            // Withdraw the request if the service has not picked it up
+            if (__atomic_compare_exchange_n(
+                    &slot->state,
+                    &state,
+                    static_cast<std::uint32_t>(P2108_SHM_SLOT_CLAIMED),
+                    false,
+                    __ATOMIC_ACQ_REL,
+                    __ATOMIC_ACQUIRE
+                )) {
+                return P2108_SHM_ERROR_SHUTDOWN;
+            }
+            continue;
+        }
+        P2108ShmWait(&slot->state, state, 100);
+    }
+#else
+    (void)client;
+    (void)batch;
+    (void)model;
+    (void)count;
+    return P2108_SHM_ERROR_UNSUPPORTED;
+#endif
+}
+
+/*******************************************************************************
+ * Return a claimed slot to the service so that other clients may use it.
+ *
+ * @param[in] client  Connection handle
+ * @param[in] batch   A slot claimed with `P2108ShmAcquire`
+ ******************************************************************************/
+void P2108ShmRelease(P2108ShmClient *client, P2108ShmBatch *batch) {
+#ifdef __linux__
+    if (batch->slot >= client->n_slots) {
+        return;
+    }
+    P2108ShmSlot *slot
+        = P2108ShmGetSlot(client->region, client->capacity, batch->slot);
+    __atomic_store_n(
+        &slot->state,
+        static_cast<std::uint32_t>(P2108_SHM_SLOT_FREE),
+        __ATOMIC_RELEASE
+    );
+    __atomic_add_fetch(&client->header->release_seq, 1, __ATOMIC_ACQ_REL);
+    P2108ShmWake(&client->header->release_seq, 1);
+#else
+    (void)client;
+    (void)batch;
+#endif
+}
@@ -0,0 +1,871 @@
+/** @file Surface.cpp
+ * Implements the precomputed loss surfaces, and the reading and writing of
+ * the files which persist them.
+ */
+#include "P2108Surface.h"
+
+#include "P2108.h"
+#include "P2108Instrumentation.h"
+#include "P2108Kernels.h"
+#include "P2108Probes.h"
+
+#include <algorithm>  // for std::min
+#include <cmath>      // for std::exp, std::fabs, std::floor, std::isfinite, ...
+#include <cstddef>    // for std::size_t
+#include <cstdint>    // for std::uint32_t, std::uint64_t
+#include <cstring>    // for std::memset, std::strncmp, std::strncpy
+#include <fstream>    // for std::ifstream, std::ofstream
+#include <limits>     // for std::numeric_limits
+#include <new>        // for std::nothrow
+#include <vector>     // for std::vector
+
+#if defined(__unix__) || defined(__APPLE__)
+    #define P2108_SURFACE_MMAP
+    #include <fcntl.h>     // for O_RDONLY, open
+    #include <sys/mman.h>  // for mmap, munmap
+    #include <sys/stat.h>  // for fstat
+    #include <unistd.h>    // for close
+#endif
+
+using namespace ITS::ITU::PSeries::P2108;
+
+namespace {
+/** Alignment, in bytes, of each surface in a file */
+constexpr std::uint64_t ALIGNMENT = 64;
+
+/** Maximum number of values in one surface */
+constexpr std::uint64_t MAX_VALUES = std::uint64_t(1) << 28;
+
+/** Round a size up to a multiple of `ALIGNMENT` */
+std::uint64_t AlignUp(const std::uint64_t n) {
+    return (n + ALIGNMENT - 1) / ALIGNMENT * ALIGNMENT;
+}
+
+/** 64-bit FNV-1a hash of a sequence of bytes */
+std::uint64_t Checksum(const void *data, const std::size_t size) {
+    const unsigned char *bytes = static_cast<const unsigned char *>(data);
+    std::uint64_t hash = 0xcbf29ce484222325u;
+    for (std::size_t i = 0; i < size; i++) {
+        hash = (hash ^ bytes[i]) * 0x100000001b3u;
+    }
+    return hash;
+}
+
+/** Checksum of the header fields which precede `header_checksum` */
+std::uint64_t HeaderChecksum(const P2108SurfaceHeader &header) {
+    return Checksum(&header, offsetof(P2108SurfaceHeader, header_checksum));
+}
+
+/*******************************************************************************
+ * Position of values along a grid axis, in units of the node spacing.
+ ******************************************************************************/
+struct GridAxis {
+        double min;          /**< Value of the first node */
+        double max;          /**< Value of the last node */
+        double origin;       /**< First node, on the scale of the axis */
+        double step;         /**< Node spacing, on the scale of the axis */
+        std::size_t count;   /**< Number of nodes */
+        std::uint32_t scale; /**< Spacing of the nodes */
+
+        GridAxis() = default;
+
+        explicit GridAxis(const P2108SurfaceAxis &axis):
+            min(axis.min), max(axis.max), count(axis.count), scale(axis.scale) {
+            origin = ToScale(min);
+            step = (ToScale(max) - origin) / (count - 1);
+        }
+
+        /** Map a value to the scale on which the nodes are evenly spaced */
+        double ToScale(const double x) const {
+            switch (scale) {
+                case P2108_SURFACE_LOG:
+                    return std::log(x);
+                case P2108_SURFACE_PERCENTAGE:
+                    return std::log(-std::log1p(-x / 100));
+                default:
+                    return x;
+            }
+        }
+
+        /** Map a value on the scale of the axis back to a value */
+        double FromScale(const double u) const {
+            switch (scale) {
+                case P2108_SURFACE_LOG:
+                    return std::exp(u);
+                case P2108_SURFACE_PERCENTAGE:
+                    return -100 * std::expm1(-std::exp(u));
+                default:
+                    return u;
+            }
+        }
+
+        /** Whether a value lies within the nodes of the axis */
+        bool Contains(const double x) const { return x >= min && x <= max; }
+
+        /** Value at a fractional node index */
+        double At(const double index) const {
+            if (index <= 0)
+                return min;
+            if (index >= count - 1)
+                return max;
+            return FromScale(origin + index * step);
+        }
+
+        /** Locate a contained value, as the node below it and the weight of
+         * the node above it */
+        void Locate(const double x, std::size_t &i, double &w) const {
+            const double t = std::fmax((ToScale(x) - origin) / step, 0);
+            i = std::min(static_cast<std::size_t>(std::floor(t)), count - 2);
+            w = t - i;
+        }
+};
+
+/** Whether an axis is well formed, with nodes within `[lo, hi]` */
+bool ValidAxis(const P2108SurfaceAxis &axis, const double lo, const double hi) {
+    return std::isfinite(axis.min) && std::isfinite(axis.max)
+        && axis.min < axis.max && axis.min >= lo && axis.max <= hi
+        && axis.count >= 2
+        && (axis.scale == P2108_SURFACE_LINEAR
+            || (axis.scale == P2108_SURFACE_LOG && axis.min > 0)
+            || (axis.scale == P2108_SURFACE_PERCENTAGE && axis.min > 0
+                && axis.max < 100));
+}
+
+/** Whether each grid is well formed and within the domain of its model */
+bool ValidSpec(const P2108SurfaceSpec &spec) {
+    constexpr double inf = std::numeric_limits<double>::infinity();
+    const std::uint64_t asm_count = std::uint64_t(spec.asm_f__ghz.count)
+                                  * spec.asm_theta__deg.count
+                                  * spec.asm_p.count;
+    return ValidAxis(spec.tsm_f__ghz, 0.5, 67)
+        && ValidAxis(spec.tsm_d__km, 0.25, inf)
+        && ValidAxis(spec.asm_f__ghz, 10, 100)
+        && ValidAxis(spec.asm_theta__deg, 0, 90)
+        && ValidAxis(spec.asm_p, 0, 100) && spec.asm_p.min > 0
+        && spec.asm_p.max < 100 && ValidAxis(spec.hgtcm_nu, -inf, inf)
+        && asm_count <= MAX_VALUES;
+}
+
+/** Median loss and standard deviation of Equation (3) */
+void TerrestrialMoments(
+    const double f__ghz, const double d__km, double &median, double &sigma
+) {
+    const double P_l = std::pow(10, -0.2 * Inline::Equation_4(f__ghz));
+    const double P_s = std::pow(10, -0.2 * Inline::Equation_5(f__ghz, d__km));
+    median = Inline::Equation_3a_Median(P_l, P_s);
+    sigma = Inline::Equation_3b(P_l, P_s);
+}
+
+/*******************************************************************************
+ * Value of the ASM surface: the logarithm of the power term of Equation (7),
+ * which varies more slowly with the elevation angle and percentage than the
+ * loss itself.
+ *
+ * @param[in] f__ghz      Frequency, in GHz
+ * @param[in] theta__deg  Elevation angle, in degrees
+ * @param[in] p           Percentage of locations, in %
+ * @return                @f$ \ln(L_{ces} + 1 + 0.6 Q^{-1}(p/100)) @f$
+ ******************************************************************************/
+double AeronauticalTerm(
+    const double f__ghz, const double theta__deg, const double p
+) {
+    double cot_term, exponent;
+    Inline::Equation_7_AngleTerms(theta__deg, cot_term, exponent);
+    return exponent
+         * std::log(Inline::Equation_7_Scale(f__ghz, p) * cot_term);
+}
+
+/** Loss of Equation (7) less its inverse CCDF term, from `AeronauticalTerm` */
+double AeronauticalLoss(const double term) {
+    return std::exp(term) - 1;
+}
+
+/** Loss, in dB, of the values of the surfaces stored as losses */
+double Identity(const double loss__db) {
+    return loss__db;
+}
+
+/** Grids of the surfaces in a file, which locate points on the surfaces */
+struct Grids {
+        GridAxis tsm_f;     /**< TSM frequency */
+        GridAxis tsm_d;     /**< TSM path distance */
+        GridAxis asm_f;     /**< ASM frequency */
+        GridAxis asm_theta; /**< ASM elevation angle */
+        GridAxis asm_p;     /**< ASM percentage of locations */
+        GridAxis hgtcm_nu;  /**< HGTCM diffraction parameter */
+
+        Grids() = default;
+
+        explicit Grids(const P2108SurfaceSpec &spec):
+            tsm_f(spec.tsm_f__ghz),
+            tsm_d(spec.tsm_d__km),
+            asm_f(spec.asm_f__ghz),
+            asm_theta(spec.asm_theta__deg),
+            asm_p(spec.asm_p),
+            hgtcm_nu(spec.hgtcm_nu) {}
+
+        /** Interpolate a TSM surface; the inputs must be contained */
+        double Terrestrial(
+            const double *values, const double f__ghz, const double d__km
+        ) const {
+            std::size_t i, j;
+            double u, v;
+            tsm_f.Locate(f__ghz, i, u);
+            tsm_d.Locate(d__km, j, v);
+            const double *row = values + i * tsm_d.count + j;
+            const double *next = row + tsm_d.count;
+            return (1 - u) * ((1 - v) * row[0] + v * row[1])
+                 + u * ((1 - v) * next[0] + v * next[1]);
+        }
+
+        /** Interpolate the ASM surface; the inputs must be contained */
+        double Aeronautical(
+            const double *values,
+            const double f__ghz,
+            const double theta__deg,
+            const double p
+        ) const {
+            std::size_t i, j, k;
+            double u, v, w;
+            asm_f.Locate(f__ghz, i, u);
+            asm_theta.Locate(theta__deg, j, v);
+            asm_p.Locate(p, k, w);
+            const std::size_t n_p = asm_p.count;
+            const std::size_t plane = asm_theta.count * n_p;
+            double result = 0;
+            for (std::size_t a = 0; a < 2; a++) {
+                for (std::size_t b = 0; b < 2; b++) {
+                    const double *cell
+                        = values + (i + a) * plane + (j + b) * n_p + k;
+                    const double weight = (a ? u : 1 - u) * (b ? v : 1 - v);
+                    result += weight * ((1 - w) * cell[0] + w * cell[1]);
+                }
+            }
+            return result;
+        }
+
+        /** Interpolate the HGTCM surface; the input must be contained */
+        double HeightGain(const double *values, const double nu) const {
+            std::size_t i;
+            double w;
+            hgtcm_nu.Locate(nu, i, w);
+            return (1 - w) * values[i] + w * values[i + 1];
+        }
+};
+
+/*******************************************************************************
+ * Tabulate one surface, and measure its interpolation error at the centers
+ * of its grid cells.
+ *
+ * @param[in]  axes       Axes of the surface, in storage order
+ * @param[in]  n_axes     Number of axes, 1 to 3
+ * @param[in]  evaluate   Value of the surface at a point
+ * @param[in]  lookup     Interpolated value of the surface at a point
+ * @param[in]  decode     Loss, in dB, given a value of the surface
+ * @param[out] values     Value at each node
+ * @param[out] max_error  Maximum absolute error of the loss found, in dB
+ ******************************************************************************/
+template<typename Evaluate, typename Lookup, typename Decode>
+void Tabulate(
+    const GridAxis *axes,
+    const std::size_t n_axes,
+    const Evaluate &evaluate,
+    const Lookup &lookup,
+    const Decode &decode,
+    std::vector<double> &values,
+    double &max_error
+) {
+    std::size_t count = 1;
+    for (std::size_t a = 0; a < n_axes; a++) {
+        count *= axes[a].count;
+    }
+    values.resize(count);
+    double x[3] = {0, 0, 0};
+    for (std::size_t node = 0; node < count; node++) {
+        for (std::size_t a = n_axes, rest = node; a-- > 0;) {
+            x[a] = axes[a].At(static_cast<double>(rest % axes[a].count));
+            rest /= axes[a].count;
+        }
+        values[node] = evaluate(x);
+    }
+
+    // The values are in place, so the surface may be interpolated
+    max_error = 0;
+    std::size_t cells = 1;
+    for (std::size_t a = 0; a < n_axes; a++) {
+        cells *= axes[a].count - 1;
+    }
+    for (std::size_t cell = 0; cell < cells; cell++) {
+        for (std::size_t a = n_axes, rest = cell; a-- > 0;) {
+            x[a] = axes[a].At((rest % (axes[a].count - 1)) + 0.5);
+            rest /= axes[a].count - 1;
+        }
+        const double error = std::fabs(decode(lookup(x)) - decode(evaluate(x)));
+        if (error > max_error) {
+            max_error = error;
+        }
+    }
+}
+
+/** Fill in the location and checksum of a section */
+void PlaceSection(
+    P2108SurfaceSection &section,
+    std::uint64_t &offset,
+    const std::vector<double> &values,
+    const double max_error
+) {
+    section.offset = offset;
+    section.count = values.size();
+    section.checksum = Checksum(values.data(), values.size() * sizeof(double));
+    section.max_error = max_error;
+    offset = AlignUp(offset + values.size() * sizeof(double));
+}
+
+/** Whether a section lies within a file of a given size */
+bool ValidSection(
+    const P2108SurfaceSection &section,
+    const std::uint64_t count,
+    const std::uint64_t size
+) {
+    return section.count == count && section.offset % sizeof(double) == 0
+        && section.offset >= sizeof(P2108SurfaceHeader)
+        && section.offset <= size
+        && section.count <= (size - section.offset) / sizeof(double);
+}
+
+/** Whether the values of a section match its checksum */
+bool SectionChecksum(
+    const P2108SurfaceHeader *header, const P2108SurfaceSection &section
+) {
+    const char *base = reinterpret_cast<const char *>(header);
+    return Checksum(base + section.offset, section.count * sizeof(double))
+        == section.checksum;
+}
+
+/*******************************************************************************
+ * Validate the contents of a surface file in memory.
+ *
+ * @param[in] data  Contents of the file
+ * @param[in] size  Size of the file, in bytes
+ * @return          Status code
+ ******************************************************************************/
+int ValidateFile(const void *data, const std::size_t size) {
+    if (size < sizeof(P2108SurfaceHeader))
+        return P2108_SURFACE_ERROR_FORMAT;
+
+    const P2108SurfaceHeader *header
+        = static_cast<const P2108SurfaceHeader *>(data);
+    if (header->magic != P2108_SURFACE_MAGIC)
+        return P2108_SURFACE_ERROR_FORMAT;
+
+    if (header->version != P2108_SURFACE_VERSION)
+        return P2108_SURFACE_ERROR_VERSION;
+
+    if (std::strncmp(
+            header->library_version,
+            LIBRARY_VERSION,
+            P2108_SURFACE_LIBRARY_VERSION_SIZE
+        )
+        != 0)
+        return P2108_SURFACE_ERROR_STALE;
+
+    if (HeaderChecksum(*header) != header->header_checksum)
+        return P2108_SURFACE_ERROR_CHECKSUM;
+
+    const P2108SurfaceSpec &spec = header->spec;
+    const std::uint64_t tsm_count
+        = std::uint64_t(spec.tsm_f__ghz.count) * spec.tsm_d__km.count;
+    const std::uint64_t asm_count = std::uint64_t(spec.asm_f__ghz.count)
+                                  * spec.asm_theta__deg.count
+                                  * spec.asm_p.count;
+    if (header->file_size != size || !ValidSpec(spec)
+        || !ValidSection(header->tsm_median, tsm_count, size)
+        || !ValidSection(header->tsm_sigma, tsm_count, size)
+        || !ValidSection(header->asm_loss, asm_count, size)
+        || !ValidSection(header->hgtcm_loss, spec.hgtcm_nu.count, size))
+        return P2108_SURFACE_ERROR_FORMAT;
+
+    if (!SectionChecksum(header, header->tsm_median)
+        || !SectionChecksum(header, header->tsm_sigma)
+        || !SectionChecksum(header, header->asm_loss)
+        || !SectionChecksum(header, header->hgtcm_loss))
+        return P2108_SURFACE_ERROR_CHECKSUM;
+
+    return P2108_SURFACE_SUCCESS;
+}
+}  // namespace
+
+/** An open surface file */
+struct P2108Surface {
+        void *data;               /**< Contents of the file */
+        std::size_t size;         /**< Size of the file, in bytes */
+        Grids grids;              /**< Grids of the surfaces */
+        const double *tsm_median; /**< TSM median loss */
+        const double *tsm_sigma;  /**< TSM standard deviation */
+        const double *asm_loss;   /**< ASM log of the power term */
+        const double *hgtcm_loss; /**< HGTCM loss of Equation (2a) */
+};
+
+namespace {
+/** Release the contents of a file, as mapped or read by `P2108SurfaceOpen` */
+void ReleaseFile(void *data, const std::size_t size) {
+#ifdef P2108_SURFACE_MMAP
+    munmap(data, size);
+#else
+    (void)size;
+    delete[] static_cast<double *>(data);
+#endif
+}
+
+/** Get the values of a section of an open file */
+const double *
+    SectionValues(const void *data, const P2108SurfaceSection &section) {
+    return reinterpret_cast<const double *>(
+        static_cast<const char *>(data) + section.offset
+    );
+}
+}  // namespace
+
+/*******************************************************************************
+ * Get grids which span the domain of each model.
+ *
+ * Percentages span 1% to 99%, path distances 0.25 km to 100 km, and the
+ * diffraction parameter 0 to 32, which covers clutter up to 50 m deep at
+ * 3 GHz. Frequencies and distances are spaced logarithmically, and
+ * percentages on the `P2108_SURFACE_PERCENTAGE` scale.
+ *
+ * @param[in]  nodes  Number of nodes along each axis, at least 2
+ * @param[out] spec   Grids of the surfaces
+ ******************************************************************************/
+void P2108SurfaceDefaultSpec(uint32_t nodes, P2108SurfaceSpec *spec) {
+    spec->tsm_f__ghz = {0.5, 67, nodes, P2108_SURFACE_LOG};
+    spec->tsm_d__km = {0.25, 100, nodes, P2108_SURFACE_LOG};
+    spec->asm_f__ghz = {10, 100, nodes, P2108_SURFACE_LOG};
+    spec->asm_theta__deg = {0, 90, nodes, P2108_SURFACE_LINEAR};
+    spec->asm_p = {1, 99, nodes, P2108_SURFACE_PERCENTAGE};
+    spec->hgtcm_nu = {0, 32, nodes, P2108_SURFACE_LINEAR};
+}
+
+/*******************************************************************************
+ * Tabulate the surfaces on the given grids and write them to a file.
+ *
+ * @param[in] path  Path of the file to write
+ * @param[in] spec  Grids of the surfaces
+ * @return          Status code
+ ******************************************************************************/
+int P2108SurfaceWrite(const char *path, const P2108SurfaceSpec *spec) {
+    if (!ValidSpec(*spec))
+        return P2108_SURFACE_ERROR_ARGUMENT;
+
+    P2108SurfaceHeader header;
+    std::memset(&header, 0, sizeof(header));
+    header.magic = P2108_SURFACE_MAGIC;
+    header.version = P2108_SURFACE_VERSION;
+    std::strncpy(
+        header.library_version,
+        LIBRARY_VERSION,
+        P2108_SURFACE_LIBRARY_VERSION_SIZE - 1
+    );
+    header.spec = *spec;
+
+    const Grids grids(*spec);
+    std::vector<double> tsm_median, tsm_sigma, asm_loss, hgtcm_loss;
+    double median_error, sigma_error, asm_error, hgtcm_error;
+    const GridAxis tsm_axes[2] = {grids.tsm_f, grids.tsm_d};
+    const GridAxis asm_axes[3] = {grids.asm_f, grids.asm_theta, grids.asm_p};
+
+    Tabulate(
+        tsm_axes,
+        2,
+        [](const double *x) {
+            double median, sigma;
+            TerrestrialMoments(x[0], x[1], median, sigma);
+            return median;
+        },
+        [&](const double *x) {
+            return grids.Terrestrial(tsm_median.data(), x[0], x[1]);
+        },
+        Identity,
+        tsm_median,
+        median_error
+    );
+    Tabulate(
+        tsm_axes,
+        2,
+        [](const double *x) {
+            double median, sigma;
+            TerrestrialMoments(x[0], x[1], median, sigma);
+            return sigma;
+        },
+        [&](const double *x) {
+            return grids.Terrestrial(tsm_sigma.data(), x[0], x[1]);
+        },
+        Identity,
+        tsm_sigma,
+        sigma_error
+    );
+    Tabulate(
+        asm_axes,
+        3,
+        [](const double *x) { return AeronauticalTerm(x[0], x[1], x[2]); },
+        [&](const double *x) {
+            return grids.Aeronautical(asm_loss.data(), x[0], x[1], x[2]);
+        },
+        AeronauticalLoss,
+        asm_loss,
+        asm_error
+    );
+    Tabulate(
+        &grids.hgtcm_nu,
+        1,
+        [](const double *x) { return Inline::Equation_2a(x[0]); },
+        [&](const double *x) {
+            return grids.HeightGain(hgtcm_loss.data(), x[0]);
+        },
+        Identity,
+        hgtcm_loss,
+        hgtcm_error
+    );
+
+    // Lay out the surfaces after the header
+    std::uint64_t offset = AlignUp(sizeof(header));
+    PlaceSection(header.tsm_median, offset, tsm_median, median_error);
+    PlaceSection(header.tsm_sigma, offset, tsm_sigma, sigma_error);
+    PlaceSection(header.asm_loss, offset, asm_loss, asm_error);
+    PlaceSection(header.hgtcm_loss, offset, hgtcm_loss, hgtcm_error);
+    header.file_size = header.hgtcm_loss.offset
+                     + hgtcm_loss.size() * sizeof(double);
+    header.header_checksum = HeaderChecksum(header);
+
+    std::ofstream file(path, std::ios::binary | std::ios::trunc);
+    if (!file)
+        return P2108_SURFACE_ERROR_WRITE;
+
+    const P2108SurfaceSection *sections[4] = {
+        &header.tsm_median, &header.tsm_sigma, &header.asm_loss,
+        &header.hgtcm_loss
+    };
+    const std::vector<double> *values[4] = {
+        &tsm_median, &tsm_sigma, &asm_loss, &hgtcm_loss
+    };
+    file.write(reinterpret_cast<const char *>(&header), sizeof(header));
+    std::uint64_t position = sizeof(header);
+    const char padding[ALIGNMENT] = {};
+    for (int s = 0; s < 4; s++) {
+        file.write(padding, sections[s]->offset - position);
+        file.write(
+            reinterpret_cast<const char *>(values[s]->data()),
+            values[s]->size() * sizeof(double)
+        );
+        position = sections[s]->offset + values[s]->size() * sizeof(double);
+    }
+    file.close();
+    return file ? P2108_SURFACE_SUCCESS : P2108_SURFACE_ERROR_WRITE;
+}
+
+/*******************************************************************************
+ * Open a surface file, mapping it read-only, and validate its contents.
+ *
+ * @param[in]  path     Path of the file
+ * @param[out] surface  Surface handle, freed with `P2108SurfaceClose`
+ * @return              Status code
+ ******************************************************************************/
+int P2108SurfaceOpen(const char *path, P2108Surface **surface) {
+    *surface = nullptr;
+    void *data;
+    std::size_t size;
+#ifdef P2108_SURFACE_MMAP
+    const int fd = open(path, O_RDONLY);
+    if (fd < 0)
+        return P2108_SURFACE_ERROR_OPEN;
+
+    struct stat st;
+    if (fstat(fd, &st) != 0) {
+        close(fd);
+        return P2108_SURFACE_ERROR_OPEN;
+    }
+    size = static_cast<std::size_t>(st.st_size);
+    if (size < sizeof(P2108SurfaceHeader)) {
+        close(fd);
+        return P2108_SURFACE_ERROR_FORMAT;
+    }
+    data = mmap(nullptr, size, PROT_READ, MAP_SHARED, fd, 0);
+    close(fd);
+    if (data == MAP_FAILED)
+        return P2108_SURFACE_ERROR_OPEN;
+#else
+    std::ifstream file(path, std::ios::binary | std::ios::ate);
+    if (!file)
+        return P2108_SURFACE_ERROR_OPEN;
+
+    size = static_cast<std::size_t>(file.tellg());
+    file.seekg(0);
+
+    // Allocate as doubles, so the values are aligned
+    double *buffer = new (std::nothrow)
+        double[(size + sizeof(double) - 1) / sizeof(double)];
+    if (buffer == nullptr)
+        return P2108_SURFACE_ERROR_OPEN;
+    if (!file.read(reinterpret_cast<char *>(buffer), size)) {
+        delete[] buffer;
+        return P2108_SURFACE_ERROR_OPEN;
+    }
+    data = buffer;
+#endif
+
+    int rtn = ValidateFile(data, size);
+    if (rtn == P2108_SURFACE_SUCCESS) {
+        const P2108SurfaceHeader *header
+            = static_cast<const P2108SurfaceHeader *>(data);
+        *surface = new (std::nothrow) P2108Surface {
+            data,
+            size,
+            Grids(header->spec),
+            SectionValues(data, header->tsm_median),
+            SectionValues(data, header->tsm_sigma),
+            SectionValues(data, header->asm_loss),
+            SectionValues(data, header->hgtcm_loss)
+        };
+        if (*surface == nullptr)
+            rtn = P2108_SURFACE_ERROR_OPEN;
+    }
+    if (rtn != P2108_SURFACE_SUCCESS) {
+        ReleaseFile(data, size);
+    }
+    return rtn;
+}
+
+/*******************************************************************************
+ * Unmap a surface file and free its handle.
+ *
+ * @param[in] surface  Surface handle (may be `NULL`)
+ ******************************************************************************/
+void P2108SurfaceClose(P2108Surface *surface) {
+    if (surface != nullptr) {
+        ReleaseFile(surface->data, surface->size);
+        delete surface;
+    }
+}
+
+/*******************************************************************************
+ * Get the header of an open surface file, with its grids and error bounds.
+ *
+ * @param[in] surface  Surface handle
+ * @return             Header of the file
+ ******************************************************************************/
+const P2108SurfaceHeader *P2108SurfaceGetHeader(const P2108Surface *surface) {
+    return static_cast<const P2108SurfaceHeader *>(surface->data);
+}
+
+/*******************************************************************************
+ * Evaluate the Aeronautical Statistical Model for a batch of records,
+ * interpolating in a surface file.
+ *
+ * @param[in]  surface     Surface handle
+ * @param[in]  n           Number of records
+ * @param[in]  f__ghz      Frequency, in GHz
+ * @param[in]  theta__deg  Elevation angle, in degrees
+ * @param[in]  p           Percentage of locations, in %
+ * @param[in]  algorithm   Inverse CCDF (`InverseCCDFAlgorithm` value)
+ * @param[out] L_ces__db   Additional loss (clutter loss), in dB
+ * @param[out] rtn         Return code of each record (may be `NULL`)
+ * @return                 Number of records which failed validation
+ ******************************************************************************/
+size_t P2108SurfaceAeronauticalStatisticalModel(
+    const P2108Surface *surface,
+    size_t n,
+    const double *f__ghz,
+    const double *theta__deg,
+    const double *p,
+    int algorithm,
+    double *L_ces__db,
+    int *rtn
+) {
+    P2108_INSTRUMENT(P2108_STATS_ASM_SURFACE);
+    P2108_PROBE1(asm_surface__entry, ProbeInt(n));
+    const InverseCCDFAlgorithm iccd_algorithm
+        = Inline::ToInverseCCDFAlgorithm(algorithm);
+    const Grids &grids = surface->grids;
+    int first = SUCCESS;
+    std::size_t failed = 0;
+    for (std::size_t i = 0; i < n; i++) {
+        const ReturnCode code = Inline::Section3p3_InputValidation(
+            f__ghz[i], theta__deg[i], p[i]
+        );
+        if (code != SUCCESS) {
+            L_ces__db[i] = std::numeric_limits<double>::quiet_NaN();
+            if (failed++ == 0) {
+                first = code;
+            }
+        } else if (grids.asm_f.Contains(f__ghz[i])
+                   && grids.asm_theta.Contains(theta__deg[i])
+                   && grids.asm_p.Contains(p[i])) {
+            const double Q_p
+                = Inline::InverseComplementaryCumulativeDistribution(
+                    p[i] / 100, iccd_algorithm
+                );
+            const double term = grids.Aeronautical(
+                surface->asm_loss, f__ghz[i], theta__deg[i], p[i]
+            );
+            L_ces__db[i] = AeronauticalLoss(term) - 0.6 * Q_p;
+        } else {
+            Inline::AeronauticalStatisticalModel(
+                f__ghz[i], theta__deg[i], p[i], L_ces__db[i], iccd_algorithm
+            );
+        }
+        if (rtn != nullptr) {
+            rtn[i] = code;
+        }
+    }
+    P2108_PROBE1(asm_surface__return, ProbeInt(failed));
+    P2108_INSTRUMENT_CODE(first);
+    return failed;
+}
+
+/*******************************************************************************
+ * Evaluate the Terrestrial Statistical Model for a batch of records,
+ * interpolating in a surface file.
+ *
+ * @param[in]  surface    Surface handle
+ * @param[in]  n          Number of records
+ * @param[in]  f__ghz     Frequency, in GHz
+ * @param[in]  d__km      Path distance, in km
+ * @param[in]  p          Percentage of locations, in %
+ * @param[in]  algorithm  Inverse CCDF (`InverseCCDFAlgorithm` value)
+ * @param[out] L_ctt__db  Additional loss (clutter loss), in dB
+ * @param[out] rtn        Return code of each record (may be `NULL`)
+ * @return                Number of records which failed validation
+ ******************************************************************************/
+size_t P2108SurfaceTerrestrialStatisticalModel(
+    const P2108Surface *surface,
+    size_t n,
+    const double *f__ghz,
+    const double *d__km,
+    const double *p,
+    int algorithm,
+    double *L_ctt__db,
+    int *rtn
+) {
+    P2108_INSTRUMENT(P2108_STATS_TSM_SURFACE);
+    P2108_PROBE1(tsm_surface__entry, ProbeInt(n));
+    const InverseCCDFAlgorithm iccd_algorithm
+        = Inline::ToInverseCCDFAlgorithm(algorithm);
+    const Grids &grids = surface->grids;
+    const bool has_2km = grids.tsm_d.Contains(2);
+    int first = SUCCESS;
+    std::size_t failed = 0;
+    for (std::size_t i = 0; i < n; i++) {
+        const ReturnCode code
+            = Inline::Section3p2_InputValidation(f__ghz[i], d__km[i], p[i]);
+        if (code != SUCCESS) {
+            L_ctt__db[i] = std::numeric_limits<double>::quiet_NaN();
+            if (failed++ == 0) {
+                first = code;
+            }
+        } else if (has_2km && grids.tsm_f.Contains(f__ghz[i])
+                   && grids.tsm_d.Contains(d__km[i])) {
+            const double Q_p
+                = Inline::InverseComplementaryCumulativeDistribution(
+                    p[i] / 100, iccd_algorithm
+                );
+            const double f = f__ghz[i], d = d__km[i];
+            const double L_d__db
+                = grids.Terrestrial(surface->tsm_median, f, d)
+                - grids.Terrestrial(surface->tsm_sigma, f, d) * Q_p;
+            const double L_2km__db
+                = grids.Terrestrial(surface->tsm_median, f, 2)
+                - grids.Terrestrial(surface->tsm_sigma, f, 2) * Q_p;
+
+            // Equation (6), the lesser of the losses at 2 km and at distance
+            L_ctt__db[i] = std::fmin(L_2km__db, L_d__db);
+        } else {
+            Inline::TerrestrialStatisticalModel(
+                f__ghz[i], d__km[i], p[i], L_ctt__db[i], iccd_algorithm
+            );
+        }
+        if (rtn != nullptr) {
+            rtn[i] = code;
+        }
+    }
+    P2108_PROBE1(tsm_surface__return, ProbeInt(failed));
+    P2108_INSTRUMENT_CODE(first);
+    return failed;
+}
+
+/*******************************************************************************
+ * Evaluate the Height Gain Terminal Correction Model for a batch of records,
+ * interpolating in a surface file.
+ *
+ * @param[in]  surface       Surface handle
+ * @param[in]  n             Number of records
+ * @param[in]  f__ghz        Frequency, in GHz
+ * @param[in]  h__meter      Antenna height, in meters
+ * @param[in]  w_s__meter    Street width, in meters
+ * @param[in]  R__meter      Representative clutter height, in meters
+ * @param[in]  clutter_type  Clutter type (`ClutterType` value)
+ * @param[out] A_h__db       Additional loss (clutter loss), in dB
+ * @param[out] rtn           Return code of each record (may be `NULL`)
+ * @return                   Number of records which failed validation
+ ******************************************************************************/
+size_t P2108SurfaceHeightGainTerminalCorrectionModel(
+    const P2108Surface *surface,
+    size_t n,
+    const double *f__ghz,
+    const double *h__meter,
+    const double *w_s__meter,
+    const double *R__meter,
+    const int *clutter_type,
+    double *A_h__db,
+    int *rtn
+) {
+    P2108_INSTRUMENT(P2108_STATS_HGTCM_SURFACE);
+    P2108_PROBE1(hgtcm_surface__entry, ProbeInt(n));
+    const Grids &grids = surface->grids;
+    int first = SUCCESS;
+    std::size_t failed = 0;
+    for (std::size_t i = 0; i < n; i++) {
+        const ClutterType type = static_cast<ClutterType>(clutter_type[i]);
+        ReturnCode code = Inline::Section3p1_InputValidation(
+            f__ghz[i], h__meter[i], w_s__meter[i], R__meter[i]
+        );
+        const bool diffraction = type == ClutterType::SUBURBAN
+                              || type == ClutterType::URBAN
+                              || type == ClutterType::TREES_FOREST
+                              || type == ClutterType::DENSE_URBAN;
+        bool tabulated = false;
+        if (code == SUCCESS && diffraction && h__meter[i] < R__meter[i]) {
+            const double h_dif__meter = R__meter[i] - h__meter[i];
+            const double nu = Generic::Equation_2c(
+                Inline::Equation_2g(f__ghz[i]),
+                h_dif__meter,
+                Generic::Equation_2e(h_dif__meter, w_s__meter[i])
+            );
+            if (grids.hgtcm_nu.Contains(nu)) {
+                A_h__db[i] = grids.HeightGain(surface->hgtcm_loss, nu);
+                tabulated = true;
+            }
+        }
+        if (code == SUCCESS && !tabulated) {
+            code = Inline::HeightGainTerminalCorrectionModel(
+                f__ghz[i],
+                h__meter[i],
+                w_s__meter[i],
+                R__meter[i],
+                type,
+                A_h__db[i]
+            );
+        }
+        if (code != SUCCESS) {
+            A_h__db[i] = std::numeric_limits<double>::quiet_NaN();
+            if (failed++ == 0) {
+                first = code;
+            }
+        }
+        if (rtn != nullptr) {
+            rtn[i] = code;
+        }
+    }
+    P2108_PROBE1(hgtcm_surface__return, ProbeInt(failed));
+    P2108_INSTRUMENT_CODE(first);
+    return failed;
+}
@@ -0,0 +1,294 @@
+/** @file Tracks.cpp
+ * Implements the replay of aircraft tracks through the Aeronautical
+ * Statistical Model.
+ */
+#include "P2108Tracks.h"
+
+#include "P2108.h"
+#include "P2108Batch.h"
+#include "P2108Instrumentation.h"
+#include "P2108Kernels.h"
+#include "P2108Probes.h"
+
+#include <algorithm>      // for std::min
+#include <cmath>          // for std::asin, std::cos, std::sqrt, ...
+#include <cstddef>        // for std::size_t
+#include <cstdint>        // for std::uint64_t
+#include <limits>         // for std::numeric_limits
+#include <new>            // for std::nothrow
+#include <unordered_map>  // for std::unordered_map
+#include <vector>         // for std::vector
+
+using namespace ITS::ITU::PSeries::P2108;
+
+namespace {
+/** Terms of the model which depend only on the track */
+struct TrackTerms {
+        double f__ghz; /**< Frequency, in GHz */
+        double p;      /**< Percentage of locations, in % */
+        double scale;  /**< Scale of Equation (7) */
+        double Q_p;    /**< Inverse CCDF of p / 100 */
+};
+
+/*******************************************************************************
+ * Intermediate results of one tile of samples, reused between calls on a
+ * thread.
+ ******************************************************************************/
+struct TrackTile {
+        std::vector<int> code;     /**< Validation result of each sample */
+        std::vector<double> scale; /**< Scale of Equation (7) of each sample */
+        std::vector<double> Q_p;   /**< Inverse CCDF of each sample */
+
+        /** Get the tile of this thread, with room for `n` samples */
+        static TrackTile &Get(const std::size_t n) {
+            static thread_local TrackTile tile;
+            if (tile.code.size() < n) {
+                tile.code.resize(n);
+                tile.scale.resize(n);
+                tile.Q_p.resize(n);
+            }
+            return tile;
+        }
+};
+
+/** Earth-centered, Earth-fixed coordinates, in meters */
+struct ECEF {
+        double x; /**< Toward latitude 0, longitude 0 */
+        double y; /**< Toward latitude 0, longitude 90 degrees east */
+        double z; /**< Toward the north pole */
+};
+
+/** Convert a WGS-84 geodetic position to ECEF coordinates */
+ECEF GeodeticToECEF(
+    const double lat__rad, const double lon__rad, const double h__meter
+) {
+    constexpr double a__meter = 6378137.0;  // Semi-major axis
+    constexpr double flattening = 1 / 298.257223563;
+    constexpr double e2 = flattening * (2 - flattening);
+    const double sin_lat = std::sin(lat__rad);
+    const double N__meter = a__meter / std::sqrt(1 - e2 * sin_lat * sin_lat);
+    const double r__meter = (N__meter + h__meter) * std::cos(lat__rad);
+    return {
+        r__meter * std::cos(lon__rad),
+        r__meter * std::sin(lon__rad),
+        (N__meter * (1 - e2) + h__meter) * sin_lat
+    };
+}
+}  // namespace
+
+/** State of the tracks of a replay */
+struct P2108TrackReplay {
+        std::unordered_map<std::uint64_t, TrackTerms> tracks; /**< By ID */
+};
+
+/*******************************************************************************
+ * Create a replay with no tracks.
+ *
+ * @return  Replay, freed with `P2108TrackReplayFree`, or `NULL` if out of
+ *          memory
+ ******************************************************************************/
+P2108TrackReplay *P2108TrackReplayCreate(void) {
+    return new (std::nothrow) P2108TrackReplay;
+}
+
+/*******************************************************************************
+ * Free a replay and its tracks.
+ *
+ * @param[in] replay  Replay, or `NULL`
+ ******************************************************************************/
+void P2108TrackReplayFree(P2108TrackReplay *replay) {
+    delete replay;
+}
+
+/*******************************************************************************
+ * Set the frequency, percentage of locations and inverse CCDF algorithm of a
+ * track.
+ *
+ * The track is added if it is not already set. If the inputs are invalid,
+ * the track is left unchanged.
+ *
+ * @param[in] replay     Replay
+ * @param[in] track      Track ID
+ * @param[in] f__ghz     Frequency, in GHz
+ * @param[in] p          Percentage of locations, in %
+ * @param[in] algorithm  Inverse CCDF (`InverseCCDFAlgorithm` value)
+ * @return               `P2108_TRACK_SUCCESS`, `P2108_TRACK_ERROR_ARGUMENT`,
+ *                       or the `ReturnCode` of an invalid frequency or
+ *                       percentage
+ ******************************************************************************/
+int P2108TrackReplaySetTrack(
+    P2108TrackReplay *replay,
+    uint64_t track,
+    double f__ghz,
+    double p,
+    int algorithm
+) {
+    P2108_INSTRUMENT(P2108_STATS_TRACK_SET);
+    P2108_PROBE3(
+        track_set__entry, ProbeInt(track), ProbeBits(f__ghz), ProbeBits(p)
+    );
+    int rtn = P2108_TRACK_ERROR_ARGUMENT;
+    if (replay != nullptr) {
+        // Validate the frequency and percentage at a valid elevation angle
+        rtn = Inline::Section3p3_InputValidation(f__ghz, 0, p);
+    }
+    if (rtn == SUCCESS) {
+        replay->tracks[track] = {
+            f__ghz,
+            p,
+            Inline::Equation_7_Scale(f__ghz, p),
+            Inline::InverseComplementaryCumulativeDistribution(
+                p / 100, Inline::ToInverseCCDFAlgorithm(algorithm)
+            )
+        };
+    }
+    P2108_PROBE1(track_set__return, ProbeInt(rtn));
+    return P2108_INSTRUMENT_RETURN(rtn);
+}
+
+/*******************************************************************************
+ * Remove a track from a replay.
+ *
+ * @param[in] replay  Replay
+ * @param[in] track   Track ID
+ * @return            `P2108_TRACK_SUCCESS`, or `P2108_TRACK_ERROR_UNKNOWN` if
+ *                    the track is not set
+ ******************************************************************************/
+int P2108TrackReplayRemoveTrack(P2108TrackReplay *replay, uint64_t track) {
+    if (replay == nullptr) {
+        return P2108_TRACK_ERROR_ARGUMENT;
+    }
+    return replay->tracks.erase(track) == 1 ? P2108_TRACK_SUCCESS
+                                            : P2108_TRACK_ERROR_UNKNOWN;
+}
+
+/*******************************************************************************
+ * Get the number of tracks set in a replay.
+ *
+ * @param[in] replay  Replay
+ * @return            Number of tracks
+ ******************************************************************************/
+size_t P2108TrackReplayCount(const P2108TrackReplay *replay) {
+    return (replay == nullptr) ? 0 : replay->tracks.size();
+}
+
+/*******************************************************************************
+ * Evaluate the Aeronautical Statistical Model for samples of the tracks of
+ * a replay.
+ *
+ * Samples are evaluated in tiles of `P2108GetBatchTileSize` samples. The
+ * terms of each sample's track are gathered for the whole tile, then the
+ * loss of the tile is computed from the contiguous terms. Samples of tracks
+ * which are not set, or with an invalid elevation angle, get a NaN loss.
+ *
+ * @param[in]  replay      Replay
+ * @param[in]  n           Number of samples
+ * @param[in]  track       Track ID of each sample
+ * @param[in]  theta__deg  Elevation angle of each sample, in degrees
+ * @param[out] L_ces__db   Additional loss (clutter loss) of each sample, in dB
+ * @param[out] rtn         Return code of each sample (may be `NULL`): a
+ *                         `ReturnCode`, or `P2108_TRACK_ERROR_UNKNOWN`
+ * @return                 Number of invalid samples
+ ******************************************************************************/
+size_t P2108TrackReplayEvaluate(
+    const P2108TrackReplay *replay,
+    size_t n,
+    const uint64_t *track,
+    const double *theta__deg,
+    double *L_ces__db,
+    int *rtn
+) {
+    P2108_INSTRUMENT(P2108_STATS_TRACK_EVALUATE);
+    P2108_PROBE1(track_evaluate__entry, ProbeInt(n));
+    const std::size_t tile_n = std::min(n, P2108GetBatchTileSize());
+    TrackTile &tile = TrackTile::Get(tile_n);
+    int first = SUCCESS;
+    std::size_t failed = 0;
+    for (std::size_t start = 0; start < n; start += tile_n) {
+        const std::size_t m = std::min(tile_n, n - start);
+
+        // Gather the terms of each sample's track, and validate the angle
+        for (std::size_t t = 0, i = start; t < m; t++, i++) {
+            const auto found = replay->tracks.find(track[i]);
+            if (found == replay->tracks.end()) {
+                tile.code[t] = P2108_TRACK_ERROR_UNKNOWN;
+                continue;
+            }
+            const TrackTerms &terms = found->second;
+            tile.code[t] = Inline::Section3p3_InputValidation(
+                terms.f__ghz, theta__deg[i], terms.p
+            );
+            tile.scale[t] = terms.scale;
+            tile.Q_p[t] = terms.Q_p;
+        }
+
+        // Clutter loss
+        for (std::size_t t = 0, i = start; t < m; t++, i++) {
+            if (tile.code[t] == SUCCESS) {
+                L_ces__db[i] = Inline::Equation_7_Angle(
+                    tile.scale[t], theta__deg[i], tile.Q_p[t]
+                );
+            } else {
+                L_ces__db[i] = std::numeric_limits<double>::quiet_NaN();
+                if (failed++ == 0) {
+                    first = tile.code[t];
+                }
+            }
+            if (rtn != nullptr) {
+                rtn[i] = tile.code[t];
+            }
+        }
+    }
+    P2108_PROBE1(track_evaluate__return, ProbeInt(failed));
+    P2108_INSTRUMENT_CODE(first);
+    return failed;
+}
+
+/*******************************************************************************
+ * Compute the elevation angle of a target, such as an aircraft, seen from a
+ * ground station.
+ *
+ * Positions are WGS-84 geodetic coordinates, with heights above the
+ * ellipsoid. The angle is measured from the plane normal to the ellipsoid at
+ * the station, and is negative for targets below that plane.
+ *
+ * @param[in] station_lat__deg  Latitude of the station, in degrees
+ * @param[in] station_lon__deg  Longitude of the station, in degrees
+ * @param[in] station_h__meter  Height of the station, in meters
+ * @param[in] lat__deg          Latitude of the target, in degrees
+ * @param[in] lon__deg          Longitude of the target, in degrees
+ * @param[in] h__meter          Height of the target, in meters
+ * @return                      Elevation angle, in degrees, or NaN if the
+ *                              positions coincide
+ ******************************************************************************/
+double P2108ElevationAngle(
+    double station_lat__deg,
+    double station_lon__deg,
+    double station_h__meter,
+    double lat__deg,
+    double lon__deg,
+    double h__meter
+) {
+    constexpr double DEG_TO_RAD = PI / 180.0;
+    const double lat__rad = station_lat__deg * DEG_TO_RAD;
+    const double lon__rad = station_lon__deg * DEG_TO_RAD;
+    const ECEF station = GeodeticToECEF(lat__rad, lon__rad, station_h__meter);
+    const ECEF target = GeodeticToECEF(
+        lat__deg * DEG_TO_RAD, lon__deg * DEG_TO_RAD, h__meter
+    );
+
+    const double dx = target.x - station.x;
+    const double dy = target.y - station.y;
+    const double dz = target.z - station.z;
+    const double range__meter = std::sqrt(dx * dx + dy * dy + dz * dz);
+    if (range__meter == 0) {
+        return std::numeric_limits<double>::quiet_NaN();
+    }
+    // Component of the line of sight along the local vertical at the station
+    const double horizontal = std::cos(lon__rad) * dx + std::sin(lon__rad) * dy;
+    const double up__meter
+        = std::cos(lat__rad) * horizontal + std::sin(lat__rad) * dz;
+    const double sin_theta
+        = std::fmax(-1, std::fmin(1, up__meter / range__meter));
+    return std::asin(sin_theta) / DEG_TO_RAD;
+}
@@ -0,0 +1,286 @@
+/** @file TestBatch.cpp
+ * Tests for the strided batch interface to the models
+ */
+#include "P2108Batch.h"
+#include "TestUtils.h"
+
+#include <cmath>    // for std::isnan
+#include <cstddef>  // for std::size_t
+#include <random>   // for std::mt19937, std::uniform_real_distribution
+#include <vector>   // for std::vector
+
+namespace {
+/** A link record, as stored by an array-of-structures caller */
+struct Link {
+        double f__ghz;
+        int clutter_type;
+        double d__km;
+        double theta__deg;
+        double h__meter;
+        double w_s__meter;
+        double R__meter;
+        double p;
+        double loss__db;
+        int rtn;
+};
+
+/** Generate link records, some of which are invalid for each model */
+std::vector<Link> MakeLinks(const std::size_t n) {
+    std::mt19937 gen(2108);
+    std::uniform_real_distribution<double> f(0, 105), d(0, 20), theta(-5, 95),
+        h(-1, 30), w(0, 40), R(1, 25), p(-5, 105);
+    std::uniform_int_distribution<int> clutter(0, 7);
+    std::vector<Link> links(n);
+    for (Link &link : links) {
+        link.f__ghz = f(gen);
+        link.clutter_type = clutter(gen);
+        link.d__km = d(gen);
+        link.theta__deg = theta(gen);
+        link.h__meter = h(gen);
+        link.w_s__meter = w(gen);
+        link.R__meter = R(gen);
+        link.p = p(gen);
+        link.loss__db = -1;
+        link.rtn = -1;
+    }
+    return links;
+}
+
+/** Check a batch result against the scalar function */
+void ExpectResult(
+    const ReturnCode rtn,
+    const double expected,
+    const int actual_rtn,
+    const double actual
+) {
+    EXPECT_EQ(actual_rtn, rtn);
+    if (rtn == SUCCESS) {
+        EXPECT_EQ(actual, expected);
+    } else {
+        EXPECT_TRUE(std::isnan(actual));
+    }
+}
+
+constexpr std::ptrdiff_t STRIDE = sizeof(Link);
+}  // namespace
+
+TEST(BatchTest, TestArrayOfStructures) {
+    std::vector<Link> links = MakeLinks(2000);
+    const std::size_t n = links.size();
+    Link *l = links.data();
+
+    std::size_t failed = P2108TerrestrialStatisticalModelBatch(
+        n,
+        &l->f__ghz,
+        STRIDE,
+        &l->d__km,
+        STRIDE,
+        &l->p,
+        STRIDE,
+        ABRAMOWITZ_STEGUN,
+        &l->loss__db,
+        STRIDE,
+        &l->rtn,
+        STRIDE
+    );
+    std::size_t expected_failed = 0;
+    for (const Link &link : links) {
+        double L_ctt__db;
+        const ReturnCode rtn = TerrestrialStatisticalModel(
+            link.f__ghz, link.d__km, link.p, L_ctt__db
+        );
+        expected_failed += (rtn != SUCCESS);
+        ExpectResult(rtn, L_ctt__db, link.rtn, link.loss__db);
+    }
+    EXPECT_EQ(failed, expected_failed);
+
+    failed = P2108AeronauticalStatisticalModelBatch(
+        n,
+        &l->f__ghz,
+        STRIDE,
+        &l->theta__deg,
+        STRIDE,
+        &l->p,
+        STRIDE,
+        ABRAMOWITZ_STEGUN,
+        &l->loss__db,
+        STRIDE,
+        &l->rtn,
+        STRIDE
+    );
+    expected_failed = 0;
+    for (const Link &link : links) {
+        double L_ces__db;
+        const ReturnCode rtn = AeronauticalStatisticalModel(
+            link.f__ghz, link.theta__deg, link.p, L_ces__db
+        );
+        expected_failed += (rtn != SUCCESS);
+        ExpectResult(rtn, L_ces__db, link.rtn, link.loss__db);
+    }
+    EXPECT_EQ(failed, expected_failed);
+
+    // Scale frequencies into the HGTCM range
+    for (Link &link : links) {
+        link.f__ghz /= 30;
+    }
+    failed = P2108HeightGainTerminalCorrectionModelBatch(
+        n,
+        &l->f__ghz,
+        STRIDE,
+        &l->h__meter,
+        STRIDE,
+        &l->w_s__meter,
+        STRIDE,
+        &l->R__meter,
+        STRIDE,
+        &l->clutter_type,
+        STRIDE,
+        &l->loss__db,
+        STRIDE,
+        &l->rtn,
+        STRIDE
+    );
+    expected_failed = 0;
+    for (const Link &link : links) {
+        double A_h__db;
+        const ReturnCode rtn = HeightGainTerminalCorrectionModel(
+            link.f__ghz,
+            link.h__meter,
+            link.w_s__meter,
+            link.R__meter,
+            static_cast<ClutterType>(link.clutter_type),
+            A_h__db
+        );
+        expected_failed += (rtn != SUCCESS);
+        ExpectResult(rtn, A_h__db, link.rtn, link.loss__db);
+    }
+    EXPECT_EQ(failed, expected_failed);
+}
+
+TEST(BatchTest, TestContiguousMatchesStrided) {
+    const std::vector<Link> links = MakeLinks(500);
+    const std::size_t n = links.size();
+    std::vector<double> f__ghz(n), d__km(n), p(n), L_ctt__db(n);
+    std::vector<int> rtn(n);
+    for (std::size_t i = 0; i < n; i++) {
+        f__ghz[i] = links[i].f__ghz;
+        d__km[i] = links[i].d__km;
+        p[i] = links[i].p;
+    }
+    constexpr std::ptrdiff_t D = sizeof(double);
+    const std::size_t failed = P2108TerrestrialStatisticalModelBatch(
+        n,
+        f__ghz.data(),
+        D,
+        d__km.data(),
+        D,
+        p.data(),
+        D,
+        ABRAMOWITZ_STEGUN,
+        L_ctt__db.data(),
+        D,
+        rtn.data(),
+        sizeof(int)
+    );
+    std::size_t expected_failed = 0;
+    for (std::size_t i = 0; i < n; i++) {
+        double expected;
+        const ReturnCode code
+            = TerrestrialStatisticalModel(f__ghz[i], d__km[i], p[i], expected);
+        expected_failed += (code != SUCCESS);
+        ExpectResult(code, expected, rtn[i], L_ctt__db[i]);
+    }
+    EXPECT_EQ(failed, expected_failed);
+}
+
+TEST(BatchTest, TestBroadcastAndNoReturnCodes) {
+    // A stride of 0 broadcasts one frequency and percentage to every record
+    const double f__ghz = 26.6, p = 45;
+    const std::vector<double> d__km = {0.1, 1, 2, 5, 10};
+    std::vector<double> L_ctt__db(d__km.size());
+    const std::size_t failed = P2108TerrestrialStatisticalModelBatch(
+        d__km.size(),
+        &f__ghz,
+        0,
+        d__km.data(),
+        sizeof(double),
+        &p,
+        0,
+        ABRAMOWITZ_STEGUN,
+        L_ctt__db.data(),
+        sizeof(double),
+        nullptr,
+        0
+    );
+    EXPECT_EQ(failed, 1u);
+    EXPECT_TRUE(std::isnan(L_ctt__db[0]));
+    for (std::size_t i = 1; i < d__km.size(); i++) {
+        double expected;
+        TerrestrialStatisticalModel(f__ghz, d__km[i], p, expected);
+        EXPECT_EQ(L_ctt__db[i], expected);
+    }
+}
+
+TEST(BatchTest, TestEmpty) {
+    EXPECT_EQ(
+        P2108AeronauticalStatisticalModelBatch(
+            0,
+            nullptr,
+            0,
+            nullptr,
+            0,
+            nullptr,
+            0,
+            ABRAMOWITZ_STEGUN,
+            nullptr,
+            0,
+            nullptr,
+            0
+        ),
+        0u
+    );
+}
+
+TEST(BatchTest, TestTileSizes) {
+    std::vector<Link> links = MakeLinks(1000);
+    const std::size_t n = links.size();
+    Link *l = links.data();
+    std::vector<double> expected(n);
+    std::vector<int> expected_rtn(n);
+    for (std::size_t i = 0; i < n; i++) {
+        expected_rtn[i] = AeronauticalStatisticalModel(
+            links[i].f__ghz, links[i].theta__deg, links[i].p, expected[i]
+        );
+    }
+
+    // Results do not depend on the tile size, including partial tiles
+    EXPECT_EQ(P2108GetBatchTileSize(), P2108_DEFAULT_BATCH_TILE_SIZE);
+    for (const std::size_t tile : {1, 7, 64, 999, 100000}) {
+        P2108SetBatchTileSize(tile);
+        EXPECT_EQ(P2108GetBatchTileSize(), tile);
+        P2108AeronauticalStatisticalModelBatch(
+            n,
+            &l->f__ghz,
+            STRIDE,
+            &l->theta__deg,
+            STRIDE,
+            &l->p,
+            STRIDE,
+            ABRAMOWITZ_STEGUN,
+            &l->loss__db,
+            STRIDE,
+            &l->rtn,
+            STRIDE
+        );
+        for (std::size_t i = 0; i < n; i++) {
+            ExpectResult(
+                static_cast<ReturnCode>(expected_rtn[i]),
+                expected[i],
+                links[i].rtn,
+                links[i].loss__db
+            );
+        }
+    }
+    P2108SetBatchTileSize(0);
+    EXPECT_EQ(P2108GetBatchTileSize(), P2108_DEFAULT_BATCH_TILE_SIZE);
+}
@@ -0,0 +1,207 @@
+/** @file TestGeneric.cpp
+ * Tests for the generic kernels over each numeric type
+ */
+#include "P2108Generic.h"
+#include "P2108Jacobian.h"
+#include "P2108Kernels.h"
+#include "TestUtils.h"
+
+#include <cmath>    // for std::fabs, std::fmax
+#include <cstddef>  // for std::size_t
+
+namespace {
+/** Number of test records, and lanes of the packs */
+constexpr std::size_t N = 8;
+
+const double TSM_F__GHZ[N] = {0.6, 1, 2.5, 6, 10, 26, 60, 66};
+const double TSM_D__KM[N] = {0.3, 0.5, 1, 1.5, 2, 3, 10, 100};
+const double ASM_F__GHZ[N] = {11, 12, 20, 30, 45, 50, 80, 99};
+const double ASM_THETA__DEG[N] = {1, 5, 15, 30, 40, 45, 60, 85};
+const double P[N] = {1, 5, 20, 35, 45, 70, 90, 99};
+
+/** Expect two derivatives to agree to a relative tolerance */
+void ExpectClose(const double actual, const double expected) {
+    EXPECT_NEAR(actual, expected, 1e-10 * std::fmax(std::fabs(expected), 1));
+}
+
+/** Diffraction loss of Equation (2a), for heights below the clutter */
+template<typename T>
+T Diffraction(
+    const T &f__ghz, const T &h__meter, const T &w_s__meter, const T &R__meter
+) {
+    const T h_dif__meter = R__meter - h__meter;
+    const T theta_clut__deg = Generic::Equation_2e(h_dif__meter, w_s__meter);
+    return Generic::Equation_2a(Generic::Equation_2c(
+        Generic::Equation_2g(f__ghz), h_dif__meter, theta_clut__deg
+    ));
+}
+}  // namespace
+
+TEST(GenericTest, TestDoubleMatchesModels) {
+    for (std::size_t i = 0; i < N; i++) {
+        double L_ctt__db, L_ces__db;
+        TerrestrialStatisticalModel(
+            TSM_F__GHZ[i], TSM_D__KM[i], P[i], L_ctt__db
+        );
+        EXPECT_EQ(
+            Generic::TerrestrialStatisticalModel(
+                TSM_F__GHZ[i], TSM_D__KM[i], P[i]
+            ),
+            L_ctt__db
+        );
+        AeronauticalStatisticalModel(
+            ASM_F__GHZ[i], ASM_THETA__DEG[i], P[i], L_ces__db
+        );
+        EXPECT_EQ(
+            Generic::AeronauticalStatisticalModel(
+                ASM_F__GHZ[i], ASM_THETA__DEG[i], P[i]
+            ),
+            L_ces__db
+        );
+    }
+}
+
+TEST(GenericTest, TestFloatMatchesDouble) {
+    for (std::size_t i = 0; i < N; i++) {
+        const float L_ctt__db = Generic::TerrestrialStatisticalModel(
+            static_cast<float>(TSM_F__GHZ[i]),
+            static_cast<float>(TSM_D__KM[i]),
+            static_cast<float>(P[i])
+        );
+        EXPECT_NEAR(
+            L_ctt__db,
+            Generic::TerrestrialStatisticalModel(
+                TSM_F__GHZ[i], TSM_D__KM[i], P[i]
+            ),
+            1e-3
+        );
+        const float L_ces__db = Generic::AeronauticalStatisticalModel(
+            static_cast<float>(ASM_F__GHZ[i]),
+            static_cast<float>(ASM_THETA__DEG[i]),
+            static_cast<float>(P[i])
+        );
+        EXPECT_NEAR(
+            L_ces__db,
+            Generic::AeronauticalStatisticalModel(
+                ASM_F__GHZ[i], ASM_THETA__DEG[i], P[i]
+            ),
+            1e-3
+        );
+    }
+}
+
+TEST(GenericTest, TestPackMatchesScalar) {
+    typedef Pack<double, N> P8;
+    double L_ctt__db[N], L_ces__db[N], A_h__db[N], Q_p[N];
+    const P8 p = P8::Load(P);
+    const P8 tsm = Generic::TerrestrialStatisticalModel(
+        P8::Load(TSM_F__GHZ), P8::Load(TSM_D__KM), p
+    );
+    const P8 asm_ = Generic::AeronauticalStatisticalModel(
+        P8::Load(ASM_F__GHZ), P8::Load(ASM_THETA__DEG), p
+    );
+    const P8 diffraction
+        = Diffraction(P8(1), P8(0.5), P8::Load(TSM_D__KM), p);
+    const P8 iccd
+        = Generic::InverseComplementaryCumulativeDistribution(p / P8(100));
+    tsm.Store(L_ctt__db);
+    asm_.Store(L_ces__db);
+    diffraction.Store(A_h__db);
+    iccd.Store(Q_p);
+    for (std::size_t i = 0; i < N; i++) {
+        EXPECT_EQ(
+            L_ctt__db[i],
+            Generic::TerrestrialStatisticalModel(
+                TSM_F__GHZ[i], TSM_D__KM[i], P[i]
+            )
+        );
+        EXPECT_EQ(
+            L_ces__db[i],
+            Generic::AeronauticalStatisticalModel(
+                ASM_F__GHZ[i], ASM_THETA__DEG[i], P[i]
+            )
+        );
+        EXPECT_EQ(A_h__db[i], Diffraction(1.0, 0.5, TSM_D__KM[i], P[i]));
+        EXPECT_EQ(
+            Q_p[i], InverseComplementaryCumulativeDistribution(P[i] / 100)
+        );
+    }
+}
+
+TEST(GenericTest, TestDualMatchesTerrestrialJacobian) {
+    typedef Dual<double> D;
+    P2108TSMJacobian jacobian[N];
+    P2108TerrestrialStatisticalModelJacobian(
+        N, TSM_F__GHZ, TSM_D__KM, P, ABRAMOWITZ_STEGUN, jacobian, nullptr
+    );
+    for (std::size_t i = 0; i < N; i++) {
+        const double f = TSM_F__GHZ[i], d = TSM_D__KM[i], p = P[i];
+        const D by_f
+            = Generic::TerrestrialStatisticalModel(D(f, 1), D(d), D(p));
+        const D by_d
+            = Generic::TerrestrialStatisticalModel(D(f), D(d, 1), D(p));
+        const D by_p
+            = Generic::TerrestrialStatisticalModel(D(f), D(d), D(p, 1));
+        EXPECT_EQ(by_f.v, jacobian[i].L_ctt__db);
+        ExpectClose(by_f.d, jacobian[i].dL_ctt__df);
+        ExpectClose(by_d.d, jacobian[i].dL_ctt__dd);
+        ExpectClose(by_p.d, jacobian[i].dL_ctt__dp);
+    }
+}
+
+TEST(GenericTest, TestDualMatchesAeronauticalJacobian) {
+    typedef Dual<double> D;
+    P2108ASMJacobian jacobian[N];
+    P2108AeronauticalStatisticalModelJacobian(
+        N, ASM_F__GHZ, ASM_THETA__DEG, P, ABRAMOWITZ_STEGUN, jacobian, nullptr
+    );
+    for (std::size_t i = 0; i < N; i++) {
+        const double f = ASM_F__GHZ[i], theta = ASM_THETA__DEG[i], p = P[i];
+        const D by_f
+            = Generic::AeronauticalStatisticalModel(D(f, 1), D(theta), D(p));
+        const D by_theta
+            = Generic::AeronauticalStatisticalModel(D(f), D(theta, 1), D(p));
+        const D by_p
+            = Generic::AeronauticalStatisticalModel(D(f), D(theta), D(p, 1));
+        EXPECT_EQ(by_f.v, jacobian[i].L_ces__db);
+        ExpectClose(by_f.d, jacobian[i].dL_ces__df);
+        ExpectClose(by_theta.d, jacobian[i].dL_ces__dtheta);
+        ExpectClose(by_p.d, jacobian[i].dL_ces__dp);
+    }
+}
+
+TEST(GenericTest, TestDualMatchesHeightGainJacobian) {
+    typedef Dual<double> D;
+    const double f__ghz[N] = {0.4, 0.5, 1, 1.5, 2, 2.5, 2.9, 3};
+    const double h__meter[N] = {1.5, 3, 5, 2, 8, 10, 1, 14};
+    const double w_s__meter[N] = {27, 10, 20, 15, 30, 50, 5, 40};
+    const double R__meter[N] = {10, 15, 20, 10, 15, 25, 12, 15};
+    int clutter_type[N];
+    for (std::size_t i = 0; i < N; i++) {
+        clutter_type[i] = ClutterType::URBAN;
+    }
+    P2108HGTCMJacobian jacobian[N];
+    P2108HeightGainTerminalCorrectionModelJacobian(
+        N,
+        f__ghz,
+        h__meter,
+        w_s__meter,
+        R__meter,
+        clutter_type,
+        jacobian,
+        nullptr
+    );
+    for (std::size_t i = 0; i < N; i++) {
+        const double f = f__ghz[i], h = h__meter[i];
+        const double w_s = w_s__meter[i], R = R__meter[i];
+        const D by_f = Diffraction(D(f, 1), D(h), D(w_s), D(R));
+        const D by_h = Diffraction(D(f), D(h, 1), D(w_s), D(R));
+        const D by_w_s = Diffraction(D(f), D(h), D(w_s, 1), D(R));
+        const D by_R = Diffraction(D(f), D(h), D(w_s), D(R, 1));
+        EXPECT_EQ(by_f.v, jacobian[i].A_h__db);
+        ExpectClose(by_f.d, jacobian[i].dA_h__df);
+        ExpectClose(by_h.d, jacobian[i].dA_h__dh);
+        ExpectClose(by_w_s.d, jacobian[i].dA_h__dw_s);
+        ExpectClose(by_R.d, jacobian[i].dA_h__dR);
+    }
+}
@@ -0,0 +1,300 @@
+#include "TestUtils.h"
+
+#include "P2108Instrumentation.h"
+#include "P2108Jacobian.h"
+#include "P2108Link.h"
+#include "P2108Raster.h"
+#include "P2108Sampler.h"
+#include "P2108Surface.h"
+#include "P2108Tracks.h"
+
+#include <cstddef>  // for std::size_t
+#include <cstdint>  // for std::uint64_t, std::uint8_t
+#include <cstdio>   // for std::remove
+#include <cstring>  // for std::strcmp
+#include <string>   // for std::string
+#include <thread>   // for std::thread
+#include <vector>   // for std::vector
+
+/** Sum the buckets of a timing histogram */
+std::uint64_t SumHistogram(const P2108FunctionStats &stats) {
+    std::uint64_t sum = 0;
+    for (std::size_t i = 0; i < P2108_STATS_HIST_BUCKETS; i++) {
+        sum += stats.histogram[i];
+    }
+    return sum;
+}
+
+TEST(InstrumentationTest, TestCountsByReturnCode) {
+    P2108ResetStats();
+    double L_ces__db;
+    AeronauticalStatisticalModel(10, 10.5, 45, L_ces__db);
+    AeronauticalStatisticalModel(20, 10.5, 45, L_ces__db);
+    AeronauticalStatisticalModel(5, 10.5, 45, L_ces__db);
+
+    P2108Stats stats;
+    P2108GetStats(&stats);
+    const P2108FunctionStats &asm_stats = stats.functions[P2108_STATS_ASM];
+    if (!(stats.flags & P2108_STATS_ENABLED)) {
+        // Compiled out: all counters must be zero
+        EXPECT_EQ(asm_stats.calls, 0u);
+        EXPECT_EQ(asm_stats.codes[SUCCESS], 0u);
+        return;
+    }
+    EXPECT_EQ(asm_stats.calls, 3u);
+    EXPECT_EQ(asm_stats.codes[SUCCESS], 2u);
+    EXPECT_EQ(asm_stats.codes[ERROR33__FREQUENCY], 1u);
+    EXPECT_EQ(SumHistogram(asm_stats), 3u);
+    EXPECT_EQ(stats.functions[P2108_STATS_TSM].calls, 0u);
+
+    P2108ResetStats();
+    P2108GetStats(&stats);
+    EXPECT_EQ(stats.functions[P2108_STATS_ASM].calls, 0u);
+}
+
+TEST(InstrumentationTest, TestCountsAcrossThreads) {
+    P2108ResetStats();
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 4; t++) {
+        threads.emplace_back([] {
+            double L_ctt__db, A_h__db;
+            for (int i = 0; i < 1000; i++) {
+                TerrestrialStatisticalModel(26.6, 15.8, 45, L_ctt__db);
+                HeightGainTerminalCorrectionModel(
+                    1.5, 2, 27, 15, ClutterType::URBAN, A_h__db
+                );
+            }
+        });
+    }
+    for (std::thread &t : threads) {
+        t.join();
+    }
+
+    // Counters of threads which have exited are kept
+    P2108Stats stats;
+    P2108GetStats(&stats);
+    if (!(stats.flags & P2108_STATS_ENABLED)) {
+        GTEST_SKIP() << "Instrumentation is not compiled in";
+    }
+    const P2108FunctionStats &tsm_stats = stats.functions[P2108_STATS_TSM];
+    const P2108FunctionStats &hgtcm_stats = stats.functions[P2108_STATS_HGTCM];
+    EXPECT_EQ(tsm_stats.calls, 4000u);
+    EXPECT_EQ(tsm_stats.codes[SUCCESS], 4000u);
+    EXPECT_EQ(SumHistogram(tsm_stats), 4000u);
+    EXPECT_EQ(hgtcm_stats.calls, 4000u);
+    EXPECT_GT(hgtcm_stats.total__ns, 0u);
+}
+
+TEST(InstrumentationTest, TestCountsRasterCalls) {
+    P2108ResetStats();
+    const P2108RasterGeometry grid = {4, 4, -1.5, 1.5, 1, -1};
+    std::vector<float> raster(16);
+    P2108TerrestrialCoverage(
+        &grid, 0, 0, 26.6, 45, ABRAMOWITZ_STEGUN, raster.data(), 1
+    );
+    P2108TerrestrialCoverage(
+        &grid, 0, 0, 0.1, 45, ABRAMOWITZ_STEGUN, raster.data(), 1
+    );
+
+    P2108Stats stats;
+    P2108GetStats(&stats);
+    if (!(stats.flags & P2108_STATS_ENABLED)) {
+        GTEST_SKIP() << "Instrumentation is not compiled in";
+    }
+    const P2108FunctionStats &coverage
+        = stats.functions[P2108_STATS_TSM_COVERAGE];
+    EXPECT_EQ(coverage.calls, 2u);
+    EXPECT_EQ(coverage.codes[P2108_RASTER_SUCCESS], 1u);
+    EXPECT_EQ(coverage.codes[ERROR32__FREQUENCY], 1u);
+    EXPECT_EQ(stats.functions[P2108_STATS_TSM_COVERAGE_FILE].calls, 0u);
+
+    const std::vector<std::uint8_t> land_cover(16, 1);
+    int clutter_types[P2108_LAND_COVER_CODES] = {0};
+    clutter_types[1] = ClutterType::URBAN;
+    P2108HeightGainRaster(
+        &grid,
+        land_cover.data(),
+        clutter_types,
+        nullptr,
+        1.5,
+        2,
+        27,
+        raster.data(),
+        1
+    );
+    P2108GetStats(&stats);
+    const P2108FunctionStats &height_gain
+        = stats.functions[P2108_STATS_HGTCM_RASTER];
+    EXPECT_EQ(height_gain.calls, 1u);
+    EXPECT_EQ(height_gain.codes[P2108_RASTER_SUCCESS], 1u);
+}
+
+TEST(InstrumentationTest, TestCountsTrackReplayCalls) {
+    P2108ResetStats();
+    P2108TrackReplay *replay = P2108TrackReplayCreate();
+    P2108TrackReplaySetTrack(replay, 1, 10, 45, ABRAMOWITZ_STEGUN);
+    P2108TrackReplaySetTrack(replay, 2, 5, 45, ABRAMOWITZ_STEGUN);
+    const std::uint64_t track[3] = {1, 1, 2};
+    const double theta__deg[3] = {10.5, 20, 10.5};
+    double L_ces__db[3];
+    P2108TrackReplayEvaluate(replay, 3, track, theta__deg, L_ces__db, nullptr);
+    P2108TrackReplayFree(replay);
+
+    P2108Stats stats;
+    P2108GetStats(&stats);
+    if (!(stats.flags & P2108_STATS_ENABLED)) {
+        GTEST_SKIP() << "Instrumentation is not compiled in";
+    }
+    const P2108FunctionStats &set = stats.functions[P2108_STATS_TRACK_SET];
+    EXPECT_EQ(set.calls, 2u);
+    EXPECT_EQ(set.codes[SUCCESS], 1u);
+    EXPECT_EQ(set.codes[ERROR33__FREQUENCY], 1u);
+    const P2108FunctionStats &evaluate
+        = stats.functions[P2108_STATS_TRACK_EVALUATE];
+    EXPECT_EQ(evaluate.calls, 1u);
+    EXPECT_EQ(evaluate.codes[P2108_TRACK_ERROR_UNKNOWN], 1u);
+}
+
+TEST(InstrumentationTest, TestCountsSamplerCalls) {
+    P2108ResetStats();
+    double L__db[4];
+    P2108TerrestrialStatisticalModelSamples(10, 1, 1, 0, 0, 4, L__db);
+    P2108TerrestrialStatisticalModelSamples(0.1, 1, 1, 0, 0, 4, L__db);
+    P2108AeronauticalStatisticalModelSamples(10, 45, 1, 0, 0, 4, L__db);
+
+    P2108Stats stats;
+    P2108GetStats(&stats);
+    if (!(stats.flags & P2108_STATS_ENABLED)) {
+        GTEST_SKIP() << "Instrumentation is not compiled in";
+    }
+    const P2108FunctionStats &tsm = stats.functions[P2108_STATS_TSM_SAMPLES];
+    EXPECT_EQ(tsm.calls, 2u);
+    EXPECT_EQ(tsm.codes[SUCCESS], 1u);
+    EXPECT_EQ(tsm.codes[ERROR32__FREQUENCY], 1u);
+    const P2108FunctionStats &aero = stats.functions[P2108_STATS_ASM_SAMPLES];
+    EXPECT_EQ(aero.calls, 1u);
+    EXPECT_EQ(aero.codes[SUCCESS], 1u);
+}
+
+TEST(InstrumentationTest, TestCountsLinkBatchCalls) {
+    P2108ResetStats();
+    const P2108LinkTerminal terminal = {5, 27, 15, ClutterType::URBAN};
+    P2108Link links[3] = {
+        {1, 2, 50, terminal, terminal},
+        {5, 2, 50, terminal, terminal},
+        {1, 0.1, 50, terminal, terminal},
+    };
+    P2108LinkCorrection corrections[3];
+    P2108LinkClutterCorrectionBatch(
+        1, links, ABRAMOWITZ_STEGUN, corrections, nullptr
+    );
+    P2108LinkClutterCorrectionBatch(
+        3, links, ABRAMOWITZ_STEGUN, corrections, nullptr
+    );
+
+    P2108Stats stats;
+    P2108GetStats(&stats);
+    if (!(stats.flags & P2108_STATS_ENABLED)) {
+        GTEST_SKIP() << "Instrumentation is not compiled in";
+    }
+    const P2108FunctionStats &link = stats.functions[P2108_STATS_LINK_BATCH];
+    EXPECT_EQ(link.calls, 2u);
+    EXPECT_EQ(link.codes[SUCCESS], 1u);
+    EXPECT_EQ(link.codes[ERROR31__FREQUENCY], 1u);
+}
+
+TEST(InstrumentationTest, TestCountsJacobianCalls) {
+    P2108ResetStats();
+    const double f__ghz[2] = {10, 0.1};
+    const double theta__deg[2] = {45, 45};
+    const double d__km[2] = {1, 1};
+    const double p[2] = {50, 50};
+    P2108ASMJacobian asm_jacobian[2];
+    P2108TSMJacobian tsm_jacobian[2];
+    P2108AeronauticalStatisticalModelJacobian(
+        2, f__ghz, theta__deg, p, ABRAMOWITZ_STEGUN, asm_jacobian, nullptr
+    );
+    P2108TerrestrialStatisticalModelJacobian(
+        1, f__ghz, d__km, p, ABRAMOWITZ_STEGUN, tsm_jacobian, nullptr
+    );
+
+    P2108Stats stats;
+    P2108GetStats(&stats);
+    if (!(stats.flags & P2108_STATS_ENABLED)) {
+        GTEST_SKIP() << "Instrumentation is not compiled in";
+    }
+    const P2108FunctionStats &aero = stats.functions[P2108_STATS_ASM_JACOBIAN];
+    EXPECT_EQ(aero.calls, 1u);
+    EXPECT_EQ(aero.codes[ERROR33__FREQUENCY], 1u);
+    const P2108FunctionStats &tsm = stats.functions[P2108_STATS_TSM_JACOBIAN];
+    EXPECT_EQ(tsm.calls, 1u);
+    EXPECT_EQ(tsm.codes[SUCCESS], 1u);
+}
+
+TEST(InstrumentationTest, TestCountsSurfaceCalls) {
+    const std::string path = GetTempFilePath(".p2108");
+    P2108SurfaceSpec spec;
+    P2108SurfaceDefaultSpec(8, &spec);
+    ASSERT_EQ(P2108SurfaceWrite(path.c_str(), &spec), P2108_SURFACE_SUCCESS);
+    P2108Surface *surface = nullptr;
+    ASSERT_EQ(P2108SurfaceOpen(path.c_str(), &surface), P2108_SURFACE_SUCCESS);
+    P2108ResetStats();
+    const double f__ghz[2] = {10, 0.1};
+    const double d__km[2] = {1, 1};
+    const double p[2] = {50, 50};
+    double L_ctt__db[2];
+    P2108SurfaceTerrestrialStatisticalModel(
+        surface, 1, f__ghz, d__km, p, ABRAMOWITZ_STEGUN, L_ctt__db, nullptr
+    );
+    P2108SurfaceTerrestrialStatisticalModel(
+        surface, 2, f__ghz, d__km, p, ABRAMOWITZ_STEGUN, L_ctt__db, nullptr
+    );
+    P2108SurfaceClose(surface);
+    std::remove(path.c_str());
+
+    P2108Stats stats;
+    P2108GetStats(&stats);
+    if (!(stats.flags & P2108_STATS_ENABLED)) {
+        GTEST_SKIP() << "Instrumentation is not compiled in";
+    }
+    const P2108FunctionStats &tsm = stats.functions[P2108_STATS_TSM_SURFACE];
+    EXPECT_EQ(tsm.calls, 2u);
+    EXPECT_EQ(tsm.codes[SUCCESS], 1u);
+    EXPECT_EQ(tsm.codes[ERROR32__FREQUENCY], 1u);
+}
+
+TEST(InstrumentationTest, TestFunctionNames) {
+    EXPECT_STREQ(
+        P2108GetStatsFunctionName(P2108_STATS_ASM),
+        "AeronauticalStatisticalModel"
+    );
+    EXPECT_STREQ(
+        P2108GetStatsFunctionName(P2108_STATS_TSM_COVERAGE_FILE),
+        "P2108TerrestrialCoverageFile"
+    );
+    EXPECT_STREQ(
+        P2108GetStatsFunctionName(P2108_STATS_HGTCM_RASTER_FILE),
+        "P2108HeightGainRasterFile"
+    );
+    EXPECT_STREQ(
+        P2108GetStatsFunctionName(P2108_STATS_TRACK_EVALUATE),
+        "P2108TrackReplayEvaluate"
+    );
+    EXPECT_STREQ(
+        P2108GetStatsFunctionName(P2108_STATS_ASM_SAMPLES),
+        "P2108AeronauticalStatisticalModelSamples"
+    );
+    EXPECT_STREQ(
+        P2108GetStatsFunctionName(P2108_STATS_LINK_BATCH),
+        "P2108LinkClutterCorrectionBatch"
+    );
+    EXPECT_STREQ(
+        P2108GetStatsFunctionName(P2108_STATS_HGTCM_JACOBIAN),
+        "P2108HeightGainTerminalCorrectionModelJacobian"
+    );
+    EXPECT_STREQ(
+        P2108GetStatsFunctionName(P2108_STATS_HGTCM_SURFACE),
+        "P2108SurfaceHeightGainTerminalCorrectionModel"
+    );
+    EXPECT_STREQ(P2108GetStatsFunctionName(P2108_STATS_N_FUNCTIONS), "");
+}
@@ -1,5 +1,8 @@
+#include "P2108Batch.h"
+#include "P2108Kernels.h"
 #include "TestUtils.h"
 
+#include <cmath>          // for std::erfc, std::fabs, std::fmax, std::pow, ...
 #include <gtest/gtest.h>  // GoogleTest
 #include <stdexcept>      // for std::out_of_range
 
@@ -31,4 +34,145 @@ TEST(InverseCCDFTest, TestInverseCCDFInputInvalid) {
     EXPECT_THROW(
         InverseComplementaryCumulativeDistribution(1.1), std::out_of_range
     );
-}
\ No newline at end of file
+}
+TEST(InverseCCDFTest, TestAS241KnownValues) {
+    const double q[4] = {0.5, 0.1, 0.025, 1e-10};
+    const double expected[4] = {
+        0, 1.2815515655446004, 1.9599639845400540, 6.3613409024040557
+    };
+    for (int i = 0; i < 4; i++) {
+        EXPECT_NEAR(
+            InverseComplementaryCumulativeDistribution(q[i], WICHURA_AS241),
+            expected[i],
+            1e-15 * (1 + expected[i])
+        );
+        if (q[i] < 1e-3) {
+            continue;  // 1 - q rounds away too much of q to mirror the value
+        }
+        EXPECT_NEAR(
+            InverseComplementaryCumulativeDistribution(
+                1 - q[i], WICHURA_AS241
+            ),
+            -expected[i],
+            1e-15 * (1 + expected[i])
+        );
+    }
+}
+
+TEST(InverseCCDFTest, TestAlgorithmErrors) {
+    // Compare each algorithm to AS241 over both tails and the center
+    double max_as = 0, max_ppnd7 = 0, max_roundtrip = 0;
+    for (double log_q = -300; log_q < -0.302; log_q += 0.01) {
+        const double tail = std::pow(10, log_q);
+        for (const double q : {tail, 1 - tail}) {
+            if (q >= 1) {
+                continue;
+            }
+            const double exact = InverseComplementaryCumulativeDistribution(
+                q, WICHURA_AS241
+            );
+            const double upper = 0.5 * std::erfc(exact / std::sqrt(2.0));
+            max_roundtrip
+                = std::fmax(max_roundtrip, std::fabs(upper - q) / q);
+            max_ppnd7 = std::fmax(
+                max_ppnd7,
+                std::fabs(
+                    InverseComplementaryCumulativeDistribution(
+                        q, WICHURA_PPND7
+                    )
+                    - exact
+                ) / std::fmax(std::fabs(exact), 1)
+            );
+            if (tail > 1e-10) {
+                max_as = std::fmax(
+                    max_as,
+                    std::fabs(
+                        InverseComplementaryCumulativeDistribution(
+                            q, ABRAMOWITZ_STEGUN
+                        )
+                        - exact
+                    )
+                );
+            }
+        }
+    }
+    // An error in z changes Q(z) by about z^2 times as much, relatively
+    EXPECT_LT(max_roundtrip, 1e-12);
+    EXPECT_LT(max_ppnd7, 5e-7);
+    EXPECT_LT(max_as, 4.5e-4);
+}
+
+TEST(InverseCCDFTest, TestAlgorithmDerivatives) {
+    for (const double q : {0.001, 0.05, 0.3, 0.5, 0.7, 0.95, 0.999}) {
+        const double h = 1e-7;
+        const double numeric
+            = (Inline::InverseComplementaryCumulativeDistributionAS241(q + h)
+               - Inline::InverseComplementaryCumulativeDistributionAS241(q - h))
+            / (2 * h);
+        EXPECT_NEAR(
+            Inline::InverseComplementaryCumulativeDistributionDerivative(
+                q, WICHURA_AS241
+            ),
+            numeric,
+            1e-6 * std::fabs(numeric)
+        );
+    }
+}
+
+TEST(InverseCCDFTest, TestAlgorithmSelection) {
+    const double f__ghz = 26.6, d__km = 15.8, p = 45;
+    const auto batch = [&](const int algorithm) {
+        double L_ctt__db;
+        P2108TerrestrialStatisticalModelBatch(
+            1,
+            &f__ghz,
+            0,
+            &d__km,
+            0,
+            &p,
+            0,
+            algorithm,
+            &L_ctt__db,
+            0,
+            nullptr,
+            0
+        );
+        return L_ctt__db;
+    };
+    double L_default__db;
+    TerrestrialStatisticalModel(f__ghz, d__km, p, L_default__db);
+    EXPECT_EQ(batch(ABRAMOWITZ_STEGUN), L_default__db);
+    const double L_ppnd7__db = batch(WICHURA_PPND7);
+    const double L_as241__db = batch(WICHURA_AS241);
+    EXPECT_NE(L_as241__db, L_default__db);
+    EXPECT_NEAR(L_as241__db, L_default__db, 0.01);
+    EXPECT_NEAR(L_as241__db, L_ppnd7__db, 1e-5);
+
+    // A call with another algorithm does not change the scalar models
+    double L_ctt__db;
+    TerrestrialStatisticalModel(f__ghz, d__km, p, L_ctt__db);
+    EXPECT_EQ(L_ctt__db, L_default__db);
+    EXPECT_EQ(
+        InverseComplementaryCumulativeDistribution(0.45),
+        Inline::InverseComplementaryCumulativeDistribution(0.45)
+    );
+
+    // Unknown algorithms select the default
+    EXPECT_EQ(Inline::ToInverseCCDFAlgorithm(7), ABRAMOWITZ_STEGUN);
+    EXPECT_EQ(Inline::ToInverseCCDFAlgorithm(-1), ABRAMOWITZ_STEGUN);
+    EXPECT_EQ(Inline::ToInverseCCDFAlgorithm(WICHURA_PPND7), WICHURA_PPND7);
+    EXPECT_EQ(batch(7), L_default__db);
+}
+
+TEST(InverseCCDFTest, TestAlgorithmInputInvalid) {
+    for (const double q : {-1.0, 0.0, 1.0, 1.1}) {
+        EXPECT_THROW(
+            InverseComplementaryCumulativeDistribution(q, WICHURA_PPND7),
+            std::out_of_range
+        );
+        EXPECT_THROW(
+            InverseComplementaryCumulativeDistribution(q, WICHURA_AS241),
+            std::out_of_range
+        );
+    }
+}
@@ -0,0 +1,274 @@
+/** @file TestJacobian.cpp
+ * Tests for the batch Jacobian APIs
+ */
+#include "P2108Jacobian.h"
+#include "P2108Kernels.h"
+#include "TestUtils.h"
+
+#include <cmath>    // for std::fabs, std::fmax, std::isnan
+#include <cstddef>  // for std::size_t
+#include <vector>   // for std::vector
+
+namespace {
+/** Relative step of the central finite differences */
+constexpr double STEP = 1e-6;
+
+/** Relative tolerance of the analytic derivatives */
+constexpr double TOLERANCE = 1e-5;
+
+/** Expect an analytic derivative to match a central finite difference */
+template<typename Model>
+void ExpectDerivative(
+    const double analytic, const double x, const Model &model
+) {
+    const double h = STEP * std::fmax(std::fabs(x), 1);
+    const double numeric = (model(x + h) - model(x - h)) / (2 * h);
+    EXPECT_NEAR(
+        analytic, numeric, TOLERANCE * std::fmax(std::fabs(numeric), 1)
+    ) << "at " << x;
+}
+}  // namespace
+
+TEST(JacobianTest, TestInverseCCDFDerivative) {
+    for (const double q : {0.001, 0.02, 0.1, 0.3, 0.45, 0.55, 0.8, 0.99}) {
+        ExpectDerivative(
+            Inline::InverseComplementaryCumulativeDistributionDerivative(q),
+            q,
+            [](const double x) {
+                return Inline::InverseComplementaryCumulativeDistribution(x);
+            }
+        );
+    }
+}
+
+TEST(JacobianTest, TestTerrestrialStatisticalModel) {
+    const std::vector<double> f__ghz = {2.5, 3, 6, 10, 26, 60, 66};
+    const std::vector<double> d__km = {0.3, 0.5, 1, 1.5, 3, 10, 100};
+    const std::vector<double> p = {1, 5, 20, 35, 70, 90, 99};
+    const std::size_t n = f__ghz.size();
+    std::vector<P2108TSMJacobian> jacobian(n);
+    std::vector<int> rtn(n);
+    EXPECT_EQ(
+        P2108TerrestrialStatisticalModelJacobian(
+            n,
+            f__ghz.data(),
+            d__km.data(),
+            p.data(),
+            ABRAMOWITZ_STEGUN,
+            jacobian.data(),
+            rtn.data()
+        ),
+        0u
+    );
+    for (std::size_t i = 0; i < n; i++) {
+        const auto model = [&](const double f, const double d, const double q) {
+            double L_ctt__db;
+            TerrestrialStatisticalModel(f, d, q, L_ctt__db);
+            return L_ctt__db;
+        };
+        EXPECT_EQ(rtn[i], SUCCESS);
+        EXPECT_EQ(jacobian[i].L_ctt__db, model(f__ghz[i], d__km[i], p[i]));
+        ExpectDerivative(jacobian[i].dL_ctt__df, f__ghz[i], [&](double x) {
+            return model(x, d__km[i], p[i]);
+        });
+        ExpectDerivative(jacobian[i].dL_ctt__dd, d__km[i], [&](double x) {
+            return model(f__ghz[i], x, p[i]);
+        });
+        ExpectDerivative(jacobian[i].dL_ctt__dp, p[i], [&](double x) {
+            return model(f__ghz[i], d__km[i], x);
+        });
+    }
+}
+
+TEST(JacobianTest, TestTerrestrialStatisticalModelBranches) {
+    const double f__ghz[3] = {3, 3, 3};
+    const double d__km[3] = {1, 2, 5};
+    const double p[3] = {50, 50, 50};
+    P2108TSMJacobian jacobian[3];
+    P2108TerrestrialStatisticalModelJacobian(
+        3, f__ghz, d__km, p, ABRAMOWITZ_STEGUN, jacobian, nullptr
+    );
+
+    // Below 2 km, the loss grows with distance; at and beyond it, the
+    // 2 km loss applies
+    EXPECT_GT(jacobian[0].dL_ctt__dd, 0);
+    EXPECT_EQ(jacobian[1].dL_ctt__dd, 0);
+    EXPECT_EQ(jacobian[2].dL_ctt__dd, 0);
+    EXPECT_EQ(jacobian[1].L_ctt__db, jacobian[2].L_ctt__db);
+    EXPECT_EQ(jacobian[1].dL_ctt__df, jacobian[2].dL_ctt__df);
+}
+
+TEST(JacobianTest, TestAeronauticalStatisticalModel) {
+    const std::vector<double> f__ghz = {11, 12, 20, 30, 50, 80, 99};
+    const std::vector<double> theta__deg = {1, 5, 15, 30, 45, 60, 85};
+    const std::vector<double> p = {1, 5, 20, 35, 70, 90, 99};
+    const std::size_t n = f__ghz.size();
+    std::vector<P2108ASMJacobian> jacobian(n);
+    std::vector<int> rtn(n);
+    EXPECT_EQ(
+        P2108AeronauticalStatisticalModelJacobian(
+            n,
+            f__ghz.data(),
+            theta__deg.data(),
+            p.data(),
+            ABRAMOWITZ_STEGUN,
+            jacobian.data(),
+            rtn.data()
+        ),
+        0u
+    );
+    for (std::size_t i = 0; i < n; i++) {
+        const auto model = [&](const double f, const double t, const double q) {
+            double L_ces__db;
+            AeronauticalStatisticalModel(f, t, q, L_ces__db);
+            return L_ces__db;
+        };
+        EXPECT_EQ(rtn[i], SUCCESS);
+        EXPECT_EQ(jacobian[i].L_ces__db, model(f__ghz[i], theta__deg[i], p[i]));
+        ExpectDerivative(jacobian[i].dL_ces__df, f__ghz[i], [&](double x) {
+            return model(x, theta__deg[i], p[i]);
+        });
+        ExpectDerivative(
+            jacobian[i].dL_ces__dtheta,
+            theta__deg[i],
+            [&](double x) { return model(f__ghz[i], x, p[i]); }
+        );
+        ExpectDerivative(jacobian[i].dL_ces__dp, p[i], [&](double x) {
+            return model(f__ghz[i], theta__deg[i], x);
+        });
+    }
+}
+
+TEST(JacobianTest, TestHeightGainTerminalCorrectionModel) {
+    const std::vector<double> f__ghz = {0.4, 0.5, 1, 2.9, 1.5, 2};
+    const std::vector<double> h__meter = {1.5, 3, 5, 10, 2, 8};
+    const std::vector<double> w_s__meter = {27, 10, 20, 50, 15, 30};
+    const std::vector<double> R__meter = {10, 15, 20, 25, 10, 15};
+    const std::vector<int> clutter_type = {
+        ClutterType::OPEN_RURAL,
+        ClutterType::SUBURBAN,
+        ClutterType::URBAN,
+        ClutterType::DENSE_URBAN,
+        ClutterType::WATER_SEA,
+        ClutterType::TREES_FOREST
+    };
+    const std::size_t n = f__ghz.size();
+    std::vector<P2108HGTCMJacobian> jacobian(n);
+    std::vector<int> rtn(n);
+    EXPECT_EQ(
+        P2108HeightGainTerminalCorrectionModelJacobian(
+            n,
+            f__ghz.data(),
+            h__meter.data(),
+            w_s__meter.data(),
+            R__meter.data(),
+            clutter_type.data(),
+            jacobian.data(),
+            rtn.data()
+        ),
+        0u
+    );
+    for (std::size_t i = 0; i < n; i++) {
+        const ClutterType type = static_cast<ClutterType>(clutter_type[i]);
+        const auto model = [&](
+                               const double f,
+                               const double h,
+                               const double w_s,
+                               const double R
+                           ) {
+            double A_h__db;
+            HeightGainTerminalCorrectionModel(f, h, w_s, R, type, A_h__db);
+            return A_h__db;
+        };
+        const double f = f__ghz[i], h = h__meter[i];
+        const double w_s = w_s__meter[i], R = R__meter[i];
+        EXPECT_EQ(rtn[i], SUCCESS);
+        EXPECT_EQ(jacobian[i].A_h__db, model(f, h, w_s, R));
+        ExpectDerivative(jacobian[i].dA_h__df, f, [&](double x) {
+            return model(x, h, w_s, R);
+        });
+        ExpectDerivative(jacobian[i].dA_h__dh, h, [&](double x) {
+            return model(f, x, w_s, R);
+        });
+        ExpectDerivative(jacobian[i].dA_h__dw_s, w_s, [&](double x) {
+            return model(f, h, x, R);
+        });
+        ExpectDerivative(jacobian[i].dA_h__dR, R, [&](double x) {
+            return model(f, h, w_s, x);
+        });
+    }
+}
+
+TEST(JacobianTest, TestHeightGainTerminalCorrectionModelAboveClutter) {
+    const double f__ghz = 1, h__meter = 20, w_s__meter = 27, R__meter = 15;
+    const int clutter_type = ClutterType::URBAN;
+    P2108HGTCMJacobian jacobian;
+    int rtn;
+    P2108HeightGainTerminalCorrectionModelJacobian(
+        1,
+        &f__ghz,
+        &h__meter,
+        &w_s__meter,
+        &R__meter,
+        &clutter_type,
+        &jacobian,
+        &rtn
+    );
+    EXPECT_EQ(rtn, SUCCESS);
+    EXPECT_EQ(jacobian.A_h__db, 0);
+    EXPECT_EQ(jacobian.dA_h__df, 0);
+    EXPECT_EQ(jacobian.dA_h__dh, 0);
+    EXPECT_EQ(jacobian.dA_h__dw_s, 0);
+    EXPECT_EQ(jacobian.dA_h__dR, 0);
+}
+
+TEST(JacobianTest, TestInvalidRecords) {
+    const double f__ghz[3] = {3, 3, 100};
+    const double d__km[3] = {1, 0.1, 1};
+    const double p[3] = {50, 50, 50};
+    P2108TSMJacobian tsm[3];
+    int rtn[3];
+    EXPECT_EQ(
+        P2108TerrestrialStatisticalModelJacobian(
+            3, f__ghz, d__km, p, ABRAMOWITZ_STEGUN, tsm, rtn
+        ),
+        2u
+    );
+    EXPECT_EQ(rtn[0], SUCCESS);
+    EXPECT_EQ(rtn[1], ERROR32__DISTANCE);
+    EXPECT_EQ(rtn[2], ERROR32__FREQUENCY);
+    EXPECT_FALSE(std::isnan(tsm[0].L_ctt__db));
+    EXPECT_TRUE(std::isnan(tsm[1].L_ctt__db));
+    EXPECT_TRUE(std::isnan(tsm[2].dL_ctt__dp));
+
+    const double theta__deg[2] = {30, 95};
+    const double asm_f__ghz[2] = {30, 30};
+    P2108ASMJacobian asm_jacobian[2];
+    EXPECT_EQ(
+        P2108AeronauticalStatisticalModelJacobian(
+            2, asm_f__ghz, theta__deg, p, ABRAMOWITZ_STEGUN, asm_jacobian, rtn
+        ),
+        1u
+    );
+    EXPECT_EQ(rtn[1], ERROR33__THETA);
+    EXPECT_TRUE(std::isnan(asm_jacobian[1].dL_ces__dtheta));
+
+    const double h__meter = 1.5, w_s__meter = 27, R__meter = 10;
+    const int clutter_type = 7;
+    P2108HGTCMJacobian hgtcm;
+    EXPECT_EQ(
+        P2108HeightGainTerminalCorrectionModelJacobian(
+            1,
+            f__ghz,
+            &h__meter,
+            &w_s__meter,
+            &R__meter,
+            &clutter_type,
+            &hgtcm,
+            rtn
+        ),
+        1u
+    );
+    EXPECT_EQ(rtn[0], ERROR31__CLUTTER_TYPE);
+    EXPECT_TRUE(std::isnan(hgtcm.A_h__db));
+}
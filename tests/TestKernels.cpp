@@ -0,0 +1,68 @@
+/** @file TestKernels.cpp
+ * Tests that the header-only kernels match the exported library functions
+ */
+#include "P2108Kernels.h"
+#include "TestUtils.h"
+
+#include <random>  // for std::mt19937, std::uniform_real_distribution
+
+namespace {
+/** Number of random inputs compared for each model */
+constexpr int N_SAMPLES = 10000;
+}  // namespace
+
+TEST(KernelsTest, TestAeronauticalStatisticalModel) {
+    std::mt19937 gen(2108);
+    std::uniform_real_distribution<double> f(5, 105), theta(-5, 95), p(-5, 105);
+    for (int i = 0; i < N_SAMPLES; i++) {
+        const double f__ghz = f(gen), theta__deg = theta(gen), p_ = p(gen);
+        double expected = -1, actual = -1;
+        const ReturnCode rtn
+            = AeronauticalStatisticalModel(f__ghz, theta__deg, p_, expected);
+        EXPECT_EQ(
+            Inline::AeronauticalStatisticalModel(
+                f__ghz, theta__deg, p_, actual
+            ),
+            rtn
+        );
+        EXPECT_EQ(actual, expected);
+    }
+}
+
+TEST(KernelsTest, TestTerrestrialStatisticalModel) {
+    std::mt19937 gen(2108);
+    std::uniform_real_distribution<double> f(0, 70), d(0, 50), p(-5, 105);
+    for (int i = 0; i < N_SAMPLES; i++) {
+        const double f__ghz = f(gen), d__km = d(gen), p_ = p(gen);
+        double expected = -1, actual = -1;
+        const ReturnCode rtn
+            = TerrestrialStatisticalModel(f__ghz, d__km, p_, expected);
+        EXPECT_EQ(
+            Inline::TerrestrialStatisticalModel(f__ghz, d__km, p_, actual), rtn
+        );
+        EXPECT_EQ(actual, expected);
+    }
+}
+
+TEST(KernelsTest, TestHeightGainTerminalCorrectionModel) {
+    std::mt19937 gen(2108);
+    std::uniform_real_distribution<double> f(0, 3.5), h(-1, 30), w(-1, 50),
+        R(-1, 30);
+    std::uniform_int_distribution<int> clutter(0, 7);
+    for (int i = 0; i < N_SAMPLES; i++) {
+        const double f__ghz = f(gen), h__m = h(gen), w__m = w(gen),
+                     R__m = R(gen);
+        const ClutterType type = static_cast<ClutterType>(clutter(gen));
+        double expected = -1, actual = -1;
+        const ReturnCode rtn = HeightGainTerminalCorrectionModel(
+            f__ghz, h__m, w__m, R__m, type, expected
+        );
+        EXPECT_EQ(
+            Inline::HeightGainTerminalCorrectionModel(
+                f__ghz, h__m, w__m, R__m, type, actual
+            ),
+            rtn
+        );
+        EXPECT_EQ(actual, expected);
+    }
+}
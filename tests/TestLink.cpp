@@ -0,0 +1,154 @@
+/** @file TestLink.cpp
+ * Tests for the end-to-end clutter correction of terrestrial links
+ */
+#include "P2108Batch.h"
+#include "P2108Link.h"
+#include "TestUtils.h"
+
+#include <cmath>    // for std::isnan
+#include <cstddef>  // for std::size_t
+#include <vector>   // for std::vector
+
+namespace {
+/** Make a link from its inputs */
+P2108Link MakeLink(
+    const double f__ghz,
+    const double d__km,
+    const double p,
+    const P2108LinkTerminal &tx,
+    const P2108LinkTerminal &rx
+) {
+    P2108Link link;
+    link.f__ghz = f__ghz;
+    link.d__km = d__km;
+    link.p = p;
+    link.tx = tx;
+    link.rx = rx;
+    return link;
+}
+}  // namespace
+
+TEST(LinkTest, TestComponentsMatchModels) {
+    // Links spanning several tiles, with terminals in and above the clutter
+    const std::size_t n = 2 * P2108GetBatchTileSize() + 11;
+    std::vector<P2108Link> links(n);
+    for (std::size_t i = 0; i < n; i++) {
+        const P2108LinkTerminal tx
+            = {1.5 + (i % 30), 27, 20, static_cast<int>(1 + i % 6)};
+        const P2108LinkTerminal rx
+            = {1.0 + (i % 17), 10.0 + (i % 5), 15, static_cast<int>(1 + i % 5)};
+        const double f__ghz = 0.5 + (i % 25) * 0.1;
+        links[i] = MakeLink(f__ghz, 0.25 + i * 0.01, 1 + i % 98, tx, rx);
+    }
+    std::vector<P2108LinkCorrection> corrections(n);
+    std::vector<int> rtn(n);
+    EXPECT_EQ(
+        P2108LinkClutterCorrectionBatch(
+            n, links.data(), ABRAMOWITZ_STEGUN, corrections.data(), rtn.data()
+        ),
+        0u
+    );
+
+    std::size_t n_in_clutter = 0;
+    for (std::size_t i = 0; i < n; i++) {
+        const P2108Link &link = links[i];
+        double A_h_tx__db, A_h_rx__db, L_ctt__db = 0;
+        ASSERT_EQ(
+            HeightGainTerminalCorrectionModel(
+                link.f__ghz,
+                link.tx.h__meter,
+                link.tx.w_s__meter,
+                link.tx.R__meter,
+                static_cast<ClutterType>(link.tx.clutter_type),
+                A_h_tx__db
+            ),
+            SUCCESS
+        );
+        ASSERT_EQ(
+            HeightGainTerminalCorrectionModel(
+                link.f__ghz,
+                link.rx.h__meter,
+                link.rx.w_s__meter,
+                link.rx.R__meter,
+                static_cast<ClutterType>(link.rx.clutter_type),
+                A_h_rx__db
+            ),
+            SUCCESS
+        );
+        if (link.tx.h__meter < link.tx.R__meter
+            && link.rx.h__meter < link.rx.R__meter) {
+            ASSERT_EQ(
+                TerrestrialStatisticalModel(
+                    link.f__ghz, link.d__km, link.p, L_ctt__db
+                ),
+                SUCCESS
+            );
+            n_in_clutter++;
+        }
+        EXPECT_EQ(rtn[i], SUCCESS);
+        EXPECT_EQ(corrections[i].A_h_tx__db, A_h_tx__db);
+        EXPECT_EQ(corrections[i].A_h_rx__db, A_h_rx__db);
+        EXPECT_EQ(corrections[i].L_ctt__db, L_ctt__db);
+        EXPECT_EQ(
+            corrections[i].total__db, A_h_tx__db + A_h_rx__db + L_ctt__db
+        );
+    }
+    EXPECT_GT(n_in_clutter, 0u);
+    EXPECT_LT(n_in_clutter, n);
+}
+
+TEST(LinkTest, TestInvalidLinks) {
+    const P2108LinkTerminal in_clutter = {5, 27, 15, ClutterType::URBAN};
+    const P2108LinkTerminal above_clutter = {30, 27, 15, ClutterType::URBAN};
+    const P2108LinkTerminal bad_height = {-1, 27, 15, ClutterType::URBAN};
+    const P2108LinkTerminal bad_type = {5, 27, 15, 7};
+    const std::vector<P2108Link> links = {
+        MakeLink(1, 2, 50, in_clutter, in_clutter),
+        MakeLink(5, 2, 50, in_clutter, in_clutter),
+        MakeLink(1, 2, 50, bad_height, in_clutter),
+        MakeLink(1, 2, 50, in_clutter, bad_type),
+        MakeLink(1, 0.1, 50, in_clutter, in_clutter),
+        MakeLink(0.1, 2, 50, in_clutter, in_clutter),
+        // Statistical model inputs are not used above the clutter
+        MakeLink(0.1, 0.1, 100, above_clutter, in_clutter),
+    };
+    const std::vector<int> expected = {
+        SUCCESS,
+        ERROR31__FREQUENCY,
+        ERROR31__ANTENNA_HEIGHT,
+        ERROR31__CLUTTER_TYPE,
+        ERROR32__DISTANCE,
+        ERROR32__FREQUENCY,
+        SUCCESS,
+    };
+    std::vector<P2108LinkCorrection> corrections(links.size());
+    std::vector<int> rtn(links.size());
+    EXPECT_EQ(
+        P2108LinkClutterCorrectionBatch(
+            links.size(),
+            links.data(),
+            ABRAMOWITZ_STEGUN,
+            corrections.data(),
+            rtn.data()
+        ),
+        5u
+    );
+    for (std::size_t i = 0; i < links.size(); i++) {
+        EXPECT_EQ(rtn[i], expected[i]) << "link " << i;
+        EXPECT_EQ(std::isnan(corrections[i].total__db), rtn[i] != SUCCESS);
+    }
+    EXPECT_EQ(corrections.back().A_h_tx__db, 0);
+    EXPECT_EQ(corrections.back().L_ctt__db, 0);
+
+    // The return codes are optional
+    EXPECT_EQ(
+        P2108LinkClutterCorrectionBatch(
+            links.size(),
+            links.data(),
+            ABRAMOWITZ_STEGUN,
+            corrections.data(),
+            nullptr
+        ),
+        5u
+    );
+}
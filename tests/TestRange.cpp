@@ -0,0 +1,153 @@
+/** @file TestRange.cpp
+ * Tests for the lazy range views over model evaluations
+ */
+#include "P2108Range.h"
+#include "TestUtils.h"
+
+#include <algorithm>  // for std::find_if
+#include <cmath>      // for std::isnan
+#include <cstddef>    // for std::size_t
+#include <iterator>   // for std::distance
+#include <vector>     // for std::vector
+
+namespace {
+/** An input range which counts the elements read from it */
+class CountingRange {
+    public:
+        /** Iterator which counts dereferences */
+        class iterator {
+            public:
+                iterator(const double *it, std::size_t *reads):
+                    it_(it), reads_(reads) {}
+                double operator*() const {
+                    ++*reads_;
+                    return *it_;
+                }
+                iterator &operator++() {
+                    ++it_;
+                    return *this;
+                }
+                bool operator!=(const iterator &other) const {
+                    return it_ != other.it_;
+                }
+            private:
+                const double *it_;
+                std::size_t *reads_;
+        };
+
+        CountingRange(const std::vector<double> &values, std::size_t &reads):
+            values_(values), reads_(&reads) {}
+        iterator begin() const {
+            return iterator(values_.data(), reads_);
+        }
+        iterator end() const {
+            return iterator(values_.data() + values_.size(), reads_);
+        }
+    private:
+        const std::vector<double> &values_;
+        std::size_t *reads_;
+};
+
+/** Generate distances from 0 to 10 km in steps of 1 m */
+std::vector<double> MakeDistances() {
+    std::vector<double> d__km(10001);
+    for (std::size_t i = 0; i < d__km.size(); i++) {
+        d__km[i] = i * 0.001;
+    }
+    return d__km;
+}
+}  // namespace
+
+TEST(RangeTest, TestMatchesScalar) {
+    const std::vector<double> d__km = MakeDistances();
+    auto losses = TerrestrialStatisticalModelRange(3.0, d__km, 50.0);
+    std::size_t i = 0;
+    for (const ModelResult &result : losses) {
+        double expected;
+        const ReturnCode rtn
+            = TerrestrialStatisticalModel(3.0, d__km[i], 50.0, expected);
+        EXPECT_EQ(result.rtn, rtn);
+        if (rtn == SUCCESS) {
+            EXPECT_EQ(result.loss__db, expected);
+        } else {
+            EXPECT_TRUE(std::isnan(result.loss__db));
+        }
+        i++;
+    }
+    EXPECT_EQ(i, d__km.size());
+}
+
+TEST(RangeTest, TestFindIfStopsEarly) {
+    const std::vector<double> d__km = MakeDistances();
+    std::size_t reads = 0;
+    auto losses = TerrestrialStatisticalModelRange(
+        3.0, CountingRange(d__km, reads), 50.0
+    );
+    auto it = std::find_if(
+        losses.begin(),
+        losses.end(),
+        [](const ModelResult &r) { return r.rtn == SUCCESS; }
+    );
+    ASSERT_TRUE(it != losses.end());
+    EXPECT_EQ(it->rtn, SUCCESS);
+
+    // Distances below 0.25 km are invalid, so the first valid record is the
+    // 251st. Only the chunks up to that record have been evaluated.
+    using Range = decltype(losses);
+    EXPECT_LT(reads, 251 + Range::MAX_CHUNK);
+    EXPECT_LT(reads, d__km.size());
+
+    // The range resumes where the search stopped
+    std::size_t remaining = std::distance(it, losses.end());
+    EXPECT_EQ(remaining, d__km.size() - 250);
+}
+
+TEST(RangeTest, TestShortestInput) {
+    const std::vector<double> f__ghz = {10, 20, 30};
+    const std::vector<double> theta__deg = {10, 20, 30, 40, 50};
+    const std::vector<double> p = {1, 50, 99, 50};
+    auto losses = AeronauticalStatisticalModelRange(f__ghz, theta__deg, p);
+    std::size_t n = 0;
+    for (const ModelResult &result : losses) {
+        double expected;
+        EXPECT_EQ(
+            result.rtn,
+            AeronauticalStatisticalModel(
+                f__ghz[n], theta__deg[n], p[n], expected
+            )
+        );
+        EXPECT_EQ(result.loss__db, expected);
+        n++;
+    }
+    EXPECT_EQ(n, f__ghz.size());
+}
+
+TEST(RangeTest, TestClutterTypes) {
+    // Clutter type 7 is invalid
+    const std::vector<int> clutter_type = {1, 2, 3, 4, 5, 6, 7};
+    auto losses = HeightGainTerminalCorrectionModelRange(
+        1.5, 2.0, 27.0, 15.0, clutter_type
+    );
+    auto it = losses.begin();
+    for (const int type : clutter_type) {
+        ASSERT_TRUE(it != losses.end());
+        double expected;
+        const ReturnCode rtn = HeightGainTerminalCorrectionModel(
+            1.5, 2.0, 27.0, 15.0, static_cast<ClutterType>(type), expected
+        );
+        const ModelResult result = *it++;
+        EXPECT_EQ(result.rtn, rtn);
+        if (rtn == SUCCESS) {
+            EXPECT_EQ(result.loss__db, expected);
+        } else {
+            EXPECT_TRUE(std::isnan(result.loss__db));
+        }
+    }
+    EXPECT_TRUE(it == losses.end());
+}
+
+TEST(RangeTest, TestEmpty) {
+    const std::vector<double> none;
+    auto losses = TerrestrialStatisticalModelRange(none, none, none);
+    EXPECT_TRUE(losses.begin() == losses.end());
+}
@@ -0,0 +1,444 @@
+/** @file TestRaster.cpp
+ * Tests for the raster engines
+ */
+#include "P2108Raster.h"
+#include "TestUtils.h"
+
+#include <cmath>    // for NAN, std::isnan, std::sqrt
+#include <cstddef>  // for std::size_t
+#include <cstdint>  // for std::uint8_t
+#include <cstdio>   // for std::remove
+#include <fstream>  // for std::ifstream
+#include <sstream>  // for std::stringstream
+#include <string>   // for std::string
+#include <vector>   // for std::vector
+
+namespace {
+/** A north-up grid of 100 m cells, with the transmitter inside it */
+P2108RasterGeometry MakeGrid() {
+    P2108RasterGeometry grid;
+    grid.n_rows = 37;
+    grid.n_cols = 53;
+    grid.x0__km = -1.05;
+    grid.y0__km = 2.0;
+    grid.dx__km = 0.1;
+    grid.dy__km = -0.1;
+    return grid;
+}
+
+constexpr double TX_X__KM = 0.33, TX_Y__KM = 0.21, F__GHZ = 3.5, P = 50;
+}  // namespace
+
+TEST(RasterTest, TestTerrestrialCoverageMatchesScalar) {
+    const P2108RasterGeometry grid = MakeGrid();
+    std::vector<float> raster(grid.n_rows * grid.n_cols);
+    ASSERT_EQ(
+        P2108TerrestrialCoverage(
+            &grid,
+            TX_X__KM,
+            TX_Y__KM,
+            F__GHZ,
+            P,
+            ABRAMOWITZ_STEGUN,
+            raster.data(),
+            3
+        ),
+        P2108_RASTER_SUCCESS
+    );
+    std::size_t n_invalid = 0;
+    for (std::size_t r = 0; r < grid.n_rows; r++) {
+        for (std::size_t c = 0; c < grid.n_cols; c++) {
+            const double x = grid.x0__km + c * grid.dx__km - TX_X__KM;
+            const double y = grid.y0__km + r * grid.dy__km - TX_Y__KM;
+            const double d__km = std::sqrt(x * x + y * y);
+            double expected;
+            const ReturnCode rtn
+                = TerrestrialStatisticalModel(F__GHZ, d__km, P, expected);
+            const float actual = raster[r * grid.n_cols + c];
+            if (rtn == SUCCESS) {
+                EXPECT_EQ(actual, static_cast<float>(expected));
+            } else {
+                EXPECT_TRUE(std::isnan(actual));
+                n_invalid++;
+            }
+        }
+    }
+    EXPECT_GT(n_invalid, 0u);  // Cells within 250 m of the transmitter
+}
+
+TEST(RasterTest, TestThreadCountDoesNotChangeResults) {
+    const P2108RasterGeometry grid = MakeGrid();
+    std::vector<float> one(grid.n_rows * grid.n_cols);
+    std::vector<float> many(one.size());
+    P2108TerrestrialCoverage(
+        &grid, TX_X__KM, TX_Y__KM, F__GHZ, P, ABRAMOWITZ_STEGUN, one.data(), 1
+    );
+    P2108TerrestrialCoverage(
+        &grid, TX_X__KM, TX_Y__KM, F__GHZ, P, ABRAMOWITZ_STEGUN, many.data(), 0
+    );
+    for (std::size_t i = 0; i < one.size(); i++) {
+        if (!std::isnan(one[i])) {
+            EXPECT_EQ(one[i], many[i]);
+        }
+    }
+}
+
+TEST(RasterTest, TestTerrestrialCoverageFile) {
+    const P2108RasterGeometry grid = MakeGrid();
+    std::vector<float> expected(grid.n_rows * grid.n_cols);
+    P2108TerrestrialCoverage(
+        &grid,
+        TX_X__KM,
+        TX_Y__KM,
+        F__GHZ,
+        P,
+        ABRAMOWITZ_STEGUN,
+        expected.data(),
+        2
+    );
+
+    const std::string path = GetTempFilePath(".f32");
+    ASSERT_EQ(
+        P2108TerrestrialCoverageFile(
+            &grid,
+            TX_X__KM,
+            TX_Y__KM,
+            F__GHZ,
+            P,
+            ABRAMOWITZ_STEGUN,
+            path.c_str(),
+            2
+        ),
+        P2108_RASTER_SUCCESS
+    );
+    std::vector<float> actual(expected.size());
+    std::ifstream file(path, std::ios::binary | std::ios::ate);
+    ASSERT_TRUE(file.good());
+    EXPECT_EQ(
+        static_cast<std::size_t>(file.tellg()), actual.size() * sizeof(float)
+    );
+    file.seekg(0);
+    file.read(
+        reinterpret_cast<char *>(actual.data()), actual.size() * sizeof(float)
+    );
+    file.close();
+    for (std::size_t i = 0; i < actual.size(); i++) {
+        if (!std::isnan(expected[i])) {
+            EXPECT_EQ(actual[i], expected[i]);
+        } else {
+            EXPECT_TRUE(std::isnan(actual[i]));
+        }
+    }
+
+    std::ifstream hdr(path + ".hdr");
+    std::stringstream text;
+    text << hdr.rdbuf();
+    hdr.close();
+    EXPECT_EQ(text.str().compare(0, 5, "ENVI\n"), 0);
+    EXPECT_NE(text.str().find("samples = 53\n"), std::string::npos);
+    EXPECT_NE(text.str().find("lines = 37\n"), std::string::npos);
+    EXPECT_NE(text.str().find("data type = 4\n"), std::string::npos);
+    EXPECT_NE(text.str().find("map info = {"), std::string::npos);
+    std::remove(path.c_str());
+    std::remove((path + ".hdr").c_str());
+}
+
+TEST(RasterTest, TestTerrestrialCoverageErrors) {
+    P2108RasterGeometry grid = MakeGrid();
+    std::vector<float> raster(grid.n_rows * grid.n_cols);
+    EXPECT_EQ(
+        P2108TerrestrialCoverage(
+            &grid, 0, 0, 0.1, P, ABRAMOWITZ_STEGUN, raster.data(), 1
+        ),
+        ERROR32__FREQUENCY
+    );
+    EXPECT_EQ(
+        P2108TerrestrialCoverage(
+            &grid, 0, 0, F__GHZ, 100, ABRAMOWITZ_STEGUN, raster.data(), 1
+        ),
+        ERROR32__PERCENTAGE
+    );
+    EXPECT_EQ(
+        P2108TerrestrialCoverage(
+            &grid, 0, 0, F__GHZ, P, ABRAMOWITZ_STEGUN, nullptr, 1
+        ),
+        P2108_RASTER_ERROR_ARGUMENT
+    );
+    EXPECT_EQ(
+        P2108TerrestrialCoverage(
+            nullptr, 0, 0, F__GHZ, P, ABRAMOWITZ_STEGUN, raster.data(), 1
+        ),
+        P2108_RASTER_ERROR_ARGUMENT
+    );
+    grid.n_cols = 0;
+    EXPECT_EQ(
+        P2108TerrestrialCoverage(
+            &grid, 0, 0, F__GHZ, P, ABRAMOWITZ_STEGUN, raster.data(), 1
+        ),
+        P2108_RASTER_ERROR_ARGUMENT
+    );
+    grid = MakeGrid();
+    EXPECT_EQ(
+        P2108TerrestrialCoverageFile(
+            &grid,
+            0,
+            0,
+            F__GHZ,
+            P,
+            ABRAMOWITZ_STEGUN,
+            "no/such/directory/raster.f32",
+            1
+        ),
+        P2108_RASTER_ERROR_IO
+    );
+}
+
+namespace {
+/** A land-cover raster using every code, with a table mapping codes 1-6 */
+struct LandCover {
+        P2108RasterGeometry grid;
+        std::vector<std::uint8_t> codes;
+        std::vector<float> R__meter;
+        int clutter_types[P2108_LAND_COVER_CODES] = {};
+
+        LandCover() {
+            grid = MakeGrid();
+            codes.resize(grid.n_rows * grid.n_cols);
+            R__meter.resize(codes.size());
+            for (std::size_t i = 0; i < codes.size(); i++) {
+                codes[i] = static_cast<std::uint8_t>(i % 9);
+                R__meter[i] = (i % 5 == 0) ? NAN : 3.0f + (i % 23);
+            }
+            for (int code = 1; code <= 6; code++) {
+                clutter_types[code] = code;  // Codes 7 and 8 are unmapped
+            }
+        }
+};
+
+constexpr double H__METER = 8, W_S__METER = 27, F_HGTCM__GHZ = 1.5;
+
+/** Write a vector to a raw binary file */
+template<typename T>
+void WriteRaw(const std::string &path, const std::vector<T> &data) {
+    std::ofstream file(path, std::ios::binary);
+    file.write(
+        reinterpret_cast<const char *>(data.data()), data.size() * sizeof(T)
+    );
+}
+
+/** Read a raw binary `float` file */
+std::vector<float> ReadRaw(const std::string &path) {
+    std::ifstream file(path, std::ios::binary | std::ios::ate);
+    std::vector<float> data(static_cast<std::size_t>(file.tellg()) / 4);
+    file.seekg(0);
+    file.read(reinterpret_cast<char *>(data.data()), data.size() * 4);
+    return data;
+}
+}  // namespace
+
+TEST(RasterTest, TestHeightGainRasterMatchesScalar) {
+    const LandCover lc;
+    const std::size_t n = lc.codes.size();
+    std::vector<float> with_R(n), without_R(n);
+    ASSERT_EQ(
+        P2108HeightGainRaster(
+            &lc.grid,
+            lc.codes.data(),
+            lc.clutter_types,
+            lc.R__meter.data(),
+            F_HGTCM__GHZ,
+            H__METER,
+            W_S__METER,
+            with_R.data(),
+            2
+        ),
+        P2108_RASTER_SUCCESS
+    );
+    ASSERT_EQ(
+        P2108HeightGainRaster(
+            &lc.grid,
+            lc.codes.data(),
+            lc.clutter_types,
+            nullptr,
+            F_HGTCM__GHZ,
+            H__METER,
+            W_S__METER,
+            without_R.data(),
+            2
+        ),
+        P2108_RASTER_SUCCESS
+    );
+    const double R_default__meter[] = {0, 10, 10, 10, 15, 15, 20};
+    for (std::size_t i = 0; i < n; i++) {
+        const int code = lc.codes[i];
+        if (code == 0 || code > 6) {
+            EXPECT_TRUE(std::isnan(with_R[i]));
+            EXPECT_TRUE(std::isnan(without_R[i]));
+            continue;
+        }
+        const ClutterType type = static_cast<ClutterType>(code);
+        double expected;
+        HeightGainTerminalCorrectionModel(
+            F_HGTCM__GHZ,
+            H__METER,
+            W_S__METER,
+            R_default__meter[code],
+            type,
+            expected
+        );
+        EXPECT_EQ(without_R[i], static_cast<float>(expected));
+        if (!std::isnan(lc.R__meter[i])) {
+            HeightGainTerminalCorrectionModel(
+                F_HGTCM__GHZ,
+                H__METER,
+                W_S__METER,
+                lc.R__meter[i],
+                type,
+                expected
+            );
+        }
+        EXPECT_EQ(with_R[i], static_cast<float>(expected));
+    }
+}
+
+TEST(RasterTest, TestHeightGainRasterFile) {
+    const LandCover lc;
+    std::vector<float> expected(lc.codes.size());
+    P2108HeightGainRaster(
+        &lc.grid,
+        lc.codes.data(),
+        lc.clutter_types,
+        lc.R__meter.data(),
+        F_HGTCM__GHZ,
+        H__METER,
+        W_S__METER,
+        expected.data(),
+        1
+    );
+    const std::string codes_path = GetTempFilePath("_land_cover.u8");
+    const std::string R_path = GetTempFilePath("_clutter_height.f32");
+    const std::string path = GetTempFilePath("_height_gain.f32");
+    WriteRaw(codes_path, lc.codes);
+    WriteRaw(R_path, lc.R__meter);
+    const int rtn = P2108HeightGainRasterFile(
+        &lc.grid,
+        codes_path.c_str(),
+        lc.clutter_types,
+        R_path.c_str(),
+        F_HGTCM__GHZ,
+        H__METER,
+        W_S__METER,
+        path.c_str(),
+        0
+    );
+#ifdef _WIN32
+    EXPECT_EQ(rtn, P2108_RASTER_ERROR_UNSUPPORTED);
+#else
+    ASSERT_EQ(rtn, P2108_RASTER_SUCCESS);
+    const std::vector<float> actual = ReadRaw(path);
+    ASSERT_EQ(actual.size(), expected.size());
+    for (std::size_t i = 0; i < actual.size(); i++) {
+        if (std::isnan(expected[i])) {
+            EXPECT_TRUE(std::isnan(actual[i]));
+        } else {
+            EXPECT_EQ(actual[i], expected[i]);
+        }
+    }
+
+    // The height raster does not match the size of the grid
+    WriteRaw(R_path, std::vector<float>(lc.codes.size() - 1));
+    EXPECT_EQ(
+        P2108HeightGainRasterFile(
+            &lc.grid,
+            codes_path.c_str(),
+            lc.clutter_types,
+            R_path.c_str(),
+            F_HGTCM__GHZ,
+            H__METER,
+            W_S__METER,
+            path.c_str(),
+            1
+        ),
+        P2108_RASTER_ERROR_SIZE
+    );
+    EXPECT_EQ(
+        P2108HeightGainRasterFile(
+            &lc.grid,
+            "no_such_land_cover.u8",
+            lc.clutter_types,
+            nullptr,
+            F_HGTCM__GHZ,
+            H__METER,
+            W_S__METER,
+            path.c_str(),
+            1
+        ),
+        P2108_RASTER_ERROR_IO
+    );
+#endif
+    std::remove(codes_path.c_str());
+    std::remove(R_path.c_str());
+    std::remove(path.c_str());
+    std::remove((path + ".hdr").c_str());
+}
+
+TEST(RasterTest, TestHeightGainRasterErrors) {
+    const LandCover lc;
+    std::vector<float> raster(lc.codes.size());
+    EXPECT_EQ(
+        P2108HeightGainRaster(
+            &lc.grid,
+            lc.codes.data(),
+            lc.clutter_types,
+            nullptr,
+            5,
+            H__METER,
+            W_S__METER,
+            raster.data(),
+            1
+        ),
+        ERROR31__FREQUENCY
+    );
+    EXPECT_EQ(
+        P2108HeightGainRaster(
+            &lc.grid,
+            lc.codes.data(),
+            lc.clutter_types,
+            nullptr,
+            F_HGTCM__GHZ,
+            H__METER,
+            0,
+            raster.data(),
+            1
+        ),
+        ERROR31__STREET_WIDTH
+    );
+    EXPECT_EQ(
+        P2108HeightGainRaster(
+            &lc.grid,
+            lc.codes.data(),
+            nullptr,
+            nullptr,
+            F_HGTCM__GHZ,
+            H__METER,
+            W_S__METER,
+            raster.data(),
+            1
+        ),
+        P2108_RASTER_ERROR_ARGUMENT
+    );
+    EXPECT_EQ(
+        P2108HeightGainRaster(
+            &lc.grid,
+            nullptr,
+            lc.clutter_types,
+            nullptr,
+            F_HGTCM__GHZ,
+            H__METER,
+            W_S__METER,
+            raster.data(),
+            1
+        ),
+        P2108_RASTER_ERROR_ARGUMENT
+    );
+}
@@ -0,0 +1,78 @@
+/** @file TestReturnCodes.cpp
+ * Tests for the status messages of library return codes
+ */
+#include "TestUtils.h"
+
+#include <cstddef>  // for std::size_t
+#include <string>   // for std::string
+#include <vector>   // for std::vector
+
+TEST(ReturnCodesTest, TestMessagesMatchStrings) {
+    const std::vector<int> codes = {
+        SUCCESS,
+        ERROR31__FREQUENCY,
+        ERROR31__CLUTTER_TYPE,
+        ERROR32__DISTANCE,
+        ERROR33__THETA,
+        1,
+        -5,
+    };
+    for (const int code : codes) {
+        const char *msg = GetReturnStatusMessage(code);
+        EXPECT_EQ(GetReturnStatus(code), msg);
+        char *c_msg = GetReturnStatusCharArray(code);
+        EXPECT_STREQ(c_msg, msg);
+        FreeReturnStatusCharArray(c_msg);
+    }
+}
+
+TEST(ReturnCodesTest, TestMessagesAreInterned) {
+    EXPECT_EQ(
+        GetReturnStatusMessage(ERROR32__DISTANCE),
+        GetReturnStatusMessage(ERROR32__DISTANCE)
+    );
+    const std::string success = GetReturnStatusMessage(SUCCESS);
+    EXPECT_NE(success.find("Status: Successful execution"), std::string::npos);
+    const std::string undefined = GetReturnStatusMessage(127);
+    EXPECT_NE(undefined.find("Error: Undefined"), std::string::npos);
+}
+
+TEST(ReturnCodesTest, TestHistogram) {
+    const std::vector<ReturnCode> codes = {
+        ERROR32__DISTANCE,
+        SUCCESS,
+        ERROR32__DISTANCE,
+        SUCCESS,
+        ERROR32__FREQUENCY,
+        SUCCESS,
+        static_cast<ReturnCode>(200),  // Not a library code, so not counted
+    };
+    ReturnStatusCount counts[4];
+    const std::size_t n = GetReturnStatusHistogram(
+        codes.data(), codes.size(), counts, 4
+    );
+    ASSERT_EQ(n, 3u);
+    EXPECT_EQ(counts[0].code, SUCCESS);
+    EXPECT_EQ(counts[0].count, 3u);
+    EXPECT_EQ(counts[1].code, ERROR32__FREQUENCY);
+    EXPECT_EQ(counts[1].count, 1u);
+    EXPECT_EQ(counts[2].code, ERROR32__DISTANCE);
+    EXPECT_EQ(counts[2].count, 2u);
+    for (std::size_t i = 0; i < n; i++) {
+        EXPECT_EQ(counts[i].message, GetReturnStatusMessage(counts[i].code));
+    }
+}
+
+TEST(ReturnCodesTest, TestHistogramTruncated) {
+    const std::vector<ReturnCode> codes
+        = {ERROR33__THETA, SUCCESS, ERROR31__FREQUENCY};
+    ReturnStatusCount counts[1];
+    EXPECT_EQ(
+        GetReturnStatusHistogram(codes.data(), codes.size(), counts, 1), 3u
+    );
+    EXPECT_EQ(counts[0].code, SUCCESS);
+    EXPECT_EQ(
+        GetReturnStatusHistogram(codes.data(), codes.size(), nullptr, 0), 3u
+    );
+    EXPECT_EQ(GetReturnStatusHistogram(nullptr, 0, counts, 1), 0u);
+}
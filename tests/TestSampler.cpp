@@ -0,0 +1,149 @@
+/** @file TestSampler.cpp
+ * Tests for the Monte Carlo samplers
+ */
+#include "P2108Kernels.h"
+#include "P2108Sampler.h"
+#include "TestUtils.h"
+
+#include <cmath>    // for std::erfc, std::fabs, std::sqrt
+#include <cstddef>  // for std::size_t
+#include <cstdint>  // for std::uint32_t
+#include <vector>   // for std::vector
+
+TEST(SamplerTest, TestPhiloxKnownAnswers) {
+    // Known-answer vectors of the Random123 reference implementation
+    const std::uint32_t counters[3][4] = {
+        {0, 0, 0, 0},
+        {0xffffffff, 0xffffffff, 0xffffffff, 0xffffffff},
+        {0x243f6a88, 0x85a308d3, 0x13198a2e, 0x03707344}
+    };
+    const std::uint32_t keys[3][2] = {
+        {0, 0}, {0xffffffff, 0xffffffff}, {0xa4093822, 0x299f31d0}
+    };
+    const std::uint32_t expected[3][4] = {
+        {0x6627e8d5, 0xe169c58d, 0xbc57ac4c, 0x9b00dbd8},
+        {0x408f276d, 0x41c83b0e, 0xa20bc7c6, 0x6d5451fd},
+        {0xd16cfe09, 0x94fdcceb, 0x5001e420, 0x24126ea1}
+    };
+    for (int i = 0; i < 3; i++) {
+        std::uint32_t output[4];
+        P2108Philox4x32(counters[i], keys[i], output);
+        for (int j = 0; j < 4; j++) {
+            EXPECT_EQ(output[j], expected[i][j]) << "vector " << i;
+        }
+    }
+}
+
+TEST(SamplerTest, TestStreamsAreReproducible) {
+    const std::size_t n = 1001;
+    std::vector<double> whole(n), parts(n);
+    P2108StandardNormalSamples(42, 7, 0, n, whole.data());
+    // The same samples, drawn in pieces starting at odd and even indices
+    P2108StandardNormalSamples(42, 7, 0, 3, parts.data());
+    P2108StandardNormalSamples(42, 7, 3, 300, parts.data() + 3);
+    P2108StandardNormalSamples(42, 7, 303, n - 303, parts.data() + 303);
+    for (std::size_t i = 0; i < n; i++) {
+        EXPECT_EQ(whole[i], parts[i]);
+    }
+    // Other streams and seeds differ
+    std::vector<double> other(n);
+    P2108StandardNormalSamples(42, 8, 0, n, other.data());
+    EXPECT_NE(whole, other);
+    P2108StandardNormalSamples(43, 7, 0, n, other.data());
+    EXPECT_NE(whole, other);
+}
+
+TEST(SamplerTest, TestStandardNormalMoments) {
+    const std::size_t n = 200000;
+    std::vector<double> z(n);
+    P2108StandardNormalSamples(1, 0, 0, n, z.data());
+    double sum = 0, sum2 = 0;
+    std::size_t above = 0;
+    for (const double x : z) {
+        sum += x;
+        sum2 += x * x;
+        above += (x > 1.6448536269514722) ? 1 : 0;  // Q(x) = 0.05
+    }
+    const double mean = sum / n;
+    EXPECT_NEAR(mean, 0, 0.01);
+    EXPECT_NEAR(sum2 / n - mean * mean, 1, 0.01);
+    EXPECT_NEAR(static_cast<double>(above) / n, 0.05, 0.002);
+}
+
+TEST(SamplerTest, TestTerrestrialSamplesMatchModel) {
+    const double f__ghz = 26.6;
+    const std::size_t n = 1000;
+    for (const double d__km : {0.5, 2.0, 15.8}) {
+        std::vector<double> z(n), L_ctt__db(n);
+        P2108StandardNormalSamples(5, 1, 0, n, z.data());
+        ASSERT_EQ(
+            P2108TerrestrialStatisticalModelSamples(
+                f__ghz, d__km, 5, 1, 0, n, L_ctt__db.data()
+            ),
+            SUCCESS
+        );
+        const double L_l__db = Inline::Equation_4(f__ghz);
+        for (std::size_t i = 0; i < n; i++) {
+            // The model, with the deviate as the inverse CCDF
+            const double L_2km__db = Inline::Equation_3(
+                L_l__db, Inline::Equation_5(f__ghz, 2), z[i]
+            );
+            const double L_d__db = Inline::Equation_3(
+                L_l__db, Inline::Equation_5(f__ghz, d__km), z[i]
+            );
+            EXPECT_EQ(L_ctt__db[i], std::fmin(L_2km__db, L_d__db));
+
+            // The model at the equivalent percentage of locations
+            const double p = 50 * std::erfc(z[i] / std::sqrt(2.0));
+            if (p > 1e-6 && p < 100 - 1e-6) {
+                double expected;
+                TerrestrialStatisticalModel(f__ghz, d__km, p, expected);
+                EXPECT_NEAR(L_ctt__db[i], expected, 6 * 4.5e-4);
+            }
+        }
+    }
+}
+
+TEST(SamplerTest, TestAeronauticalSamplesMatchModel) {
+    const double f__ghz = 26.6;
+    const std::size_t n = 1000;
+    for (const double theta__deg : {0.0, 15.8, 89.0}) {
+        std::vector<double> z(n), L_ces__db(n);
+        P2108StandardNormalSamples(9, 2, 10, n, z.data());
+        ASSERT_EQ(
+            P2108AeronauticalStatisticalModelSamples(
+                f__ghz, theta__deg, 9, 2, 10, n, L_ces__db.data()
+            ),
+            SUCCESS
+        );
+        for (std::size_t i = 0; i < n; i++) {
+            const double p = 50 * std::erfc(z[i] / std::sqrt(2.0));
+            if (p > 1e-6 && p < 100 - 1e-6) {
+                double expected;
+                AeronauticalStatisticalModel(f__ghz, theta__deg, p, expected);
+                EXPECT_NEAR(L_ces__db[i], expected, 1e-3) << "p = " << p;
+            }
+        }
+    }
+}
+
+TEST(SamplerTest, TestSamplerErrors) {
+    double L__db = 0;
+    EXPECT_EQ(
+        P2108TerrestrialStatisticalModelSamples(0.1, 1, 0, 0, 0, 1, &L__db),
+        ERROR32__FREQUENCY
+    );
+    EXPECT_EQ(
+        P2108TerrestrialStatisticalModelSamples(26.6, 0.1, 0, 0, 0, 1, &L__db),
+        ERROR32__DISTANCE
+    );
+    EXPECT_EQ(
+        P2108AeronauticalStatisticalModelSamples(5, 10, 0, 0, 0, 1, &L__db),
+        ERROR33__FREQUENCY
+    );
+    EXPECT_EQ(
+        P2108AeronauticalStatisticalModelSamples(26.6, 91, 0, 0, 0, 1, &L__db),
+        ERROR33__THETA
+    );
+    EXPECT_EQ(L__db, 0);
+}
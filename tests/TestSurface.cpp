@@ -0,0 +1,363 @@
+/** @file TestSurface.cpp
+ * Tests for the precomputed loss surfaces and their files
+ */
+#include "P2108Kernels.h"
+#include "P2108Surface.h"
+#include "TestUtils.h"
+
+#include <cmath>    // for std::fabs, std::isnan
+#include <cstddef>  // for std::size_t
+#include <cstdio>   // for std::remove
+#include <fstream>  // for std::fstream
+#include <string>   // for std::string
+#include <vector>   // for std::vector
+
+namespace {
+/** Write a surface file with the default grids */
+void WriteDefaultFile(const std::string &path) {
+    P2108SurfaceSpec spec;
+    P2108SurfaceDefaultSpec(P2108_SURFACE_DEFAULT_NODES, &spec);
+    ASSERT_EQ(P2108SurfaceWrite(path.c_str(), &spec), P2108_SURFACE_SUCCESS);
+}
+
+/** Overwrite bytes of a file at an offset */
+void Patch(
+    const std::string &path,
+    const std::size_t offset,
+    const void *bytes,
+    const std::size_t size
+) {
+    std::fstream file(path, std::ios::in | std::ios::out | std::ios::binary);
+    file.seekp(offset);
+    file.write(static_cast<const char *>(bytes), size);
+}
+
+/** Status of opening a file, closing it if it opens */
+int OpenStatus(const std::string &path) {
+    P2108Surface *surface;
+    const int rtn = P2108SurfaceOpen(path.c_str(), &surface);
+    P2108SurfaceClose(surface);
+    return rtn;
+}
+}  // namespace
+
+TEST(SurfaceTest, TestQueriesWithinErrorBounds) {
+    const std::string path = GetTempFilePath(".p2108");
+    WriteDefaultFile(path);
+    P2108Surface *surface;
+    ASSERT_EQ(P2108SurfaceOpen(path.c_str(), &surface), P2108_SURFACE_SUCCESS);
+    const P2108SurfaceHeader *header = P2108SurfaceGetHeader(surface);
+    EXPECT_EQ(header->version, P2108_SURFACE_VERSION);
+    EXPECT_EQ(header->spec.asm_p.count, P2108_SURFACE_DEFAULT_NODES);
+    EXPECT_GT(header->asm_loss.max_error, 0);
+    EXPECT_LT(header->asm_loss.max_error, 2);
+    EXPECT_LT(header->tsm_median.max_error, 0.1);
+    EXPECT_LT(header->tsm_sigma.max_error, 0.1);
+    EXPECT_LT(header->hgtcm_loss.max_error, 0.2);
+
+    // Bounds are found at the cell centers, so allow some margin
+    const std::vector<double> f__ghz = {0.7, 1.3, 2.5, 6, 10.5, 26, 60, 66};
+    const std::vector<double> d__km = {0.3, 0.7, 1, 1.5, 2, 3.3, 10, 99};
+    const std::vector<double> p = {1.5, 5, 20, 35, 50, 70, 90, 98.5};
+    const std::size_t n = f__ghz.size();
+    std::vector<double> L_ctt__db(n);
+    std::vector<int> rtn(n);
+    EXPECT_EQ(
+        P2108SurfaceTerrestrialStatisticalModel(
+            surface,
+            n,
+            f__ghz.data(),
+            d__km.data(),
+            p.data(),
+            ABRAMOWITZ_STEGUN,
+            L_ctt__db.data(),
+            rtn.data()
+        ),
+        0u
+    );
+    for (std::size_t i = 0; i < n; i++) {
+        double expected;
+        TerrestrialStatisticalModel(f__ghz[i], d__km[i], p[i], expected);
+        const double Q_p
+            = InverseComplementaryCumulativeDistribution(p[i] / 100);
+        const double bound = header->tsm_median.max_error
+                           + header->tsm_sigma.max_error * std::fabs(Q_p);
+        EXPECT_EQ(rtn[i], SUCCESS);
+        EXPECT_NEAR(L_ctt__db[i], expected, 2 * bound);
+    }
+
+    const std::vector<double> asm_f__ghz = {10, 12, 20, 30, 45, 60, 80, 100};
+    const std::vector<double> theta__deg = {0, 1, 5, 15, 30, 45, 60, 90};
+    std::vector<double> L_ces__db(n);
+    EXPECT_EQ(
+        P2108SurfaceAeronauticalStatisticalModel(
+            surface,
+            n,
+            asm_f__ghz.data(),
+            theta__deg.data(),
+            p.data(),
+            ABRAMOWITZ_STEGUN,
+            L_ces__db.data(),
+            rtn.data()
+        ),
+        0u
+    );
+    for (std::size_t i = 0; i < n; i++) {
+        double expected;
+        AeronauticalStatisticalModel(
+            asm_f__ghz[i], theta__deg[i], p[i], expected
+        );
+        EXPECT_EQ(rtn[i], SUCCESS);
+        EXPECT_NEAR(L_ces__db[i], expected, 2 * header->asm_loss.max_error);
+    }
+
+    const std::vector<double> h__meter = {1.5, 3, 5, 10, 2, 8, 20, 1};
+    const std::vector<double> w_s__meter = {27, 10, 20, 50, 15, 30, 27, 5};
+    const std::vector<double> R__meter = {10, 15, 20, 25, 10, 15, 15, 30};
+    const std::vector<int> clutter_type = {
+        ClutterType::URBAN,
+        ClutterType::SUBURBAN,
+        ClutterType::DENSE_URBAN,
+        ClutterType::TREES_FOREST,
+        ClutterType::OPEN_RURAL,
+        ClutterType::WATER_SEA,
+        ClutterType::URBAN,
+        ClutterType::URBAN
+    };
+    const std::vector<double> hgtcm_f__ghz
+        = {0.03, 0.1, 0.5, 1, 1.5, 2, 2.5, 3};
+    std::vector<double> A_h__db(n);
+    EXPECT_EQ(
+        P2108SurfaceHeightGainTerminalCorrectionModel(
+            surface,
+            n,
+            hgtcm_f__ghz.data(),
+            h__meter.data(),
+            w_s__meter.data(),
+            R__meter.data(),
+            clutter_type.data(),
+            A_h__db.data(),
+            rtn.data()
+        ),
+        0u
+    );
+    for (std::size_t i = 0; i < n; i++) {
+        double expected;
+        HeightGainTerminalCorrectionModel(
+            hgtcm_f__ghz[i],
+            h__meter[i],
+            w_s__meter[i],
+            R__meter[i],
+            static_cast<ClutterType>(clutter_type[i]),
+            expected
+        );
+        EXPECT_EQ(rtn[i], SUCCESS);
+        EXPECT_NEAR(A_h__db[i], expected, 2 * header->hgtcm_loss.max_error);
+    }
+
+    P2108SurfaceClose(surface);
+    std::remove(path.c_str());
+}
+
+TEST(SurfaceTest, TestOutsideGridsUsesModels) {
+    const std::string path = GetTempFilePath(".p2108");
+    P2108SurfaceSpec spec;
+    P2108SurfaceDefaultSpec(8, &spec);
+    spec.tsm_d__km = {0.25, 1, 8, P2108_SURFACE_LOG};
+    ASSERT_EQ(P2108SurfaceWrite(path.c_str(), &spec), P2108_SURFACE_SUCCESS);
+    P2108Surface *surface;
+    ASSERT_EQ(P2108SurfaceOpen(path.c_str(), &surface), P2108_SURFACE_SUCCESS);
+
+    // Without 2 km in the grid, Equation (6) is evaluated by the model
+    const double f__ghz = 3, d__km = 0.5, p = 50;
+    double L_ctt__db, expected;
+    P2108SurfaceTerrestrialStatisticalModel(
+        surface, 1, &f__ghz, &d__km, &p, ABRAMOWITZ_STEGUN, &L_ctt__db, nullptr
+    );
+    TerrestrialStatisticalModel(f__ghz, d__km, p, expected);
+    EXPECT_EQ(L_ctt__db, expected);
+
+    const double asm_f__ghz = 30, theta__deg = 30, asm_p = 0.5;
+    double L_ces__db;
+    P2108SurfaceAeronauticalStatisticalModel(
+        surface,
+        1,
+        &asm_f__ghz,
+        &theta__deg,
+        &asm_p,
+        ABRAMOWITZ_STEGUN,
+        &L_ces__db,
+        nullptr
+    );
+    AeronauticalStatisticalModel(asm_f__ghz, theta__deg, asm_p, expected);
+    EXPECT_EQ(L_ces__db, expected);
+
+    const double hgtcm_f__ghz = 3, h__meter = 1, w_s__meter = 5;
+    const double R__meter = 200;
+    const int clutter_type = ClutterType::URBAN;
+    double A_h__db;
+    P2108SurfaceHeightGainTerminalCorrectionModel(
+        surface,
+        1,
+        &hgtcm_f__ghz,
+        &h__meter,
+        &w_s__meter,
+        &R__meter,
+        &clutter_type,
+        &A_h__db,
+        nullptr
+    );
+    HeightGainTerminalCorrectionModel(
+        hgtcm_f__ghz,
+        h__meter,
+        w_s__meter,
+        R__meter,
+        ClutterType::URBAN,
+        expected
+    );
+    EXPECT_EQ(A_h__db, expected);
+
+    P2108SurfaceClose(surface);
+    std::remove(path.c_str());
+}
+
+TEST(SurfaceTest, TestInvalidRecords) {
+    const std::string path = GetTempFilePath(".p2108");
+    P2108SurfaceSpec spec;
+    P2108SurfaceDefaultSpec(4, &spec);
+    ASSERT_EQ(P2108SurfaceWrite(path.c_str(), &spec), P2108_SURFACE_SUCCESS);
+    P2108Surface *surface;
+    ASSERT_EQ(P2108SurfaceOpen(path.c_str(), &surface), P2108_SURFACE_SUCCESS);
+
+    const double f__ghz[2] = {3, 3};
+    const double d__km[2] = {1, 0.1};
+    const double p[2] = {50, 50};
+    double L__db[2];
+    int rtn[2];
+    EXPECT_EQ(
+        P2108SurfaceTerrestrialStatisticalModel(
+            surface, 2, f__ghz, d__km, p, ABRAMOWITZ_STEGUN, L__db, rtn
+        ),
+        1u
+    );
+    EXPECT_EQ(rtn[0], SUCCESS);
+    EXPECT_EQ(rtn[1], ERROR32__DISTANCE);
+    EXPECT_TRUE(std::isnan(L__db[1]));
+
+    const double theta__deg[2] = {30, 95};
+    const double asm_f__ghz[2] = {30, 30};
+    EXPECT_EQ(
+        P2108SurfaceAeronauticalStatisticalModel(
+            surface, 2, asm_f__ghz, theta__deg, p, ABRAMOWITZ_STEGUN, L__db, rtn
+        ),
+        1u
+    );
+    EXPECT_EQ(rtn[1], ERROR33__THETA);
+    EXPECT_TRUE(std::isnan(L__db[1]));
+
+    const double h__meter[2] = {1.5, 1.5};
+    const double w_s__meter[2] = {27, 27};
+    const double R__meter[2] = {10, 10};
+    const int clutter_type[2] = {ClutterType::URBAN, 7};
+    EXPECT_EQ(
+        P2108SurfaceHeightGainTerminalCorrectionModel(
+            surface,
+            2,
+            f__ghz,
+            h__meter,
+            w_s__meter,
+            R__meter,
+            clutter_type,
+            L__db,
+            rtn
+        ),
+        1u
+    );
+    EXPECT_EQ(rtn[1], ERROR31__CLUTTER_TYPE);
+    EXPECT_TRUE(std::isnan(L__db[1]));
+
+    P2108SurfaceClose(surface);
+    std::remove(path.c_str());
+}
+
+TEST(SurfaceTest, TestRejectsInvalidFiles) {
+    const std::string path = GetTempFilePath(".p2108");
+    EXPECT_EQ(OpenStatus("missing_surface.p2108"), P2108_SURFACE_ERROR_OPEN);
+
+    P2108SurfaceSpec spec;
+    P2108SurfaceDefaultSpec(4, &spec);
+    P2108SurfaceWrite(path.c_str(), &spec);
+    EXPECT_EQ(OpenStatus(path), P2108_SURFACE_SUCCESS);
+
+    // A corrupted value of a surface
+    const P2108SurfaceHeader *header = nullptr;
+    const double value = 123;
+    const std::size_t data_offset = (sizeof(*header) + 63) / 64 * 64;
+    Patch(path, data_offset + 8, &value, sizeof(value));
+    EXPECT_EQ(OpenStatus(path), P2108_SURFACE_ERROR_CHECKSUM);
+
+    // A corrupted grid
+    P2108SurfaceWrite(path.c_str(), &spec);
+    const uint32_t count = 5;
+    Patch(
+        path,
+        offsetof(P2108SurfaceHeader, spec.asm_p.count),
+        &count,
+        sizeof(count)
+    );
+    EXPECT_EQ(OpenStatus(path), P2108_SURFACE_ERROR_CHECKSUM);
+
+    // A file written by another version of the library
+    P2108SurfaceWrite(path.c_str(), &spec);
+    const char library_version[P2108_SURFACE_LIBRARY_VERSION_SIZE] = "0.9";
+    Patch(
+        path,
+        offsetof(P2108SurfaceHeader, library_version),
+        library_version,
+        sizeof(library_version)
+    );
+    EXPECT_EQ(OpenStatus(path), P2108_SURFACE_ERROR_STALE);
+
+    // A file with another layout version
+    const uint32_t version = P2108_SURFACE_VERSION + 1;
+    Patch(path, offsetof(P2108SurfaceHeader, version), &version, 4);
+    EXPECT_EQ(OpenStatus(path), P2108_SURFACE_ERROR_VERSION);
+
+    // Not a surface file
+    const uint32_t magic = 0;
+    Patch(path, offsetof(P2108SurfaceHeader, magic), &magic, 4);
+    EXPECT_EQ(OpenStatus(path), P2108_SURFACE_ERROR_FORMAT);
+
+    // A truncated file
+    P2108SurfaceWrite(path.c_str(), &spec);
+    {
+        std::ofstream file(path, std::ios::binary | std::ios::trunc);
+        file.write(reinterpret_cast<const char *>(&spec), sizeof(spec));
+    }
+    EXPECT_EQ(OpenStatus(path), P2108_SURFACE_ERROR_FORMAT);
+    std::remove(path.c_str());
+}
+
+TEST(SurfaceTest, TestRejectsInvalidSpec) {
+    const std::string path = GetTempFilePath(".p2108");
+    P2108SurfaceSpec spec;
+    P2108SurfaceDefaultSpec(1, &spec);
+    EXPECT_EQ(
+        P2108SurfaceWrite(path.c_str(), &spec), P2108_SURFACE_ERROR_ARGUMENT
+    );
+    P2108SurfaceDefaultSpec(4, &spec);
+    spec.tsm_f__ghz.min = 0.1;
+    EXPECT_EQ(
+        P2108SurfaceWrite(path.c_str(), &spec), P2108_SURFACE_ERROR_ARGUMENT
+    );
+    P2108SurfaceDefaultSpec(4, &spec);
+    spec.asm_p.max = 100;
+    EXPECT_EQ(
+        P2108SurfaceWrite(path.c_str(), &spec), P2108_SURFACE_ERROR_ARGUMENT
+    );
+    P2108SurfaceDefaultSpec(4, &spec);
+    spec.asm_theta__deg.scale = P2108_SURFACE_LOG;
+    EXPECT_EQ(
+        P2108SurfaceWrite(path.c_str(), &spec), P2108_SURFACE_ERROR_ARGUMENT
+    );
+}
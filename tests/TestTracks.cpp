@@ -0,0 +1,129 @@
+/** @file TestTracks.cpp
+ * Tests for the replay of aircraft tracks
+ */
+#include "P2108Batch.h"
+#include "P2108Tracks.h"
+#include "TestUtils.h"
+
+#include <cmath>    // for std::isnan
+#include <cstddef>  // for std::size_t
+#include <cstdint>  // for std::uint64_t
+#include <vector>   // for std::vector
+
+namespace {
+/** Frequency and percentage of each track of the tests */
+constexpr double TRACK_F__GHZ[] = {10, 26.6, 55.5, 100};
+constexpr double TRACK_P[] = {1, 45, 50, 99};
+constexpr std::size_t N_TRACKS = 4;
+}  // namespace
+
+TEST(TracksTest, TestInterleavedTracksMatchScalar) {
+    P2108TrackReplay *replay = P2108TrackReplayCreate();
+    ASSERT_NE(replay, nullptr);
+    for (std::size_t k = 0; k < N_TRACKS; k++) {
+        EXPECT_EQ(
+            P2108TrackReplaySetTrack(
+                replay,
+                100 + k,
+                TRACK_F__GHZ[k],
+                TRACK_P[k],
+                ABRAMOWITZ_STEGUN
+            ),
+            P2108_TRACK_SUCCESS
+        );
+    }
+    EXPECT_EQ(P2108TrackReplayCount(replay), N_TRACKS);
+
+    // Samples of every track interleave, spanning several tiles
+    const std::size_t n = 3 * P2108GetBatchTileSize() + 7;
+    std::vector<std::uint64_t> track(n);
+    std::vector<double> theta__deg(n), L_ces__db(n);
+    std::vector<int> rtn(n);
+    for (std::size_t i = 0; i < n; i++) {
+        track[i] = 100 + (i * 7) % N_TRACKS;
+        theta__deg[i] = (i % 181) * 0.5;
+    }
+    EXPECT_EQ(
+        P2108TrackReplayEvaluate(
+            replay,
+            n,
+            track.data(),
+            theta__deg.data(),
+            L_ces__db.data(),
+            rtn.data()
+        ),
+        0u
+    );
+    for (std::size_t i = 0; i < n; i++) {
+        const std::size_t k = track[i] - 100;
+        double expected;
+        AeronauticalStatisticalModel(
+            TRACK_F__GHZ[k], theta__deg[i], TRACK_P[k], expected
+        );
+        EXPECT_EQ(rtn[i], SUCCESS);
+        EXPECT_EQ(L_ces__db[i], expected);
+    }
+    P2108TrackReplayFree(replay);
+}
+
+TEST(TracksTest, TestInvalidSamples) {
+    P2108TrackReplay *replay = P2108TrackReplayCreate();
+    P2108TrackReplaySetTrack(replay, 1, 26.6, 45, ABRAMOWITZ_STEGUN);
+    P2108TrackReplaySetTrack(replay, 2, 26.6, 45, ABRAMOWITZ_STEGUN);
+    EXPECT_EQ(P2108TrackReplayRemoveTrack(replay, 2), P2108_TRACK_SUCCESS);
+    EXPECT_EQ(
+        P2108TrackReplayRemoveTrack(replay, 2), P2108_TRACK_ERROR_UNKNOWN
+    );
+
+    const std::uint64_t track[] = {1, 2, 1, 1};
+    const double theta__deg[] = {10, 10, -1, 91};
+    double L_ces__db[4];
+    int rtn[4];
+    EXPECT_EQ(
+        P2108TrackReplayEvaluate(replay, 4, track, theta__deg, L_ces__db, rtn),
+        3u
+    );
+    EXPECT_EQ(rtn[0], SUCCESS);
+    EXPECT_EQ(rtn[1], P2108_TRACK_ERROR_UNKNOWN);
+    EXPECT_EQ(rtn[2], ERROR33__THETA);
+    EXPECT_EQ(rtn[3], ERROR33__THETA);
+    EXPECT_FALSE(std::isnan(L_ces__db[0]));
+    for (int i = 1; i < 4; i++) {
+        EXPECT_TRUE(std::isnan(L_ces__db[i]));
+    }
+
+    // Invalid track inputs leave the track unchanged
+    EXPECT_EQ(
+        P2108TrackReplaySetTrack(replay, 1, 5, 45, ABRAMOWITZ_STEGUN),
+        ERROR33__FREQUENCY
+    );
+    EXPECT_EQ(
+        P2108TrackReplaySetTrack(replay, 1, 26.6, 100, ABRAMOWITZ_STEGUN),
+        ERROR33__PERCENTAGE
+    );
+    double L_again__db;
+    P2108TrackReplayEvaluate(
+        replay, 1, track, theta__deg, &L_again__db, nullptr
+    );
+    EXPECT_EQ(L_again__db, L_ces__db[0]);
+    EXPECT_EQ(
+        P2108TrackReplaySetTrack(nullptr, 1, 26.6, 45, ABRAMOWITZ_STEGUN),
+        P2108_TRACK_ERROR_ARGUMENT
+    );
+    P2108TrackReplayFree(replay);
+}
+
+TEST(TracksTest, TestElevationAngle) {
+    // Directly above the station
+    EXPECT_NEAR(
+        P2108ElevationAngle(40, -105, 1600, 40, -105, 11600), 90, 1e-9
+    );
+    // Level with the station at the equator, one degree east: below the
+    // horizon by half of the angle subtended at the center of the Earth
+    EXPECT_NEAR(P2108ElevationAngle(0, 0, 0, 0, 1, 0), -0.5, 1e-9);
+    // 10 km up, about 50 km north of the station
+    const double theta__deg = P2108ElevationAngle(45, 7, 0, 45.45, 7, 10000);
+    EXPECT_GT(theta__deg, 10.5);
+    EXPECT_LT(theta__deg, 11.5);
+    EXPECT_TRUE(std::isnan(P2108ElevationAngle(1, 2, 3, 1, 2, 3)));
+}
@@ -5,9 +5,16 @@
 
 #include <fstream>  // for std::ifstream
 #include <sstream>  // for std::istringstream
-#include <string>   // for std::string, std::getline
+#include <string>   // for std::string, std::getline, std::to_string
 #include <vector>   // for std::vector
 
+#ifdef _WIN32
+    #include <process.h>  // for _getpid
+    #define getpid _getpid
+#else
+    #include <unistd.h>  // for getpid
+#endif
+
 /*******************************************************************************
  * Append a directory separator ('/' or '\') to a string, based on the
  * current operating system.
@@ -40,6 +47,28 @@ std::string GetDataDirectory() {
     return dataDir;
 }
 
+/******************************************************************************
+ * Get a path for a temporary file, in the working directory, which is unique
+ * to the running test.
+ *
+ * The path is built from the names of the test and its suite and from the
+ * process ID, so tests which run concurrently (e.g., `ctest -j`) never share
+ * a file.
+ *
+ * @param[in] suffix  Text appended to the path, such as a file extension
+ * @return            The path of the temporary file
+ *****************************************************************************/
+std::string GetTempFilePath(const std::string &suffix) {
+    const ::testing::TestInfo *info
+        = ::testing::UnitTest::GetInstance()->current_test_info();
+    std::string path = "tmp_";
+    if (info != nullptr) {
+        path += std::string(info->test_suite_name()) + "_" + info->name() + "_";
+    }
+    path += std::to_string(static_cast<long>(getpid()));
+    return path + suffix;
+}
+
 std::vector<AeronauticalStatisticalModelTestData>
     readAeronauticalStatisticalModelTestData(const std::string &filename) {
     std::vector<AeronauticalStatisticalModelTestData> testData;
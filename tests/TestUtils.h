@@ -20,6 +20,7 @@ constexpr double ABSTOL__DB = 0.1;
 
 void AppendDirectorySep(std::string &str);
 std::string GetDataDirectory();
+std::string GetTempFilePath(const std::string &suffix);
 
 struct AeronauticalStatisticalModelTestData {
         double f__ghz;